@@ -1,3 +1,5 @@
 Config={}
 Config.title="[container]" --
-Config.data_path="../data/" --设置资源目录
\ No newline at end of file
+Config.data_path="../data/" --设置资源目录
+Config.physics_pvd=false --是否连接PhysX Visual Debugger，环境变量PHYSICS_PVD=1也可以开启
+Config.physics_pvd_host="127.0.0.1" --PVD地址
\ No newline at end of file
@@ -11,6 +11,7 @@ require("renderer/texture_2d")
 require("renderer/render_texture")
 require("renderer/render_texture_geometry_buffer")
 require("renderer/noise_texture")
+require("renderer/frame_graph")
 require("control/input")
 require("control/key_code")
 require("utils/screen")
@@ -36,24 +37,52 @@ function LoginScene:ctor()
 
     ---@field render_texture_geometry_buffer_ RenderTextureGeometryBuffer
     self.render_texture_geometry_buffer_ = nil
-    self.render_texture_ssao_ = nil
+    ---@field render_texture_geometry_buffer_packed_ RenderTextureGeometryBuffer 压缩GBuffer
+    self.render_texture_geometry_buffer_packed_ = nil
+    self.use_packed_geometry_buffer_ = false --使用压缩GBuffer，按G键切换，对比帧耗时。
+    self.go_camera_ssao_blur_horizontal_ = nil
+    self.go_camera_ssao_blur_vertical_ = nil
+    self.material_ssao_blur_horizontal_ = nil --SSAO水平模糊
+    self.material_ssao_blur_vertical_ = nil --SSAO垂直模糊
+    --SSAO档位，按T键切换。scale:分辨率缩小倍数 kernel_size:默认采样数量 blur:是否模糊
+    --每个档位有自己的RenderTexture，都是临时的，只有当前档位的会被FrameGraph分配显存。
+    self.ssao_tier_vec_ = {
+        {name="full",scale=1,kernel_size=64,blur=false},
+        {name="half",scale=2,kernel_size=32,blur=true},
+        {name="quarter",scale=4,kernel_size=16,blur=true},
+    }
+    self.ssao_tier_index_ = 1
+    self.ssao_kernel_size_ = 64 --SSAO采样数量，按K键切换。
+    self.ssao_benchmark_ = nil --按B键依次测试每个档位的帧耗时
     self.noise_texture_ = nil
     self.go_skeleton_ = nil --骨骼蒙皮动画物体
     self.animation_ = nil--骨骼动画
     self.animation_clip_ = nil --- 骨骼动画片段
     self.material_fbx_model_ = nil --材质
+    self.material_fbx_model_packed_ = nil --输出到压缩GBuffer的材质
+    self.mesh_renderer_fbx_model_ = nil
     self.environment_=nil --环境
     self.go_point_light_1_=nil --灯光
     self.go_point_light_2_=nil --灯光
+    self.go_point_light_vec_={} --分簇光照的点光源
     self.go_ssao_deferred_rendering_plane_=nil--墙壁
     self.material_ssao_deferred_rendering_plane_=nil
+    self.material_clustered_lighting_plane_=nil --分簇计算点光源的合成材质，只支持完整GBuffer。
+    self.mesh_renderer_ssao_deferred_rendering_plane_=nil
+    self.use_clustered_lighting_ = false --使用分簇点光源合成，按L键切换。
+    self.material_ssao_near_plane_packed_=nil --从压缩GBuffer计算SSAO的材质
+    self.mesh_renderer_ssao_near_plane_=nil
 end
 
 function LoginScene:Awake()
     print("LoginScene Awake")
     LoginScene.super.Awake(self)
 
+    --相机按读写的RenderTexture排序，GBuffer、SSAO只在这一帧内使用，交给FrameGraph分配显存。
+    FrameGraph:set_enable(true)
+
     self:CreateEnvironment()
+    self:CreatePointLights()
     self:CreateModel()
 
     self:CreateGeometryBufferCamera()
@@ -61,8 +90,13 @@ function LoginScene:Awake()
     self:CreateSSAOCamera()
     self:CreateSSAOPlane()
 
+    self:CreateSSAOBlurCameras()
+
     self:CreateSSAODeferredRenderingCamera()
     self:CreateSSAODeferredRenderingPlane()
+
+    self:UsePackedGeometryBuffer(self.use_packed_geometry_buffer_)
+    self:UseSSAOTier(self.ssao_tier_index_)
 end
 
 --- 创建环境
@@ -72,11 +106,31 @@ function LoginScene:CreateEnvironment()
     self.environment_:set_ambient_color_intensity(0.0)
 end
 
+--- 创建点光源，在模型前方排成网格，用于测试光源分簇。
+function LoginScene:CreatePointLights()
+    math.randomseed(os.time())
+    for y=0,7 do
+        for x=0,11 do
+            local go_point_light=GameObject.new("point_light_"..(y*12+x))
+            go_point_light:AddComponent(Transform):set_local_position(glm.vec3(x*0.5-2.75,y*0.5-1.75,1))
+            ---@type PointLight
+            local light=go_point_light:AddComponent(PointLight)
+            light:set_color(glm.vec3(math.random_floats(0,1),math.random_floats(0,1),math.random_floats(0,1)))
+            light:set_intensity(0.3)
+            --衰减快，照射范围小，每个簇只有少量灯光。
+            light:set_attenuation_constant(1.0)
+            light:set_attenuation_linear(0.7)
+            light:set_attenuation_quadratic(4.0)
+            table.insert(self.go_point_light_vec_,go_point_light)
+        end
+    end
+end
+
 --- 创建模型
 function LoginScene:CreateModel()
     --创建骨骼蒙皮动画
     self.go_skeleton_=GameObject.new("skeleton")
-    self.go_skeleton_:set_layer(2<<1)
+    self.go_skeleton_:set_layer(shift_left(2,1))
     self.go_skeleton_:AddComponent(Transform):set_local_position(glm.vec3(0, 0, 0))
     self.go_skeleton_:GetComponent(Transform):set_local_rotation(glm.vec3(-30, 0, 0))
 
@@ -86,10 +140,12 @@ function LoginScene:CreateModel()
     --手动创建Material
     self.material_fbx_model_ = Material.new()--设置材质
     self.material_fbx_model_:Parse("material/default_ssao_gbuffer.mat")
+    self.material_fbx_model_packed_ = Material.new()
+    self.material_fbx_model_packed_:Parse("material/default_ssao_gbuffer_packed.mat")
 
     --挂上 MeshRenderer 组件
-    local mesh_renderer= self.go_skeleton_:AddComponent(MeshRenderer)
-    mesh_renderer:SetMaterial(self.material_fbx_model_)
+    self.mesh_renderer_fbx_model_= self.go_skeleton_:AddComponent(MeshRenderer)
+    self.mesh_renderer_fbx_model_:SetMaterial(self.material_fbx_model_)
 end
 
 --- 创建渲染到GeometryBuffer相机
@@ -104,15 +160,23 @@ function LoginScene:CreateGeometryBufferCamera()
     --设置为黑色背景
     geometry_buffer_camera:set_clear_color(49/255,77/255,121/255,1)
     geometry_buffer_camera:set_depth(1)
-    geometry_buffer_camera:set_culling_mask(2<<1)
+    geometry_buffer_camera:set_culling_mask(shift_left(2,1))
     geometry_buffer_camera:SetView(glm.vec3(0.0,0.0,0.0), glm.vec3(0.0,1.0,0.0))
     geometry_buffer_camera:SetPerspective(60, Screen:aspect_ratio(), 1, 1000)
     --设置延迟渲染
     geometry_buffer_camera:set_deferred_shading(true)
+    --合成Pass按GBuffer相机的视锥体分簇读取点光源
+    geometry_buffer_camera:set_light_cluster(true)
     --设置RenderTexture
     self.render_texture_geometry_buffer_ = RenderTextureGeometryBuffer.new()
+    self.render_texture_geometry_buffer_:set_transient(true)
     self.render_texture_geometry_buffer_:Init(960,640)
     geometry_buffer_camera:set_target_render_texture(self.render_texture_geometry_buffer_)
+    --压缩GBuffer，切换时替换相机的RenderTexture
+    self.render_texture_geometry_buffer_packed_ = RenderTextureGeometryBuffer.new()
+    self.render_texture_geometry_buffer_packed_:set_transient(true)
+    self.render_texture_geometry_buffer_packed_:set_packed(true)
+    self.render_texture_geometry_buffer_packed_:Init(960,640)
 end
 
 --- 创建渲染到SSAO相机
@@ -127,13 +191,21 @@ function LoginScene:CreateSSAOCamera()
     --设置为黑色背景
     ssao_camera:set_clear_color(49/255,77/255,121/255,1)
     ssao_camera:set_depth(2)
-    ssao_camera:set_culling_mask(2<<2)
+    ssao_camera:set_culling_mask(shift_left(2,2))
     ssao_camera:SetView(glm.vec3(0.0,0.0,0.0), glm.vec3(0.0,1.0,0.0))
     ssao_camera:SetPerspective(60, Screen:aspect_ratio(), 1, 1000)
-    --设置RenderTexture
-    self.render_texture_ssao_ = RenderTexture.new()
-    self.render_texture_ssao_:Init(960,640)
-    ssao_camera:set_target_render_texture(self.render_texture_ssao_)
+    --每个档位创建SSAO、水平模糊、垂直模糊的RenderTexture，UpdateSSAOPasses中设置给相机。
+    local create_render_texture=function(scale)
+        local render_texture = RenderTexture.new()
+        render_texture:set_transient(true)
+        render_texture:Init(math.floor(960/scale),math.floor(640/scale))
+        return render_texture
+    end
+    for _,tier in ipairs(self.ssao_tier_vec_) do
+        tier.render_texture_ssao_=create_render_texture(tier.scale)
+        tier.render_texture_blur_horizontal_=create_render_texture(tier.scale)
+        tier.render_texture_blur_vertical_=create_render_texture(tier.scale)
+    end
 end
 
 ---手动创建SSAO目标FBO需要的Plane
@@ -156,7 +228,7 @@ function LoginScene:CreateSSAOPlane()
     go_ssao_near_plane_:AddComponent(Transform):set_local_position(glm.vec3(0, 0, -10))
     go_ssao_near_plane_:GetComponent(Transform):set_local_rotation(glm.vec3(0, 0, 0))
 
-    go_ssao_near_plane_:set_layer(2<<2)
+    go_ssao_near_plane_:set_layer(shift_left(2,2))
 
     local mesh_filter=go_ssao_near_plane_:AddComponent(MeshFilter)
     mesh_filter:CreateMesh(vertex_data,vertex_index_data)--手动构建Mesh
@@ -174,9 +246,16 @@ function LoginScene:CreateSSAOPlane()
     self.material_ssao_near_plane_:SetTexture("u_noise_texture",noise_texture:noise_texture_2d())
     ObjectReferenceManager:Retain(noise_texture)
 
+    --压缩GBuffer没有坐标纹理，从深度重建坐标。
+    self.material_ssao_near_plane_packed_ = Material.new()
+    self.material_ssao_near_plane_packed_:Parse("material/default_renderer_to_ssao_buffer_packed.mat")
+    self.material_ssao_near_plane_packed_:SetTexture("u_frag_depth_texture",self.render_texture_geometry_buffer_packed_:depth_texture_2d())
+    self.material_ssao_near_plane_packed_:SetTexture("u_frag_normal_texture",self.render_texture_geometry_buffer_packed_:frag_normal_texture_2d())
+    self.material_ssao_near_plane_packed_:SetTexture("u_noise_texture",noise_texture:noise_texture_2d())
+
     --挂上 MeshRenderer 组件
-    local mesh_renderer= go_ssao_near_plane_:AddComponent(MeshRenderer)
-    mesh_renderer:SetMaterial(self.material_ssao_near_plane_)
+    self.mesh_renderer_ssao_near_plane_= go_ssao_near_plane_:AddComponent(MeshRenderer)
+    self.mesh_renderer_ssao_near_plane_:SetMaterial(self.material_ssao_near_plane_)
 end
 
 ---创建16个随机向量，用于噪声纹理
@@ -193,6 +272,67 @@ function LoginScene:CreateNoise()
     return ssaoNoise
 end
 
+--- 创建SSAO水平、垂直模糊相机，在SSAO分辨率下按深度差加权模糊，去掉噪声纹理的图案。
+--- 不模糊的档位合成时不读取模糊结果，FrameGraph会剔除这两个相机。
+function LoginScene:CreateSSAOBlurCameras()
+    local create_camera=function(name,depth,layer)
+        local go_camera= GameObject.new(name)
+        go_camera:AddComponent(Transform):set_local_position(glm.vec3(0, 0, 10))
+        go_camera:GetComponent(Transform):set_local_rotation(glm.vec3(0, 0, 0))
+        local camera=go_camera:AddComponent(Camera)
+        camera:set_clear_color(1,1,1,1)
+        camera:set_depth(depth)
+        camera:set_culling_mask(layer)
+        camera:SetView(glm.vec3(0.0,0.0,0.0), glm.vec3(0.0,1.0,0.0))
+        --和GBuffer相机相同的投影，Shader中用来把深度转换为线性深度。
+        camera:SetPerspective(60, Screen:aspect_ratio(), 1, 1000)
+        return go_camera
+    end
+    self.go_camera_ssao_blur_horizontal_=create_camera("ssao_blur_horizontal_camera",3,shift_left(2,4))
+    self.go_camera_ssao_blur_vertical_=create_camera("ssao_blur_vertical_camera",4,shift_left(2,5))
+
+    self.material_ssao_blur_horizontal_=self:CreateSSAOBlurPlane("ssao_blur_horizontal_plane",shift_left(2,4),glm.vec3(1,0,0))
+    self.material_ssao_blur_vertical_=self:CreateSSAOBlurPlane("ssao_blur_vertical_plane",shift_left(2,5),glm.vec3(0,1,0))
+end
+
+---手动创建SSAO模糊需要的Plane
+---@param name string
+---@param layer number
+---@param blur_direction glm.vec3 @模糊方向
+---@return Material
+function LoginScene:CreateSSAOBlurPlane(name,layer,blur_direction)
+    local vertex_data={
+        -1,-1,0,  1.0,1.0,1.0,1.0, 0,0, -1,-1,1,
+        1,-1,0,  1.0,1.0,1.0,1.0, 1,0, 1,-1,1,
+        1, 1,0,  1.0,1.0,1.0,1.0, 1,1, 1, 1,1,
+        -1, 1,0,  1.0,1.0,1.0,1.0, 0,1, -1, 1,1,
+    }
+    local vertex_index_data={
+        0,1,2,
+        0,2,3,
+    }
+
+    local go_plane=GameObject.new(name)
+    ObjectReferenceManager:Retain(go_plane)
+
+    go_plane:AddComponent(Transform):set_local_position(glm.vec3(0, 0, -10))
+    go_plane:GetComponent(Transform):set_local_rotation(glm.vec3(0, 0, 0))
+
+    go_plane:set_layer(layer)
+
+    local mesh_filter=go_plane:AddComponent(MeshFilter)
+    mesh_filter:CreateMesh(vertex_data,vertex_index_data)--手动构建Mesh
+
+    --纹理在UpdateSSAOPasses中设置
+    local material = Material.new()
+    material:Parse("material/default_ssao_blur.mat")
+    material:SetUniform3f("u_blur_direction",blur_direction)
+
+    local mesh_renderer= go_plane:AddComponent(MeshRenderer)
+    mesh_renderer:SetMaterial(material)
+    return material
+end
+
 
 --- 创建延迟渲染相机
 function LoginScene:CreateSSAODeferredRenderingCamera()
@@ -205,8 +345,8 @@ function LoginScene:CreateSSAODeferredRenderingCamera()
     local camera_deferred_rendering=self.go_camera_deferred_rendering_:AddComponent(Camera)
     --设置为黑色背景
     camera_deferred_rendering:set_clear_color(49/255,77/255,121/255,1)
-    camera_deferred_rendering:set_depth(3)
-    camera_deferred_rendering:set_culling_mask(2<<3)
+    camera_deferred_rendering:set_depth(5)
+    camera_deferred_rendering:set_culling_mask(shift_left(2,3))
     camera_deferred_rendering:SetView(glm.vec3(0.0,0.0,0.0), glm.vec3(0.0,1.0,0.0))
     camera_deferred_rendering:SetPerspective(60, Screen:aspect_ratio(), 1, 1000)
 end
@@ -229,7 +369,7 @@ function LoginScene:CreateSSAODeferredRenderingPlane()
     self.go_ssao_deferred_rendering_plane_:AddComponent(Transform):set_local_position(glm.vec3(0, 0, -10))
     self.go_ssao_deferred_rendering_plane_:GetComponent(Transform):set_local_rotation(glm.vec3(0, 0, 0))
 
-    self.go_ssao_deferred_rendering_plane_:set_layer(2<<3)
+    self.go_ssao_deferred_rendering_plane_:set_layer(shift_left(2,3))
 
     local mesh_filter=self.go_ssao_deferred_rendering_plane_:AddComponent(MeshFilter)
     mesh_filter:CreateMesh(vertex_data,vertex_index_data)--手动构建Mesh
@@ -237,19 +377,172 @@ function LoginScene:CreateSSAODeferredRenderingPlane()
     --手动创建Material
     self.material_ssao_deferred_rendering_plane_ = Material.new()--设置材质
     self.material_ssao_deferred_rendering_plane_:Parse("material/default_ssao_deferred_rendering.mat")
-    --设置材质纹理
-    self.material_ssao_deferred_rendering_plane_:SetTexture("u_frag_diffuse_color_texture",self.render_texture_geometry_buffer_:frag_diffuse_color_texture_2d())
-    self.material_ssao_deferred_rendering_plane_:SetTexture("u_ssao_texture",self.render_texture_ssao_:color_texture_2d())
+    --材质纹理在UsePackedGeometryBuffer、UpdateSSAOPasses中设置。
+
+    --分簇点光源合成，读取完整GBuffer，灯光网格、灯光索引纹理是全局纹理。
+    self.material_clustered_lighting_plane_ = Material.new()
+    self.material_clustered_lighting_plane_:Parse("material/ssao_rendering_clustered.mat")
+    local render_texture_geometry_buffer=self.render_texture_geometry_buffer_
+    self.material_clustered_lighting_plane_:SetTexture("u_frag_position_texture",render_texture_geometry_buffer:frag_position_texture_2d())
+    self.material_clustered_lighting_plane_:SetTexture("u_frag_normal_texture",render_texture_geometry_buffer:frag_normal_texture_2d())
+    self.material_clustered_lighting_plane_:SetTexture("u_frag_vertex_color_texture",render_texture_geometry_buffer:frag_vertex_color_texture_2d())
+    self.material_clustered_lighting_plane_:SetTexture("u_frag_diffuse_color_texture",render_texture_geometry_buffer:frag_diffuse_color_texture_2d())
+    self.material_clustered_lighting_plane_:SetTexture("u_frag_specular_intensity_texture",render_texture_geometry_buffer:frag_specular_intensity_texture_2d())
+    self.material_clustered_lighting_plane_:SetTexture("u_frag_specular_highlight_shininess_texture",render_texture_geometry_buffer:frag_specular_highlight_shininess_texture_2d())
 
     --挂上 MeshRenderer 组件
-    local mesh_renderer= self.go_ssao_deferred_rendering_plane_:AddComponent(MeshRenderer)
-    mesh_renderer:SetMaterial(self.material_ssao_deferred_rendering_plane_)
+    self.mesh_renderer_ssao_deferred_rendering_plane_= self.go_ssao_deferred_rendering_plane_:AddComponent(MeshRenderer)
+    self.mesh_renderer_ssao_deferred_rendering_plane_:SetMaterial(self.material_ssao_deferred_rendering_plane_)
 end
 
+--- 切换完整GBuffer/压缩GBuffer，替换GBuffer相机的RenderTexture、模型和SSAO的材质，以及相机读取的RenderTexture。
+--- @param packed boolean
+function LoginScene:UsePackedGeometryBuffer(packed)
+    self.use_packed_geometry_buffer_=packed
+    --压缩GBuffer没有坐标、高光纹理，不能分簇计算点光源。
+    if packed and self.use_clustered_lighting_ then
+        self:UseClusteredLighting(false)
+    end
+    local render_texture_geometry_buffer=packed and self.render_texture_geometry_buffer_packed_ or self.render_texture_geometry_buffer_
+
+    self.go_camera_geometry_buffer_:GetComponent(Camera):set_target_render_texture(render_texture_geometry_buffer)
+    self.mesh_renderer_fbx_model_:SetMaterial(packed and self.material_fbx_model_packed_ or self.material_fbx_model_)
+    self.mesh_renderer_ssao_near_plane_:SetMaterial(packed and self.material_ssao_near_plane_packed_ or self.material_ssao_near_plane_)
+    --压缩GBuffer的Diffuse纹理a通道是高光强度，rgb不变。
+    self.material_ssao_deferred_rendering_plane_:SetTexture("u_frag_diffuse_color_texture",render_texture_geometry_buffer:frag_diffuse_color_texture_2d())
+
+    self:UpdateSSAOPasses()
+
+    print("LoginScene use packed geometry buffer:"..tostring(packed))
+end
+
+--- 切换合成材质：只计算环境光和SSAO / 分簇计算点光源。
+--- @param clustered boolean
+function LoginScene:UseClusteredLighting(clustered)
+    if clustered and self.use_packed_geometry_buffer_ then
+        print("LoginScene clustered lighting need full geometry buffer,press G to switch")
+        return
+    end
+    self.use_clustered_lighting_=clustered
+    self.mesh_renderer_ssao_deferred_rendering_plane_:SetMaterial(clustered and self.material_clustered_lighting_plane_ or self.material_ssao_deferred_rendering_plane_)
+
+    print("LoginScene use clustered lighting:"..tostring(clustered).." point light num:"..#self.go_point_light_vec_)
+end
+
+--- 切换SSAO档位，采样数量恢复为档位默认值。
+--- @param tier_index number
+function LoginScene:UseSSAOTier(tier_index)
+    self.ssao_tier_index_=tier_index
+    local tier=self.ssao_tier_vec_[tier_index]
+    self:UpdateSSAOPasses()
+    self:SetSSAOKernelSize(tier.kernel_size)
+
+    print("LoginScene use ssao tier:"..tier.name.." scale:1/"..tier.scale.." blur:"..tostring(tier.blur))
+end
+
+--- 设置SSAO采样数量，只在变化时重新生成采样核心。
+--- @param kernel_size number @不超过64
+function LoginScene:SetSSAOKernelSize(kernel_size)
+    self.ssao_kernel_size_=kernel_size
+    local ssao_kernel=self:GenerateSSAOKernel(kernel_size)
+    for _,material in ipairs({self.material_ssao_near_plane_,self.material_ssao_near_plane_packed_}) do
+        material:SetUniform1f("u_kernel_size",kernel_size)
+        for i=1,#ssao_kernel do
+            material:SetUniform3f("u_ssao_kernel["..(i-1).."]",ssao_kernel[i])
+        end
+    end
+    print("LoginScene ssao kernel size:"..kernel_size)
+end
+
+--- 按当前GBuffer和SSAO档位，设置SSAO、模糊、合成相机的RenderTexture和材质。
+function LoginScene:UpdateSSAOPasses()
+    local render_texture_geometry_buffer=self.use_packed_geometry_buffer_ and self.render_texture_geometry_buffer_packed_ or self.render_texture_geometry_buffer_
+    local depth_texture_2d=render_texture_geometry_buffer:depth_texture_2d()
+    local tier=self.ssao_tier_vec_[self.ssao_tier_index_]
+
+    --SSAO读取GBuffer的坐标(深度)、法线
+    local ssao_camera=self.go_camera_ssao_:GetComponent(Camera)
+    ssao_camera:set_target_render_texture(tier.render_texture_ssao_)
+    ssao_camera:ClearInputRenderTexture()
+    ssao_camera:AddInputRenderTexture(render_texture_geometry_buffer)
+    self.material_ssao_near_plane_:SetUniform1f("u_ssao_scale",tier.scale)
+    self.material_ssao_near_plane_packed_:SetUniform1f("u_ssao_scale",tier.scale)
+
+    --水平模糊读取SSAO结果，垂直模糊读取水平模糊结果，都需要GBuffer深度。
+    local blur_pass_vec={
+        {self.go_camera_ssao_blur_horizontal_,self.material_ssao_blur_horizontal_,tier.render_texture_ssao_,tier.render_texture_blur_horizontal_},
+        {self.go_camera_ssao_blur_vertical_,self.material_ssao_blur_vertical_,tier.render_texture_blur_horizontal_,tier.render_texture_blur_vertical_},
+    }
+    for _,blur_pass in ipairs(blur_pass_vec) do
+        local camera=blur_pass[1]:GetComponent(Camera)
+        local material=blur_pass[2]
+        camera:set_target_render_texture(blur_pass[4])
+        camera:ClearInputRenderTexture()
+        camera:AddInputRenderTexture(render_texture_geometry_buffer)
+        camera:AddInputRenderTexture(blur_pass[3])
+        material:SetTexture("u_ssao_texture",blur_pass[3]:color_texture_2d())
+        material:SetTexture("u_frag_depth_texture",depth_texture_2d)
+        material:SetUniform1f("u_ssao_scale",tier.scale)
+    end
+
+    --合成读取GBuffer的Diffuse和SSAO结果，低分辨率时按GBuffer深度双边上采样。
+    local render_texture_ssao=tier.blur and tier.render_texture_blur_vertical_ or tier.render_texture_ssao_
+    self.material_ssao_deferred_rendering_plane_:SetTexture("u_ssao_texture",render_texture_ssao:color_texture_2d())
+    self.material_ssao_deferred_rendering_plane_:SetTexture("u_frag_depth_texture",depth_texture_2d)
+    self.material_ssao_deferred_rendering_plane_:SetUniform1f("u_ssao_scale",tier.scale)
+    local camera_deferred_rendering=self.go_camera_deferred_rendering_:GetComponent(Camera)
+    camera_deferred_rendering:ClearInputRenderTexture()
+    camera_deferred_rendering:AddInputRenderTexture(render_texture_geometry_buffer)
+    camera_deferred_rendering:AddInputRenderTexture(render_texture_ssao)
+end
+
+--- 开始依次测试每个SSAO档位的帧耗时，测试完恢复当前档位。
+function LoginScene:StartSSAOBenchmark()
+    self.ssao_benchmark_={
+        restore_tier_index_=self.ssao_tier_index_,
+        tier_index_=1,
+        frame_=0,
+        warm_up_frame_num_=30,--切换后等待显存分配、Shader编译
+        frame_num_=120,
+        total_time_=0,
+        result_vec_={},
+    }
+    self:UseSSAOTier(1)
+end
+
+--- 每帧累计当前档位的帧耗时
+function LoginScene:UpdateSSAOBenchmark()
+    local benchmark=self.ssao_benchmark_
+    benchmark.frame_=benchmark.frame_+1
+    if benchmark.frame_<=benchmark.warm_up_frame_num_ then
+        return
+    end
+    benchmark.total_time_=benchmark.total_time_+Time:delta_time()
+    if benchmark.frame_<benchmark.warm_up_frame_num_+benchmark.frame_num_ then
+        return
+    end
+
+    local tier=self.ssao_tier_vec_[benchmark.tier_index_]
+    table.insert(benchmark.result_vec_,{tier.name,benchmark.total_time_*1000/benchmark.frame_num_})
+    if benchmark.tier_index_<#self.ssao_tier_vec_ then
+        benchmark.tier_index_=benchmark.tier_index_+1
+        benchmark.frame_=0
+        benchmark.total_time_=0
+        self:UseSSAOTier(benchmark.tier_index_)
+        return
+    end
+
+    self.ssao_benchmark_=nil
+    for _,result in ipairs(benchmark.result_vec_) do
+        print(string.format("LoginScene ssao benchmark tier:%s frame time:%.3fms",result[1],result[2]))
+    end
+    self:UseSSAOTier(benchmark.restore_tier_index_)
+end
 
 ---创建SSAOKernel即对片段周围随机采样点，对于每个片段，会再叠加一个随机值。在Shader中有个64位长度的数组，需要一个一个将数值上传到Shader中。
 ---@return table<number,glm.vec3>
-function LoginScene:GenerateSSAOKernel()
+---@param kernel_size number @采样数量
+function LoginScene:GenerateSSAOKernel(kernel_size)
     local lerp = function(a, b, f)
         return a + f * (b - a)
     end
@@ -257,7 +550,7 @@ function LoginScene:GenerateSSAOKernel()
     local ssaoKernel = {}
     math.randomseed(os.time())
 
-    for i = 1, 64 do
+    for i = 1, kernel_size do
         local sample = glm.vec3(
                 math.random_floats(-1.0, 1.0),
                 math.random_floats(-1.0, 1.0),
@@ -266,7 +559,8 @@ function LoginScene:GenerateSSAOKernel()
         sample = glm.normalize(sample)
         sample = sample * math.random_floats(0.0, 1.0)
 
-        local scale = i / 64.0
+        --采样点靠近中心更密集，采样数量少时同样覆盖整个半径。
+        local scale = i / kernel_size
         scale = lerp(0.1, 1.0, scale * scale)
         sample = sample * scale
 
@@ -288,11 +582,33 @@ function LoginScene:Update()
     --设置观察者世界坐标(即相机位置)
     local camera_position=self.go_camera_geometry_buffer_:GetComponent(Transform):position()
     self.material_fbx_model_:SetUniform3f("u_view_pos",camera_position)
+    self.material_clustered_lighting_plane_:SetUniform3f("u_view_pos",camera_position)
 
-    --设置ssao_kernel
-    local ssao_kernel=self:GenerateSSAOKernel()
-    for i=1,#ssao_kernel do
-        self.material_ssao_near_plane_:SetUniform3f("u_ssao_kernel["..(i-1).."]",ssao_kernel[i])
+    --按G键切换完整GBuffer/压缩GBuffer
+    if Input.GetKeyUp(Cpp.KeyCode.KEY_CODE_G) then
+        self:UsePackedGeometryBuffer(not self.use_packed_geometry_buffer_)
+    end
+    --按L键切换分簇点光源合成
+    if Input.GetKeyUp(Cpp.KeyCode.KEY_CODE_L) then
+        self:UseClusteredLighting(not self.use_clustered_lighting_)
+    end
+    local material_ssao_near_plane=self.use_packed_geometry_buffer_ and self.material_ssao_near_plane_packed_ or self.material_ssao_near_plane_
+
+    --按T键切换SSAO档位，按K键切换采样数量，按B键测试每个档位的帧耗时。
+    if self.ssao_benchmark_ then
+        self:UpdateSSAOBenchmark()
+    elseif Input.GetKeyUp(Cpp.KeyCode.KEY_CODE_T) then
+        self:UseSSAOTier(self.ssao_tier_index_ % #self.ssao_tier_vec_ + 1)
+    elseif Input.GetKeyUp(Cpp.KeyCode.KEY_CODE_K) then
+        self:SetSSAOKernelSize(self.ssao_kernel_size_>=64 and 8 or self.ssao_kernel_size_*2)
+    elseif Input.GetKeyUp(Cpp.KeyCode.KEY_CODE_B) then
+        self:StartSSAOBenchmark()
+    end
+    --压缩GBuffer从深度重建坐标，需要GBuffer相机的逆矩阵。
+    if self.use_packed_geometry_buffer_ then
+        local geometry_buffer_camera=self.go_camera_geometry_buffer_:GetComponent(Camera)
+        local view_projection=geometry_buffer_camera:projection_mat4()*geometry_buffer_camera:view_mat4()
+        material_ssao_near_plane:SetUniformMatrix4f("u_inverse_view_projection",glm.inverse(view_projection))
     end
 
     --鼠标滚轮控制相机远近
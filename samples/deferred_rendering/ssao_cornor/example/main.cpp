@@ -3,8 +3,18 @@
 #include "app/application.h"
 #include "app/application_editor.h"
 #include "app/application_standalone.h"
+#include "app/application_headless.h"
 
-int main(void){
+int main(int argc,char* argv[]){
+    //--headless 无窗口运行 --frames=N 帧，输出帧耗时统计后退出。
+    //--headless --script-benchmark 只执行脚本性能测试。
+    int frame_num=1000;
+    bool script_benchmark=false;
+    if(ApplicationHeadless::ParseCommandLine(argc,argv,frame_num,script_benchmark)){
+        Application::Init(new ApplicationHeadless(frame_num,script_benchmark));
+        Application::Run();
+        return 0;
+    }
     Application::Init(new ApplicationEditor());
     Application::Run();
     return 0;
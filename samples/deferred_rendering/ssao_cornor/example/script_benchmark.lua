@@ -0,0 +1,214 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+--- 脚本性能测试：同样的脚本分别在Lua和LuaJIT构建中运行，对比向量计算、Transform动画、组件Update的耗时和内存分配。
+--- 引擎中运行：ssao --headless --script-benchmark
+--- 单独运行(没有glm，只测试number和ffi)：cd example && lua script_benchmark.lua 或 luajit script_benchmark.lua
+if Cpp==nil then
+    package.path="../source_lua/?.lua;../source_lua/utils/?.lua;"..package.path
+end
+
+require("lua_extension")
+require("ffi_math")
+
+local DELTA_TIME=1/60
+
+local sin=math.sin
+local cos=math.cos
+local sqrt=math.sqrt
+
+--- 执行一项测试
+--- @param func function 参数是执行次数，返回计算结果，避免被优化掉。
+--- @param count number 执行次数
+--- @return number,number 耗时(毫秒)，每1000次分配的内存(KB)
+local function measure(func,count)
+    func(math.floor(count/10))--预热，LuaJIT先把循环编译好。
+    collectgarbage("collect")
+    local begin=os.clock()
+    func(count)
+    local time=(os.clock()-begin)*1000
+
+    --停止GC，统计分配量。
+    local allocate_count=math.max(math.floor(count/10),1)
+    collectgarbage("collect")
+    collectgarbage("stop")
+    local memory=collectgarbage("count")
+    func(allocate_count)
+    local allocated=(collectgarbage("count")-memory)/allocate_count*1000
+    collectgarbage("restart")
+    collectgarbage("collect")
+    return time,allocated
+end
+
+-- 向量计算：模拟粒子，速度衰减、重力、累计长度。
+local vector_math_count=200000
+local vector_math={
+    number=function(count)
+        local px,py,pz=0,0,0
+        local vx,vy,vz=1,2,3
+        local sum=0
+        for i=1,count do
+            vx,vy,vz=vx*0.99,(vy-9.8*DELTA_TIME)*0.99,vz*0.99
+            px,py,pz=px+vx*DELTA_TIME,py+vy*DELTA_TIME,pz+vz*DELTA_TIME
+            sum=sum+sqrt(px*px+py*py+pz*pz)
+        end
+        return sum
+    end,
+    glm=glm and function(count)
+        local position=glm.vec3(0,0,0)
+        local velocity=glm.vec3(1,2,3)
+        local gravity=glm.vec3(0,-9.8,0)
+        local origin=glm.vec3(0,0,0)
+        local sum=0
+        for i=1,count do
+            velocity=(velocity+gravity*DELTA_TIME)*0.99
+            position=position+velocity*DELTA_TIME
+            sum=sum+glm.distance(position,origin)
+        end
+        return sum
+    end,
+    ffi=FFIMath.enable and function(count)
+        local vec3=FFIMath.vec3
+        local position=vec3(0,0,0)
+        local velocity=vec3(1,2,3)
+        local gravity=vec3(0,-9.8,0)
+        local sum=0
+        for i=1,count do
+            velocity=(velocity+gravity*DELTA_TIME)*0.99
+            position=position+velocity*DELTA_TIME
+            sum=sum+position:length()
+        end
+        return sum
+    end,
+}
+
+-- Transform动画：每个物体绕Y轴旋转，计算模型矩阵并变换一个点。次数是帧数。
+local transform_object_num=1000
+local transform_frame_count=60
+local transform_angles={}
+local transform_speeds={}
+local transform_offsets={}
+for i=1,transform_object_num do
+    transform_angles[i]=0
+    transform_speeds[i]=i%7+1
+    transform_offsets[i]=i%13+1
+end
+
+local transform_animation={
+    number=function(count)
+        local sum=0
+        for frame=1,count do
+            for i=1,transform_object_num do
+                local angle=transform_angles[i]+transform_speeds[i]*DELTA_TIME
+                transform_angles[i]=angle
+                --绕Y轴旋转 (offset,0,0)
+                local x=cos(angle)*transform_offsets[i]
+                local z=-sin(angle)*transform_offsets[i]
+                sum=sum+x+z
+            end
+        end
+        return sum
+    end,
+    glm=glm and function(count)
+        local identity=glm.mat4(1)
+        local axis=glm.vec3(0,1,0)
+        local sum=0
+        for frame=1,count do
+            for i=1,transform_object_num do
+                local angle=transform_angles[i]+transform_speeds[i]*DELTA_TIME
+                transform_angles[i]=angle
+                local model=glm.rotate(identity,angle,axis)
+                local position=model*glm.vec4(transform_offsets[i],0,0,1)
+                sum=sum+position.x+position.z
+            end
+        end
+        return sum
+    end,
+    ffi=FFIMath.enable and function(count)
+        local vec4=FFIMath.vec4
+        local angle_axis=FFIMath.angle_axis
+        local axis=FFIMath.vec3(0,1,0)
+        local sum=0
+        for frame=1,count do
+            for i=1,transform_object_num do
+                local angle=transform_angles[i]+transform_speeds[i]*DELTA_TIME
+                transform_angles[i]=angle
+                local model=angle_axis(angle,axis):to_mat4()
+                local position=model*vec4(transform_offsets[i],0,0,1)
+                sum=sum+position.x+position.z
+            end
+        end
+        return sum
+    end,
+}
+
+-- 组件Update：和ComponentScheduler一样用xpcall逐个调用，组件中移动位置。次数是帧数。
+local component_num=2000
+local component_frame_count=60
+
+local BenchmarkComponent=class("BenchmarkComponent")
+
+function BenchmarkComponent:ctor(position,velocity)
+    self.position_=position
+    self.velocity_=velocity
+end
+
+function BenchmarkComponent:Update()
+    self.position_=self.position_+self.velocity_*DELTA_TIME
+end
+
+--- 创建组件，返回执行函数，创建组件不计入测试。
+--- @param create_vector function 参数是序号，返回位置或速度。
+local function component_update(create_vector)
+    local components={}
+    for i=1,component_num do
+        components[i]=BenchmarkComponent.new(create_vector(0),create_vector(i))
+    end
+    return function(count)
+        local traceback=debug.traceback
+        for frame=1,count do
+            for i=1,component_num do
+                local component=components[i]
+                xpcall(component.Update,traceback,component)
+            end
+        end
+        return components[component_num].position_
+    end
+end
+
+local component_updates={
+    number=component_update(function(i) return i end),
+    glm=glm and component_update(function(i) return glm.vec3(i,i,i) end),
+    ffi=FFIMath.enable and component_update(function(i) return FFIMath.vec3(i,i,i) end),
+}
+
+local benchmarks={
+    {"vector math",vector_math,vector_math_count},
+    {"transform animation",transform_animation,transform_frame_count},
+    {"component update",component_updates,component_frame_count},
+}
+
+--- 执行所有测试，输出耗时和分配量。
+function RunScriptBenchmark()
+    print(string.format("script benchmark: %s",jit and jit.version or _VERSION))
+    print(string.format("%-20s %-8s %12s %14s","benchmark","impl","time(ms)","KB/1000 iter"))
+    for _,benchmark in ipairs(benchmarks) do
+        local name,impls,count=benchmark[1],benchmark[2],benchmark[3]
+        for _,impl in ipairs({"number","glm","ffi"}) do
+            local func=impls[impl]
+            if func then
+                local time,allocated=measure(func,count)
+                print(string.format("%-20s %-8s %12.2f %14.2f",name,impl,time,allocated))
+            else
+                print(string.format("%-20s %-8s %12s %14s",name,impl,"skip","skip"))
+            end
+        end
+    end
+end
+
+if Cpp==nil then
+    RunScriptBenchmark()
+end
\ No newline at end of file
@@ -12,11 +12,15 @@
 #include "renderer/camera.h"
 #include "renderer/mesh_renderer.h"
 #include "renderer/shader.h"
+#include "renderer/font.h"
+#include "lighting/cascaded_shadow_map.h"
+#include "ui/ui_camera.h"
 #include "control/input.h"
 #include "utils/screen.h"
 #include "render_device/render_task_consumer.h"
 #include "audio/audio.h"
 #include "utils/time.h"
+#include "utils/job_system.h"
 #include "render_device/render_task_producer.h"
 #include "physics/physics.h"
 #include "lua_binding/lua_binding.h"
@@ -29,6 +33,9 @@ void ApplicationBase::Init() {
     Debug::Init();
     DEBUG_LOG_INFO("game start");
 
+    //启动任务系统工作线程
+    JobSystem::Init();
+
     InitLuaBinding();
     LoadConfig();
 
@@ -64,6 +71,12 @@ void ApplicationBase::LoadConfig() {
     sol::state& sol_state=LuaBinding::sol_state();
     title_=sol_state["Config"]["title"];
     data_path_=sol_state["Config"]["data_path"];
+    //物理调试器默认不连接
+    Physics::set_pvd_enable(sol_state["Config"]["physics_pvd"].get_or(false));
+    sol::optional<std::string> physics_pvd_host=sol_state["Config"]["physics_pvd_host"];
+    if(physics_pvd_host){
+        Physics::set_pvd_host(physics_pvd_host.value());
+    }
 }
 
 void ApplicationBase::Run() {
@@ -82,10 +95,17 @@ void ApplicationBase::Update(){
             return false;
         }
         game_object->ForeachComponent([](Component* component){
-            component->Update();
+            if(component->NeedCallHook(COMPONENT_HOOK_UPDATE)){
+                component->Update();
+            }
         });
         return true;
     });
+    //交给Lua调度的组件，一次进入Lua全部调用。
+    Component::RunLuaScheduler(COMPONENT_HOOK_UPDATE);
+
+    //本帧新生成的字形，每页合并上传一次。
+    Font::Flush();
 
     Input::Update();
     Audio::Update();
@@ -95,6 +115,9 @@ void ApplicationBase::Update(){
 
 void ApplicationBase::Render(){
     EASY_FUNCTION(profiler::colors::Magenta); // 标记函数
+    MeshRenderer::ResetLODStatistics();
+    //先渲染方向光的级联阴影，相机渲染时采样。
+    CascadedShadowMap::Render();
     //遍历所有相机，每个相机的View Projection，都用来做一次渲染。
     Camera::Foreach([&](){
         GameObject::Foreach([](GameObject* game_object)->bool {
@@ -107,11 +130,18 @@ void ApplicationBase::Render(){
             }
             return true;
         });
+        //UI不再逐个绘制，由UI相机合批绘制。
+        UICamera* ui_camera=dynamic_cast<UICamera*>(Camera::current_camera());
+        if(ui_camera!= nullptr){
+            ui_camera->RenderUI();
+        }
     });
+    MeshRenderer::ReportLODStatistics();
 }
 
 void ApplicationBase::FixedUpdate(){
     EASY_FUNCTION(profiler::colors::Magenta) // 标记函数
+    //取回物理模拟结果，异步模拟时是上一个固定步长启动的模拟。
     Physics::FixedUpdate();
 
     GameObject::Foreach([](GameObject* game_object)->bool {
@@ -119,23 +149,38 @@ void ApplicationBase::FixedUpdate(){
             return false;
         }
         game_object->ForeachComponent([](Component* component){
-            component->FixedUpdate();
+            if(component->NeedCallHook(COMPONENT_HOOK_FIXED_UPDATE)){
+                component->FixedUpdate();
+            }
         });
         return true;
     });
+    Component::RunLuaScheduler(COMPONENT_HOOK_FIXED_UPDATE);
+
+    //组件修改完物理状态后启动下一次异步模拟，和渲染并行。
+    Physics::Simulate();
 }
 
 void ApplicationBase::OneFrame() {
     Update();
-    // 如果一帧卡了很久，就多执行几次FixedUpdate
-    float cost_time=Time::delta_time();
-    while(cost_time>=Time::fixed_update_time()){
+    // 如果一帧卡了很久，就多执行几次FixedUpdate，不足一个固定步长的时间留到下一帧。
+    fixed_update_accumulated_time_+=Time::delta_time();
+    unsigned int fixed_update_num=0;
+    while(fixed_update_accumulated_time_>=Time::fixed_update_time()){
+        if(fixed_update_num>=Time::max_fixed_update_num()){
+            fixed_update_accumulated_time_=0;
+            break;
+        }
         FixedUpdate();
-        cost_time-=Time::fixed_update_time();
+        fixed_update_accumulated_time_-=Time::fixed_update_time();
+        fixed_update_num++;
     }
 
     Render();
 
+    //统计任务系统每个线程本帧的利用率
+    JobSystem::UpdateStatistics();
+
     //发出特殊任务：渲染结束
     RenderTaskProducer::ProduceRenderTaskEndFrame();
 }
@@ -145,11 +190,17 @@ void ApplicationBase::UpdateScreenSize() {
 }
 
 void ApplicationBase::Exit() {
+    //异步物理模拟可能还在进行，先取回结果，避免JobSystem退出后PhysX任务仍在运行。
+    Physics::set_async(false);
+
     RenderTaskProducer::Exit();
     RenderTaskConsumer::Exit();
 
     //调用lua exit()
     LuaBinding::CallLuaFunction("exit");
+    Component::ReleaseLuaScheduler();
+
+    JobSystem::Exit();
 
     Debug::ShutDown();
 }
\ No newline at end of file
@@ -49,6 +49,8 @@ protected:
     std::string title_;//标题栏显示
 
     std::string data_path_;//资源目录
+
+    float fixed_update_accumulated_time_=0;//还没有执行FixedUpdate的时间
 };
 
 
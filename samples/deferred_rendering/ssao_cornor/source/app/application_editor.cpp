@@ -289,6 +289,15 @@ void ApplicationEditor::Run() {
         {
             ImGui::Begin("Status");
             ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+            //物理统计
+            const PhysicsStatistics& physics_statistics=Physics::statistics();
+            if(ImGui::CollapsingHeader("Physics",ImGuiTreeNodeFlags_DefaultOpen)){
+                ImGui::Text("bodies active %u sleeping %u static %u", physics_statistics.active_body_num_, physics_statistics.sleeping_body_num_, physics_statistics.static_body_num_);
+                ImGui::Text("pairs contact %u broadphase %u", physics_statistics.contact_pair_num_, physics_statistics.broad_phase_pair_num_);
+                ImGui::Text("touches new %u lost %u", physics_statistics.new_touch_num_, physics_statistics.lost_touch_num_);
+                ImGui::Text("simulate %.3f ms fetch %.3f ms", physics_statistics.simulate_time_, physics_statistics.fetch_time_);
+                ImGui::Text("pvd %s", Physics::pvd_connected() ? "connected" : (Physics::pvd_enable() ? "not connected" : "off"));
+            }
             ImGui::End();
         }
 
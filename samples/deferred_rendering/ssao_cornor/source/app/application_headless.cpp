@@ -0,0 +1,106 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "application_headless.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "easy/profiler.h"
+#include "utils/debug.h"
+#include "component/component.h"
+#include "lua_binding/lua_binding.h"
+#include "render_device/render_task_consumer.h"
+#include "render_device/render_task_consumer_null.h"
+
+#define HEADLESS_SCREEN_WIDTH 960
+#define HEADLESS_SCREEN_HEIGHT 640
+
+bool ApplicationHeadless::ParseCommandLine(int argc, char* argv[], int& frame_num, bool& script_benchmark) {
+    bool headless=false;
+    for (int i = 1; i < argc; ++i) {
+        if(strcmp(argv[i],"--headless")==0){
+            headless=true;
+        }else if(strncmp(argv[i],"--frames=",9)==0){
+            frame_num=std::max(atoi(argv[i]+9),1);
+        }else if(strcmp(argv[i],"--script-benchmark")==0){
+            script_benchmark=true;
+        }
+    }
+    return headless;
+}
+
+void ApplicationHeadless::InitGraphicsLibraryFramework() {
+    //初始化渲染任务消费者(单独渲染线程)，和窗口程序同样的尺寸。
+    render_task_consumer_null_=new RenderTaskConsumerNull(HEADLESS_SCREEN_WIDTH,HEADLESS_SCREEN_HEIGHT);
+    RenderTaskConsumer::Init(render_task_consumer_null_);
+}
+
+void ApplicationHeadless::Run() {
+    ApplicationBase::Run();
+
+    if(script_benchmark_){
+        //同样的脚本分别在Lua和LuaJIT构建中执行，对比输出。
+        LuaBinding::RunLuaFile("../example/script_benchmark.lua");
+        LuaBinding::CallLuaFunction("RunScriptBenchmark");
+        Exit();
+        return;
+    }
+
+    frame_time_vec_.reserve(frame_num_);
+    unsigned long long lua_call_num_begin=Component::lua_call_num();
+    unsigned long long hook_skip_num_begin=Component::hook_skip_num();
+    for (int i = 0; i < frame_num_; ++i) {
+        EASY_BLOCK("Frame"){
+            auto begin=std::chrono::steady_clock::now();
+            OneFrame();
+            auto end=std::chrono::steady_clock::now();
+            frame_time_vec_.push_back(std::chrono::duration<float,std::milli>(end-begin).count());
+
+            //帧结束任务返回后，渲染线程已经记录好上一帧的统计。
+            command_num_+=render_task_consumer_null_->frame_command_num();
+            draw_call_num_+=render_task_consumer_null_->frame_draw_call_num();
+        }EASY_END_BLOCK;
+    }
+    //只统计运行的帧，不包括main.lua中创建场景时的调用。
+    lua_call_num_=Component::lua_call_num()-lua_call_num_begin;
+    hook_skip_num_=Component::hook_skip_num()-hook_skip_num_begin;
+
+    Report();
+    Exit();
+}
+
+void ApplicationHeadless::Report() {
+    if(frame_time_vec_.empty()){
+        return;
+    }
+    std::vector<float> sorted_frame_time_vec=frame_time_vec_;
+    std::sort(sorted_frame_time_vec.begin(),sorted_frame_time_vec.end());
+    //最近秩法取百分位
+    auto percentile=[&sorted_frame_time_vec](float p)->float {
+        size_t rank=(size_t)std::ceil(p/100.0f*sorted_frame_time_vec.size());
+        return sorted_frame_time_vec[std::max(rank,(size_t)1)-1];
+    };
+    float total_time=0;
+    for (auto frame_time : frame_time_vec_) {
+        total_time+=frame_time;
+    }
+    size_t frame_num=frame_time_vec_.size();
+
+    DEBUG_LOG_INFO("headless frames:{} avg:{:.3f}ms p50:{:.3f}ms p90:{:.3f}ms p95:{:.3f}ms p99:{:.3f}ms max:{:.3f}ms",
+                   frame_num,total_time/frame_num,percentile(50),percentile(90),percentile(95),percentile(99),sorted_frame_time_vec.back());
+    DEBUG_LOG_INFO("headless render commands/frame:{:.1f} draw calls/frame:{:.1f}",
+                   (double)command_num_/frame_num,(double)draw_call_num_/frame_num);
+    DEBUG_LOG_INFO("headless lua component calls/frame:{:.1f} skipped hooks/frame:{:.1f}",
+                   (double)lua_call_num_/frame_num,(double)hook_skip_num_/frame_num);
+
+    //每种渲染命令的数量 index:RenderCommand
+    const std::vector<unsigned long long>& command_count=render_task_consumer_null_->command_count();
+    for (size_t i = 0; i < command_count.size(); ++i) {
+        if(command_count[i]>0){
+            DEBUG_LOG_INFO("headless render command:{} count:{}",i,command_count[i]);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#ifndef UNTITLED_APPLICATION_HEADLESS_H
+#define UNTITLED_APPLICATION_HEADLESS_H
+
+#include <string>
+#include <vector>
+#include "application_base.h"
+
+class RenderTaskConsumerNull;
+/// 无窗口运行固定帧数，统计主线程每帧耗时(场景更新、渲染任务生成、Lua)，用于没有显示器、GPU的测试机。
+class ApplicationHeadless : public ApplicationBase{
+public:
+    /// \param frame_num 运行帧数
+    /// \param script_benchmark 只执行脚本性能测试(example/script_benchmark.lua)，不运行帧。
+    ApplicationHeadless(int frame_num,bool script_benchmark=false):ApplicationBase(),frame_num_(frame_num),script_benchmark_(script_benchmark){}
+    ~ApplicationHeadless(){}
+
+    void Run();
+
+    /// 解析命令行，有 --headless 时返回true。
+    /// \param argc
+    /// \param argv
+    /// \param frame_num --frames=N 指定的帧数，没有指定时不修改。
+    /// \param script_benchmark 有 --script-benchmark 时为true
+    static bool ParseCommandLine(int argc,char* argv[],int& frame_num,bool& script_benchmark);
+
+public:
+    /// 使用不调用图形API的渲染任务消费者
+    virtual void InitGraphicsLibraryFramework() override;
+
+private:
+    /// 输出帧耗时百分位和渲染命令统计
+    void Report();
+
+private:
+    int frame_num_;//运行帧数
+    bool script_benchmark_;//只执行脚本性能测试
+    RenderTaskConsumerNull* render_task_consumer_null_= nullptr;
+    std::vector<float> frame_time_vec_;//每帧耗时，毫秒
+    unsigned long long command_num_=0;//所有帧渲染命令数量
+    unsigned long long draw_call_num_=0;//所有帧绘制次数
+    unsigned long long lua_call_num_=0;//所有帧调用Lua组件回调的次数
+    unsigned long long hook_skip_num_=0;//所有帧跳过的组件回调次数
+};
+
+
+#endif //UNTITLED_APPLICATION_HEADLESS_H
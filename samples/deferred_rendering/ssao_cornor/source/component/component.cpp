@@ -3,8 +3,20 @@
 //
 
 #include "component.h"
+#include <typeinfo>
 #include "game_object.h"
 
+unsigned long long Component::lua_call_num_=0;
+unsigned long long Component::hook_skip_num_=0;
+sol::table Component::lua_scheduler_;
+sol::protected_function Component::lua_scheduler_functions_[COMPONENT_HOOK_NUM];
+
+/// 回调函数名，下标是ComponentHook。
+static const char* kComponentHookNames[COMPONENT_HOOK_NUM]={
+        "OnEnable","Awake","Update","FixedUpdate","OnPreRender","OnPostRender","OnDisable",
+        "OnTriggerEnter","OnTriggerExit","OnTriggerStay"
+};
+
 //注册反射
 RTTR_REGISTRATION
 {
@@ -20,70 +32,147 @@ Component::~Component() {
 
 }
 
-/// 同步调用Lua组件函数
-/// \param function_name
-void Component::SyncLuaComponent(const char* function_name,GameObject* game_object){
-    if (!lua_component_instance_.valid()){
+void Component::set_game_object(GameObject* game_object) {
+    game_object_=game_object;
+    UpdateHookMask();
+}
+
+void Component::set_lua_component_instance(sol::table lua_component_instance) {
+    lua_component_instance_=lua_component_instance;
+    //Lua组件基类的回调是空函数，子类重写了才需要调用。
+    sol::state_view lua_state(lua_component_instance.lua_state());
+    sol::table base_component=lua_state["Component"];
+    lua_hook_mask_=0;
+    for (int i = 0; i < COMPONENT_HOOK_NUM; ++i) {
+        lua_hook_functions_[i]=sol::lua_nil;
+        sol::object function=lua_component_instance[kComponentHookNames[i]];
+        if(function.get_type()!=sol::type::function){
+            continue;
+        }
+        if(base_component.valid() && function==base_component.get<sol::object>(kComponentHookNames[i])){
+            continue;
+        }
+        lua_hook_functions_[i]=function.as<sol::protected_function>();
+        lua_hook_mask_|=1u<<i;
+    }
+    UpdateHookMask();
+}
+
+void Component::UpdateHookMask() {
+    //构造完成后才能取到实际类型
+    if(typeid(*this)==typeid(Component)){
+        hook_mask_=lua_hook_mask_;
+        if(delegate_update_to_lua_){
+            hook_mask_&=~((1u<<COMPONENT_HOOK_UPDATE)|(1u<<COMPONENT_HOOK_FIXED_UPDATE));
+        }
+    }else{
+        hook_mask_=0xffffffff;
+    }
+}
+
+bool Component::DelegateUpdateToLua() {
+    unsigned int update_hook_mask=(1u<<COMPONENT_HOOK_UPDATE)|(1u<<COMPONENT_HOOK_FIXED_UPDATE);
+    if(typeid(*this)!=typeid(Component) || (lua_hook_mask_&update_hook_mask)==0){
+        return false;
+    }
+    delegate_update_to_lua_=true;
+    UpdateHookMask();
+    return true;
+}
+
+void Component::set_lua_scheduler(sol::table lua_scheduler) {
+    lua_scheduler_=lua_scheduler;
+    lua_scheduler_functions_[COMPONENT_HOOK_UPDATE]=lua_scheduler["Update"];
+    lua_scheduler_functions_[COMPONENT_HOOK_FIXED_UPDATE]=lua_scheduler["FixedUpdate"];
+}
+
+void Component::ReleaseLuaScheduler() {
+    for (auto& function : lua_scheduler_functions_) {
+        function=sol::lua_nil;
+    }
+    lua_scheduler_=sol::lua_nil;
+}
+
+void Component::RunLuaScheduler(ComponentHook hook) {
+    sol::protected_function& function=lua_scheduler_functions_[hook];
+    if(function.valid()==false){
         return;
     }
-    sol::protected_function function_awake=lua_component_instance_[function_name];
-    if(!function_awake.valid()){
+    //每个组件的错误在Lua中单独捕获，这里只会收到调度器本身的错误。
+    lua_call_num_++;
+    auto result=function(lua_scheduler_);
+    if(result.valid()== false){
+        sol::error err = result;
+        DEBUG_LOG_ERROR("\n---- RUN LUA_FUNCTION ERROR ----\nComponentScheduler call {} error\n{}\n------------------------",kComponentHookNames[hook],err.what());
+    }
+}
+
+bool Component::trigger_event_interest() {
+    unsigned int trigger_hook_mask=(1u<<COMPONENT_HOOK_ON_TRIGGER_ENTER)|(1u<<COMPONENT_HOOK_ON_TRIGGER_EXIT)|(1u<<COMPONENT_HOOK_ON_TRIGGER_STAY);
+    return (lua_hook_mask_&trigger_hook_mask)!=0;
+}
+
+/// 同步调用Lua组件函数
+/// \param hook
+void Component::SyncLuaComponent(ComponentHook hook,GameObject* game_object){
+    if((lua_hook_mask_ & (1u<<hook))==0){
         return;
     }
-    auto result=function_awake(lua_component_instance_,game_object);
+    lua_call_num_++;
+    auto result=lua_hook_functions_[hook](lua_component_instance_,game_object);
     if(result.valid()== false){
         sol::error err = result;
         type t=type::get(this);
         std::string component_type_name=t.get_name().to_string();
-        DEBUG_LOG_ERROR("\n---- RUN LUA_FUNCTION ERROR ----\nComponent call Awake error,type:{}\n{}\n------------------------",component_type_name,err.what());
+        DEBUG_LOG_ERROR("\n---- RUN LUA_FUNCTION ERROR ----\nComponent call {} error,type:{}\n{}\n------------------------",kComponentHookNames[hook],component_type_name,err.what());
     }
 }
 
 void Component::OnEnable() {
 //    DEBUG_LOG_INFO("Cpp.Component OnEnable");
-    SyncLuaComponent("OnEnable");
+    SyncLuaComponent(COMPONENT_HOOK_ON_ENABLE);
 }
 
 void Component::Awake() {
 //    DEBUG_LOG_INFO("Cpp.Component Awake");
-    SyncLuaComponent("Awake");
+    SyncLuaComponent(COMPONENT_HOOK_AWAKE);
 }
 
 void Component::Update() {
 //    DEBUG_LOG_INFO("Cpp.Component Update");
-    SyncLuaComponent("Update");
+    SyncLuaComponent(COMPONENT_HOOK_UPDATE);
 }
 
 
 void Component::FixedUpdate() {
 //    DEBUG_LOG_INFO("Cpp.Component FixedUpdate");
-    SyncLuaComponent("FixedUpdate");
+    SyncLuaComponent(COMPONENT_HOOK_FIXED_UPDATE);
 }
 
 
 void Component::OnPreRender() {
 //    DEBUG_LOG_INFO("Cpp.Component OnPreRender");
-    SyncLuaComponent("OnPreRender");
+    SyncLuaComponent(COMPONENT_HOOK_ON_PRE_RENDER);
 }
 
 void Component::OnPostRender() {
 //    DEBUG_LOG_INFO("Cpp.Component OnPostRender");
-    SyncLuaComponent("OnPostRender");
+    SyncLuaComponent(COMPONENT_HOOK_ON_POST_RENDER);
 }
 
 void Component::OnDisable() {
 //    DEBUG_LOG_INFO("Cpp.Component OnDisable");
-    SyncLuaComponent("OnDisable");
+    SyncLuaComponent(COMPONENT_HOOK_ON_DISABLE);
 }
 
 void Component::OnTriggerEnter(GameObject* game_object) {
-    SyncLuaComponent("OnTriggerEnter",game_object);
+    SyncLuaComponent(COMPONENT_HOOK_ON_TRIGGER_ENTER,game_object);
 }
 
 void Component::OnTriggerExit(GameObject* game_object) {
-    SyncLuaComponent("OnTriggerExit",game_object);
+    SyncLuaComponent(COMPONENT_HOOK_ON_TRIGGER_EXIT,game_object);
 }
 
 void Component::OnTriggerStay(GameObject* game_object) {
-    SyncLuaComponent("OnTriggerStay",game_object);
+    SyncLuaComponent(COMPONENT_HOOK_ON_TRIGGER_STAY,game_object);
 }
@@ -13,6 +13,21 @@
 #include "utils/debug.h"
 using namespace rttr;
 
+/// 组件回调，每个回调对应hook_mask的一位。
+enum ComponentHook{
+    COMPONENT_HOOK_ON_ENABLE=0,
+    COMPONENT_HOOK_AWAKE,
+    COMPONENT_HOOK_UPDATE,
+    COMPONENT_HOOK_FIXED_UPDATE,
+    COMPONENT_HOOK_ON_PRE_RENDER,
+    COMPONENT_HOOK_ON_POST_RENDER,
+    COMPONENT_HOOK_ON_DISABLE,
+    COMPONENT_HOOK_ON_TRIGGER_ENTER,
+    COMPONENT_HOOK_ON_TRIGGER_EXIT,
+    COMPONENT_HOOK_ON_TRIGGER_STAY,
+    COMPONENT_HOOK_NUM
+};
+
 class GameObject;
 class Component {
 public:
@@ -20,18 +35,55 @@ public:
     virtual ~Component();
 
     GameObject* game_object(){return game_object_;}
-    void set_game_object(GameObject* game_object){game_object_=game_object;}
+    void set_game_object(GameObject* game_object);
 
-    /// 设置对应的Lua组件
+    /// 设置对应的Lua组件，查找Lua组件实现的回调函数并缓存。
+    /// 之后再给Lua组件实例添加的回调函数不会被调用。
     /// \param lua_component_instance
-    void set_lua_component_instance(sol::table lua_component_instance){
-        lua_component_instance_=lua_component_instance;
+    void set_lua_component_instance(sol::table lua_component_instance);
+
+    /// 是否处理触发事件，不处理的组件物理不派发触发事件。
+    /// Lua组件重写了OnTriggerEnter/OnTriggerExit/OnTriggerStay才处理，C++组件重写触发函数时也要重写这个函数。
+    virtual bool trigger_event_interest();
+
+    /// 引擎遍历组件调用回调之前检查，不需要调用时跳过，省去虚函数和Lua调用。
+    /// C++子类组件可能重写了回调，都需要调用；Lua组件只有实现了回调才需要调用。
+    bool NeedCallHook(ComponentHook hook){
+        if(hook_mask_ & (1u<<hook)){
+            return true;
+        }
+        hook_skip_num_++;
+        return false;
     }
 
+    /// 把Update/FixedUpdate交给Lua组件调度器调用，C++不再逐个调用。
+    /// \return 只有Lua组件(C++类型就是Component)并且实现了Update或FixedUpdate才能交给Lua调度
+    bool DelegateUpdateToLua();
+
+    /// 设置Lua组件调度器，缓存它的Update/FixedUpdate函数。
+    /// \param lua_scheduler Lua中的ComponentScheduler
+    static void set_lua_scheduler(sol::table lua_scheduler);
+
+    /// 释放Lua组件调度器的引用，在Lua虚拟机关闭之前调用。
+    static void ReleaseLuaScheduler();
+
+    /// 进入Lua组件调度器一次，调用所有交给Lua调度的组件。
+    /// \param hook COMPONENT_HOOK_UPDATE 或 COMPONENT_HOOK_FIXED_UPDATE
+    static void RunLuaScheduler(ComponentHook hook);
+
+    /// 累计调用Lua回调函数的次数
+    static unsigned long long lua_call_num(){return lua_call_num_;}
+
+    /// 累计跳过的回调次数
+    static unsigned long long hook_skip_num(){return hook_skip_num_;}
+
 private:
     /// 同步调用Lua组件函数
-    /// \param function_name
-    void SyncLuaComponent(const char* function_name,GameObject* game_object= nullptr);
+    /// \param hook
+    void SyncLuaComponent(ComponentHook hook,GameObject* game_object= nullptr);
+
+    /// 更新需要调用的回调，C++子类组件全部需要调用。
+    void UpdateHookMask();
 
 public:
     virtual void OnEnable();
@@ -54,6 +106,16 @@ public:
 private:
     GameObject* game_object_;
     sol::table lua_component_instance_;
+    sol::protected_function lua_hook_functions_[COMPONENT_HOOK_NUM];//Lua组件实现的回调函数
+    unsigned int lua_hook_mask_=0;//Lua组件实现了哪些回调
+    unsigned int hook_mask_=0xffffffff;//需要调用的回调，附加到GameObject之前全部调用。
+    bool delegate_update_to_lua_=false;//Update/FixedUpdate由Lua组件调度器调用
+
+    static sol::table lua_scheduler_;
+    static sol::protected_function lua_scheduler_functions_[COMPONENT_HOOK_NUM];//只缓存Update/FixedUpdate
+
+    static unsigned long long lua_call_num_;
+    static unsigned long long hook_skip_num_;
 
 RTTR_ENABLE();
 };
@@ -11,13 +11,17 @@ using namespace rttr;
 
 Tree GameObject::game_object_tree_;//用树存储所有的GameObject。
 std::list<GameObject*> GameObject::game_object_list_;
+unsigned int GameObject::next_id_=1;
+std::unordered_map<unsigned int,GameObject*> GameObject::id_game_object_map_;
 
-GameObject::GameObject(const char *name): Tree::Node(), layer_(0x01) {
+GameObject::GameObject(const char *name): Tree::Node(), id_(next_id_++), layer_(0x01) {
     set_name(name);
+    id_game_object_map_[id_]=this;
     game_object_tree_.root_node()->AddChild(this);
 }
 
 GameObject::~GameObject() {
+    id_game_object_map_.erase(id_);
     DEBUG_LOG_INFO("GameObject::~GameObject");
 }
 
@@ -43,6 +47,14 @@ GameObject* GameObject::Find(const char *name) {
     return game_object_find;
 }
 
+GameObject* GameObject::FindById(unsigned int id) {
+    auto iter=id_game_object_map_.find(id);
+    if(iter==id_game_object_map_.end()){
+        return nullptr;
+    }
+    return iter->second;
+}
+
 /// 附加组件实例
 /// \param component_instance_table
 void GameObject::AttachComponent(Component* component){
@@ -71,6 +83,17 @@ void GameObject::ForeachComponent(std::function<void(Component*)> func) {
     }
 }
 
+bool GameObject::trigger_event_interest() {
+    for (auto& v : components_map_){
+        for (auto component : v.second){
+            if(component->trigger_event_interest()){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 /// 遍历GameObject
 /// \param func
 void GameObject::Foreach(std::function<bool(GameObject* game_object)> func) {
@@ -23,6 +23,9 @@ public:
     const char * name(){return name_;}
     void set_name(const char *name){ name_=name;}
 
+    /// 唯一编号，从1开始，不会复用。延迟处理的事件用编号引用物体，物体销毁后就查找不到。
+    unsigned int id(){return id_;}
+
     unsigned char layer(){return layer_;}
     void set_layer(unsigned char layer){layer_=layer;}
 
@@ -59,6 +62,11 @@ public:
     /// \param name
     /// \return
     static GameObject* Find(const char *name);
+
+    /// 按编号查找GameObject
+    /// \param id
+    /// \return 已经销毁时返回nullptr
+    static GameObject* FindById(unsigned int id);
 public:
     /// 添加组件，仅用于C++中添加组件。
     /// \tparam T 组件类型
@@ -113,6 +121,9 @@ public:
     /// \param func
     void ForeachComponent(std::function<void(Component*)> func);
 
+    /// 是否有组件处理触发事件，没有就不用记录这个物体的触发事件。
+    bool trigger_event_interest();
+
     /// 遍历GameObject
     /// \param func
     static void Foreach(std::function<bool(GameObject* game_object)> func);
@@ -123,6 +134,8 @@ public:
 private:
     const char * name_;
 
+    unsigned int id_;
+
     unsigned char layer_;//将物体分不同的层，用于相机分层、物理碰撞分层等。
 
     bool active_self_=true;//自身是否激活
@@ -132,6 +145,10 @@ private:
     static Tree game_object_tree_;//用树存储所有的GameObject。
 
     static std::list<GameObject*> game_object_list_;//存储所有的GameObject。
+
+    static unsigned int next_id_;
+
+    static std::unordered_map<unsigned int,GameObject*> id_game_object_map_;//编号查找GameObject
 };
 
 
@@ -0,0 +1,221 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "cascaded_shadow_map.h"
+#include <algorithm>
+#include <cmath>
+#include <glad/gl.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include "easy/profiler.h"
+#include "directional_light.h"
+#include "component/game_object.h"
+#include "renderer/camera.h"
+#include "renderer/material.h"
+#include "renderer/mesh_renderer.h"
+#include "renderer/shader.h"
+#include "renderer/texture_2d.h"
+#include "render_device/gpu_resource_mapper.h"
+#include "render_device/render_task_producer.h"
+#include "render_device/uniform_buffer_object_manager.h"
+#include "utils/debug.h"
+#include "utils/screen.h"
+
+unsigned short CascadedShadowMap::resolution_=2048;
+unsigned char CascadedShadowMap::cascade_num_=CASCADED_SHADOW_MAX_NUM;
+DirectionalLight* CascadedShadowMap::light_= nullptr;
+Camera* CascadedShadowMap::camera_= nullptr;
+float CascadedShadowMap::shadow_distance_=100.f;
+float CascadedShadowMap::split_lambda_=0.5f;
+float CascadedShadowMap::depth_bias_=1.5f;
+unsigned char CascadedShadowMap::culling_mask_=0xff;
+Texture2D* CascadedShadowMap::depth_texture_2d_= nullptr;
+unsigned int CascadedShadowMap::frame_buffer_object_handles_[CASCADED_SHADOW_MAX_NUM]={0};
+CascadedShadowMap::Cascade CascadedShadowMap::cascades_[CASCADED_SHADOW_MAX_NUM];
+std::vector<CascadedShadowMap::Caster> CascadedShadowMap::caster_vec_;
+unsigned int CascadedShadowMap::caster_draw_num_[CASCADED_SHADOW_MAX_NUM]={0};
+
+void CascadedShadowMap::Init(unsigned short resolution, unsigned char cascade_num) {
+    resolution_=std::max(resolution,(unsigned short)1);
+    cascade_num_=std::min(std::max(cascade_num,(unsigned char)1),(unsigned char)CASCADED_SHADOW_MAX_NUM);
+
+    //删除旧的深度纹理和FBO
+    if(depth_texture_2d_!= nullptr){
+        for (auto& frame_buffer_object_handle : frame_buffer_object_handles_) {
+            if(frame_buffer_object_handle!=0){
+                RenderTaskProducer::ProduceRenderTaskDeleteFBO(frame_buffer_object_handle);
+                frame_buffer_object_handle=0;
+            }
+        }
+        delete depth_texture_2d_;
+    }
+
+    depth_texture_2d_=Texture2D::CreateDepthArray(resolution_,resolution_,cascade_num_);
+    for (int i = 0; i < cascade_num_; ++i) {
+        frame_buffer_object_handles_[i]=GPUResourceMapper::GenerateFBOHandle();
+        RenderTaskProducer::ProduceRenderTaskCreateDepthFBO(frame_buffer_object_handles_[i],depth_texture_2d_->texture_handle(),i);
+    }
+    //材质中声明 u_shadow_map_texture 即可采样阴影。
+    Material::SetGlobalTexture("u_shadow_map_texture",depth_texture_2d_);
+}
+
+void CascadedShadowMap::UpdateCascades() {
+    glm::mat4& view=camera_->view_mat4();
+    glm::mat4& projection=camera_->projection_mat4();
+    glm::mat4 inverse_projection=glm::inverse(projection);
+    glm::mat4 inverse_view=glm::inverse(view);
+    auto unproject=[&inverse_projection](float x,float y,float z){
+        glm::vec4 position=inverse_projection*glm::vec4(x,y,z,1.0f);
+        return glm::vec3(position)/position.w;
+    };
+    float near_clip=std::max(-unproject(0,0,-1).z,0.01f);
+    float far_clip=std::max(-unproject(0,0,1).z,near_clip*2.0f);
+    float shadow_far=std::max(std::min(far_clip,shadow_distance_),near_clip*2.0f);
+
+    //视锥体4条棱在近、远裁剪面上的端点，视空间。
+    glm::vec3 near_corner[4];
+    glm::vec3 far_corner[4];
+    for (int i = 0; i < 4; ++i) {
+        float ndc_x=(float)(i&1)*2.0f-1.0f;
+        float ndc_y=(float)(i>>1)*2.0f-1.0f;
+        near_corner[i]=unproject(ndc_x,ndc_y,-1);
+        far_corner[i]=unproject(ndc_x,ndc_y,1);
+    }
+
+    //光源视图矩阵只有旋转，光源方向接近竖直时换一个up。
+    glm::vec3 light_direction=glm::normalize(light_->direction());
+    glm::vec3 up=std::abs(light_direction.y)>0.99f?glm::vec3(1,0,0):glm::vec3(0,1,0);
+    glm::mat4 light_view=glm::lookAt(glm::vec3(0),light_direction,up);
+
+    float split_near=near_clip;
+    for (int i = 0; i < cascade_num_; ++i) {
+        //对数划分和均匀划分按split_lambda混合
+        float p=(float)(i+1)/cascade_num_;
+        float log_split=near_clip*powf(shadow_far/near_clip,p);
+        float uniform_split=near_clip+(shadow_far-near_clip)*p;
+        float split_far=glm::mix(uniform_split,log_split,split_lambda_);
+
+        //这一级视锥体的8个顶点，变换到世界空间。
+        glm::vec3 corner[8];
+        glm::vec3 center(0);
+        for (int j = 0; j < 4; ++j) {
+            glm::vec3 direction=far_corner[j]-near_corner[j];
+            float t_near=(-split_near-near_corner[j].z)/direction.z;
+            float t_far=(-split_far-near_corner[j].z)/direction.z;
+            corner[j]=glm::vec3(inverse_view*glm::vec4(near_corner[j]+direction*t_near,1.0f));
+            corner[j+4]=glm::vec3(inverse_view*glm::vec4(near_corner[j]+direction*t_far,1.0f));
+            center+=corner[j]+corner[j+4];
+        }
+        center/=8.0f;
+        //包围球半径不随相机旋转变化，取整避免浮点误差引起抖动。
+        float radius=0;
+        for (auto& point : corner) {
+            radius=std::max(radius,glm::length(point-center));
+        }
+        radius=std::ceil(radius*16.0f)/16.0f;
+
+        //中心按阴影纹理像素对齐
+        glm::vec3 light_center=glm::vec3(light_view*glm::vec4(center,1.0f));
+        float texel_size=radius*2.0f/resolution_;
+        light_center.x=std::floor(light_center.x/texel_size)*texel_size;
+        light_center.y=std::floor(light_center.y/texel_size)*texel_size;
+
+        Cascade& cascade=cascades_[i];
+        cascade.light_view_=light_view;
+        cascade.center_=light_center;
+        cascade.radius_=radius;
+        cascade.split_far_=split_far;
+        //近裁剪面之前的物体由DEPTH_CLAMP压到近裁剪面，不会被裁掉。
+        glm::mat4 light_projection=glm::ortho(light_center.x-radius,light_center.x+radius,light_center.y-radius,light_center.y+radius,
+                                              -light_center.z-radius,-light_center.z+radius);
+        cascade.light_view_projection_=light_projection*light_view;
+
+        split_near=split_far;
+    }
+}
+
+void CascadedShadowMap::CollectCasters() {
+    caster_vec_.clear();
+    GameObject::Foreach([](GameObject* game_object)->bool {
+        if(!game_object->active_self()){//当自身没有激活，返回false，打断遍历子节点。
+            return false;
+        }
+        if((game_object->layer()&culling_mask_)==0){
+            return true;
+        }
+        MeshRenderer* mesh_renderer=game_object->GetComponent<MeshRenderer>();
+        if(mesh_renderer== nullptr || mesh_renderer->cast_shadow()==false){
+            return true;
+        }
+        Caster caster;
+        caster.mesh_renderer_=mesh_renderer;
+        if(mesh_renderer->GetWorldBounds(caster.model_,caster.center_,caster.radius_)){
+            caster_vec_.push_back(caster);
+        }
+        return true;
+    });
+}
+
+bool CascadedShadowMap::Intersect(const Cascade& cascade, const Caster& caster) {
+    glm::vec3 center=glm::vec3(cascade.light_view_*glm::vec4(caster.center_,1.0f));
+    float range=cascade.radius_+caster.radius_;
+    if(std::abs(center.x-cascade.center_.x)>range || std::abs(center.y-cascade.center_.y)>range){
+        return false;
+    }
+    //比投影范围更远的物体不会遮挡范围内的物体，更近的物体都要绘制。
+    return -center.z-caster.radius_<=-cascade.center_.z+cascade.radius_;
+}
+
+void CascadedShadowMap::Render() {
+    if(light_== nullptr || camera_== nullptr){
+        return;
+    }
+    EASY_FUNCTION();
+    if(depth_texture_2d_== nullptr){
+        Init(resolution_,cascade_num_);
+    }
+    UpdateCascades();
+    CollectCasters();
+
+    Shader* shader=Shader::Find("shader/shadow_caster");
+    shader->Active();
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_DEPTH_TEST,true);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_DEPTH_CLAMP,true);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_BLEND,false);
+    //双面绘制，单面的平面也能投射阴影。
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_CULL_FACE,false);
+    RenderTaskProducer::ProduceRenderTaskSetViewportSize(resolution_,resolution_);
+
+    for (int i = 0; i < cascade_num_; ++i) {
+        Cascade& cascade=cascades_[i];
+        caster_draw_num_[i]=0;
+        RenderTaskProducer::ProduceRenderTaskBindFBO(frame_buffer_object_handles_[i]);
+        RenderTaskProducer::ProduceRenderTaskSetClearFlagAndClearColorBuffer(GL_DEPTH_BUFFER_BIT,0,0,0,0);
+        for (auto& caster : caster_vec_) {
+            if(Intersect(cascade,caster)==false){
+                continue;
+            }
+            glm::mat4 light_model_view_projection=cascade.light_view_projection_*caster.model_;
+            RenderTaskProducer::ProduceRenderTaskSetUniformMatrix4fv(shader->shader_program_handle(),"u_light_model_view_projection",false,light_model_view_projection);
+            caster.mesh_renderer_->RenderShadowCaster();
+            caster_draw_num_[i]++;
+        }
+        RenderTaskProducer::ProduceRenderTaskUnBindFBO(frame_buffer_object_handles_[i]);
+    }
+    //恢复状态，和MeshRenderer绘制时的默认状态一致，不影响之后的绘制。
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_DEPTH_CLAMP,false);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_CULL_FACE,true);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_BLEND,true);
+    RenderTaskProducer::ProduceRenderTaskSetBlenderFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderTaskProducer::ProduceRenderTaskSetViewportSize(Screen::width(),Screen::height());
+
+    //上传级联参数，接收阴影的Shader按视空间深度选择级联。
+    glm::vec4 split_depth(0);
+    for (int i = 0; i < cascade_num_; ++i) {
+        UniformBufferObjectManager::UpdateUniformBlockSubDataMatrix4f("u_cascaded_shadow",fmt::format("light_view_projection[{}]",i),cascades_[i].light_view_projection_);
+        split_depth[i]=cascades_[i].split_far_;
+    }
+    UniformBufferObjectManager::UpdateUniformBlockSubData4f("u_cascaded_shadow","split_depth",split_depth);
+    UniformBufferObjectManager::UpdateUniformBlockSubData1i("u_cascaded_shadow","cascade_num",cascade_num_);
+    UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_cascaded_shadow","depth_bias",depth_bias_/resolution_);
+}
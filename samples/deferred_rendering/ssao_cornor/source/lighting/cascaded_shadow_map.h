@@ -0,0 +1,104 @@
+//
+// Created by captainchen on 2026/10/19.
+// 级联阴影：把主相机视锥体按深度切分成几段，每段用一个贴合的正交投影渲染方向光的深度，
+// 每一级只绘制与它相交的投射阴影物体，使用只输出深度的Shader，所有级联共用一张深度纹理数组。
+//
+
+#ifndef UNTITLED_CASCADED_SHADOW_MAP_H
+#define UNTITLED_CASCADED_SHADOW_MAP_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#define CASCADED_SHADOW_MAX_NUM 4 //最大级联数量
+
+class Camera;
+class DirectionalLight;
+class MeshRenderer;
+class Texture2D;
+class CascadedShadowMap {
+public:
+    /// 设置阴影深度纹理分辨率和级联数量，已经创建过深度纹理时重新创建。
+    /// \param resolution 每一级深度纹理的宽高
+    /// \param cascade_num 级联数量，不超过CASCADED_SHADOW_MAX_NUM
+    static void Init(unsigned short resolution,unsigned char cascade_num);
+
+    /// 投射阴影的方向光，为空时不渲染阴影。
+    static DirectionalLight* light(){return light_;}
+    static void set_light(DirectionalLight* light){light_=light;}
+
+    /// 级联贴合的相机，为空时不渲染阴影。
+    static Camera* camera(){return camera_;}
+    static void set_camera(Camera* camera){camera_=camera;}
+
+    /// 阴影距离，相机远裁剪面更远时只在这个距离内计算阴影。
+    static float shadow_distance(){return shadow_distance_;}
+    static void set_shadow_distance(float shadow_distance){shadow_distance_=shadow_distance;}
+
+    /// 级联划分方式，0:均匀划分 1:按对数划分，近处的级联更小、更清晰。
+    static float split_lambda(){return split_lambda_;}
+    static void set_split_lambda(float split_lambda){split_lambda_=split_lambda;}
+
+    /// 深度偏移，单位是阴影纹理像素，避免阴影失真(shadow acne)。
+    /// 正交投影的深度范围和宽度相同，所以偏移1个像素可以容忍45度以内的斜面，和级联大小无关。
+    static float depth_bias(){return depth_bias_;}
+    static void set_depth_bias(float depth_bias){depth_bias_=depth_bias;}
+
+    /// 投射阴影的Layer
+    static unsigned char culling_mask(){return culling_mask_;}
+    static void set_culling_mask(unsigned char culling_mask){culling_mask_=culling_mask;}
+
+    /// 渲染所有级联的深度，上传级联参数UBO，在所有相机渲染之前调用。
+    static void Render();
+
+    /// 上一次渲染每一级绘制的物体数量，级别超出cascade_num时返回0。
+    static unsigned int caster_draw_num(unsigned char cascade){return cascade<cascade_num_?caster_draw_num_[cascade]:0;}
+
+    /// 上一次渲染的投射阴影物体数量
+    static unsigned int caster_num(){return (unsigned int)caster_vec_.size();}
+
+private:
+    /// 投射阴影的物体
+    struct Caster{
+        MeshRenderer* mesh_renderer_;
+        glm::mat4 model_;
+        glm::vec3 center_;//世界空间包围球
+        float radius_;
+    };
+
+    /// 一级阴影
+    struct Cascade{
+        glm::mat4 light_view_;//只有旋转的光源视图矩阵
+        glm::mat4 light_view_projection_;
+        glm::vec3 center_;//光源视空间的包围球中心
+        float radius_;//包围球半径，正交投影范围
+        float split_far_;//覆盖的相机视空间深度
+    };
+
+    /// 计算每一级覆盖的相机视锥体，用包围球贴合正交投影，中心按阴影纹理像素对齐避免移动相机时阴影闪烁。
+    static void UpdateCascades();
+
+    /// 收集投射阴影的物体和世界空间包围球
+    static void CollectCasters();
+
+    /// 包围球是否在这一级的正交投影范围内，光源和投影范围之间的物体也要绘制。
+    static bool Intersect(const Cascade& cascade,const Caster& caster);
+
+private:
+    static unsigned short resolution_;
+    static unsigned char cascade_num_;
+    static DirectionalLight* light_;
+    static Camera* camera_;
+    static float shadow_distance_;
+    static float split_lambda_;
+    static float depth_bias_;
+    static unsigned char culling_mask_;
+    static Texture2D* depth_texture_2d_;//深度纹理数组，每一级一层。
+    static unsigned int frame_buffer_object_handles_[CASCADED_SHADOW_MAX_NUM];//每一层一个FBO
+    static Cascade cascades_[CASCADED_SHADOW_MAX_NUM];
+    static std::vector<Caster> caster_vec_;
+    static unsigned int caster_draw_num_[CASCADED_SHADOW_MAX_NUM];
+};
+
+
+#endif //UNTITLED_CASCADED_SHADOW_MAP_H
@@ -12,6 +12,7 @@
 #include "renderer/mesh_renderer.h"
 #include "renderer/material.h"
 #include "render_device/uniform_buffer_object_manager.h"
+#include "cascaded_shadow_map.h"
 
 using namespace rttr;
 RTTR_REGISTRATION//注册反射
@@ -30,6 +31,9 @@ DirectionalLight::DirectionalLight():Light()
 }
 
 DirectionalLight::~DirectionalLight() {
+    if(CascadedShadowMap::light()==this){
+        CascadedShadowMap::set_light(nullptr);
+    }
 
 }
 
@@ -49,6 +53,7 @@ void DirectionalLight::Update(){
     glm::vec3 rotation=game_object()->GetComponent<Transform>()->rotation();
     glm::mat4 eulerAngleYXZ = glm::eulerAngleYXZ(glm::radians(rotation.y), glm::radians(rotation.x), glm::radians(rotation.z));
     glm::vec3 light_rotation=glm::vec3(eulerAngleYXZ * glm::vec4(0,0,-1,0));
+    direction_=light_rotation;
     std::string uniform_block_member_name=fmt::format("data[{}].dir",light_id_);
     UniformBufferObjectManager::UpdateUniformBlockSubData3f("u_directional_light_array",uniform_block_member_name,light_rotation);
 }
@@ -19,6 +19,9 @@ public:
 
     virtual void set_intensity(float intensity) override;
 
+    /// 光照方向，Update时根据Transform旋转计算。
+    glm::vec3 direction(){return direction_;}
+
 public:
     void Update() override;
 
@@ -27,6 +30,8 @@ public:
     void OnDisable() override;
 
 private:
+    glm::vec3 direction_=glm::vec3(0,0,-1);//光照方向
+
     static unsigned int light_count_;//灯光数量
 
 RTTR_ENABLE(Light);
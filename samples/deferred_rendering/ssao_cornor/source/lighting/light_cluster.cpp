@@ -0,0 +1,201 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "light_cluster.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <glad/gl.h>
+#include "easy/profiler.h"
+#include "point_light.h"
+#include "renderer/camera.h"
+#include "renderer/material.h"
+#include "renderer/texture_2d.h"
+#include "render_device/uniform_buffer_object_manager.h"
+#include "utils/job_system.h"
+#include "utils/debug.h"
+
+Texture2D* LightCluster::light_grid_texture_2d_= nullptr;
+Texture2D* LightCluster::light_index_texture_2d_= nullptr;
+glm::mat4 LightCluster::projection_(0.f);
+float LightCluster::near_=0.f;
+float LightCluster::far_=0.f;
+std::vector<LightCluster::AABB> LightCluster::cluster_aabb_vec_;
+std::vector<LightCluster::ViewLight> LightCluster::view_light_vec_;
+std::vector<std::vector<unsigned short>> LightCluster::slice_light_index_vec_;
+std::vector<unsigned short> LightCluster::light_grid_vec_;
+std::vector<unsigned short> LightCluster::light_index_vec_;
+unsigned int LightCluster::light_index_num_=0;
+unsigned int LightCluster::max_cluster_light_num_=0;
+unsigned int LightCluster::skipped_light_num_=0;
+
+void LightCluster::Init() {
+    light_grid_texture_2d_=Texture2D::Create(LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y,LIGHT_CLUSTER_Z,GL_RG16UI,GL_RG_INTEGER,
+                                             GL_NEAREST,GL_NEAREST,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE,GL_UNSIGNED_SHORT, nullptr,0);
+    light_index_texture_2d_=Texture2D::Create(LIGHT_INDEX_TEXTURE_WIDTH,LIGHT_INDEX_TEXTURE_HEIGHT,GL_R16UI,GL_RED_INTEGER,
+                                              GL_NEAREST,GL_NEAREST,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE,GL_UNSIGNED_SHORT, nullptr,0);
+    //材质中声明 u_light_grid_texture、u_light_index_texture 即可使用。
+    Material::SetGlobalTexture("u_light_grid_texture",light_grid_texture_2d_);
+    Material::SetGlobalTexture("u_light_index_texture",light_index_texture_2d_);
+
+    slice_light_index_vec_.resize(LIGHT_CLUSTER_Z);
+    light_grid_vec_.resize(LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y*LIGHT_CLUSTER_Z*2,0);
+}
+
+void LightCluster::UpdateClusterBounds(const glm::mat4& projection) {
+    projection_=projection;
+    glm::mat4 inverse_projection=glm::inverse(projection);
+    auto unproject=[&inverse_projection](float x,float y,float z){
+        glm::vec4 position=inverse_projection*glm::vec4(x,y,z,1.0f);
+        return glm::vec3(position)/position.w;
+    };
+    //近、远裁剪面距离，正交相机的近裁剪面可能是0，指数划分需要大于0。
+    near_=std::max(-unproject(0,0,-1).z,0.01f);
+    far_=std::max(-unproject(0,0,1).z,near_*2.0f);
+
+    cluster_aabb_vec_.resize(LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y*LIGHT_CLUSTER_Z);
+    for (int y = 0; y < LIGHT_CLUSTER_Y; ++y) {
+        for (int x = 0; x < LIGHT_CLUSTER_X; ++x) {
+            //簇的4条棱，在近、远裁剪面上的端点。
+            glm::vec3 near_corner[4];
+            glm::vec3 far_corner[4];
+            for (int i = 0; i < 4; ++i) {
+                float ndc_x=(float)(x+(i&1))/LIGHT_CLUSTER_X*2.0f-1.0f;
+                float ndc_y=(float)(y+(i>>1))/LIGHT_CLUSTER_Y*2.0f-1.0f;
+                near_corner[i]=unproject(ndc_x,ndc_y,-1);
+                far_corner[i]=unproject(ndc_x,ndc_y,1);
+            }
+            for (int z = 0; z < LIGHT_CLUSTER_Z; ++z) {
+                //指数划分深度，第z层范围 near*(far/near)^(z/Z) ~ near*(far/near)^((z+1)/Z)
+                float slice_near=near_*powf(far_/near_,(float)z/LIGHT_CLUSTER_Z);
+                float slice_far=near_*powf(far_/near_,(float)(z+1)/LIGHT_CLUSTER_Z);
+                AABB& aabb=cluster_aabb_vec_[(z*LIGHT_CLUSTER_Y+y)*LIGHT_CLUSTER_X+x];
+                aabb.min_=glm::vec3(FLT_MAX);
+                aabb.max_=glm::vec3(-FLT_MAX);
+                for (int i = 0; i < 4; ++i) {
+                    glm::vec3 direction=far_corner[i]-near_corner[i];
+                    for (float depth : {slice_near,slice_far}) {
+                        //棱与 z=-depth 平面的交点
+                        float t=(-depth-near_corner[i].z)/direction.z;
+                        glm::vec3 point=near_corner[i]+direction*t;
+                        aabb.min_=glm::min(aabb.min_,point);
+                        aabb.max_=glm::max(aabb.max_,point);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool LightCluster::Intersect(const ViewLight& light, const AABB& aabb) {
+    glm::vec3 closest=glm::clamp(light.center_,aabb.min_,aabb.max_);
+    glm::vec3 offset=closest-light.center_;
+    return glm::dot(offset,offset)<=light.range_*light.range_;
+}
+
+void LightCluster::Build(Camera* camera) {
+    EASY_FUNCTION();
+    if(light_grid_texture_2d_== nullptr){
+        Init();
+    }
+    glm::mat4& view=camera->view_mat4();
+    glm::mat4& projection=camera->projection_mat4();
+    if(cluster_aabb_vec_.empty() || projection!=projection_){
+        UpdateClusterBounds(projection);
+    }
+
+    //视锥体深度范围内的点光源，变换到视空间。
+    view_light_vec_.clear();
+    unsigned int skipped_light_num=0;
+    for (auto point_light : PointLight::all_point_light()) {
+        //PointLightBlock中没有这个灯光的数据，Shader按序号读取会越界。
+        if(point_light->light_id()>=POINT_LIGHT_MAX_NUM){
+            skipped_light_num++;
+            continue;
+        }
+        float range=point_light->range();
+        if(range<=0){
+            continue;
+        }
+        glm::vec3 center=glm::vec3(view*glm::vec4(point_light->position(),1.0f));
+        if(center.z-range>-near_ || center.z+range<-far_){
+            continue;
+        }
+        view_light_vec_.push_back({center,range,point_light->light_id()});
+    }
+    //数量变化时才输出，避免每帧刷屏。
+    if(skipped_light_num!=skipped_light_num_){
+        skipped_light_num_=skipped_light_num;
+        if(skipped_light_num>0){
+            DEBUG_LOG_WARN("LightCluster skip {} point lights,light id exceed POINT_LIGHT_MAX_NUM:{}",skipped_light_num,POINT_LIGHT_MAX_NUM);
+        }
+    }
+
+    //每一层簇一个任务
+    JobSystem::ParallelFor(LIGHT_CLUSTER_Z,[](int z){
+        std::vector<unsigned short>& slice_light_index=slice_light_index_vec_[z];
+        slice_light_index.clear();
+        //先筛选和这一层深度范围相交的灯光
+        const AABB& first_aabb=cluster_aabb_vec_[z*LIGHT_CLUSTER_Y*LIGHT_CLUSTER_X];
+        std::vector<const ViewLight*> slice_light_vec;
+        for (auto& light : view_light_vec_) {
+            if(light.center_.z-light.range_<=first_aabb.max_.z && light.center_.z+light.range_>=first_aabb.min_.z){
+                slice_light_vec.push_back(&light);
+            }
+        }
+        for (int i = 0; i < LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y; ++i) {
+            int cluster_index=z*LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y+i;
+            const AABB& aabb=cluster_aabb_vec_[cluster_index];
+            size_t offset=slice_light_index.size();
+            for (auto light : slice_light_vec) {
+                if(Intersect(*light,aabb)){
+                    slice_light_index.push_back(light->light_id_);
+                }
+            }
+            //先记录层内的起始位置，合并时再加上层的起始位置。
+            light_grid_vec_[cluster_index*2]=(unsigned short)offset;
+            light_grid_vec_[cluster_index*2+1]=(unsigned short)(slice_light_index.size()-offset);
+        }
+    });
+
+    //合并每一层的灯光索引
+    const unsigned int max_light_index_num=LIGHT_INDEX_TEXTURE_WIDTH*LIGHT_INDEX_TEXTURE_HEIGHT;
+    light_index_vec_.clear();
+    max_cluster_light_num_=0;
+    for (int z = 0; z < LIGHT_CLUSTER_Z; ++z) {
+        unsigned int slice_offset=(unsigned int)light_index_vec_.size();
+        std::vector<unsigned short>& slice_light_index=slice_light_index_vec_[z];
+        if(slice_offset+slice_light_index.size()>max_light_index_num){
+            DEBUG_LOG_ERROR("LightCluster light index overflow,slice:{} index num:{}",z,slice_offset+slice_light_index.size());
+        }
+        for (int i = 0; i < LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y; ++i) {
+            int cluster_index=z*LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y+i;
+            unsigned int offset=slice_offset+light_grid_vec_[cluster_index*2];
+            unsigned int count=light_grid_vec_[cluster_index*2+1];
+            //超出索引纹理容量的灯光丢弃
+            count=offset<max_light_index_num?std::min(count,max_light_index_num-offset):0;
+            light_grid_vec_[cluster_index*2]=(unsigned short)std::min(offset,max_light_index_num-1);
+            light_grid_vec_[cluster_index*2+1]=(unsigned short)count;
+            max_cluster_light_num_=std::max(max_cluster_light_num_,count);
+        }
+        size_t copy_num=std::min((size_t)(max_light_index_num-std::min(slice_offset,max_light_index_num)),slice_light_index.size());
+        light_index_vec_.insert(light_index_vec_.end(),slice_light_index.begin(),slice_light_index.begin()+copy_num);
+    }
+    light_index_num_=(unsigned int)light_index_vec_.size();
+
+    //上传灯光网格、灯光索引，索引纹理只更新用到的行。
+    light_grid_texture_2d_->UpdateSubImage(0,0,LIGHT_CLUSTER_X*LIGHT_CLUSTER_Y,LIGHT_CLUSTER_Z,GL_RG_INTEGER,GL_UNSIGNED_SHORT,
+                                           (unsigned char*)light_grid_vec_.data(),(unsigned int)(light_grid_vec_.size()*sizeof(unsigned short)));
+    int row_num=(int)((light_index_num_+LIGHT_INDEX_TEXTURE_WIDTH-1)/LIGHT_INDEX_TEXTURE_WIDTH);
+    light_index_vec_.resize(row_num*LIGHT_INDEX_TEXTURE_WIDTH,0);
+    light_index_texture_2d_->UpdateSubImage(0,0,LIGHT_INDEX_TEXTURE_WIDTH,row_num,GL_RED_INTEGER,GL_UNSIGNED_SHORT,
+                                            (unsigned char*)light_index_vec_.data(),(unsigned int)(light_index_vec_.size()*sizeof(unsigned short)));
+
+    //上传簇参数，Shader计算片段所在的簇：层 = log(深度/near) * slice_scale
+    float slice_scale=LIGHT_CLUSTER_Z/logf(far_/near_);
+    UniformBufferObjectManager::UpdateUniformBlockSubDataMatrix4f("u_light_cluster","view",view);
+    UniformBufferObjectManager::UpdateUniformBlockSubDataMatrix4f("u_light_cluster","projection",projection);
+    UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_light_cluster","near_clip",near_);
+    UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_light_cluster","slice_scale",slice_scale);
+}
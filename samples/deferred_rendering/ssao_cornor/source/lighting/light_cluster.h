@@ -0,0 +1,75 @@
+//
+// Created by captainchen on 2026/10/19.
+// 光源分簇：把相机视锥体切分成 16x9x24 的簇(froxel)，每帧把点光源按照射范围分配到相交的簇，
+// 光照Shader根据片段所在的簇，只计算影响这个簇的点光源，而不是遍历所有点光源。
+//
+
+#ifndef UNTITLED_LIGHT_CLUSTER_H
+#define UNTITLED_LIGHT_CLUSTER_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#define LIGHT_CLUSTER_X 16 //水平方向簇数量
+#define LIGHT_CLUSTER_Y 9 //垂直方向簇数量
+#define LIGHT_CLUSTER_Z 24 //深度方向簇数量，按指数划分，近处的簇更薄。
+#define LIGHT_INDEX_TEXTURE_WIDTH 1024 //灯光索引纹理宽度
+#define LIGHT_INDEX_TEXTURE_HEIGHT 64 //灯光索引纹理高度，最多存储 1024*64 个灯光索引。
+
+class Camera;
+class Texture2D;
+class LightCluster {
+public:
+    /// 以相机视锥体划分簇，分配点光源，上传簇参数UBO、灯光网格纹理、灯光索引纹理。
+    /// 延迟渲染的光照Pass读取的是最近一次分簇的结果，所以只需要GBuffer相机分簇。
+    /// \param camera
+    static void Build(Camera* camera);
+
+    /// 上一次分簇的灯光索引数量
+    static unsigned int light_index_num(){return light_index_num_;}
+
+    /// 上一次分簇单个簇中最多的灯光数量
+    static unsigned int max_cluster_light_num(){return max_cluster_light_num_;}
+
+private:
+    /// 视空间包围盒
+    struct AABB{
+        glm::vec3 min_;
+        glm::vec3 max_;
+    };
+
+    /// 视空间的点光源
+    struct ViewLight{
+        glm::vec3 center_;
+        float range_;
+        unsigned short light_id_;//在PointLightBlock中的序号
+    };
+
+    /// 创建灯光网格纹理、灯光索引纹理，设置为全局纹理。
+    static void Init();
+
+    /// 投影矩阵变化后，重新计算每个簇的视空间包围盒。
+    /// \param projection
+    static void UpdateClusterBounds(const glm::mat4& projection);
+
+    /// 视空间球体与包围盒是否相交
+    static bool Intersect(const ViewLight& light,const AABB& aabb);
+
+private:
+    static Texture2D* light_grid_texture_2d_;//每个簇对应一个像素，rg:灯光索引起始位置、灯光数量
+    static Texture2D* light_index_texture_2d_;//所有簇的灯光索引，按簇依次排列。
+    static glm::mat4 projection_;//计算簇包围盒时的投影矩阵
+    static float near_;//近裁剪面距离
+    static float far_;//远裁剪面距离
+    static std::vector<AABB> cluster_aabb_vec_;//每个簇的视空间包围盒
+    static std::vector<ViewLight> view_light_vec_;//视锥体内的点光源
+    static std::vector<std::vector<unsigned short>> slice_light_index_vec_;//每一层簇的灯光索引，多线程分配后再合并。
+    static std::vector<unsigned short> light_grid_vec_;//上传到灯光网格纹理
+    static std::vector<unsigned short> light_index_vec_;//上传到灯光索引纹理
+    static unsigned int light_index_num_;
+    static unsigned int max_cluster_light_num_;
+    static unsigned int skipped_light_num_;//序号超出PointLightBlock容量、没有参与分簇的点光源数量
+};
+
+
+#endif //UNTITLED_LIGHT_CLUSTER_H
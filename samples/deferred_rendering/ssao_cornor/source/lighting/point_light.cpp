@@ -3,6 +3,9 @@
 //
 
 #include "point_light.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <rttr/registration>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform2.hpp>
@@ -12,6 +15,7 @@
 #include "renderer/mesh_renderer.h"
 #include "renderer/material.h"
 #include "render_device/uniform_buffer_object_manager.h"
+#include "utils/debug.h"
 
 using namespace rttr;
 RTTR_REGISTRATION//注册反射
@@ -21,51 +25,85 @@ RTTR_REGISTRATION//注册反射
 }
 
 unsigned int PointLight::light_count_=0;
+std::vector<PointLight*> PointLight::all_point_light_;
 
-PointLight::PointLight():Light(),attenuation_constant_(0),attenuation_linear_(0),attenuation_quadratic_(0)
+PointLight::PointLight():Light(),attenuation_constant_(0),attenuation_linear_(0),attenuation_quadratic_(0),
+    position_(0.f),range_(0.f),range_dirty_(true)
 {
     light_id_=light_count_;
     light_count_++;
-    UniformBufferObjectManager::UpdateUniformBlockSubData1i("u_point_light_array","actually_used_count",light_count_);
+    if(light_id_>=POINT_LIGHT_MAX_NUM){
+        DEBUG_LOG_ERROR("PointLight id:{} exceed POINT_LIGHT_MAX_NUM:{},this light will be ignored",light_id_,POINT_LIGHT_MAX_NUM);
+    }
+    UniformBufferObjectManager::UpdateUniformBlockSubData1i("u_point_light_array","actually_used_count",std::min(light_count_,(unsigned int)POINT_LIGHT_MAX_NUM));
+    all_point_light_.push_back(this);
 }
 
 PointLight::~PointLight() {
+    auto iter=std::find(all_point_light_.begin(),all_point_light_.end(),this);
+    if(iter!=all_point_light_.end()){
+        all_point_light_.erase(iter);
+    }
+}
 
+float PointLight::range() {
+    if(range_dirty_==false){
+        return range_;
+    }
+    range_dirty_=false;
+    //亮度 = 颜色 * 强度 / (constant + linear*d + quadratic*d*d)，求亮度等于1/256时的距离d。
+    float brightness=std::max(color_.r,std::max(color_.g,color_.b))*intensity_;
+    float c=attenuation_constant_-brightness*256.0f;
+    if(c>=0){
+        range_=0;
+    }else if(attenuation_quadratic_>0){
+        range_=(-attenuation_linear_+sqrtf(attenuation_linear_*attenuation_linear_-4*attenuation_quadratic_*c))/(2*attenuation_quadratic_);
+    }else if(attenuation_linear_>0){
+        range_=-c/attenuation_linear_;
+    }else{
+        range_=FLT_MAX;//不衰减
+    }
+    return range_;
 }
 
 
 void PointLight::set_color(glm::vec3 color){
     Light::set_color(color);
+    range_dirty_=true;
     std::string uniform_block_member_name=fmt::format("data[{}].color",light_id_);
     UniformBufferObjectManager::UpdateUniformBlockSubData3f("u_point_light_array",uniform_block_member_name,color_);
 };
 
 void PointLight::set_intensity(float intensity){
     Light::set_intensity(intensity);
+    range_dirty_=true;
     std::string uniform_block_member_name=fmt::format("data[{}].intensity",light_id_);
     UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_point_light_array",uniform_block_member_name,intensity_);
 };
 
 void PointLight::set_attenuation_constant(float attenuation_constant){
     attenuation_constant_ = attenuation_constant;
+    range_dirty_=true;
     std::string uniform_block_member_name=fmt::format("data[{}].constant",light_id_);
     UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_point_light_array",uniform_block_member_name,attenuation_constant_);
 }
 
 void PointLight::set_attenuation_linear(float attenuation_linear){
     attenuation_linear_ = attenuation_linear;
+    range_dirty_=true;
     std::string uniform_block_member_name=fmt::format("data[{}].linear",light_id_);
     UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_point_light_array",uniform_block_member_name,attenuation_linear_);
 }
 
 void PointLight::set_attenuation_quadratic(float attenuation_quadratic){
     attenuation_quadratic_ = attenuation_quadratic;
+    range_dirty_=true;
     std::string uniform_block_member_name=fmt::format("data[{}].quadratic",light_id_);
     UniformBufferObjectManager::UpdateUniformBlockSubData1f("u_point_light_array",uniform_block_member_name,attenuation_quadratic_);
 }
 
 void PointLight::Update(){
-    glm::vec3 light_position=game_object()->GetComponent<Transform>()->position();
+    position_=game_object()->GetComponent<Transform>()->position();
     std::string uniform_block_member_name=fmt::format("data[{}].pos",light_id_);
-    UniformBufferObjectManager::UpdateUniformBlockSubData3f("u_point_light_array",uniform_block_member_name,light_position);
+    UniformBufferObjectManager::UpdateUniformBlockSubData3f("u_point_light_array",uniform_block_member_name,position_);
 }
\ No newline at end of file
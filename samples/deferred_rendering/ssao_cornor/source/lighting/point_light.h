@@ -5,9 +5,12 @@
 #ifndef ENGINE_LIGHTING_POINT_LIGHT_H
 #define ENGINE_LIGHTING_POINT_LIGHT_H
 
+#include <vector>
 #include <rttr/registration>
 #include "light.h"
 
+#define POINT_LIGHT_MAX_NUM 128 //最大点光源数量，PointLightBlock的容量，序号超出的点光源不参与光照。
+
 using namespace rttr;
 
 class PointLight : public Light {
@@ -28,6 +31,15 @@ public:
     float attenuation_quadratic() const{return attenuation_quadratic_;}
     void set_attenuation_quadratic(float attenuation_quadratic);
 
+    /// 世界坐标，Update时记录。
+    const glm::vec3& position() const{return position_;}
+
+    /// 照射范围，衰减后亮度低于1/256的距离，用于光源分簇。
+    float range();
+
+    /// 所有点光源，用于光源分簇。
+    static const std::vector<PointLight*>& all_point_light(){return all_point_light_;}
+
 public:
     void Update() override;
 
@@ -35,8 +47,12 @@ private:
     float attenuation_constant_;//点光衰减常数项
     float attenuation_linear_;//点光衰减一次项
     float attenuation_quadratic_;//点光衰减二次项
+    glm::vec3 position_;//世界坐标
+    float range_;//照射范围
+    bool range_dirty_;//颜色、强度、衰减修改后重新计算照射范围
 
     static unsigned int light_count_;//灯光数量
+    static std::vector<PointLight*> all_point_light_;//所有点光源
 
 RTTR_ENABLE(Light);
 };
@@ -27,6 +27,7 @@ extern "C"{
 #include "renderer/render_texture.h"
 #include "renderer/render_texture_geometry_buffer.h"
 #include "renderer/noise_texture.h"
+#include "renderer/frame_graph.h"
 #include "ui/rect_transform.h"
 #include "ui/ui_button.h"
 #include "ui/ui_camera.h"
@@ -38,6 +39,8 @@ extern "C"{
 #include "utils/debug.h"
 #include "utils/screen.h"
 #include "utils/time.h"
+#include "utils/job_system.h"
+#include "utils/typed_buffer.h"
 #include "physics/physics.h"
 #include "physics/rigid_actor.h"
 #include "physics/rigid_dynamic.h"
@@ -45,16 +48,22 @@ extern "C"{
 #include "physics/collider.h"
 #include "physics/sphere_collider.h"
 #include "physics/box_collider.h"
+#include "physics/scene_query_batch.h"
 #include "lighting/environment.h"
 #include "lighting/light.h"
 #include "lighting/directional_light.h"
 #include "lighting/point_light.h"
+#include "lighting/cascaded_shadow_map.h"
 
 sol::state LuaBinding::sol_state_;
 
 void LuaBinding::Init(std::string package_path) {
     sol_state_.open_libraries(sol::lib::base,sol::lib::package,sol::lib::coroutine,sol::lib::string,sol::lib::os,sol::lib::math,
                               sol::lib::table,sol::lib::debug,sol::lib::bit32,sol::lib::io,sol::lib::utf8);
+#ifdef USE_LUAJIT
+    //LuaJIT的ffi、jit库，数学计算使用ffi结构体，见 source_lua/utils/ffi_math.lua。
+    sol_state_.open_libraries(sol::lib::ffi,sol::lib::jit);
+#endif
     //启用luasocket
     sol_state_.require("socket.core",luaopen_socket_core,true);
     //设置lua搜索目录
@@ -79,6 +88,37 @@ namespace sol2{
         }
         return res;
     }
+
+    /// C++的序号(从0开始，小于0表示失败)转换为Lua的序号(从1开始，失败返回nil)
+    /// \param index
+    /// \return
+    inline sol::optional<int> to_lua_index(int index)
+    {
+        if(index<0){
+            return sol::nullopt;
+        }
+        return index+1;
+    }
+
+#ifdef USE_LUAJIT
+    #define LUA_TCDATA 10 //LuaJIT的cdata类型，lua.h中没有定义。
+
+    /// 将LuaJIT ffi结构体转换为glm类型，ffi结构体和glm内存布局相同，直接复制内存。
+    /// \tparam T glm::vec2 vec3 vec4 mat4
+    /// \param cdata ffi_math.lua中创建的结构体
+    /// \return
+    template <typename T>
+    T convert_ffi(sol::stack_object cdata)
+    {
+        lua_State* lua_state=cdata.lua_state();
+        if(lua_type(lua_state,cdata.stack_index())!=LUA_TCDATA){
+            DEBUG_LOG_ERROR("convert_ffi need cdata,got {}",luaL_typename(lua_state,cdata.stack_index()));
+            return T(0);
+        }
+        //结构体cdata返回的是结构体本身的内存
+        return *static_cast<const T*>(lua_topointer(lua_state,cdata.stack_index()));
+    }
+#endif
 }
 
 void LuaBinding::BindLua() {
@@ -166,7 +206,10 @@ void LuaBinding::BindLua() {
                                              sol::meta_function::to_string,[] (const glm::mat4* m) {return glm::to_string(*m);},
                                              sol::meta_function::addition,[] (const glm::mat4* m_a,const  glm::mat4* m_b) {return (*m_a)+(*m_b);},
                                              sol::meta_function::subtraction,[] (const glm::mat4* m_a,const  glm::mat4* m_b) {return (*m_a)-(*m_b);},
-                                             sol::meta_function::multiplication,[] (const glm::mat4* m,const glm::vec4* v) {return (*m)*(*v);},
+                                             sol::meta_function::multiplication,sol::overload(
+                                                     [] (const glm::mat4* m,const glm::vec4* v) {return (*m)*(*v);},
+                                                     [] (const glm::mat4* m_a,const glm::mat4* m_b) {return (*m_a)*(*m_b);}
+                                             ),
                                              sol::meta_function::division,[] (const glm::mat4* m,const float a) {return (*m)/a;},
                                              sol::meta_function::unary_minus,[] (const glm::mat4* m) {return (*m)*-1;},
                                              sol::meta_function::equal_to,[] (const glm::mat4* m_a,const  glm::mat4* m_b) {return (*m_a)==(*m_b);}
@@ -181,6 +224,7 @@ void LuaBinding::BindLua() {
             return glm::distance(*a,*b);
         }));
         glm_ns_table.set_function("radians",sol::overload([] (const float f) {return glm::radians(f);}));
+        glm_ns_table.set_function("inverse",sol::overload([] (const glm::mat4* m) {return glm::inverse(*m);}));
         glm_ns_table.set_function("to_string",sol::overload(
                 [] (const glm::mat4* m) {return glm::to_string((*m));},
                 [] (const glm::vec3* v) {return glm::to_string((*v));}
@@ -189,6 +233,16 @@ void LuaBinding::BindLua() {
                 [] (const glm::vec3* v) {return glm::normalize((*v));}
         ));
     }
+#ifdef USE_LUAJIT
+    //ffi结构体转换为glm类型，传给引擎接口。
+    {
+        auto glm_ns_table = sol_state_["glm"].get_or_create<sol::table>();
+        glm_ns_table["vec2_from_ffi"]=&sol2::convert_ffi<glm::vec2>;
+        glm_ns_table["vec3_from_ffi"]=&sol2::convert_ffi<glm::vec3>;
+        glm_ns_table["vec4_from_ffi"]=&sol2::convert_ffi<glm::vec4>;
+        glm_ns_table["mat4_from_ffi"]=&sol2::convert_ffi<glm::mat4>;
+    }
+#endif
 
     auto cpp_ns_table = sol_state_["Cpp"].get_or_create<sol::table>();
     // audio
@@ -340,7 +394,11 @@ void LuaBinding::BindLua() {
                                            "OnEnable",&Component::OnEnable,
                                            "game_object",&Component::game_object,
                                            "set_game_object",&Component::set_game_object,
-                                           "set_lua_component_instance",&Component::set_lua_component_instance
+                                           "set_lua_component_instance",&Component::set_lua_component_instance,
+                                           "DelegateUpdateToLua",&Component::DelegateUpdateToLua,
+                                           "set_lua_scheduler",&Component::set_lua_scheduler,
+                                           "lua_call_num",&Component::lua_call_num,
+                                           "hook_skip_num",&Component::hook_skip_num
         );
 
         cpp_ns_table.new_usertype<Transform>("Transform",sol::call_constructor,sol::constructors<Transform()>(),
@@ -543,9 +601,13 @@ void LuaBinding::BindLua() {
                                         "Foreach",&Camera::Foreach,
                                         "current_camera",&Camera::current_camera,
                                         "Sort",&Camera::Sort,
+                                        "light_cluster",&Camera::light_cluster,
+                                        "set_light_cluster",&Camera::set_light_cluster,
                                         "CheckRenderToTexture",&Camera::CheckRenderToTexture,
                                         "set_target_render_texture",&Camera::set_target_render_texture,
                                         "clear_target_render_texture",&Camera::clear_target_render_texture,
+                                        "AddInputRenderTexture",&Camera::AddInputRenderTexture,
+                                        "ClearInputRenderTexture",&Camera::ClearInputRenderTexture,
                                         "deferred_shading",&Camera::deferred_shading,
                                         "set_deferred_shading",&Camera::set_deferred_shading
         );
@@ -557,7 +619,8 @@ void LuaBinding::BindLua() {
         });
 
         cpp_ns_table.new_usertype<UICamera>("UICamera",sol::call_constructor,sol::constructors<UICamera()>(),
-                                          sol::base_classes,sol::bases<Camera,Component>()
+                                          sol::base_classes,sol::bases<Camera,Component>(),
+                                          "batch_num",&UICamera::batch_num
         );
 
         cpp_ns_table.new_usertype<Material>("Material",sol::call_constructor,sol::constructors<Material()>(),
@@ -572,18 +635,32 @@ void LuaBinding::BindLua() {
         cpp_ns_table.new_usertype<MeshFilter>("MeshFilter",sol::call_constructor,sol::constructors<MeshFilter()>(),
                                             sol::base_classes,sol::bases<Component>(),
                                             "LoadMesh", &MeshFilter::LoadMesh,
-                                            "CreateMesh", [] (MeshFilter* meshFilter,std::vector<float>& vertex_data,std::vector<unsigned short>& vertex_index_data)
-                                            {return meshFilter->CreateMesh(vertex_data,vertex_index_data);},
+                                            "CreateMesh", sol::overload(
+                                                    [] (MeshFilter* meshFilter,TypedBuffer* vertex_data,TypedBuffer* vertex_index_data)
+                                                    {return meshFilter->CreateMesh(vertex_data,vertex_index_data);},
+                                                    [] (MeshFilter* meshFilter,std::vector<float>& vertex_data,std::vector<unsigned short>& vertex_index_data)
+                                                    {return meshFilter->CreateMesh(vertex_data,vertex_index_data);}),
                                             "GetMeshName",&MeshFilter::GetMeshName,
-                                            "set_vertex_relate_bone_infos",&MeshFilter::set_vertex_relate_bone_infos,
-                                            "LoadWeight",&MeshFilter::LoadWeight
+                                            "set_vertex_relate_bone_infos",sol::overload(
+                                                    sol::resolve<void(TypedBuffer*)>(&MeshFilter::set_vertex_relate_bone_infos),
+                                                    sol::resolve<void(std::vector<int>&)>(&MeshFilter::set_vertex_relate_bone_infos)),
+                                            "LoadWeight",&MeshFilter::LoadWeight,
+                                            "GenerateLOD",&MeshFilter::GenerateLOD,
+                                            "lod_num",&MeshFilter::lod_num,
+                                            "set_lod_screen_relative_height",&MeshFilter::set_lod_screen_relative_height,
+                                            "lod_hysteresis",&MeshFilter::lod_hysteresis,
+                                            "set_lod_hysteresis",&MeshFilter::set_lod_hysteresis
         );
 
         cpp_ns_table.new_usertype<MeshRenderer>("MeshRenderer",sol::call_constructor,sol::constructors<MeshRenderer()>(),
                                               sol::base_classes,sol::bases<Component>(),
                                               "SetMaterial", &MeshRenderer::SetMaterial,
                                               "material", &MeshRenderer::material,
-                                              "Render", &MeshRenderer::Render
+                                              "Render", &MeshRenderer::Render,
+                                              "lod_triangle_count", &MeshRenderer::lod_triangle_count,
+                                              "lod_draw_count", &MeshRenderer::lod_draw_count,
+                                              "cast_shadow", &MeshRenderer::cast_shadow,
+                                              "set_cast_shadow", &MeshRenderer::set_cast_shadow
         );
 
 
@@ -603,11 +680,20 @@ void LuaBinding::BindLua() {
 
         cpp_ns_table.new_usertype<Texture2D>("Texture2D",
                                            "mipmap_level", &Texture2D::mipmap_level,
+                                           "mipmap_num", &Texture2D::mipmap_num,
                                            "width", &Texture2D::width,
                                            "height", &Texture2D::height,
                                            "gl_texture_format", &Texture2D::gl_texture_format,
                                            "texture_handle", &Texture2D::texture_handle,
-                                           "LoadFromFile", &Texture2D::LoadFromFile
+                                           "set_quality_skip_mipmap_num", &Texture2D::set_quality_skip_mipmap_num,
+                                           "quality_skip_mipmap_num", &Texture2D::quality_skip_mipmap_num,
+                                           "set_memory_budget", &Texture2D::set_memory_budget,
+                                           "memory_budget", &Texture2D::memory_budget,
+                                           "memory_size_total", &Texture2D::memory_size_total,
+                                           "LoadFromFile", &Texture2D::LoadFromFile,
+                                           "CreateFromBuffer", [] (unsigned short width,unsigned short height,unsigned int server_format,unsigned int client_format,
+                                                                   unsigned int filter_mag,unsigned int filter_min,unsigned int wrap_s,unsigned int wrap_t,TypedBuffer* data)
+                                           {return Texture2D::Create(width,height,server_format,client_format,filter_mag,filter_min,wrap_s,wrap_t,data);}
         );
 
         cpp_ns_table.new_usertype<AnimationClip>("AnimationClip",sol::call_constructor,sol::constructors<AnimationClip()>(),
@@ -633,7 +719,9 @@ void LuaBinding::BindLua() {
                                                  "set_in_use", &RenderTexture::set_in_use,
                                                  "frame_buffer_object_handle", &RenderTexture::frame_buffer_object_handle,
                                                  "color_texture_2d", &RenderTexture::color_texture_2d,
-                                                 "depth_texture_2d", &RenderTexture::depth_texture_2d
+                                                 "depth_texture_2d", &RenderTexture::depth_texture_2d,
+                                                 "transient", &RenderTexture::transient,
+                                                 "set_transient", &RenderTexture::set_transient
         );
         cpp_ns_table.new_usertype<RenderTextureGeometryBuffer>("RenderTextureGeometryBuffer", sol::call_constructor, sol::constructors<RenderTextureGeometryBuffer()>(),
                                                                sol::base_classes, sol::bases<RenderTexture>(),
@@ -642,7 +730,16 @@ void LuaBinding::BindLua() {
                                                                "frag_vertex_color_texture_2d", &RenderTextureGeometryBuffer::frag_vertex_color_texture_2d,
                                                                "frag_diffuse_color_texture_2d", &RenderTextureGeometryBuffer::frag_diffuse_color_texture_2d,
                                                                "frag_specular_intensity_texture_2d", &RenderTextureGeometryBuffer::frag_specular_intensity_texture_2d,
-                                                               "frag_specular_highlight_shininess_texture_2d", &RenderTextureGeometryBuffer::frag_specular_highlight_shininess_texture_2d
+                                                               "frag_specular_highlight_shininess_texture_2d", &RenderTextureGeometryBuffer::frag_specular_highlight_shininess_texture_2d,
+                                                               "packed", &RenderTextureGeometryBuffer::packed,
+                                                               "set_packed", &RenderTextureGeometryBuffer::set_packed
+        );
+        cpp_ns_table.new_usertype<FrameGraph>("FrameGraph",
+                                            "enable",&FrameGraph::enable,
+                                            "set_enable",&FrameGraph::set_enable,
+                                            "culled_pass_num",&FrameGraph::culled_pass_num,
+                                            "transient_render_texture_num",&FrameGraph::transient_render_texture_num,
+                                            "physical_render_texture_num",&FrameGraph::physical_render_texture_num
         );
         cpp_ns_table.new_usertype<NoiseTexture>("NoiseTexture",sol::call_constructor,sol::constructors<NoiseTexture()>(),
                                                 "Init", &NoiseTexture::Init,
@@ -667,7 +764,16 @@ void LuaBinding::BindLua() {
                                            sol::base_classes,sol::bases<Component>(),
                                            "texture2D", &UIImage::texture2D,
                                            "set_texture",&UIImage::set_texture,
-                                           "LoadTexture2D",&UIImage::LoadTexture2D
+                                           "LoadTexture2D",&UIImage::LoadTexture2D,
+                                           "LoadSprite",&UIImage::LoadSprite,
+                                           "width",&UIImage::width,
+                                           "height",&UIImage::height
+        );
+        cpp_ns_table.new_usertype<UIMask>("UIMask",sol::call_constructor,sol::constructors<UIMask()>(),
+                                           sol::base_classes,sol::bases<Component>(),
+                                           "texture2D", &UIMask::texture2D,
+                                           "set_texture",&UIMask::set_texture,
+                                           "LoadSprite",&UIMask::LoadSprite
         );
     }
 
@@ -699,13 +805,55 @@ void LuaBinding::BindLua() {
                         "attenuation_quadratic", &PointLight::attenuation_quadratic,
                         "set_attenuation_quadratic", &PointLight::set_attenuation_quadratic
         );
+        cpp_ns_table.new_usertype<CascadedShadowMap>("CascadedShadowMap",
+                                                   "Init", &CascadedShadowMap::Init,
+                                                   "light", &CascadedShadowMap::light,
+                                                   "set_light", &CascadedShadowMap::set_light,
+                                                   "camera", &CascadedShadowMap::camera,
+                                                   "set_camera", &CascadedShadowMap::set_camera,
+                                                   "shadow_distance", &CascadedShadowMap::shadow_distance,
+                                                   "set_shadow_distance", &CascadedShadowMap::set_shadow_distance,
+                                                   "split_lambda", &CascadedShadowMap::split_lambda,
+                                                   "set_split_lambda", &CascadedShadowMap::set_split_lambda,
+                                                   "depth_bias", &CascadedShadowMap::depth_bias,
+                                                   "set_depth_bias", &CascadedShadowMap::set_depth_bias,
+                                                   "culling_mask", &CascadedShadowMap::culling_mask,
+                                                   "set_culling_mask", &CascadedShadowMap::set_culling_mask,
+                                                   "caster_num", &CascadedShadowMap::caster_num,
+                                                   "caster_draw_num", &CascadedShadowMap::caster_draw_num
+        );
     }
 
     // physics
     {
         cpp_ns_table.new_usertype<Physics>("Physics",
                                          "CreatePxScene", &Physics::CreatePxScene,
-                                         "RaycastSingle",&Physics::RaycastSingle
+                                         "RaycastSingle",&Physics::RaycastSingle,
+                                         "async",&Physics::async,
+                                         "set_async",&Physics::set_async,
+                                         "sub_step_num",&Physics::sub_step_num,
+                                         "set_sub_step_num",&Physics::set_sub_step_num,
+                                         "fetch_wait_time",&Physics::fetch_wait_time,
+                                         "overlap_time",&Physics::overlap_time,
+                                         "pvd_enable",&Physics::pvd_enable,
+                                         "set_pvd_enable",&Physics::set_pvd_enable,
+                                         "pvd_connected",&Physics::pvd_connected,
+                                         "statistics",[](sol::this_state this_state){
+                                             //统计转成table，Lua读取一次得到所有数值。
+                                             const PhysicsStatistics& statistics=Physics::statistics();
+                                             sol::state_view lua(this_state);
+                                             sol::table table=lua.create_table();
+                                             table["active_body_num"]=statistics.active_body_num_;
+                                             table["sleeping_body_num"]=statistics.sleeping_body_num_;
+                                             table["static_body_num"]=statistics.static_body_num_;
+                                             table["contact_pair_num"]=statistics.contact_pair_num_;
+                                             table["broad_phase_pair_num"]=statistics.broad_phase_pair_num_;
+                                             table["new_touch_num"]=statistics.new_touch_num_;
+                                             table["lost_touch_num"]=statistics.lost_touch_num_;
+                                             table["simulate_time"]=statistics.simulate_time_;
+                                             table["fetch_time"]=statistics.fetch_time_;
+                                             return table;
+                                         }
         );
         cpp_ns_table.new_usertype<RigidActor>("RigidActor",sol::call_constructor, sol::constructors<RigidActor()>(),
                                             sol::base_classes, sol::bases<Component>(),
@@ -732,6 +880,65 @@ void LuaBinding::BindLua() {
                                                     "position",&RaycastHit::position,
                                                     "game_object",&RaycastHit::game_object
         );
+        cpp_ns_table.new_usertype<SceneQueryHit>("SceneQueryHit",
+                                               "position",&SceneQueryHit::position_,
+                                               "normal",&SceneQueryHit::normal_,
+                                               "distance",&SceneQueryHit::distance_,
+                                               "game_object",&SceneQueryHit::game_object_
+        );
+        cpp_ns_table.new_usertype<SceneQueryBatch>("SceneQueryBatch",sol::call_constructor,sol::constructors<SceneQueryBatch(unsigned int,unsigned int)>(),
+                                                 "Clear",&SceneQueryBatch::Clear,
+                                                 //Lua中检测序号、击中结果序号都从1开始，提交失败返回nil。
+                                                 "AddRaycast",[](SceneQueryBatch* scene_query_batch,const glm::vec3& origin,const glm::vec3& dir,float distance){
+                                                     return sol2::to_lua_index(scene_query_batch->AddRaycast(origin,dir,distance));
+                                                 },
+                                                 "AddSphereSweep",[](SceneQueryBatch* scene_query_batch,const glm::vec3& origin,float radius,const glm::vec3& dir,float distance){
+                                                     return sol2::to_lua_index(scene_query_batch->AddSphereSweep(origin,radius,dir,distance));
+                                                 },
+                                                 "AddBoxSweep",[](SceneQueryBatch* scene_query_batch,const glm::vec3& origin,const glm::vec3& half_extents,const glm::vec3& dir,float distance){
+                                                     return sol2::to_lua_index(scene_query_batch->AddBoxSweep(origin,half_extents,dir,distance));
+                                                 },
+                                                 "AddSphereOverlap",[](SceneQueryBatch* scene_query_batch,const glm::vec3& center,float radius){
+                                                     return sol2::to_lua_index(scene_query_batch->AddSphereOverlap(center,radius));
+                                                 },
+                                                 "AddBoxOverlap",[](SceneQueryBatch* scene_query_batch,const glm::vec3& center,const glm::vec3& half_extents){
+                                                     return sol2::to_lua_index(scene_query_batch->AddBoxOverlap(center,half_extents));
+                                                 },
+                                                 "AddRaycasts",&SceneQueryBatch::AddRaycasts,
+                                                 "AddSphereSweeps",&SceneQueryBatch::AddSphereSweeps,
+                                                 "AddSphereOverlaps",&SceneQueryBatch::AddSphereOverlaps,
+                                                 "Execute",&SceneQueryBatch::Execute,
+                                                 "query_num",&SceneQueryBatch::query_num,
+                                                 "max_hit_num",&SceneQueryBatch::max_hit_num,
+                                                 "hit_num",[](SceneQueryBatch* scene_query_batch,unsigned int query_index){
+                                                     return query_index>=1?scene_query_batch->hit_num(query_index-1):0;
+                                                 },
+                                                 //序号超出范围返回nil，缓冲区中超出hit_num的结果是之前批次留下的，可能引用已经销毁的物体。
+                                                 "hit",[](SceneQueryBatch* scene_query_batch,unsigned int query_index,unsigned int hit_index)->sol::optional<SceneQueryHit>{
+                                                     if(query_index<1 || query_index>scene_query_batch->query_num() ||
+                                                        hit_index<1 || hit_index>scene_query_batch->hit_num(query_index-1)){
+                                                         return sol::nullopt;
+                                                     }
+                                                     return scene_query_batch->hit(query_index-1,hit_index-1);
+                                                 },
+                                                 //一次返回所有结果，Lua不用逐个调用。
+                                                 "hit_nums",[](SceneQueryBatch* scene_query_batch){return sol::as_table(scene_query_batch->hit_num_vec());},
+                                                 "hits",[](SceneQueryBatch* scene_query_batch,sol::this_state this_state){
+                                                     //嵌套table，hits[i][j]是第i个检测的第j个结果，只包含有效的结果。
+                                                     sol::state_view lua(this_state);
+                                                     unsigned int query_num=scene_query_batch->query_num();
+                                                     sol::table hits=lua.create_table(query_num,0);
+                                                     for (unsigned int i = 0; i < query_num; ++i) {
+                                                         unsigned int hit_num=scene_query_batch->hit_num(i);
+                                                         sol::table query_hits=lua.create_table(hit_num,0);
+                                                         for (unsigned int j = 0; j < hit_num; ++j) {
+                                                             query_hits[j+1]=scene_query_batch->hit(i,j);
+                                                         }
+                                                         hits[i+1]=query_hits;
+                                                     }
+                                                     return hits;
+                                                 }
+        );
     }
 
     // utils
@@ -766,7 +973,32 @@ void LuaBinding::BindLua() {
                                       "Init",&Time::Init,
                                       "Update",&Time::Update,
                                       "TimeSinceStartup",&Time::TimeSinceStartup,
-                                      "delta_time",&Time::delta_time
+                                      "delta_time",&Time::delta_time,
+                                      "max_fixed_update_num",&Time::max_fixed_update_num,
+                                      "set_max_fixed_update_num",&Time::set_max_fixed_update_num
+        );
+
+        cpp_ns_table.new_usertype<TypedBuffer>("TypedBuffer",
+                                             "Float32",[] (size_t length){return std::make_unique<TypedBuffer>(TypedBuffer::Type::FLOAT32,length);},
+                                             "Uint16",[] (size_t length){return std::make_unique<TypedBuffer>(TypedBuffer::Type::UINT16,length);},
+                                             "Uint8",[] (size_t length){return std::make_unique<TypedBuffer>(TypedBuffer::Type::UINT8,length);},
+                                             "length",&TypedBuffer::length,
+                                             "byte_size",&TypedBuffer::byte_size,
+                                             "Get",&TypedBuffer::Get,
+                                             "Set",&TypedBuffer::Set,
+                                             "Fill",&TypedBuffer::Fill,
+                                             "Resize",&TypedBuffer::Resize,
+                                             //buffer[i] 读写元素，下标从1开始。
+                                             sol::meta_function::index,&TypedBuffer::Get,
+                                             sol::meta_function::new_index,&TypedBuffer::Set,
+                                             sol::meta_function::length,&TypedBuffer::length
+        );
+
+        cpp_ns_table.new_usertype<JobSystem>("JobSystem",
+                                           "worker_num",&JobSystem::worker_num,
+                                           "utilization",&JobSystem::utilization,
+                                           "job_num",&JobSystem::job_num,
+                                           "steal_num",&JobSystem::steal_num
         );
     }
 }
@@ -3,17 +3,33 @@
 //
 
 #include "physics.h"
+#include <cstdlib>
+#include <cstring>
+#include "easy/profiler.h"
+#include "easy/arbitrary_value.h"
 #include "utils/debug.h"
+#include "utils/time.h"
+#include "rigid_dynamic.h"
 
 PxDefaultAllocator		Physics::px_allocator_;
 PhysicErrorCallback	    Physics::physic_error_callback_;
 SimulationEventCallback Physics::simulation_event_callback_;
 PxFoundation*			Physics::px_foundation_;
 PxPhysics*				Physics::px_physics_;
-PxDefaultCpuDispatcher*	Physics::px_cpu_dispatcher_;
+PhysicsCpuDispatcher    Physics::physics_cpu_dispatcher_;
 PxScene*		        Physics::px_scene_;
-PxPvd*                  Physics::px_pvd_;
+PxPvd*                  Physics::px_pvd_= nullptr;
+bool                    Physics::pvd_enable_=false;
+std::string             Physics::pvd_host_="127.0.0.1";
 bool                    Physics::enable_ccd_=true;
+bool                    Physics::async_=false;
+bool                    Physics::simulating_=false;
+unsigned int            Physics::sub_step_num_=1;
+std::chrono::steady_clock::time_point Physics::simulate_start_time_;
+float                   Physics::fetch_wait_time_=0;
+float                   Physics::overlap_time_=0;
+float                   Physics::simulate_time_=0;
+PhysicsStatistics       Physics::statistics_;
 
 //~zh 设置在碰撞发生时，Physx需要做的事情
 //~en Set the actions when collision occurs,Physx needs to do.
@@ -44,11 +60,25 @@ void Physics::Init() {
     //~zh 创建Foundation实例。
     px_foundation_ = PxCreateFoundation(PX_PHYSICS_VERSION, px_allocator_, physic_error_callback_);
 
-    //~en Connect to pvd(PhysX Visual Debugger).
-    //~zh 连接PVD
-    px_pvd_ = PxCreatePvd(*px_foundation_);
-    PxPvdTransport* transport = PxDefaultPvdSocketTransportCreate("127.0.0.1", 5425, 10);
-    px_pvd_->connect(*transport,PxPvdInstrumentationFlag::eALL);
+    //~zh 环境变量优先于配置，发布版本不用改配置也能临时连接PVD。
+    //~en Environment variables override the config.
+    const char* pvd_env=std::getenv("PHYSICS_PVD");
+    if(pvd_env!=nullptr){
+        pvd_enable_=std::strcmp(pvd_env,"0")!=0;
+    }
+    const char* pvd_host_env=std::getenv("PHYSICS_PVD_HOST");
+    if(pvd_host_env!=nullptr){
+        pvd_host_=pvd_host_env;
+    }
+
+    //~en Connect to pvd(PhysX Visual Debugger),disabled by default to avoid startup latency and per-step overhead.
+    //~zh 连接PVD，默认关闭，避免启动时连接超时和每次模拟的传输开销。
+    if(pvd_enable_){
+        px_pvd_ = PxCreatePvd(*px_foundation_);
+        PxPvdTransport* transport = PxDefaultPvdSocketTransportCreate(pvd_host_.c_str(), 5425, 10);
+        px_pvd_->connect(*transport,PxPvdInstrumentationFlag::eALL);
+        DEBUG_LOG_INFO("Physics connect pvd {}:5425 {}",pvd_host_,px_pvd_->isConnected());
+    }
 
     //~en Creates an instance of the physics SDK.
     //~zh 创建Physx SDK实例
@@ -62,8 +92,113 @@ void Physics::FixedUpdate() {
         DEBUG_LOG_ERROR("px_scene_==nullptr,please call Physics::CreatePxScene() first");
         return;
     }
-    px_scene_->simulate(1.0f / 60.0f);
-    px_scene_->fetchResults(true);
+    EASY_FUNCTION();
+    if(async_){
+        if(simulating_==false){
+            return;
+        }
+        //checkResults不阻塞，已经完成说明模拟完全被渲染隐藏。
+        auto fetch_start_time=std::chrono::steady_clock::now();
+        overlap_time_=std::chrono::duration<float,std::milli>(fetch_start_time-simulate_start_time_).count();
+        EASY_VALUE("physics overlap ms",overlap_time_);
+        if(px_scene_->checkResults(false)==false){
+            EASY_BLOCK("Physics Fetch Wait",profiler::colors::Red);
+            px_scene_->fetchResults(true);
+            EASY_END_BLOCK;
+        }else{
+            px_scene_->fetchResults(true);
+        }
+        SyncActiveActors();
+        simulation_event_callback_.DispatchEvents();
+        fetch_wait_time_=std::chrono::duration<float,std::milli>(std::chrono::steady_clock::now()-fetch_start_time).count();
+        EASY_VALUE("physics fetch wait ms",fetch_wait_time_);
+        simulating_=false;
+        UpdateStatistics();
+        return;
+    }
+    //同步模拟，整个模拟时间都在等待。
+    auto simulate_start_time=std::chrono::steady_clock::now();
+    float sub_step_time=Time::fixed_update_time()/sub_step_num_;
+    simulate_time_=0;
+    for (unsigned int i = 0; i < sub_step_num_; ++i) {
+        auto sub_step_start_time=std::chrono::steady_clock::now();
+        px_scene_->simulate(sub_step_time);
+        simulate_time_+=std::chrono::duration<float,std::milli>(std::chrono::steady_clock::now()-sub_step_start_time).count();
+        px_scene_->fetchResults(true);
+        SyncActiveActors();
+        simulation_event_callback_.DispatchEvents();
+    }
+    fetch_wait_time_=std::chrono::duration<float,std::milli>(std::chrono::steady_clock::now()-simulate_start_time).count();
+    overlap_time_=0;
+    UpdateStatistics();
+}
+
+void Physics::SyncActiveActors() {
+    EASY_FUNCTION();
+    //活动Actor列表只在每次fetchResults后有效，每个子步都要同步，否则子步中途休眠的物体会漏掉。
+    PxU32 active_actor_num=0;
+    PxActor** active_actors=px_scene_->getActiveActors(active_actor_num);
+    for (PxU32 i = 0; i < active_actor_num; ++i) {
+        RigidDynamic* rigid_dynamic=static_cast<RigidDynamic*>(active_actors[i]->userData);
+        if(rigid_dynamic==nullptr){
+            continue;
+        }
+        rigid_dynamic->SyncTransform(static_cast<PxRigidActor*>(active_actors[i])->getGlobalPose());
+    }
+}
+
+void Physics::Simulate() {
+    if(async_==false || px_scene_==nullptr || simulating_){
+        return;
+    }
+    EASY_FUNCTION();
+    //前面的子步同步执行，最后一个子步和渲染并行。
+    auto start_time=std::chrono::steady_clock::now();
+    float sub_step_time=Time::fixed_update_time()/sub_step_num_;
+    for (unsigned int i = 1; i < sub_step_num_; ++i) {
+        px_scene_->simulate(sub_step_time);
+        px_scene_->fetchResults(true);
+        SyncActiveActors();
+        simulation_event_callback_.DispatchEvents();
+    }
+    px_scene_->simulate(sub_step_time);
+    simulating_=true;
+    simulate_start_time_=std::chrono::steady_clock::now();
+    simulate_time_=std::chrono::duration<float,std::milli>(simulate_start_time_-start_time).count();
+}
+
+void Physics::UpdateStatistics() {
+    PxSimulationStatistics simulation_statistics;
+    px_scene_->getSimulationStatistics(simulation_statistics);
+    statistics_.active_body_num_=simulation_statistics.nbActiveDynamicBodies;
+    statistics_.sleeping_body_num_=simulation_statistics.nbDynamicBodies-simulation_statistics.nbActiveDynamicBodies;
+    statistics_.static_body_num_=simulation_statistics.nbStaticBodies;
+    statistics_.contact_pair_num_=simulation_statistics.nbDiscreteContactPairsWithContacts;
+    statistics_.broad_phase_pair_num_=simulation_statistics.nbDiscreteContactPairsTotal;
+    statistics_.new_touch_num_=simulation_statistics.nbNewTouches;
+    statistics_.lost_touch_num_=simulation_statistics.nbLostTouches;
+    statistics_.simulate_time_=simulate_time_;
+    statistics_.fetch_time_=fetch_wait_time_;
+
+    EASY_VALUE("physics active bodies",statistics_.active_body_num_);
+    EASY_VALUE("physics sleeping bodies",statistics_.sleeping_body_num_);
+    EASY_VALUE("physics contact pairs",statistics_.contact_pair_num_);
+    EASY_VALUE("physics broadphase pairs",statistics_.broad_phase_pair_num_);
+    EASY_VALUE("physics simulate ms",statistics_.simulate_time_);
+}
+
+void Physics::set_async(bool async) {
+    if(async_==async){
+        return;
+    }
+    //关闭异步时取回正在进行的模拟，之后的同步模拟从这里继续。
+    if(async_ && simulating_ && px_scene_!=nullptr){
+        px_scene_->fetchResults(true);
+        SyncActiveActors();
+        simulation_event_callback_.DispatchEvents();
+        simulating_=false;
+    }
+    async_=async;
 }
 
 PxScene* Physics::CreatePxScene() {
@@ -74,14 +209,18 @@ PxScene* Physics::CreatePxScene() {
     //~zh 创建Physx Scene
     PxSceneDesc sceneDesc(px_physics_->getTolerancesScale());
     sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
-    px_cpu_dispatcher_ = PxDefaultCpuDispatcherCreate(2);
-    sceneDesc.cpuDispatcher	= px_cpu_dispatcher_;
+    //~zh PhysX任务在引擎任务系统的工作线程上执行，线程数按CPU核数。
+    //~en PhysX tasks run on the engine JobSystem workers, sized to the CPU core count.
+    sceneDesc.cpuDispatcher	= &physics_cpu_dispatcher_;
     //~en set physx event callback,such as trigger,collision,etc.
     //~zh 设置事件回调，用于接收物理事件，如Awake/Trigger等
     sceneDesc.simulationEventCallback = &simulation_event_callback_;
     //~zh 设置在碰撞发生时，Physx需要做的事情
     //~en Set the actions when collision occurs,Physx needs to do.
     sceneDesc.filterShader	= SimulationFilterShader;
+    //~zh 记录每次模拟移动过的Actor，只同步这些Actor的位姿。
+    //~en Record actors moved by each simulation, only these are synced to Transform.
+    sceneDesc.flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS;
     if(enable_ccd_){
         //~zh 启用CCD
         //~en Enable CCD
@@ -89,7 +228,7 @@ PxScene* Physics::CreatePxScene() {
     }
     PxScene* px_scene = px_physics_->createScene(sceneDesc);
     //~zh 设置PVD
-    PxPvdSceneClient* pvd_client = px_scene->getScenePvdClient();
+    PxPvdSceneClient* pvd_client = px_pvd_!=nullptr ? px_scene->getScenePvdClient() : nullptr;
     if(pvd_client)
     {
         pvd_client->setScenePvdFlag(PxPvdSceneFlag::eTRANSMIT_CONSTRAINTS, true);
@@ -6,14 +6,29 @@
 #define UNTITLED_PHYSICS_H
 
 #include <list>
+#include <chrono>
+#include <string>
 #include <glm/glm.hpp>
 #include <PxPhysicsAPI.h>
 #include "simulation_event_callback.h"
 #include "physic_error_call_back.h"
+#include "physics_cpu_dispatcher.h"
 #include "raycast_hit.h"
 
 using namespace physx;
 
+/// 物理统计，每个固定步长取回模拟结果后从PxSimulationStatistics更新。
+struct PhysicsStatistics{
+    unsigned int active_body_num_=0;//活动的动态刚体数量
+    unsigned int sleeping_body_num_=0;//休眠的动态刚体数量
+    unsigned int static_body_num_=0;
+    unsigned int contact_pair_num_=0;//有接触点的碰撞对
+    unsigned int broad_phase_pair_num_=0;//粗检测重叠、进入窄检测的碰撞对
+    unsigned int new_touch_num_=0;//本次模拟开始接触的碰撞对
+    unsigned int lost_touch_num_=0;//本次模拟结束接触的碰撞对
+    float simulate_time_=0;//调用simulate的时间(毫秒)
+    float fetch_time_=0;//取回结果等待的时间(毫秒)
+};
 
 // 物理模拟管理器
 class Physics {
@@ -21,13 +36,50 @@ public:
     /// 初始化
     static void Init();
 
-    /// 驱动物理模拟
+    /// 是否连接PVD(PhysX Visual Debugger)，默认不连接，需要在Init()之前设置。
+    /// 环境变量 PHYSICS_PVD=1/0 优先于这个设置，PHYSICS_PVD_HOST 指定PVD地址。
+    static bool pvd_enable(){return pvd_enable_;}
+    static void set_pvd_enable(bool pvd_enable){pvd_enable_=pvd_enable;}
+
+    static const std::string& pvd_host(){return pvd_host_;}
+    static void set_pvd_host(const std::string& pvd_host){pvd_host_=pvd_host;}
+
+    /// 是否已经连接上PVD
+    static bool pvd_connected(){return px_pvd_!=nullptr && px_pvd_->isConnected();}
+
+    /// 驱动物理模拟，在每个固定步长开始时调用。
+    /// 同步模式：模拟一个固定步长并等待结果。
+    /// 异步模式：取回上一次Simulate()启动的模拟结果，还没有完成时等待。
     static void FixedUpdate();
 
+    /// 异步模式下，在组件FixedUpdate之后启动下一个固定步长的模拟，和渲染并行，下一次FixedUpdate()时取回结果。
+    /// 模拟期间对场景的修改由PhysX缓存，射线检测返回模拟开始前的状态。同步模式下不做任何事。
+    static void Simulate();
+
+    /// 是否异步模拟
+    static bool async(){return async_;}
+    static void set_async(bool async);
+
+    /// 一个固定步长拆分成几次模拟，高速物体更稳定。异步模式下只有最后一次和渲染并行。
+    static unsigned int sub_step_num(){return sub_step_num_;}
+    static void set_sub_step_num(unsigned int sub_step_num){sub_step_num_=sub_step_num>0?sub_step_num:1;}
+
+    /// 上一次取回结果时等待模拟完成的时间(毫秒)
+    static float fetch_wait_time(){return fetch_wait_time_;}
+
+    /// 上一次异步模拟和主线程并行的时间(毫秒)，等待时间为0说明模拟完全被隐藏。
+    static float overlap_time(){return overlap_time_;}
+
+    /// 上一个固定步长的物理统计
+    static const PhysicsStatistics& statistics(){return statistics_;}
+
     /// 创建物理模拟的场景单元
     /// \return 创建的物理场景单元
     static PxScene* CreatePxScene();
 
+    /// 当前物理场景
+    static PxScene* px_scene(){return px_scene_;}
+
     static PxRigidDynamic* CreateRigidDynamic(const glm::vec3& pos,const char* name);
 
     static PxRigidStatic* CreateRigidStatic(const glm::vec3& pos,const char* name);
@@ -48,6 +100,13 @@ public:
     /// \param raycast_hit
     /// \return
     static bool RaycastSingle(glm::vec3& origin,glm::vec3& dir,float distance,RaycastHit* raycast_hit);
+private:
+    /// 把本次模拟移动过的Actor(getActiveActors)的位姿写入Transform，休眠的物体没有开销。
+    static void SyncActiveActors();
+
+    /// 从PxSimulationStatistics更新统计，并输出到profiler。
+    static void UpdateStatistics();
+
 private:
     static PxDefaultAllocator		px_allocator_;
     static PhysicErrorCallback	    physic_error_callback_;
@@ -56,11 +115,22 @@ private:
     static PxFoundation*			px_foundation_;
     static PxPhysics*				px_physics_;
 
-    static PxDefaultCpuDispatcher*	px_cpu_dispatcher_;
+    static PhysicsCpuDispatcher     physics_cpu_dispatcher_;//PhysX任务派发到引擎任务系统
     static PxScene*		            px_scene_;
-    static PxPvd*                   px_pvd_;
+    static PxPvd*                   px_pvd_;//不连接PVD时为nullptr
+    static bool                     pvd_enable_;
+    static std::string              pvd_host_;
 
     static bool                     enable_ccd_;//连续检测。
+
+    static bool                     async_;//异步模拟
+    static bool                     simulating_;//已经启动模拟，还没有取回结果。
+    static unsigned int             sub_step_num_;//每个固定步长的模拟次数
+    static std::chrono::steady_clock::time_point simulate_start_time_;//启动异步模拟的时间
+    static float                    fetch_wait_time_;
+    static float                    overlap_time_;
+    static float                    simulate_time_;//本次固定步长调用simulate的累计时间
+    static PhysicsStatistics        statistics_;
 };
 
 
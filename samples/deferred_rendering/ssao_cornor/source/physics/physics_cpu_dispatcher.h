@@ -0,0 +1,33 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#ifndef UNTITLED_PHYSICS_CPU_DISPATCHER_H
+#define UNTITLED_PHYSICS_CPU_DISPATCHER_H
+
+#include <PxPhysicsAPI.h>
+#include "utils/job_system.h"
+
+using namespace physx;
+
+//~en PhysicsCpuDispatcher feeds PhysX tasks into the engine JobSystem, so physics shares worker threads with the rest of the engine.
+//~zh PhysicsCpuDispatcher 把PhysX的任务派发到引擎的任务系统，物理和引擎其它并行任务共用工作线程，不再单独创建线程。
+class PhysicsCpuDispatcher: public PxCpuDispatcher {
+public:
+    void submitTask(PxBaseTask& task) override {
+        //PhysX通过任务的release()通知依赖的任务，不需要等待任务组。
+        JobSystem::Dispatch(job_group_,[&task](){
+            task.run();
+            task.release();
+        });
+    }
+
+    uint32_t getWorkerCount() const override {
+        return JobSystem::worker_num();
+    }
+
+private:
+    JobGroup job_group_;
+};
+
+#endif //UNTITLED_PHYSICS_CPU_DISPATCHER_H
@@ -4,6 +4,8 @@
 
 #include "rigid_dynamic.h"
 #include <rttr/registration>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/euler_angles.hpp>
 #include "physics.h"
 #include "component/game_object.h"
 #include "component/transform.h"
@@ -16,11 +18,15 @@ RTTR_REGISTRATION{
             .constructor<>()(rttr::policy::ctor::as_raw_ptr);
 }
 
-RigidDynamic::RigidDynamic():enable_ccd_(false){
+RigidDynamic::RigidDynamic():enable_ccd_(false),transform_(nullptr){
 
 }
 
 RigidDynamic::~RigidDynamic(){
+    //Actor的userData指向组件，组件销毁后不再同步。
+    if(px_rigid_actor_!= nullptr){
+        px_rigid_actor_->userData=nullptr;
+    }
 
 }
 
@@ -35,6 +41,13 @@ void RigidDynamic::Awake() {
     Transform* transform=game_object()->GetComponent<Transform>();
     PxRigidDynamic* px_rigid_dynamic=Physics::CreateRigidDynamic(transform->position(), game_object()->name());
     px_rigid_actor_=dynamic_cast<PxRigidActor*>(px_rigid_dynamic);
+    //初始旋转也交给PhysX，否则第一次同步位姿时Transform的旋转会被覆盖。
+    glm::vec3 rotation=glm::radians(transform->rotation());
+    glm::quat quat=glm::quat_cast(glm::eulerAngleYXZ(rotation.y,rotation.x,rotation.z));
+    px_rigid_dynamic->setGlobalPose(PxTransform(px_rigid_dynamic->getGlobalPose().p,PxQuat(quat.x,quat.y,quat.z,quat.w)));
+    //Physics从活动Actor列表通过userData找到组件
+    px_rigid_actor_->userData=this;
+    transform_=transform;
     RigidActor::Awake();
 }
 
@@ -42,13 +55,16 @@ void RigidDynamic::Update() {
 
 }
 
-void RigidDynamic::FixedUpdate() {
-    if(px_rigid_actor_ == nullptr){
-        DEBUG_LOG_ERROR("px_rigid_actor_== nullptr");
+void RigidDynamic::SyncTransform(const PxTransform& px_transform) {
+    if(transform_ == nullptr){
         return;
     }
-    //PxRigidBody受Physx物理模拟驱动，位置被改变。获取最新的位置，去更新Transform。
-    PxTransform px_transform=px_rigid_actor_->getGlobalPose();
-    Transform* transform=game_object()->GetComponent<Transform>();
-    transform->set_local_position(glm::vec3(px_transform.p.x,px_transform.p.y,px_transform.p.z));
+    //PxRigidBody受Physx物理模拟驱动，位置被改变。用最新的位姿去更新Transform。
+    transform_->set_local_position(glm::vec3(px_transform.p.x,px_transform.p.y,px_transform.p.z));
+    //四元数转成和渲染一致的YXZ顺序欧拉角(角度)，R=Ry*Rx*Rz。
+    glm::mat3 rotation=glm::mat3_cast(glm::quat(px_transform.q.w,px_transform.q.x,px_transform.q.y,px_transform.q.z));
+    float x=asinf(glm::clamp(-rotation[2][1],-1.0f,1.0f));
+    float y=atan2f(rotation[2][0],rotation[2][2]);
+    float z=atan2f(rotation[0][1],rotation[1][1]);
+    transform_->set_local_rotation(glm::degrees(glm::vec3(x,y,z)));
 }
\ No newline at end of file
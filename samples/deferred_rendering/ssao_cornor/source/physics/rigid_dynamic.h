@@ -8,6 +8,7 @@
 #include "rigid_actor.h"
 
 class Collider;
+class Transform;
 class RigidDynamic : public RigidActor{
 public:
     RigidDynamic();
@@ -27,10 +28,13 @@ public:
 
     void Update() override;
 
-    void FixedUpdate() override;
+    /// 物理模拟改变了位置和旋转，写入Transform。只由Physics遍历本次模拟移动过的Actor调用，休眠的物体不会调用。
+    /// \param px_transform PxRigidDynamic的世界位姿
+    void SyncTransform(const PxTransform& px_transform);
 
 private:
     bool enable_ccd_;
+    Transform* transform_;//Awake时缓存，同步位姿不用每次查找组件。
 
 RTTR_ENABLE(RigidActor)
 };
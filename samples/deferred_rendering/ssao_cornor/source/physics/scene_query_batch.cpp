@@ -0,0 +1,166 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "scene_query_batch.h"
+#include <algorithm>
+#include "easy/profiler.h"
+#include "physics.h"
+#include "utils/job_system.h"
+
+#define SCENE_QUERY_JOB_BATCH_SIZE 16 //每个任务执行的检测数量
+#define SCENE_QUERY_TOUCH_NUM 64 //PhysX击中结果缓冲区大小，排序后只保留最近的max_hit_num个。
+
+SceneQueryBatch::SceneQueryBatch(unsigned int max_query_num, unsigned int max_hit_num):max_query_num_(max_query_num),max_hit_num_(std::max(max_hit_num,1u)) {
+    query_vec_.reserve(max_query_num_);
+    hit_num_vec_.reserve(max_query_num_);
+    hit_vec_.resize(max_query_num_*max_hit_num_);
+}
+
+void SceneQueryBatch::Clear() {
+    query_vec_.clear();
+    hit_num_vec_.clear();
+}
+
+int SceneQueryBatch::AddQuery(const Query& query) {
+    if(query_vec_.size()>=max_query_num_){
+        return -1;
+    }
+    query_vec_.push_back(query);
+    return (int)query_vec_.size()-1;
+}
+
+int SceneQueryBatch::AddRaycast(const glm::vec3& origin, const glm::vec3& dir, float distance) {
+    return AddQuery({QueryType::RAYCAST,false,origin,dir,distance,glm::vec3(0)});
+}
+
+int SceneQueryBatch::AddSphereSweep(const glm::vec3& origin, float radius, const glm::vec3& dir, float distance) {
+    return AddQuery({QueryType::SWEEP,false,origin,dir,distance,glm::vec3(radius)});
+}
+
+int SceneQueryBatch::AddBoxSweep(const glm::vec3& origin, const glm::vec3& half_extents, const glm::vec3& dir, float distance) {
+    return AddQuery({QueryType::SWEEP,true,origin,dir,distance,half_extents});
+}
+
+int SceneQueryBatch::AddSphereOverlap(const glm::vec3& center, float radius) {
+    return AddQuery({QueryType::OVERLAP,false,center,glm::vec3(0),0,glm::vec3(radius)});
+}
+
+int SceneQueryBatch::AddBoxOverlap(const glm::vec3& center, const glm::vec3& half_extents) {
+    return AddQuery({QueryType::OVERLAP,true,center,glm::vec3(0),0,half_extents});
+}
+
+void SceneQueryBatch::AddRaycasts(const std::vector<float>& rays) {
+    for (size_t i = 0; i+7 <= rays.size(); i+=7) {
+        AddRaycast(glm::vec3(rays[i],rays[i+1],rays[i+2]),glm::vec3(rays[i+3],rays[i+4],rays[i+5]),rays[i+6]);
+    }
+}
+
+void SceneQueryBatch::AddSphereSweeps(const std::vector<float>& sweeps) {
+    for (size_t i = 0; i+8 <= sweeps.size(); i+=8) {
+        AddSphereSweep(glm::vec3(sweeps[i],sweeps[i+1],sweeps[i+2]),sweeps[i+3],glm::vec3(sweeps[i+4],sweeps[i+5],sweeps[i+6]),sweeps[i+7]);
+    }
+}
+
+void SceneQueryBatch::AddSphereOverlaps(const std::vector<float>& overlaps) {
+    for (size_t i = 0; i+4 <= overlaps.size(); i+=4) {
+        AddSphereOverlap(glm::vec3(overlaps[i],overlaps[i+1],overlaps[i+2]),overlaps[i+3]);
+    }
+}
+
+unsigned int SceneQueryBatch::Execute() {
+    EASY_FUNCTION();
+    hit_num_vec_.assign(query_vec_.size(),0);
+    if(Physics::px_scene()== nullptr){
+        return 0;
+    }
+    //场景检测只读场景，多个线程可以同时执行，异步物理模拟期间检测的是模拟开始前的状态。
+    JobSystem::ParallelForBatch((int)query_vec_.size(),SCENE_QUERY_JOB_BATCH_SIZE,[this](int begin,int end){
+        for (int i = begin; i < end; ++i) {
+            RunQuery(i);
+        }
+    });
+    unsigned int total_hit_num=0;
+    for (auto hit_num : hit_num_vec_) {
+        total_hit_num+=hit_num;
+    }
+    return total_hit_num;
+}
+
+/// 把PhysX的击中结果按距离排序，写入缓冲区。
+template<typename T>
+static unsigned int CopyHits(T* touches,unsigned int touch_num,SceneQueryHit* hits,unsigned int max_hit_num){
+    std::sort(touches,touches+touch_num,[](const T& a,const T& b){
+        return a.distance<b.distance;
+    });
+    unsigned int hit_num=std::min(touch_num,max_hit_num);
+    for (unsigned int i = 0; i < hit_num; ++i) {
+        const T& touch=touches[i];
+        hits[i].position_=glm::vec3(touch.position.x,touch.position.y,touch.position.z);
+        hits[i].normal_=glm::vec3(touch.normal.x,touch.normal.y,touch.normal.z);
+        hits[i].distance_=touch.distance;
+        hits[i].game_object_=static_cast<GameObject*>(touch.shape->userData);
+    }
+    return hit_num;
+}
+
+void SceneQueryBatch::RunQuery(unsigned int query_index) {
+    PxScene* px_scene=Physics::px_scene();
+    Query& query=query_vec_[query_index];
+    SceneQueryHit* hits=&hit_vec_[query_index*max_hit_num_];
+    PxVec3 origin(query.origin_.x,query.origin_.y,query.origin_.z);
+    //eNO_BLOCK：所有击中都作为touch返回，得到多个结果。
+    PxQueryFilterData filter_data(PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::eNO_BLOCK);
+    PxHitFlags hit_flags=PxHitFlag::ePOSITION|PxHitFlag::eNORMAL;
+    //每个线程复用自己的PhysX结果缓冲区
+    unsigned int touch_num=std::max(max_hit_num_,(unsigned int)SCENE_QUERY_TOUCH_NUM);
+
+    //检测序号在任务之间不重叠，各自写自己的结果。
+    switch (query.type_) {
+        case QueryType::RAYCAST:{
+            glm::vec3 dir=glm::normalize(query.dir_);
+            static thread_local std::vector<PxRaycastHit> touches;
+            touches.resize(touch_num);
+            PxRaycastBuffer buffer(touches.data(),touch_num);
+            px_scene->raycast(origin,PxVec3(dir.x,dir.y,dir.z),query.distance_,buffer,hit_flags,filter_data);
+            hit_num_vec_[query_index]=CopyHits(touches.data(),buffer.nbTouches,hits,max_hit_num_);
+            break;
+        }
+        case QueryType::SWEEP:{
+            glm::vec3 dir=glm::normalize(query.dir_);
+            static thread_local std::vector<PxSweepHit> touches;
+            touches.resize(touch_num);
+            PxSweepBuffer buffer(touches.data(),touch_num);
+            PxTransform pose(origin);
+            PxVec3 px_dir(dir.x,dir.y,dir.z);
+            if(query.box_){
+                px_scene->sweep(PxBoxGeometry(query.half_extents_.x,query.half_extents_.y,query.half_extents_.z),pose,px_dir,query.distance_,buffer,hit_flags,filter_data);
+            }else{
+                px_scene->sweep(PxSphereGeometry(query.half_extents_.x),pose,px_dir,query.distance_,buffer,hit_flags,filter_data);
+            }
+            hit_num_vec_[query_index]=CopyHits(touches.data(),buffer.nbTouches,hits,max_hit_num_);
+            break;
+        }
+        case QueryType::OVERLAP:{
+            static thread_local std::vector<PxOverlapHit> touches;
+            touches.resize(touch_num);
+            PxOverlapBuffer buffer(touches.data(),touch_num);
+            PxTransform pose(origin);
+            if(query.box_){
+                px_scene->overlap(PxBoxGeometry(query.half_extents_.x,query.half_extents_.y,query.half_extents_.z),pose,buffer,filter_data);
+            }else{
+                px_scene->overlap(PxSphereGeometry(query.half_extents_.x),pose,buffer,filter_data);
+            }
+            //重叠检测没有位置、法线、距离。
+            unsigned int hit_num=std::min(buffer.nbTouches,max_hit_num_);
+            for (unsigned int i = 0; i < hit_num; ++i) {
+                hits[i].position_=query.origin_;
+                hits[i].normal_=glm::vec3(0);
+                hits[i].distance_=0;
+                hits[i].game_object_=static_cast<GameObject*>(buffer.touches[i].shape->userData);
+            }
+            hit_num_vec_[query_index]=hit_num;
+            break;
+        }
+    }
+}
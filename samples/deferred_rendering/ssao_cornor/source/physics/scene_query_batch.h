@@ -0,0 +1,110 @@
+//
+// Created by captainchen on 2026/10/19.
+// 批量场景检测：一次提交很多射线、扫掠、重叠检测，在任务系统上并行执行，
+// 每个检测返回多个击中结果(位置、法线、距离、物体)，结果写入预先分配好的缓冲区。
+// Lua每批只需要调用一次提交、一次执行、一次读取结果。
+//
+
+#ifndef UNTITLED_SCENE_QUERY_BATCH_H
+#define UNTITLED_SCENE_QUERY_BATCH_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+class GameObject;
+
+/// 一个击中结果
+struct SceneQueryHit{
+    glm::vec3 position_;//击中位置，重叠检测没有位置，是检测中心。
+    glm::vec3 normal_;//击中表面法线，重叠检测为0。
+    float distance_;//从起点到击中位置的距离，重叠检测为0。
+    GameObject* game_object_;//击中的物体
+};
+
+class SceneQueryBatch {
+public:
+    /// \param max_query_num 一批最多多少个检测
+    /// \param max_hit_num 每个检测最多记录多少个击中结果，超出的按距离丢弃。
+    SceneQueryBatch(unsigned int max_query_num,unsigned int max_hit_num);
+    ~SceneQueryBatch(){}
+
+    /// 清空已经提交的检测，缓冲区保留。
+    void Clear();
+
+    /// 射线检测
+    /// \return 检测序号，超出max_query_num时返回-1。
+    int AddRaycast(const glm::vec3& origin,const glm::vec3& dir,float distance);
+
+    /// 球体扫掠检测
+    int AddSphereSweep(const glm::vec3& origin,float radius,const glm::vec3& dir,float distance);
+
+    /// 盒子扫掠检测，不旋转。
+    int AddBoxSweep(const glm::vec3& origin,const glm::vec3& half_extents,const glm::vec3& dir,float distance);
+
+    /// 球体重叠检测
+    int AddSphereOverlap(const glm::vec3& center,float radius);
+
+    /// 盒子重叠检测，不旋转。
+    int AddBoxOverlap(const glm::vec3& center,const glm::vec3& half_extents);
+
+    /// 批量提交射线检测，每7个数一个：起点xyz、方向xyz、距离。
+    void AddRaycasts(const std::vector<float>& rays);
+
+    /// 批量提交球体扫掠检测，每8个数一个：起点xyz、半径、方向xyz、距离。
+    void AddSphereSweeps(const std::vector<float>& sweeps);
+
+    /// 批量提交球体重叠检测，每4个数一个：中心xyz、半径。
+    void AddSphereOverlaps(const std::vector<float>& overlaps);
+
+    /// 并行执行所有检测，结果按距离从近到远排序。
+    /// \return 所有检测的击中结果总数
+    unsigned int Execute();
+
+    unsigned int query_num(){return (unsigned int)query_vec_.size();}
+
+    unsigned int max_hit_num(){return max_hit_num_;}
+
+    /// 指定检测的击中结果数量
+    unsigned int hit_num(unsigned int query_index){return query_index<hit_num_vec_.size()?hit_num_vec_[query_index]:0;}
+
+    /// 指定检测的第hit_index个击中结果
+    SceneQueryHit& hit(unsigned int query_index,unsigned int hit_index){return hit_vec_[query_index*max_hit_num_+hit_index];}
+
+    /// 每个检测的击中结果数量，下标是检测序号。
+    std::vector<unsigned int>& hit_num_vec(){return hit_num_vec_;}
+
+    /// 所有击中结果，第i个检测的结果从 i*max_hit_num 开始。
+    std::vector<SceneQueryHit>& hit_vec(){return hit_vec_;}
+
+private:
+    enum class QueryType{
+        RAYCAST,
+        SWEEP,
+        OVERLAP
+    };
+
+    /// 一个检测
+    struct Query{
+        QueryType type_;
+        bool box_;//扫掠、重叠检测的形状，true:盒子 false:球体
+        glm::vec3 origin_;
+        glm::vec3 dir_;
+        float distance_;
+        glm::vec3 half_extents_;//盒子半尺寸，球体时x是半径。
+    };
+
+    int AddQuery(const Query& query);
+
+    /// 执行一个检测，结果写入缓冲区。
+    void RunQuery(unsigned int query_index);
+
+private:
+    unsigned int max_query_num_;
+    unsigned int max_hit_num_;
+    std::vector<Query> query_vec_;
+    std::vector<unsigned int> hit_num_vec_;
+    std::vector<SceneQueryHit> hit_vec_;//max_query_num*max_hit_num，构造时分配。
+};
+
+
+#endif //UNTITLED_SCENE_QUERY_BATCH_H
@@ -0,0 +1,118 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "simulation_event_callback.h"
+#include <algorithm>
+#include "easy/profiler.h"
+#include "component/game_object.h"
+
+#define SIMULATION_EVENT_RESERVE_NUM 256 //事件缓冲区预留大小
+
+SimulationEventCallback::SimulationEventCallback():dispatch_event_num_(0) {
+    event_vec_.reserve(SIMULATION_EVENT_RESERVE_NUM);
+    dispatch_event_vec_.reserve(SIMULATION_EVENT_RESERVE_NUM);
+}
+
+void SimulationEventCallback::onTrigger(PxTriggerPair* pairs, PxU32 count) {
+    //~zh 设置了eTRIGGER_SHAPE的Shape走这里
+    //~en Shapes with eTRIGGER_SHAPE flag are reported here.
+    for (PxU32 i = 0; i < count; ++i) {
+        const PxTriggerPair& pair=pairs[i];
+        if(pair.flags & (PxTriggerPairFlag::eREMOVED_SHAPE_TRIGGER|PxTriggerPairFlag::eREMOVED_SHAPE_OTHER)){
+            continue;
+        }
+        if(pair.status & PxPairFlag::eNOTIFY_TOUCH_FOUND){
+            AddEvent(pair.triggerShape,pair.otherShape,EventType::TRIGGER_ENTER);
+        }
+        if(pair.status & PxPairFlag::eNOTIFY_TOUCH_LOST){
+            AddEvent(pair.triggerShape,pair.otherShape,EventType::TRIGGER_EXIT);
+        }
+    }
+}
+
+void SimulationEventCallback::onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 count) {
+    for (PxU32 i = 0; i < count; ++i) {
+        const PxContactPair& current=pairs[i];
+        if(current.flags & (PxContactPairFlag::eREMOVED_SHAPE_0|PxContactPairFlag::eREMOVED_SHAPE_1)){
+            continue;
+        }
+        for (int j = 0; j < 2; ++j) {
+            PxShape* shape=current.shapes[j];
+            PxShape* another_shape=current.shapes[j^1];
+            //~zh 判断Shape附加数据为1表示Trigger。
+            //~en If the shape's user data is 1, it is a trigger.
+            bool is_trigger=shape->getSimulationFilterData().word0 & 0x1;
+            if (!is_trigger){
+                continue;
+            }
+            //通知相交的另外一个物体进入、离开
+            if(current.events & (PxPairFlag::eNOTIFY_TOUCH_FOUND|PxPairFlag::eNOTIFY_TOUCH_CCD)) {
+                AddEvent(shape,another_shape,EventType::TRIGGER_ENTER);
+            }
+            if(current.events & (PxPairFlag::eNOTIFY_TOUCH_LOST)) {
+                AddEvent(shape,another_shape,EventType::TRIGGER_EXIT);
+            }
+        }
+    }
+}
+
+void SimulationEventCallback::AddEvent(PxShape* trigger_shape, PxShape* other_shape, EventType type) {
+    GameObject* trigger_game_object=static_cast<GameObject*>(trigger_shape->userData);
+    GameObject* other_game_object=static_cast<GameObject*>(other_shape->userData);
+    if(trigger_game_object== nullptr || other_game_object== nullptr){
+        return;
+    }
+    //没有组件处理触发事件的物体不记录
+    if(other_game_object->trigger_event_interest()==false){
+        return;
+    }
+    event_vec_.push_back({trigger_game_object->id(),other_game_object->id(),(unsigned int)event_vec_.size(),type});
+}
+
+void SimulationEventCallback::DispatchEvents() {
+    dispatch_event_num_=0;
+    if(event_vec_.empty()){
+        return;
+    }
+    EASY_FUNCTION();
+    //交换缓冲区，派发期间新记录的事件留到下一次。
+    dispatch_event_vec_.swap(event_vec_);
+    event_vec_.clear();
+
+    //同一对物体按记录顺序排列，只去掉和前一个事件类型相同的重复事件，例如CCD和普通检测同时报告进入。
+    //进入、离开、进入这样的状态变化全部保留，最后的状态和物理一致。
+    std::sort(dispatch_event_vec_.begin(),dispatch_event_vec_.end(),[](const Event& a,const Event& b){
+        if(a.trigger_id_!=b.trigger_id_) return a.trigger_id_<b.trigger_id_;
+        if(a.other_id_!=b.other_id_) return a.other_id_<b.other_id_;
+        return a.sequence_<b.sequence_;
+    });
+    auto last=std::unique(dispatch_event_vec_.begin(),dispatch_event_vec_.end(),[](const Event& a,const Event& b){
+        return a.trigger_id_==b.trigger_id_ && a.other_id_==b.other_id_ && a.type_==b.type_;
+    });
+    dispatch_event_vec_.erase(last,dispatch_event_vec_.end());
+    std::sort(dispatch_event_vec_.begin(),dispatch_event_vec_.end(),[](const Event& a,const Event& b){
+        return a.sequence_<b.sequence_;
+    });
+
+    for (auto& event : dispatch_event_vec_) {
+        //派发前面的事件时物体可能被销毁
+        GameObject* trigger_game_object=GameObject::FindById(event.trigger_id_);
+        GameObject* other_game_object=GameObject::FindById(event.other_id_);
+        if(trigger_game_object== nullptr || other_game_object== nullptr || other_game_object->active()==false){
+            continue;
+        }
+        other_game_object->ForeachComponent([&event,trigger_game_object](Component* component){
+            if(component->trigger_event_interest()==false){
+                return;
+            }
+            if(event.type_==EventType::TRIGGER_ENTER){
+                component->OnTriggerEnter(trigger_game_object);
+            }else{
+                component->OnTriggerExit(trigger_game_object);
+            }
+        });
+        dispatch_event_num_++;
+    }
+    dispatch_event_vec_.clear();
+}
@@ -5,85 +5,59 @@
 #ifndef UNTITLED_SIMULATIONEVENTCALLBACK_H
 #define UNTITLED_SIMULATIONEVENTCALLBACK_H
 
+#include <vector>
 #include "PxPhysicsAPI.h"
-#include "component/game_object.h"
-#include "utils/debug.h"
 
 using namespace physx;
 
 //~en SimulationEventCallback is a PxSimulationEventCallback that is used to receive events from the PhysX SDK.
 //~zh SimulationEventCallback 是一个用于从 PhysX SDK 接收事件的 PxSimulationEventCallback。
+//~zh 回调发生在fetchResults内部，这里只记录事件(两个GameObject编号和事件类型)，fetchResults之后再派发给组件。
+//~en Callbacks run inside fetchResults, events are only recorded here and dispatched to components after fetchResults.
 class SimulationEventCallback: public PxSimulationEventCallback {
 public:
-    void onConstraintBreak(PxConstraintInfo* constraints, PxU32 count) override {
-        DEBUG_LOG_INFO("onConstraintBreak");
-    }
-
-    void onWake(PxActor** actors, PxU32 count) override {
-        DEBUG_LOG_INFO("onWake");
-    }
-
-    void onSleep(PxActor** actors, PxU32 count) override {
-        DEBUG_LOG_INFO("onSleep");
-    }
-
-    void onTrigger(PxTriggerPair* pairs, PxU32 count) override {
-		DEBUG_LOG_INFO("onTrigger: {} trigger pairs", count);
-        while(count--)
-        {
-            const PxTriggerPair& current = *pairs++;
-            if(current.status & PxPairFlag::eNOTIFY_TOUCH_FOUND) {
-                DEBUG_LOG_INFO("Shape is entering trigger volume");
-            }
-            if(current.status & PxPairFlag::eNOTIFY_TOUCH_LOST){
-                DEBUG_LOG_INFO("Shape is leaving trigger volume");
-            }
-        }
-    }
-
-    void onAdvance(const PxRigidBody*const*, const PxTransform*, const PxU32) override {
-        DEBUG_LOG_INFO("onAdvance");
-    }
-
-    void onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 count) override {
-//		DEBUG_LOG_INFO("onContact: {} pairs", count);
-        while(count--) {
-            const PxContactPair& current = *pairs++;
-
-            for (int i = 0; i < 2; ++i) {
-                PxShape* shape=current.shapes[i];
-                PxShape* another_shape=current.shapes[i^1];
-                //~zh 判断Shape附加数据为1表示Trigger。
-                //~en If the shape's user data is 1, it is a trigger.
-                bool is_trigger=shape->getSimulationFilterData().word0 & 0x1;
-                if (!is_trigger){
-                    continue;
-                }
-                GameObject* gameObject= static_cast<GameObject *>(shape->userData);
-//                DEBUG_LOG_INFO("Shape is a trigger,gameObject:{}", gameObject->name());
-                GameObject* another_game_object= static_cast<GameObject *>(another_shape->userData);
-                if(another_game_object->active()==false){
-                    continue;
-                }
-
-                if(current.events & (PxPairFlag::eNOTIFY_TOUCH_FOUND|PxPairFlag::eNOTIFY_TOUCH_CCD)) {
-//                    DEBUG_LOG_INFO("onContact Shape is entering volume");
-                    //通知相交的另外一个物体进入
-                    another_game_object->ForeachComponent([gameObject](Component* component){
-                        component->OnTriggerEnter(gameObject);
-                    });
-                }
-
-                if(current.events & (PxPairFlag::eNOTIFY_TOUCH_LOST)) {
-//                    DEBUG_LOG_INFO("onContact Shape is leaving volume");
-                    //通知相交的另外一个物体离开
-                    another_game_object->ForeachComponent([gameObject](Component* component){
-                        component->OnTriggerExit(gameObject);
-                    });
-                }
-            }
-        }
-    }
+    SimulationEventCallback();
+
+    void onConstraintBreak(PxConstraintInfo* constraints, PxU32 count) override {}
+
+    void onWake(PxActor** actors, PxU32 count) override {}
+
+    void onSleep(PxActor** actors, PxU32 count) override {}
+
+    void onTrigger(PxTriggerPair* pairs, PxU32 count) override;
+
+    void onAdvance(const PxRigidBody*const*, const PxTransform*, const PxU32) override {}
+
+    void onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 count) override;
+
+    /// 派发记录的事件，同一对物体同一类型的事件只派发一次，物体已经销毁或者没有激活时跳过。
+    /// 在fetchResults之后调用，这时组件可以修改物理场景。
+    void DispatchEvents();
+
+    /// 上一次派发的事件数量
+    unsigned int dispatch_event_num(){return dispatch_event_num_;}
+
+private:
+    enum class EventType:unsigned char{
+        TRIGGER_ENTER,
+        TRIGGER_EXIT
+    };
+
+    /// 一个事件：other物体的组件收到trigger物体的触发事件。
+    struct Event{
+        unsigned int trigger_id_;
+        unsigned int other_id_;
+        unsigned int sequence_;//记录顺序，去重后按原顺序派发。
+        EventType type_;
+    };
+
+    /// 记录事件，other物体没有组件处理触发事件时不记录。
+    void AddEvent(PxShape* trigger_shape,PxShape* other_shape,EventType type);
+
+private:
+    std::vector<Event> event_vec_;//本次模拟记录的事件
+    std::vector<Event> dispatch_event_vec_;//正在派发的事件，和event_vec_交换，不重新分配内存。
+    unsigned int dispatch_event_num_;
 };
 
 
@@ -15,5 +15,6 @@ std::unordered_map<unsigned int, GLuint> GPUResourceMapper::shader_program_map_;
 std::unordered_map<unsigned int, GLuint> GPUResourceMapper::vao_map_;//VAO映射表
 std::unordered_map<unsigned int, GLuint> GPUResourceMapper::vbo_map_;//VBO映射表
 std::unordered_map<unsigned int, GLuint> GPUResourceMapper::texture_map_;//Texture映射表
+std::unordered_map<unsigned int, GLenum> GPUResourceMapper::texture_target_map_;//不是GL_TEXTURE_2D的纹理类型
 std::unordered_map<unsigned int, GLuint> GPUResourceMapper::ubo_map_;//UBO映射表
 std::unordered_map<unsigned int, GLuint> GPUResourceMapper::fbo_map_;//FBO映射表
@@ -54,6 +54,16 @@ public:
         vbo_map_[vbo_handle] = vbo_id;
     }
 
+    /// 删除VAO映射
+    static void UnMapVAO(unsigned int vao_handle){
+        vao_map_.erase(vao_handle);
+    }
+
+    /// 删除VBO映射
+    static void UnMapVBO(unsigned int vbo_handle){
+        vbo_map_.erase(vbo_handle);
+    }
+
     /// 映射Texture
     static void MapTexture(unsigned int texture_handle, GLuint texture_id){
         texture_map_[texture_handle] = texture_id;
@@ -84,6 +94,15 @@ public:
     static GLuint GetTexture(unsigned int texture_handle){
         return texture_map_[texture_handle];
     }
+    /// 记录不是GL_TEXTURE_2D的纹理类型，例如纹理数组。
+    static void MapTextureTarget(unsigned int texture_handle, GLenum texture_target){
+        texture_target_map_[texture_handle] = texture_target;
+    }
+    /// 获取纹理类型，绑定纹理时使用。
+    static GLenum GetTextureTarget(unsigned int texture_handle){
+        auto iter=texture_target_map_.find(texture_handle);
+        return iter==texture_target_map_.end()?GL_TEXTURE_2D:iter->second;
+    }
 
     /// 生成UBO句柄
     static unsigned int GenerateUBOHandle(){
@@ -134,6 +153,7 @@ private:
     static std::unordered_map<unsigned int, GLuint> vao_map_;//VAO映射表
     static std::unordered_map<unsigned int, GLuint> vbo_map_;//VBO映射表
     static std::unordered_map<unsigned int, GLuint> texture_map_;//Texture映射表
+    static std::unordered_map<unsigned int, GLenum> texture_target_map_;//不是GL_TEXTURE_2D的纹理类型
     static std::unordered_map<unsigned int, GLuint> ubo_map_;//UBO映射表
     static std::unordered_map<unsigned int, GLuint> fbo_map_;//FBO映射表
 };
@@ -15,6 +15,7 @@ enum RenderCommand {
     USE_SHADER_PROGRAM,//使用着色器程序
     CREATE_VAO,//创建VAO
     UPDATE_VBO_SUB_DATA,//更新VBO数据
+    DELETE_VAO,//删除VAO及其VBO、EBO
     CREATE_UBO,//创建UBO
     UPDATE_UBO_SUB_DATA,//更新UBO数据
     CREATE_COMPRESSED_TEX_IMAGE2D,//创建压缩纹理
@@ -33,12 +34,17 @@ enum RenderCommand {
     SET_STENCIL_FUNC,//设置模板测试函数
     SET_STENCIL_OP,//设置模板操作
     SET_STENCIL_BUFFER_CLEAR_VALUE,//设置清除模板缓冲值
+    SET_COLOR_MASK,//设置是否写入颜色缓冲
+    SET_SCISSOR,//设置裁剪矩形
     CREATE_FBO,//创建帧缓冲区对象(FBO)
     BIND_FBO,//绑定使用帧缓冲区对象(FBO)
     UNBIND_FBO,//取消使用帧缓冲区对象(FBO)
     DELETE_FBO,//删除帧缓冲区对象(FBO)
     CREATE_GEOMETRY_BUFFER,//创建GBuffer
     BIND_GEOMETRY_BUFFER,//绑定使用几何缓冲区(GBuffer)
+    ALIAS_RENDER_TEXTURE,//RenderTexture的FBO和纹理句柄映射到另一个RenderTexture的GPU资源
+    CREATE_DEPTH_TEXTURE_ARRAY,//创建深度纹理数组
+    CREATE_DEPTH_FBO,//创建只有深度附着点的FBO，附着深度纹理数组的一层
     CREATE_RBO,//创建RBO
     DELETE_RBO,//删除RBO
     FBO_ATTACH_RBO,//FBO附着点指定RBO
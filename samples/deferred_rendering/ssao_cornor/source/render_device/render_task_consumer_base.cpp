@@ -4,6 +4,7 @@
 
 #include "render_task_consumer_base.h"
 #include <iostream>
+#include <algorithm>
 #include <glm/gtc/matrix_transform.hpp>
 #include "timetool/stopwatch.h"
 #include "utils/debug.h"
@@ -14,6 +15,8 @@
 #include "utils/screen.h"
 #include "render_device/uniform_buffer_object_manager.h"
 
+#define GBUFFER_MAX_COLOR_ATTACHMENT_NUM 6
+
 void RenderTaskConsumerBase::Init() {
     render_thread_ = std::thread(&RenderTaskConsumerBase::ProcessTask,this);
     render_thread_.detach();
@@ -150,13 +153,22 @@ void RenderTaskConsumerBase::CreateCompressedTexImage2D(RenderTaskBase *task_bas
     //2. 将纹理绑定到特定纹理目标;
     glBindTexture(GL_TEXTURE_2D, texture_id);__CHECK_GL_ERROR__
 
-    //3. 将压缩纹理数据上传到GPU;
-    glCompressedTexImage2D(GL_TEXTURE_2D, 0, task->texture_format_, task->width_, task->height_, 0, task->compress_size_, task->data_);
-    __CHECK_GL_ERROR__
+    //3. 将压缩纹理数据上传到GPU，依次上传每一级mipmap;
+    unsigned char* data=task->data_;
+    for (int i = 0; i < task->mipmap_num_; ++i) {
+        int width=std::max(task->width_>>i,1);
+        int height=std::max(task->height_>>i,1);
+        glCompressedTexImage2D(GL_TEXTURE_2D, i, task->texture_format_, width, height, 0, task->mipmap_compress_size_[i], data);
+        __CHECK_GL_ERROR__
+        data+=task->mipmap_compress_size_[i];
+    }
+    //最大级别设为实际上传的级别，cpt中的mipmap不一定到1x1，否则纹理不完整。
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);__CHECK_GL_ERROR__
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, task->mipmap_num_-1);__CHECK_GL_ERROR__
 
-    //4. 指定放大，缩小滤波方式，线性滤波，即放大缩小的插值方式;
+    //4. 指定放大，缩小滤波方式，线性滤波，即放大缩小的插值方式;有mipmap时缩小使用三线性过滤。
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);__CHECK_GL_ERROR__
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);__CHECK_GL_ERROR__
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, task->mipmap_num_>1?GL_LINEAR_MIPMAP_LINEAR:GL_LINEAR);__CHECK_GL_ERROR__
 
     //将主线程中产生的压缩纹理句柄 映射到 纹理
     GPUResourceMapper::MapTexture(task->texture_handle_, texture_id);
@@ -173,7 +185,8 @@ void RenderTaskConsumerBase::CreateTexImage2D(RenderTaskBase *task_base) {
     //2. 将纹理绑定到特定纹理目标;
     glBindTexture(GL_TEXTURE_2D, texture_id);__CHECK_GL_ERROR__
 
-    //3. 将图片rgb数据上传到GPU;
+    //3. 将图片rgb数据上传到GPU; 图像数据每行紧密排列，和Texture2D::Create检查的大小一致。
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);__CHECK_GL_ERROR__
     glTexImage2D(GL_TEXTURE_2D, 0, task->gl_texture_format_, task->width_, task->height_, 0, task->client_format_, task->data_type_, task->data_);__CHECK_GL_ERROR__
 
     //4. 指定放大，缩小滤波方式，线性滤波，即放大缩小的插值方式;
@@ -278,11 +291,28 @@ void RenderTaskConsumerBase::UpdateVBOSubData(RenderTaskBase *task_base) {
     timetool::StopWatch stopwatch;
     stopwatch.start();
     //更新Buffer数据
-    glBufferSubData(GL_ARRAY_BUFFER,0,task->vertex_data_size_,task->vertex_data_);__CHECK_GL_ERROR__
+    glBufferSubData(GL_ARRAY_BUFFER,task->offset_,task->vertex_data_size_,task->vertex_data_);__CHECK_GL_ERROR__
     stopwatch.stop();
 //    DEBUG_LOG_INFO("glBufferSubData cost {}",stopwatch.microseconds());
 }
 
+void RenderTaskConsumerBase::DeleteVAO(RenderTaskBase *task_base) {
+    RenderTaskDeleteVAO* task=dynamic_cast<RenderTaskDeleteVAO*>(task_base);
+    GLuint vertex_array_object=GPUResourceMapper::GetVAO(task->vao_handle_);
+    GLuint vertex_buffer_object=GPUResourceMapper::GetVBO(task->vbo_handle_);
+    //EBO没有句柄，记录在VAO中。
+    GLint element_buffer_object=0;
+    glBindVertexArray(vertex_array_object);__CHECK_GL_ERROR__
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING,&element_buffer_object);__CHECK_GL_ERROR__
+    glBindVertexArray(0);__CHECK_GL_ERROR__
+    GLuint element_buffer=(GLuint)element_buffer_object;
+    glDeleteBuffers(1,&element_buffer);__CHECK_GL_ERROR__
+    glDeleteBuffers(1,&vertex_buffer_object);__CHECK_GL_ERROR__
+    glDeleteVertexArrays(1,&vertex_array_object);__CHECK_GL_ERROR__
+    GPUResourceMapper::UnMapVAO(task->vao_handle_);
+    GPUResourceMapper::UnMapVBO(task->vbo_handle_);
+}
+
 void RenderTaskConsumerBase::CreateUBO(RenderTaskBase *task_base) {
     RenderTaskCreateUBO* task=dynamic_cast<RenderTaskCreateUBO*>(task_base);
     GLuint shader_program=GPUResourceMapper::GetShaderProgram(task->shader_program_handle_);
@@ -365,9 +395,9 @@ void RenderTaskConsumerBase::ActiveAndBindTexture(RenderTaskBase *task_base) {
     RenderTaskActiveAndBindTexture* task=dynamic_cast<RenderTaskActiveAndBindTexture*>(task_base);
     //激活纹理单元
     glActiveTexture(task->texture_uint_);__CHECK_GL_ERROR__
-    //将加载的图片纹理句柄，绑定到当前激活纹理单元的Texture2D上。
+    //将加载的图片纹理句柄，绑定到当前激活纹理单元的Texture2D上，纹理数组绑定到Texture2DArray上。
     GLuint texture=GPUResourceMapper::GetTexture(task->texture_handle_);
-    glBindTexture(GL_TEXTURE_2D, texture);__CHECK_GL_ERROR__
+    glBindTexture(GPUResourceMapper::GetTextureTarget(task->texture_handle_), texture);__CHECK_GL_ERROR__
 
     //自定义Texture名
     glObjectLabel(GL_TEXTURE, texture, -1, task->texture_name_.c_str());
@@ -399,7 +429,7 @@ void RenderTaskConsumerBase::BindVAOAndDrawElements(RenderTaskBase *task_base) {
     GLuint vao=GPUResourceMapper::GetVAO(task->vao_handle_);
     glBindVertexArray(vao);__CHECK_GL_ERROR__
     {
-        glDrawElements(GL_TRIANGLES,task->vertex_index_num_,GL_UNSIGNED_SHORT,0);__CHECK_GL_ERROR__//使用顶点索引进行绘制，最后的0表示数据偏移量。
+        glDrawElements(GL_TRIANGLES,task->vertex_index_num_,GL_UNSIGNED_SHORT,(void*)(task->first_index_*sizeof(unsigned short)));__CHECK_GL_ERROR__//使用顶点索引进行绘制，最后的参数表示索引数据偏移量。
     }
     glBindVertexArray(0);__CHECK_GL_ERROR__
 }
@@ -429,6 +459,16 @@ void RenderTaskConsumerBase::SetStencilBufferClearValue(RenderTaskBase* task_bas
     glClearStencil(task->clear_value_);__CHECK_GL_ERROR__
 }
 
+void RenderTaskConsumerBase::SetColorMask(RenderTaskBase* task_base){
+    RenderTaskSetColorMask* task=dynamic_cast<RenderTaskSetColorMask*>(task_base);
+    glColorMask(task->red_,task->green_,task->blue_,task->alpha_);__CHECK_GL_ERROR__
+}
+
+void RenderTaskConsumerBase::SetScissor(RenderTaskBase* task_base){
+    RenderTaskSetScissor* task=dynamic_cast<RenderTaskSetScissor*>(task_base);
+    glScissor(task->x_,task->y_,task->width_,task->height_);__CHECK_GL_ERROR__
+}
+
 
 /// 创建FBO任务
 void RenderTaskConsumerBase::CreateFBO(RenderTaskBase* task_base){
@@ -528,37 +568,26 @@ void RenderTaskConsumerBase::CreateGBuffer(RenderTaskBase *task_base) {
     GPUResourceMapper::MapFBO(task->fbo_handle_, frame_buffer_object_id);
 
     glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_object_id);__CHECK_GL_ERROR__
-    //将FBO颜色附着点0关联的颜色纹理,存储着顶点片段坐标数据,绑定到FBO颜色附着点0
-    GLuint frag_position_texture=GPUResourceMapper::GetTexture(task->frag_position_texture_handle_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, frag_position_texture, 0);__CHECK_GL_ERROR__
-    //将FBO颜色附着点1关联的颜色纹理，存储着顶点片段法线数据,绑定到FBO颜色附着点1
-    GLuint frag_normal_texture=GPUResourceMapper::GetTexture(task->frag_normal_texture_handle_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, frag_normal_texture, 0);__CHECK_GL_ERROR__
-    //将FBO颜色附着点2关联的颜色纹理，存储着顶点片段顶点颜色数据，绑定到FBO颜色附着点2
-    GLuint frag_vertex_color_texture=GPUResourceMapper::GetTexture(task->frag_vertex_color_texture_handle_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, frag_vertex_color_texture, 0);__CHECK_GL_ERROR__
-    //将FBO颜色附着点3关联的颜色纹理，存储着顶点片段Diffuse数据，绑定到FBO颜色附着点3
-    GLuint frag_diffuse_color_texture=GPUResourceMapper::GetTexture(task->frag_diffuse_color_texture_handle_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, GL_TEXTURE_2D, frag_diffuse_color_texture, 0);__CHECK_GL_ERROR__
-    //将FBO颜色附着点4关联的颜色纹理，存储着顶点片段Specular数据，绑定到FBO颜色附着点4
-    GLuint frag_specular_intensity_texture=GPUResourceMapper::GetTexture(task->frag_specular_intensity_texture_handle_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT4, GL_TEXTURE_2D, frag_specular_intensity_texture, 0);__CHECK_GL_ERROR__
-    //将FBO颜色附着点5关联的颜色纹理，存储着顶点片段反光度数据，绑定到FBO颜色附着点5
-    GLuint frag_specular_highlight_shininess_texture=GPUResourceMapper::GetTexture(task->frag_specular_highlight_shininess_texture_handle_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT5, GL_TEXTURE_2D, frag_specular_highlight_shininess_texture, 0);__CHECK_GL_ERROR__
+    //颜色纹理按顺序绑定到FBO颜色附着点0、1、2...
+    //完整GBuffer：坐标、法线、顶点颜色、Diffuse、高光强度、反光度。
+    //压缩GBuffer：八面体编码法线、Diffuse+高光强度、顶点颜色+反光度，坐标从深度重建。
+    GLenum attachments[GBUFFER_MAX_COLOR_ATTACHMENT_NUM];
+    for (int i = 0; i < task->color_texture_count_ && i < GBUFFER_MAX_COLOR_ATTACHMENT_NUM; ++i) {
+        GLuint color_texture=GPUResourceMapper::GetTexture(task->color_texture_handle_array_[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0+i, GL_TEXTURE_2D, color_texture, 0);__CHECK_GL_ERROR__
+        attachments[i]=GL_COLOR_ATTACHMENT0+i;
+        //自定义Texture名
+        std::string label=fmt::format("gbuffer_color_attachment_{}",i);
+        glObjectLabel(GL_TEXTURE, color_texture, -1, label.c_str());
+    }
     //将深度纹理绑定到FBO深度附着点
     GLuint frag_depth_texture=GPUResourceMapper::GetTexture(task->frag_depth_texture_handle_);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, frag_depth_texture, 0);__CHECK_GL_ERROR__
+    // - 告诉OpenGL我们将要使用(帧缓冲的)哪种颜色附件来进行渲染，这是FBO的状态，绑定时不用再设置。
+    glDrawBuffers(std::min(task->color_texture_count_,GBUFFER_MAX_COLOR_ATTACHMENT_NUM), attachments);__CHECK_GL_ERROR__
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);__CHECK_GL_ERROR__
 
-    //自定义Texture名
-    glObjectLabel(GL_TEXTURE, frag_position_texture, -1, "frag_position_texture");
-    glObjectLabel(GL_TEXTURE, frag_normal_texture, -1, "frag_normal_texture");
-    glObjectLabel(GL_TEXTURE, frag_vertex_color_texture, -1, "frag_vertex_color_texture");
-    glObjectLabel(GL_TEXTURE, frag_diffuse_color_texture, -1, "frag_diffuse_color_texture");
-    glObjectLabel(GL_TEXTURE, frag_specular_intensity_texture, -1, "frag_specular_intensity_texture");
-    glObjectLabel(GL_TEXTURE, frag_specular_highlight_shininess_texture, -1, "frag_specular_highlight_shininess_texture");
     glObjectLabel(GL_TEXTURE, frag_depth_texture, -1, "frag_depth_texture");
 }
 
@@ -574,14 +603,65 @@ void RenderTaskConsumerBase::BindGBuffer(RenderTaskBase* task_base){
         DEBUG_LOG_ERROR("BindGBuffer FBO Error,Status:{} !",status);
         return;
     }
-    // - 告诉OpenGL我们将要使用(帧缓冲的)哪种颜色附件来进行渲染
-    GLuint attachments[6] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 ,GL_COLOR_ATTACHMENT3,GL_COLOR_ATTACHMENT4,GL_COLOR_ATTACHMENT5 };
-    glDrawBuffers(6, attachments);
+    //颜色附件在创建GBuffer时已经通过glDrawBuffers设置到FBO上
 
     //压入渲染目标栈
     render_target_stack_.Push(frame_buffer_object_id);
 }
 
+/// RenderTexture别名任务
+void RenderTaskConsumerBase::AliasRenderTexture(RenderTaskBase* task_base){
+    RenderTaskAliasRenderTexture* task=dynamic_cast<RenderTaskAliasRenderTexture*>(task_base);
+    //别名句柄映射到实际创建的GPU资源，之后使用别名句柄绑定FBO、纹理都访问同一块显存。
+    GPUResourceMapper::MapFBO(task->fbo_handle_,GPUResourceMapper::GetFBO(task->physical_fbo_handle_));
+    for (int i = 0; i < task->texture_count_; ++i) {
+        GPUResourceMapper::MapTexture(task->texture_handle_array_[i],GPUResourceMapper::GetTexture(task->physical_texture_handle_array_[i]));
+    }
+}
+
+/// 创建深度纹理数组
+void RenderTaskConsumerBase::CreateDepthTextureArray(RenderTaskBase* task_base){
+    RenderTaskCreateDepthTextureArray* task=dynamic_cast<RenderTaskCreateDepthTextureArray*>(task_base);
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);__CHECK_GL_ERROR__
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_id);__CHECK_GL_ERROR__
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, task->width_, task->height_, task->layer_num_, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);__CHECK_GL_ERROR__
+    //线性滤波+深度比较，一次采样得到周围4个像素的阴影比例。
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);__CHECK_GL_ERROR__
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);__CHECK_GL_ERROR__
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);__CHECK_GL_ERROR__
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);__CHECK_GL_ERROR__
+    //超出范围的不在阴影中
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);__CHECK_GL_ERROR__
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);__CHECK_GL_ERROR__
+    GLfloat border_color[4]={1.0f,1.0f,1.0f,1.0f};
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border_color);__CHECK_GL_ERROR__
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);__CHECK_GL_ERROR__
+
+    GPUResourceMapper::MapTexture(task->texture_handle_, texture_id);
+    GPUResourceMapper::MapTextureTarget(task->texture_handle_, GL_TEXTURE_2D_ARRAY);
+}
+
+/// 创建只有深度附着点的FBO
+void RenderTaskConsumerBase::CreateDepthFBO(RenderTaskBase* task_base){
+    RenderTaskCreateDepthFBO* task=dynamic_cast<RenderTaskCreateDepthFBO*>(task_base);
+    GLuint frame_buffer_object_id=0;
+    glGenFramebuffers(1, &frame_buffer_object_id);__CHECK_GL_ERROR__
+    if(frame_buffer_object_id==0){
+        DEBUG_LOG_ERROR("CreateDepthFBO FBO Error!");
+        return;
+    }
+    GPUResourceMapper::MapFBO(task->fbo_handle_, frame_buffer_object_id);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_object_id);__CHECK_GL_ERROR__
+    GLuint depth_texture=GPUResourceMapper::GetTexture(task->depth_texture_handle_);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depth_texture, 0, task->layer_);__CHECK_GL_ERROR__
+    //没有颜色附着点，这是FBO的状态，绑定时不用再设置。
+    glDrawBuffer(GL_NONE);__CHECK_GL_ERROR__
+    glReadBuffer(GL_NONE);__CHECK_GL_ERROR__
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);__CHECK_GL_ERROR__
+}
+
 /// 结束一帧
 /// \param task_base
 void RenderTaskConsumerBase::EndFrame(RenderTaskBase* task_base) {
@@ -654,6 +734,10 @@ void RenderTaskConsumerBase::ProcessTask() {
                     UpdateVBOSubData(render_task);
                     break;
                 }
+                case RenderCommand::DELETE_VAO:{
+                    DeleteVAO(render_task);
+                    break;
+                }
                 case RenderCommand::CREATE_UBO:{
                     CreateUBO(render_task);
                     break;
@@ -710,6 +794,14 @@ void RenderTaskConsumerBase::ProcessTask() {
                     SetStencilBufferClearValue(render_task);
                     break;
                 }
+                case RenderCommand::SET_COLOR_MASK:{
+                    SetColorMask(render_task);
+                    break;
+                }
+                case RenderCommand::SET_SCISSOR:{
+                    SetScissor(render_task);
+                    break;
+                }
                 case RenderCommand::CREATE_FBO:{
                     CreateFBO(render_task);
                     break;
@@ -734,6 +826,18 @@ void RenderTaskConsumerBase::ProcessTask() {
                     BindGBuffer(render_task);
                     break;
                 }
+                case RenderCommand::ALIAS_RENDER_TEXTURE:{
+                    AliasRenderTexture(render_task);
+                    break;
+                }
+                case RenderCommand::CREATE_DEPTH_TEXTURE_ARRAY:{
+                    CreateDepthTextureArray(render_task);
+                    break;
+                }
+                case RenderCommand::CREATE_DEPTH_FBO:{
+                    CreateDepthFBO(render_task);
+                    break;
+                }
                 case RenderCommand::END_FRAME:{
                     EndFrame(render_task);
                     break;
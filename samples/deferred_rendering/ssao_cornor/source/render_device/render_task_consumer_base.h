@@ -27,10 +27,11 @@ public:
 
     virtual void SwapBuffer();
 
-private:
+protected:
     /// 线程主函数：死循环处理渲染任务
-    void ProcessTask();
+    virtual void ProcessTask();
 
+private:
     /// 更新游戏画面尺寸
     /// \param task_base
     void UpdateScreenSize(RenderTaskBase* task_base);
@@ -75,6 +76,10 @@ private:
     /// \param task_base
     void UpdateVBOSubData(RenderTaskBase* task_base);
 
+    /// 删除VAO及其VBO、EBO
+    /// \param task_base
+    void DeleteVAO(RenderTaskBase* task_base);
+
     /// 创建UBO
     /// \param task_base
     void CreateUBO(RenderTaskBase* task_base);
@@ -128,6 +133,12 @@ private:
     /// 设置清除模板缓冲值
     void SetStencilBufferClearValue(RenderTaskBase* task_base);
 
+    /// 设置是否写入颜色缓冲
+    void SetColorMask(RenderTaskBase* task_base);
+
+    /// 设置裁剪矩形
+    void SetScissor(RenderTaskBase* task_base);
+
     /// 创建FBO任务
     void CreateFBO(RenderTaskBase* task_base);
 
@@ -146,15 +157,24 @@ private:
     /// 绑定使用FBO任务
     void BindGBuffer(RenderTaskBase* task_base);
 
+    /// RenderTexture别名任务
+    void AliasRenderTexture(RenderTaskBase* task_base);
+
+    /// 创建深度纹理数组
+    void CreateDepthTextureArray(RenderTaskBase* task_base);
+
+    /// 创建只有深度附着点的FBO
+    void CreateDepthFBO(RenderTaskBase* task_base);
+
     /// 结束一帧
     /// \param task_base
     void EndFrame(RenderTaskBase *task_base);
 	
 private:
     std::thread render_thread_;//渲染线程
-    bool exit_=false;
 
 protected:
+    bool exit_=false;
     RenderTargetStack render_target_stack_;//渲染目标栈
 };
 
@@ -0,0 +1,67 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "render_task_consumer_null.h"
+#include <string>
+#include "render_task_type.h"
+#include "render_command.h"
+#include "render_task_queue.h"
+#include "utils/screen.h"
+#include "render_device/uniform_buffer_object_manager.h"
+
+RenderTaskConsumerNull::RenderTaskConsumerNull(int width,int height):RenderTaskConsumerBase(),width_(width),height_(height) {
+    command_count_.resize((size_t)RenderCommand::END_FRAME+1,0);
+}
+
+RenderTaskConsumerNull::~RenderTaskConsumerNull() {}
+
+void RenderTaskConsumerNull::GetFramebufferSize(int& width,int& height) {
+    width=width_;
+    height=height_;
+}
+
+void RenderTaskConsumerNull::ProcessTask() {
+    //只初始化UniformBlock的描述，不创建UBO。
+    UniformBufferObjectManager::Init();
+
+    while (!exit_){
+        if(RenderTaskQueue::Empty()){//渲染线程一直等待主线程发出任务。
+            std::this_thread::sleep_for(std::chrono::nanoseconds(1));//没有任务休息一下。
+            continue;
+        }
+        RenderTaskBase* render_task = RenderTaskQueue::Front();
+        RenderCommand render_command=render_task->render_command_;
+        bool need_return_result=render_task->need_return_result_;
+
+        command_count_[(size_t)render_command]++;
+        command_num_++;
+        switch (render_command) {
+            case RenderCommand::UPDATE_SCREEN_SIZE:{
+                Screen::set_width_height(width_,height_);
+                break;
+            }
+            case RenderCommand::BIND_VAO_AND_DRAW_ELEMENTS:{
+                draw_call_num_++;
+                break;
+            }
+            case RenderCommand::END_FRAME:{
+                //先记录本帧统计，再通知主线程帧结束。
+                frame_command_num_=command_num_;
+                frame_draw_call_num_=draw_call_num_;
+                command_num_=0;
+                draw_call_num_=0;
+                render_task->return_result_set_=true;
+                break;
+            }
+            default:break;
+        }
+
+        RenderTaskQueue::Pop();
+
+        //如果这个任务不需要返回参数，那么用完就删掉。
+        if(need_return_result==false){
+            delete render_task;
+        }
+    }
+}
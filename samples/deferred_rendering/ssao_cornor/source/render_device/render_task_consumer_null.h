@@ -0,0 +1,47 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#ifndef UNTITLED_RENDER_TASK_CONSUMER_NULL_H
+#define UNTITLED_RENDER_TASK_CONSUMER_NULL_H
+
+#include <vector>
+#include "render_task_consumer_base.h"
+
+/// 渲染任务消费端(无窗口、无GPU)
+/// 不调用任何图形API，只统计每种渲染命令的数量，用于在没有显示器的机器上测试主线程耗时。
+class RenderTaskConsumerNull : public RenderTaskConsumerBase{
+public:
+    /// \param width 模拟的画面宽度
+    /// \param height 模拟的画面高度
+    RenderTaskConsumerNull(int width,int height);
+    ~RenderTaskConsumerNull();
+
+    virtual void GetFramebufferSize(int& width,int& height) override;
+
+    /// 上一帧的渲染命令数量，主线程在帧结束任务返回后读取。
+    unsigned int frame_command_num(){return frame_command_num_;}
+
+    /// 上一帧绘制次数
+    unsigned int frame_draw_call_num(){return frame_draw_call_num_;}
+
+    /// 从启动开始每种渲染命令的数量 index:RenderCommand
+    const std::vector<unsigned long long>& command_count(){return command_count_;}
+
+protected:
+    /// 线程主函数：取出渲染任务只计数，不执行。
+    virtual void ProcessTask() override;
+
+private:
+    int width_;
+    int height_;
+
+    std::vector<unsigned long long> command_count_;//每种渲染命令的数量
+    unsigned int command_num_=0;//当前帧渲染命令数量
+    unsigned int draw_call_num_=0;//当前帧绘制次数
+    unsigned int frame_command_num_=0;//上一帧渲染命令数量
+    unsigned int frame_draw_call_num_=0;//上一帧绘制次数
+};
+
+
+#endif //UNTITLED_RENDER_TASK_CONSUMER_NULL_H
@@ -66,7 +66,8 @@ void RenderTaskProducer::ProduceRenderTaskUseShaderProgram(unsigned int shader_p
 void RenderTaskProducer::ProduceRenderTaskCreateCompressedTexImage2D(unsigned int texture_handle, int width,
                                                                      int height, unsigned int texture_format,
                                                                      unsigned int compress_size,
-                                                                     unsigned char *data) {
+                                                                     unsigned char *data, int mipmap_num,
+                                                                     const unsigned int* mipmap_compress_size) {
     EASY_FUNCTION();
     CHECK_EXIT_RETURN
     RenderTaskCreateCompressedTexImage2D* task=new RenderTaskCreateCompressedTexImage2D();
@@ -75,6 +76,13 @@ void RenderTaskProducer::ProduceRenderTaskCreateCompressedTexImage2D(unsigned in
     task->height_=height;
     task->texture_format_=texture_format;
     task->compress_size_=compress_size;
+    task->mipmap_num_=mipmap_num;
+    task->mipmap_compress_size_= static_cast<unsigned int *>(malloc(sizeof(unsigned int)*mipmap_num));
+    if(mipmap_compress_size== nullptr){
+        task->mipmap_compress_size_[0]=compress_size;
+    }else{
+        memcpy(task->mipmap_compress_size_, mipmap_compress_size, sizeof(unsigned int)*mipmap_num);
+    }
     //拷贝数据
     task->data_= static_cast<unsigned char *>(malloc(compress_size));
     memcpy(task->data_, data, compress_size);
@@ -92,7 +100,8 @@ void RenderTaskProducer::ProduceRenderTaskCreateTexImage2D(unsigned int texture_
                                                            unsigned int wrap_t_,//垂直方向包裹方式
                                                            unsigned int data_type,
                                                            unsigned int data_size,
-                                                           unsigned char *data) {
+                                                           unsigned char *data,
+                                                           bool take_data_ownership) {
     EASY_FUNCTION();
     CHECK_EXIT_RETURN
     RenderTaskCreateTexImage2D* task=new RenderTaskCreateTexImage2D();
@@ -107,7 +116,9 @@ void RenderTaskProducer::ProduceRenderTaskCreateTexImage2D(unsigned int texture_
     task->wrap_t_=wrap_t_;
     task->data_type_=data_type;
     //拷贝数据
-    if(data_size>0){
+    if(take_data_ownership){
+        task->data_=data;
+    }else if(data_size>0){
         task->data_= static_cast<unsigned char *>(malloc(data_size));
         memcpy(task->data_, data, data_size);
     }
@@ -171,18 +182,27 @@ void RenderTaskProducer::ProduceRenderTaskCreateVAO(unsigned int shader_program_
 }
 
 void RenderTaskProducer::ProduceRenderTaskUpdateVBOSubData(unsigned int vbo_handle, unsigned int vertex_data_size,
-                                                           void *vertex_data) {
+                                                           void *vertex_data, unsigned int offset) {
     EASY_FUNCTION();
     CHECK_EXIT_RETURN
     RenderTaskUpdateVBOSubData* task=new RenderTaskUpdateVBOSubData();
     task->vbo_handle_=vbo_handle;
     task->vertex_data_size_=vertex_data_size;
+    task->offset_=offset;
     //拷贝数据
     task->vertex_data_= (unsigned char*)malloc(vertex_data_size);
     memcpy(task->vertex_data_, vertex_data, vertex_data_size);
     RenderTaskQueue::Push(task);
 }
 
+void RenderTaskProducer::ProduceRenderTaskDeleteVAO(unsigned int vao_handle, unsigned int vbo_handle) {
+    CHECK_EXIT_RETURN
+    RenderTaskDeleteVAO* task=new RenderTaskDeleteVAO();
+    task->vao_handle_=vao_handle;
+    task->vbo_handle_=vbo_handle;
+    RenderTaskQueue::Push(task);
+}
+
 void RenderTaskProducer::ProduceRenderTaskUpdateUBOSubData(std::string uniform_block_instance_name,
                                                            std::string uniform_block_member_name, void* data){
     EASY_FUNCTION();
@@ -272,12 +292,13 @@ void RenderTaskProducer::ProduceRenderTaskSetUniform3f(unsigned int shader_progr
     RenderTaskQueue::Push(task);
 }
 
-void RenderTaskProducer::ProduceRenderTaskBindVAOAndDrawElements(unsigned int vao_handle, unsigned int vertex_index_num) {
+void RenderTaskProducer::ProduceRenderTaskBindVAOAndDrawElements(unsigned int vao_handle, unsigned int vertex_index_num, unsigned int first_index) {
     EASY_FUNCTION();
     CHECK_EXIT_RETURN
     RenderTaskBindVAOAndDrawElements* task=new RenderTaskBindVAOAndDrawElements();
     task->vao_handle_=vao_handle;
     task->vertex_index_num_=vertex_index_num;
+    task->first_index_=first_index;
     RenderTaskQueue::Push(task);
 }
 
@@ -321,6 +342,28 @@ void RenderTaskProducer::ProduceRenderTaskSetStencilBufferClearValue(int clear_v
     RenderTaskQueue::Push(task);
 }
 
+void RenderTaskProducer::ProduceRenderTaskSetColorMask(bool red, bool green, bool blue, bool alpha) {
+    EASY_FUNCTION();
+    CHECK_EXIT_RETURN
+    RenderTaskSetColorMask* task=new RenderTaskSetColorMask();
+    task->red_=red;
+    task->green_=green;
+    task->blue_=blue;
+    task->alpha_=alpha;
+    RenderTaskQueue::Push(task);
+}
+
+void RenderTaskProducer::ProduceRenderTaskSetScissor(int x, int y, int width, int height) {
+    EASY_FUNCTION();
+    CHECK_EXIT_RETURN
+    RenderTaskSetScissor* task=new RenderTaskSetScissor();
+    task->x_=x;
+    task->y_=y;
+    task->width_=width;
+    task->height_=height;
+    RenderTaskQueue::Push(task);
+}
+
 void RenderTaskProducer::ProduceRenderTaskCreateFBO(int fbo_handle,unsigned short width,unsigned short height,unsigned int color_texture_handle,unsigned int depth_texture_handle){
     CHECK_EXIT_RETURN
     RenderTaskCreateFBO* task=new RenderTaskCreateFBO();
@@ -355,23 +398,16 @@ void RenderTaskProducer::ProduceRenderTaskDeleteFBO(int fbo_handle){
 
 
 void RenderTaskProducer::ProduceRenderTaskCreateGBuffer(int fbo_handle, unsigned short width, unsigned short height,
-                                                        unsigned int frag_position_texture_handle,
-                                                        unsigned int frag_normal_texture_handle,
-                                                        unsigned int frag_vertex_color_texture_handle,
-                                                        unsigned int frag_diffuse_color_texture_handle,
-                                                        unsigned int frag_specular_intensity_texture_handle,
-                                                        unsigned int frag_specular_highlight_shininess_texture_handle,
+                                                        int color_texture_count, unsigned int* color_texture_handle_array,
                                                         unsigned int frag_depth_texture_handle) {
     RenderTaskCreateGBuffer* task=new RenderTaskCreateGBuffer();
     task->fbo_handle_=fbo_handle;
     task->width_=width;
     task->height_=height;
-    task->frag_position_texture_handle_=frag_position_texture_handle;
-    task->frag_normal_texture_handle_=frag_normal_texture_handle;
-    task->frag_vertex_color_texture_handle_=frag_vertex_color_texture_handle;
-    task->frag_diffuse_color_texture_handle_=frag_diffuse_color_texture_handle;
-    task->frag_specular_intensity_texture_handle_=frag_specular_intensity_texture_handle;
-    task->frag_specular_highlight_shininess_texture_handle_=frag_specular_highlight_shininess_texture_handle;
+    //拷贝数据
+    task->color_texture_handle_array_=(unsigned int*)malloc(sizeof(unsigned int)*color_texture_count);
+    memcpy(task->color_texture_handle_array_,color_texture_handle_array,sizeof(unsigned int)*color_texture_count);
+    task->color_texture_count_=color_texture_count;
     task->frag_depth_texture_handle_=frag_depth_texture_handle;
     RenderTaskQueue::Push(task);
 }
@@ -382,6 +418,41 @@ void RenderTaskProducer::ProduceRenderTaskBindGBuffer(int fbo_handle){
     RenderTaskQueue::Push(task);
 }
 
+void RenderTaskProducer::ProduceRenderTaskAliasRenderTexture(unsigned int fbo_handle, unsigned int physical_fbo_handle, int texture_count,
+                                                             unsigned int* texture_handle_array, unsigned int* physical_texture_handle_array) {
+    CHECK_EXIT_RETURN
+    RenderTaskAliasRenderTexture* task=new RenderTaskAliasRenderTexture();
+    task->fbo_handle_=fbo_handle;
+    task->physical_fbo_handle_=physical_fbo_handle;
+    //拷贝数据
+    task->texture_handle_array_=(unsigned int*)malloc(sizeof(unsigned int)*texture_count);
+    memcpy(task->texture_handle_array_,texture_handle_array,sizeof(unsigned int)*texture_count);
+    task->physical_texture_handle_array_=(unsigned int*)malloc(sizeof(unsigned int)*texture_count);
+    memcpy(task->physical_texture_handle_array_,physical_texture_handle_array,sizeof(unsigned int)*texture_count);
+    task->texture_count_=texture_count;
+    RenderTaskQueue::Push(task);
+}
+
+void RenderTaskProducer::ProduceRenderTaskCreateDepthTextureArray(unsigned int texture_handle, unsigned short width, unsigned short height,
+                                                                  unsigned short layer_num) {
+    CHECK_EXIT_RETURN
+    RenderTaskCreateDepthTextureArray* task=new RenderTaskCreateDepthTextureArray();
+    task->texture_handle_=texture_handle;
+    task->width_=width;
+    task->height_=height;
+    task->layer_num_=layer_num;
+    RenderTaskQueue::Push(task);
+}
+
+void RenderTaskProducer::ProduceRenderTaskCreateDepthFBO(unsigned int fbo_handle, unsigned int depth_texture_handle, unsigned short layer) {
+    CHECK_EXIT_RETURN
+    RenderTaskCreateDepthFBO* task=new RenderTaskCreateDepthFBO();
+    task->fbo_handle_=fbo_handle;
+    task->depth_texture_handle_=depth_texture_handle;
+    task->layer_=layer;
+    RenderTaskQueue::Push(task);
+}
+
 void RenderTaskProducer::ProduceRenderTaskEndFrame() {
     EASY_FUNCTION();
     CHECK_EXIT_RETURN
@@ -37,10 +37,12 @@ public:
     /// \param width
     /// \param height
     /// \param texture_format 压缩纹理格式
-    /// \param compress_size
-    /// \param data 压缩纹理数据，注意函数里是拷贝内存块。
+    /// \param compress_size 所有mipmap的压缩数据大小
+    /// \param data 压缩纹理数据，从第0级开始依次存放各级mipmap，注意函数里是拷贝内存块。
+    /// \param mipmap_num mipmap数量
+    /// \param mipmap_compress_size 每一级mipmap的压缩数据大小，mipmap_num为1时可以不传。
     static void ProduceRenderTaskCreateCompressedTexImage2D(unsigned int texture_handle, int width, int height, unsigned int texture_format, unsigned int compress_size,
-                                                            unsigned char *data);
+                                                            unsigned char *data, int mipmap_num=1, const unsigned int* mipmap_compress_size= nullptr);
 
     /// 发出任务：创建纹理
     /// \param texture_handle
@@ -51,6 +53,7 @@ public:
     /// \param data_type
     /// \param data_size
     /// \param data
+    /// \param take_data_ownership true:data是malloc分配的，直接交给渲染任务，上传后free，不拷贝。
     static void ProduceRenderTaskCreateTexImage2D(unsigned int texture_handle,
                                                   int width,
                                                   int height,
@@ -62,7 +65,8 @@ public:
                                                   unsigned int wrap_t_,//垂直方向包裹方式
                                                   unsigned int data_type,
                                                   unsigned int data_size,
-                                                  unsigned char *data);
+                                                  unsigned char *data,
+                                                  bool take_data_ownership=false);
 
     /// 发出任务：删除一个或多个Texture
     /// \param size
@@ -96,7 +100,13 @@ public:
     /// \param vbo_handle
     /// \param vertex_data_size
     /// \param vertex_data
-    static void ProduceRenderTaskUpdateVBOSubData(unsigned int vbo_handle,unsigned int vertex_data_size,void* vertex_data);
+    /// \param offset 写入VBO的字节偏移，用于只更新一部分顶点。
+    static void ProduceRenderTaskUpdateVBOSubData(unsigned int vbo_handle,unsigned int vertex_data_size,void* vertex_data,unsigned int offset=0);
+
+    /// 发出任务：删除VAO，以及创建VAO时生成的VBO和EBO。
+    /// \param vao_handle
+    /// \param vbo_handle
+    static void ProduceRenderTaskDeleteVAO(unsigned int vao_handle,unsigned int vbo_handle);
 
     /// 发出任务：创建UBO
     /// \param shader_program_handle
@@ -150,7 +160,8 @@ public:
     /// 绑定VAO并绘制
     /// \param vao_handle
     /// \param inex_count
-    static void ProduceRenderTaskBindVAOAndDrawElements(unsigned int vao_handle,unsigned int vertex_index_num);
+    /// \param first_index 从第几个索引开始绘制，用于一个VAO分多次绘制(UI合批)。
+    static void ProduceRenderTaskBindVAOAndDrawElements(unsigned int vao_handle,unsigned int vertex_index_num,unsigned int first_index=0);
 
     /// 设置clear_flag并且清除颜色缓冲
     /// \param clear_flag
@@ -175,6 +186,16 @@ public:
     /// 设置清除模板缓冲值
     static void ProduceRenderTaskSetStencilBufferClearValue(int clear_value);
 
+    /// 设置是否写入颜色缓冲，只写模板时关闭。
+    static void ProduceRenderTaskSetColorMask(bool red,bool green,bool blue,bool alpha);
+
+    /// 设置裁剪矩形，需要开启GL_SCISSOR_TEST。
+    /// \param x 左下角，像素
+    /// \param y 左下角，像素
+    /// \param width
+    /// \param height
+    static void ProduceRenderTaskSetScissor(int x,int y,int width,int height);
+
     /// 创建帧缓冲区对象(FBO)
     /// \param fbo_handle FBO句柄
     /// \param width 帧缓冲区尺寸(宽)
@@ -194,18 +215,38 @@ public:
     /// \param fbo_handle FBO句柄
     /// \param width 帧缓冲区尺寸(宽)
     /// \param height 帧缓冲区尺寸(高)
+    /// \param color_texture_count 颜色纹理数量，完整GBuffer是6个，压缩GBuffer是3个。
+    /// \param color_texture_handle_array 按顺序绑定到颜色附着点的纹理句柄
+    /// \param frag_depth_texture_handle 深度纹理句柄
     static void ProduceRenderTaskCreateGBuffer(int fbo_handle, unsigned short width, unsigned short height,
-                                               unsigned int frag_position_texture_handle,
-                                               unsigned int frag_normal_texture_handle,
-                                               unsigned int frag_vertex_color_texture_handle,
-                                               unsigned int frag_diffuse_color_texture_handle,
-                                               unsigned int frag_specular_intensity_texture_handle,
-                                               unsigned int frag_specular_highlight_shininess_texture_handle,
+                                               int color_texture_count, unsigned int* color_texture_handle_array,
                                                unsigned int frag_depth_texture_handle);
 
     /// 绑定使用几何缓冲区(GBuffer)
     static void ProduceRenderTaskBindGBuffer(int fbo_handle);
 
+    /// RenderTexture别名，FBO和纹理句柄映射到另一个RenderTexture的GPU资源。
+    /// \param fbo_handle 别名FBO句柄
+    /// \param physical_fbo_handle 实际创建的FBO句柄
+    /// \param texture_count 纹理数量
+    /// \param texture_handle_array 别名纹理句柄
+    /// \param physical_texture_handle_array 实际创建的纹理句柄
+    static void ProduceRenderTaskAliasRenderTexture(unsigned int fbo_handle,unsigned int physical_fbo_handle,int texture_count,
+                                                    unsigned int* texture_handle_array,unsigned int* physical_texture_handle_array);
+
+    /// 创建深度纹理数组，开启深度比较，Shader中用sampler2DArrayShadow采样。
+    /// \param texture_handle 纹理句柄
+    /// \param width
+    /// \param height
+    /// \param layer_num 层数
+    static void ProduceRenderTaskCreateDepthTextureArray(unsigned int texture_handle,unsigned short width,unsigned short height,unsigned short layer_num);
+
+    /// 创建只有深度附着点的FBO，不写入颜色。
+    /// \param fbo_handle FBO句柄
+    /// \param depth_texture_handle 深度纹理数组句柄
+    /// \param layer 附着的层
+    static void ProduceRenderTaskCreateDepthFBO(unsigned int fbo_handle,unsigned int depth_texture_handle,unsigned short layer);
+
     /// 发出特殊任务：渲染结束
     static void ProduceRenderTaskEndFrame();
 
@@ -102,14 +102,17 @@ public:
     }
     ~RenderTaskCreateCompressedTexImage2D(){
         free(data_);
+        free(mipmap_compress_size_);
     }
 public:
     unsigned int texture_handle_= 0;
     int width_;
     int height_;
     unsigned int texture_format_;
-    int compress_size_;
-    unsigned char* data_;
+    int compress_size_;//所有mipmap的压缩数据大小
+    unsigned char* data_;//从第0级开始依次存放各级mipmap
+    int mipmap_num_=1;
+    unsigned int* mipmap_compress_size_= nullptr;//每一级mipmap的压缩数据大小
 };
 
 /// 创建纹理任务
@@ -203,6 +206,20 @@ public:
     unsigned int vbo_handle_=0;//VBO句柄
     unsigned int vertex_data_size_;//顶点数据大小
     void* vertex_data_;//顶点数据
+    unsigned int offset_=0;//写入VBO的字节偏移
+};
+
+/// 删除VAO任务，同时删除创建VAO时生成的VBO和EBO。
+class RenderTaskDeleteVAO:public RenderTaskBase{
+public:
+    RenderTaskDeleteVAO(){
+        render_command_=RenderCommand::DELETE_VAO;
+    }
+    ~RenderTaskDeleteVAO(){
+    }
+public:
+    unsigned int vao_handle_=0;//VAO句柄
+    unsigned int vbo_handle_=0;//VBO句柄
 };
 
 /// 创建UBO任务
@@ -341,6 +358,7 @@ public:
 public:
     unsigned int vao_handle_;
     unsigned int vertex_index_num_;//索引数量
+    unsigned int first_index_=0;//开始绘制的索引
 };
 
 /// 清除
@@ -395,6 +413,34 @@ public:
     int clear_value_;
 };
 
+/// 设置是否写入颜色缓冲
+class RenderTaskSetColorMask:public RenderTaskBase{
+public:
+    RenderTaskSetColorMask(){
+        render_command_=RenderCommand::SET_COLOR_MASK;
+    }
+    ~RenderTaskSetColorMask(){}
+public:
+    bool red_;
+    bool green_;
+    bool blue_;
+    bool alpha_;
+};
+
+/// 设置裁剪矩形
+class RenderTaskSetScissor:public RenderTaskBase{
+public:
+    RenderTaskSetScissor(){
+        render_command_=RenderCommand::SET_SCISSOR;
+    }
+    ~RenderTaskSetScissor(){}
+public:
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+};
+
 
 /// 创建FBO任务
 class RenderTaskCreateFBO: public RenderTaskBase{
@@ -456,17 +502,14 @@ public:
         render_command_=RenderCommand::CREATE_GEOMETRY_BUFFER;
     }
     ~RenderTaskCreateGBuffer(){
+        free(color_texture_handle_array_);
     }
 public:
     unsigned int fbo_handle_=0;//FBO句柄
     unsigned short width_=128;//帧缓冲区尺寸(宽)
     unsigned short height_=128;//帧缓冲区尺寸(高)
-    unsigned int frag_position_texture_handle_=0;//FBO颜色附着点0关联的颜色纹理,存储着顶点片段坐标数据。
-    unsigned int frag_normal_texture_handle_=0;//FBO颜色附着点1关联的颜色纹理，存储着顶点片段法线数据。
-    unsigned int frag_vertex_color_texture_handle_=0;//FBO颜色附着点2关联的颜色纹理，存储着顶点片段颜色数据。
-    unsigned int frag_diffuse_color_texture_handle_=0;//FBO颜色附着点3关联的颜色纹理，存储着顶点片段Diffuse数据。
-    unsigned int frag_specular_intensity_texture_handle_=0;//FBO颜色附着点4关联的颜色纹理，存储着顶点片段高光数据。
-    unsigned int frag_specular_highlight_shininess_texture_handle_=0;//FBO颜色附着点5关联的颜色纹理，存储着顶点片段反光度数据。
+    unsigned int* color_texture_handle_array_=nullptr;//按顺序绑定到FBO颜色附着点0、1、2...的颜色纹理
+    int color_texture_count_=0;//颜色纹理数量
     unsigned int frag_depth_texture_handle_=0;//FBO深度附着点关联的深度纹理
 };
 
@@ -482,6 +525,53 @@ public:
     unsigned int fbo_handle_=0;//FBO句柄
 };
 
+/// RenderTexture别名任务：FBO和纹理句柄映射到另一个RenderTexture的GPU资源，两者共用显存。
+class RenderTaskAliasRenderTexture: public RenderTaskBase{
+public:
+    RenderTaskAliasRenderTexture(){
+        render_command_=RenderCommand::ALIAS_RENDER_TEXTURE;
+    }
+    ~RenderTaskAliasRenderTexture(){
+        free(texture_handle_array_);
+        free(physical_texture_handle_array_);
+    }
+public:
+    unsigned int fbo_handle_=0;//别名FBO句柄
+    unsigned int physical_fbo_handle_=0;//实际创建的FBO句柄
+    unsigned int* texture_handle_array_=nullptr;//别名纹理句柄
+    unsigned int* physical_texture_handle_array_=nullptr;//实际创建的纹理句柄，与texture_handle_array_一一对应。
+    int texture_count_=0;//纹理数量
+};
+
+/// 创建深度纹理数组任务
+class RenderTaskCreateDepthTextureArray: public RenderTaskBase{
+public:
+    RenderTaskCreateDepthTextureArray(){
+        render_command_=RenderCommand::CREATE_DEPTH_TEXTURE_ARRAY;
+    }
+    ~RenderTaskCreateDepthTextureArray(){
+    }
+public:
+    unsigned int texture_handle_=0;//纹理句柄
+    unsigned short width_=0;
+    unsigned short height_=0;
+    unsigned short layer_num_=0;//层数
+};
+
+/// 创建只有深度附着点的FBO任务
+class RenderTaskCreateDepthFBO: public RenderTaskBase{
+public:
+    RenderTaskCreateDepthFBO(){
+        render_command_=RenderCommand::CREATE_DEPTH_FBO;
+    }
+    ~RenderTaskCreateDepthFBO(){
+    }
+public:
+    unsigned int fbo_handle_=0;//FBO句柄
+    unsigned int depth_texture_handle_=0;//深度纹理数组句柄
+    unsigned short layer_=0;//附着的层
+};
+
 /// 特殊任务：帧结束标志，渲染线程收到这个任务后，刷新缓冲区，设置帧结束。
 class RenderTaskEndFrame: public RenderTaskNeedReturnResult {
 public:
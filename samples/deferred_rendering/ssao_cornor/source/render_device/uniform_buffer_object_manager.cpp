@@ -8,14 +8,17 @@
 #include "render_task_type.h"
 #include "render_task_queue.h"
 #include "render_task_producer.h"
+#include "lighting/cascaded_shadow_map.h"
+#include "lighting/point_light.h"
 
 #define DIRECTIONAL_LIGHT_MAX_NUM 128 //最大方向光数量
-#define POINT_LIGHT_MAX_NUM 128 //最大点光源数量
 
 std::vector<UniformBlockInstanceBindingInfo> UniformBufferObjectManager::kUniformBlockInstanceBindingInfoArray={
         {"u_ambient","AmbientBlock",16,0,0},
         {"u_directional_light_array","DirectionalLightBlock",32*DIRECTIONAL_LIGHT_MAX_NUM+sizeof(int),1,0},
-        {"u_point_light_array","PointLightBlock",48*POINT_LIGHT_MAX_NUM+sizeof(int),2,0}
+        {"u_point_light_array","PointLightBlock",48*POINT_LIGHT_MAX_NUM+sizeof(int),2,0},
+        {"u_light_cluster","LightClusterBlock",144,3,0},
+        {"u_cascaded_shadow","CascadedShadowBlock",64*CASCADED_SHADOW_MAX_NUM+32,4,0}
 };
 
 std::unordered_map<std::string,UniformBlock> UniformBufferObjectManager::kUniformBlockMap;
@@ -57,6 +60,28 @@ void UniformBufferObjectManager::Init(){
         }
         uniform_block_member_vec.push_back({"actually_used_count",48*POINT_LIGHT_MAX_NUM,sizeof(int)});
     }
+
+    //光源分簇，用于计算片段所在的簇。
+    kUniformBlockMap["LightClusterBlock"]={
+            {
+                    {"view",0,sizeof(glm::mat4)},
+                    {"projection",64,sizeof(glm::mat4)},
+                    {"near_clip",128,sizeof(float)},
+                    {"slice_scale",132,sizeof(float)}
+            }
+    };
+
+    //级联阴影，每一级的光源投影矩阵和覆盖的视空间深度。
+    kUniformBlockMap["CascadedShadowBlock"]={{}};
+    {
+        std::vector<UniformBlockMember>& uniform_block_member_vec=kUniformBlockMap["CascadedShadowBlock"].uniform_block_member_vec_;
+        for(int i=0;i<CASCADED_SHADOW_MAX_NUM;i++){
+            uniform_block_member_vec.push_back({fmt::format("light_view_projection[{}]",i),64*i,sizeof(glm::mat4)});
+        }
+        uniform_block_member_vec.push_back({"split_depth",64*CASCADED_SHADOW_MAX_NUM,sizeof(glm::vec4)});
+        uniform_block_member_vec.push_back({"cascade_num",64*CASCADED_SHADOW_MAX_NUM+16,sizeof(int)});
+        uniform_block_member_vec.push_back({"depth_bias",64*CASCADED_SHADOW_MAX_NUM+20,sizeof(float)});
+    }
 }
 
 void UniformBufferObjectManager::CreateUniformBufferObject(){
@@ -85,6 +110,18 @@ void UniformBufferObjectManager::UpdateUniformBlockSubData3f(std::string uniform
     RenderTaskProducer::ProduceRenderTaskUpdateUBOSubData(uniform_block_instance_name, uniform_block_member_name, data);
 }
 
+void UniformBufferObjectManager::UpdateUniformBlockSubData4f(std::string uniform_block_instance_name, std::string uniform_block_member_name, glm::vec4& value){
+    void* data= malloc(sizeof(glm::vec4));
+    memcpy(data,&value,sizeof(glm::vec4));
+    RenderTaskProducer::ProduceRenderTaskUpdateUBOSubData(uniform_block_instance_name, std::move(uniform_block_member_name), data);
+}
+
+void UniformBufferObjectManager::UpdateUniformBlockSubDataMatrix4f(std::string uniform_block_instance_name, std::string uniform_block_member_name, glm::mat4& value){
+    void* data= malloc(sizeof(glm::mat4));
+    memcpy(data,&value,sizeof(glm::mat4));
+    RenderTaskProducer::ProduceRenderTaskUpdateUBOSubData(uniform_block_instance_name, std::move(uniform_block_member_name), data);
+}
+
 void UniformBufferObjectManager::UpdateUniformBlockSubData1i(std::string uniform_block_instance_name, std::string uniform_block_member_name, int value){
     void* data= malloc(sizeof(int));
     memcpy(data,&value,sizeof(int));
@@ -72,6 +72,18 @@ public:
     /// \param value
     static void UpdateUniformBlockSubData3f(std::string uniform_block_instance_name, std::string uniform_block_member_name, glm::vec3& value);
 
+    /// 更新UBO数据(vec4)
+    /// \param uniform_block_instance_name
+    /// \param uniform_block_member_name
+    /// \param value
+    static void UpdateUniformBlockSubData4f(std::string uniform_block_instance_name, std::string uniform_block_member_name, glm::vec4& value);
+
+    /// 更新UBO数据(mat4)
+    /// \param uniform_block_instance_name
+    /// \param uniform_block_member_name
+    /// \param value
+    static void UpdateUniformBlockSubDataMatrix4f(std::string uniform_block_instance_name, std::string uniform_block_member_name, glm::mat4& value);
+
     /// 更新UBO数据(int)
     /// \param uniform_block_instance_name
     /// \param uniform_block_member_name
@@ -9,6 +9,9 @@
 #include <glad/gl.h>
 #include <rttr/registration>
 #include "render_texture.h"
+#include "frame_graph.h"
+#include "lighting/light_cluster.h"
+#include "lighting/cascaded_shadow_map.h"
 #include "component/game_object.h"
 #include "component/transform.h"
 #include "render_device/render_task_producer.h"
@@ -35,6 +38,7 @@ Camera::Camera():Component(),clear_color_(49.f/255,77.f/255,121.f/255,1.f),
         depth_=max_depth+1;
     }
     all_camera_.push_back(this);
+    FrameGraph::SetDirty();
 }
 
 
@@ -43,6 +47,10 @@ Camera::~Camera() {
     if(iter!=all_camera_.end()){
         all_camera_.erase(iter);
     }
+    FrameGraph::SetDirty();
+    if(CascadedShadowMap::camera()==this){
+        CascadedShadowMap::set_camera(nullptr);
+    }
 }
 
 void Camera::SetView(const glm::vec3 &cameraForward,const glm::vec3 &cameraUp) {
@@ -113,6 +121,7 @@ void Camera::set_target_render_texture(RenderTexture* render_texture){
         clear_target_render_texture();
     }
     target_render_texture_=render_texture;
+    FrameGraph::SetDirty();
 }
 
 void Camera::clear_target_render_texture() {
@@ -126,6 +135,19 @@ void Camera::clear_target_render_texture() {
     target_render_texture_->set_in_use(false);
 }
 
+void Camera::AddInputRenderTexture(RenderTexture* render_texture) {
+    if(std::find(input_render_textures_.begin(),input_render_textures_.end(),render_texture)!=input_render_textures_.end()){
+        return;
+    }
+    input_render_textures_.push_back(render_texture);
+    FrameGraph::SetDirty();
+}
+
+void Camera::ClearInputRenderTexture() {
+    input_render_textures_.clear();
+    FrameGraph::SetDirty();
+}
+
 void Camera::set_depth(unsigned char depth) {
     if(depth_==depth){
         return;
@@ -138,18 +160,52 @@ void Camera::Sort() {
     std::sort(all_camera_.begin(),all_camera_.end(),[](Camera* a, Camera* b){
         return a->depth() < b->depth();
     });
+    FrameGraph::SetDirty();
 }
 
 void Camera::Foreach(std::function<void()> func) {
+    if(FrameGraph::enable()){
+        ForeachFrameGraph(func);
+        return;
+    }
     for (auto iter=all_camera_.begin();iter!=all_camera_.end();iter++){
         current_camera_=*iter;
         current_camera_->CheckRenderToTexture();
         current_camera_->Clear();
+        if(current_camera_->light_cluster_){
+            LightCluster::Build(current_camera_);
+        }
         func();
         current_camera_->CheckCancelRenderToTexture();
     }
 }
 
+void Camera::ForeachFrameGraph(std::function<void()> func) {
+    const std::vector<Camera*>& cameras=FrameGraph::Compile(all_camera_);
+    Camera* bound_camera= nullptr;//绑定了当前渲染目标的相机
+    for (auto camera : cameras){
+        current_camera_=camera;
+        //相邻的相机写入同一个RenderTexture时，不需要解绑再绑定FBO。
+        if(bound_camera!= nullptr && (bound_camera->target_render_texture_!=camera->target_render_texture_ ||
+                                      bound_camera->deferred_shading_!=camera->deferred_shading_)){
+            bound_camera->CheckCancelRenderToTexture();
+            bound_camera= nullptr;
+        }
+        if(bound_camera== nullptr){
+            camera->CheckRenderToTexture();
+            bound_camera=camera;
+        }
+        camera->Clear();
+        if(camera->light_cluster_){
+            LightCluster::Build(camera);
+        }
+        func();
+    }
+    if(bound_camera!= nullptr){
+        bound_camera->CheckCancelRenderToTexture();
+    }
+}
+
 
 
 
@@ -94,11 +94,27 @@ public:
     /// 清空渲染目标RenderTexture
     void clear_target_render_texture();
 
+    RenderTexture* target_render_texture(){return target_render_texture_;}
+
+    /// 声明这个相机读取的RenderTexture，FrameGraph据此排序相机、剔除没有被使用的相机。
+    /// \param render_texture
+    void AddInputRenderTexture(RenderTexture* render_texture);
+
+    /// 清空读取的RenderTexture
+    void ClearInputRenderTexture();
+
+    const std::vector<RenderTexture*>& input_render_textures(){return input_render_textures_;}
+
     /// 是否延迟渲染
     bool deferred_shading(){return deferred_shading_;}
     /// 设置是否延迟渲染
     void set_deferred_shading(bool deferred_shading){deferred_shading_=deferred_shading;}
 
+    /// 是否在渲染前以这个相机的视锥体给点光源分簇
+    bool light_cluster(){return light_cluster_;}
+    /// 设置光源分簇，前向渲染相机、延迟渲染的GBuffer相机开启，光照Shader只计算片段所在簇的点光源。
+    void set_light_cluster(bool light_cluster){light_cluster_=light_cluster;}
+
 public:
     virtual void Update();
 
@@ -120,12 +136,20 @@ protected:
 
     RenderTexture* target_render_texture_;//渲染目标RenderTexture
 
+    std::vector<RenderTexture*> input_render_textures_;//读取的RenderTexture
+
     bool deferred_shading_ = false;//是否延迟渲染
+
+    bool light_cluster_ = false;//渲染前给点光源分簇
 public:
     /// 遍历所有Camera
     /// \param func
     static void Foreach(std::function<void()> func);
 
+    /// 按FrameGraph编译的顺序遍历Camera
+    /// \param func
+    static void ForeachFrameGraph(std::function<void()> func);
+
     /// 遍历all_camera_时，轮到的那个Camera。
     /// \return
     static Camera* current_camera(){return current_camera_;}
@@ -4,18 +4,33 @@
 
 #include "font.h"
 #include <fstream>
+#include <algorithm>
 #include "freetype/ftbitmap.h"
+#include "freetype/ftmodapi.h"
 #include "app/application.h"
 #include "spdlog/spdlog.h"
 #include "texture_2d.h"
+#include "skyline_packer.h"
+#include "utils/job_system.h"
 
 using std::ifstream;
 using std::ios;
 
 std::unordered_map<std::string,Font*> Font::font_map_;
+unsigned int Font::frame_=1;
 
 Font* Font::LoadFromFile(std::string font_file_path,unsigned short font_size){
-    Font* font=GetFont(font_file_path);
+    return Load(font_file_path,font_size,false);
+}
+
+Font* Font::LoadSDFFromFile(std::string font_file_path, unsigned short font_size) {
+    return Load(font_file_path,font_size,true);
+}
+
+Font* Font::Load(const std::string& font_file_path, unsigned short font_size, bool sdf) {
+    //SDF字体与普通字体分开缓存
+    std::string font_key=sdf?font_file_path+":sdf":font_file_path;
+    Font* font=GetFont(font_key);
     if(font!= nullptr){
         return font;
     }
@@ -28,109 +43,363 @@ Font* Font::LoadFromFile(std::string font_file_path,unsigned short font_size){
     char *font_file_buffer = new char[len];
     input_file_stream.read(font_file_buffer , len);
 
-    //将ttf 传入FreeType解析
-    FT_Library ft_library= nullptr;
-    FT_Face ft_face= nullptr;
-    FT_Init_FreeType(&ft_library);//FreeType初始化;
-    FT_Error error = FT_New_Memory_Face(ft_library, (const FT_Byte*)font_file_buffer, len, 0, &ft_face);
-    if (error != 0){
-        spdlog::error("FT_New_Memory_Face return error {}!",error);
+    //创建Font实例，保存Freetype解析字体结果。
+    font=new Font();
+    font->font_size_=font_size;
+    font->font_file_buffer_=font_file_buffer;
+    font->sdf_=sdf;
+
+    //将ttf 传入FreeType解析，每个线程一份。
+    if(font->CreateThreadFaces(len)==false){
+        delete font;
         return nullptr;
     }
+    font_map_[font_key]=font;
+
+    //创建第一页图集
+    font->AcquirePage();
+
+    return font;
+}
 
-    FT_Select_Charmap(ft_face, FT_ENCODING_UNICODE);
+bool Font::CreateThreadFaces(int length) {
+    unsigned int thread_num=JobSystem::worker_num()+1;
+    for (unsigned int i = 0; i < thread_num; ++i) {
+        FT_Library ft_library= nullptr;
+        FT_Face ft_face= nullptr;
+        FT_Init_FreeType(&ft_library);//FreeType初始化;
+        FT_Error error = FT_New_Memory_Face(ft_library, (const FT_Byte*)font_file_buffer_, length, 0, &ft_face);
+        if (error != 0){
+            spdlog::error("FT_New_Memory_Face return error {}!",error);
+            FT_Done_FreeType(ft_library);
+            return false;
+        }
 
-    FT_F26Dot6 ft_size = (FT_F26Dot6)(font_size*(1 << 6));
+        FT_Select_Charmap(ft_face, FT_ENCODING_UNICODE);
 
-    FT_Set_Char_Size(ft_face, ft_size, 0, 72, 72);
+        FT_F26Dot6 ft_size = (FT_F26Dot6)(font_size_*(1 << 6));
 
-    if (ft_face == nullptr){
-        spdlog::error("FT_Set_Char_Size error!");
-        return nullptr;
+        FT_Set_Char_Size(ft_face, ft_size, 0, 72, 72);
+
+        if(sdf_){
+            FT_Property_Set(ft_library, "sdf", "spread", &sdf_spread_);
+        }
+
+        thread_ft_libraries_.push_back(ft_library);
+        thread_ft_faces_.push_back(ft_face);
     }
+    FT_Face ft_face=thread_ft_faces_[0];
+    line_height_=ft_face->size->metrics.height/64.0f;
+    has_kerning_=FT_HAS_KERNING(ft_face);
+    return true;
+}
 
-    //创建Font实例，保存Freetype解析字体结果。
-    font=new Font();
-    font->font_size_=font_size;
-    font->font_file_buffer_=font_file_buffer;
-    font->ft_library_=ft_library;
-    font->ft_face_=ft_face;
-    font_map_[font_file_path]=font;
-
-    //创建空白的、仅Alpha通道纹理，用于生成文字。
-    unsigned char * pixels = (unsigned char *)malloc(font->font_texture_size_ * font->font_texture_size_);
-    memset(pixels, 0,font->font_texture_size_*font->font_texture_size_);
-    font->font_texture_=Texture2D::Create(font->font_texture_size_,
-                                          font->font_texture_size_,
-                                          GL_RED,
-                                          GL_RED,
-                                          GL_LINEAR,
-                                          GL_LINEAR,
-                                            GL_CLAMP_TO_EDGE,
-                                            GL_CLAMP_TO_EDGE,
-                                          GL_UNSIGNED_BYTE,
-                                          pixels,
-                                          font->font_texture_size_ * font->font_texture_size_);
-    free(pixels);
+Font::~Font() {
+    for (auto page : pages_) {
+        ClearPage(page);
+        delete page->font_texture_;
+        delete page->packer_;
+        free(page->pixels_);
+        delete page;
+    }
+    pages_.clear();
 
-    return font;
+    for (size_t i = 0; i < thread_ft_faces_.size(); ++i) {
+        FT_Done_Face(thread_ft_faces_[i]);
+        FT_Done_FreeType(thread_ft_libraries_[i]);
+    }
+    delete[] font_file_buffer_;
 }
 
 Font* Font::GetFont(std::string font_file_path) {
     return font_map_[font_file_path];
 }
 
-void Font::LoadCharacter(char ch) {
-    if(character_map_[ch]!= nullptr){
-        return;
+void Font::DecodeUTF8(const std::string& str, std::vector<unsigned int>& code_points) {
+    code_points.clear();
+    size_t i=0;
+    while(i<str.size()){
+        unsigned char ch=str[i];
+        unsigned int code_point;
+        int follow_num;
+        if(ch<0x80){
+            code_point=ch;
+            follow_num=0;
+        }else if((ch&0xE0)==0xC0){
+            code_point=ch&0x1F;
+            follow_num=1;
+        }else if((ch&0xF0)==0xE0){
+            code_point=ch&0x0F;
+            follow_num=2;
+        }else if((ch&0xF8)==0xF0){
+            code_point=ch&0x07;
+            follow_num=3;
+        }else{
+            i++;//非法的首字节
+            continue;
+        }
+        if(i+follow_num>=str.size()){
+            break;//末尾不完整
+        }
+        bool valid=true;
+        for (int j = 1; j <= follow_num; ++j) {
+            unsigned char follow=str[i+j];
+            if((follow&0xC0)!=0x80){
+                valid=false;
+                break;
+            }
+            code_point=(code_point<<6)|(follow&0x3F);
+        }
+        if(valid==false){
+            i++;
+            continue;
+        }
+        code_points.push_back(code_point);
+        i+=follow_num+1;
     }
-    //加载这个字的字形,加载到 m_FTFace上面去;Glyph：字形，图形字符 [glif];
-    FT_Load_Glyph(ft_face_, FT_Get_Char_Index(ft_face_, ch), FT_LOAD_DEFAULT);
+}
 
-    //从 FTFace上面读取这个字形  到 ft_glyph 变量;
-    FT_Glyph ft_glyph;
-    FT_Get_Glyph(ft_face_->glyph, &ft_glyph);
-    //渲染为256级灰度图
-    FT_Glyph_To_Bitmap(&ft_glyph, ft_render_mode_normal, 0, 1);
+std::vector<Font::Character*> Font::LoadStr(std::string str) {
+    std::vector<unsigned int> code_points;
+    DecodeUTF8(str,code_points);
 
-    FT_BitmapGlyph ft_bitmap_glyph = (FT_BitmapGlyph)ft_glyph;
-    FT_Bitmap& ft_bitmap = ft_bitmap_glyph->bitmap;
+    std::vector<Character*> character_vec;
+    if(LoadCodePoints(code_points,character_vec)==false){
+        spdlog::error("LoadStr error:{}",str);
+        character_vec.clear();
+        return character_vec;
+    }
+    //只返回有bitmap的字符
+    character_vec.erase(std::remove(character_vec.begin(),character_vec.end(),nullptr),character_vec.end());
+    return character_vec;
+}
 
-    //计算新生成的字符，在图集中的排列。
-    if(font_texture_fill_x+ft_bitmap.width>=font_texture_size_){//从左上角往右上角填充，满了就换一行。
-        font_texture_fill_x=0;
-        font_texture_fill_y+=font_size_;
+bool Font::LoadCodePoints(const std::vector<unsigned int>& code_points, std::vector<Character*>& character_vec) {
+    character_vec.resize(code_points.size());
+    if(code_points.empty()){
+        return true;
     }
-    if(font_texture_fill_y+font_size_>=font_texture_size_){
-        spdlog::error("{} is out of font_texture y",ch);
-        return;
+
+    //1. 优先使用已经包含最多字符的页，相同时选择最近使用的页。
+    Page* best_page= nullptr;
+    size_t best_hit_num=0;
+    for (auto page : pages_) {
+        size_t hit_num=0;
+        for (auto code_point : code_points) {
+            if(page->character_map_.find(code_point)!=page->character_map_.end()){
+                hit_num++;
+            }
+        }
+        if(best_page== nullptr || hit_num>best_hit_num || (hit_num==best_hit_num && page->last_use_frame_>best_page->last_use_frame_)){
+            best_page=page;
+            best_hit_num=hit_num;
+        }
     }
-    font_texture_->UpdateSubImage(font_texture_fill_x, font_texture_fill_y, ft_bitmap.width, ft_bitmap.rows,  GL_RED, GL_UNSIGNED_BYTE, ft_bitmap.buffer,ft_bitmap.width*ft_bitmap.rows*sizeof(GL_UNSIGNED_BYTE));
 
-    //存储字符信息
-    Character* character=new Character(font_texture_fill_x*1.0f/font_texture_size_,font_texture_fill_y*1.0f/font_texture_size_,(font_texture_fill_x+ft_bitmap.width)*1.0f/font_texture_size_,(font_texture_fill_y+ft_bitmap.rows)*1.0f/font_texture_size_);
-    character_map_[ch]=character;
+    //2. 放不下就换新的一页，或者淘汰最久没有使用的页。
+    Page* page=best_page;
+    if(page== nullptr || (best_hit_num<code_points.size() && LoadCharactersToPage(page,code_points)==false)){
+        page=AcquirePage();
+        if(page== nullptr){
+            spdlog::error("LoadCodePoints error,all font pages are in use this frame");
+            return false;
+        }
+        if(LoadCharactersToPage(page,code_points)==false){
+            spdlog::error("LoadCodePoints error,string too large for one font page");
+            return false;
+        }
+    }
+    page->last_use_frame_=frame_;
 
-    font_texture_fill_x+=ft_bitmap.width;
+    //返回所有字符信息
+    for (size_t i = 0; i < code_points.size(); ++i) {
+        auto iter=page->character_map_.find(code_points[i]);
+        character_vec[i]=iter==page->character_map_.end()? nullptr:iter->second;
+    }
+    return true;
 }
 
-std::vector<Font::Character*> Font::LoadStr(std::string str) {
-    //生成所有的字符 bitmap
-    for(auto ch : str){
-        LoadCharacter(ch);
+float Font::GetKerning(unsigned int left_code_point, unsigned int right_code_point) {
+    if(has_kerning_==false){
+        return 0;
     }
-    //返回所有字符信息
-    std::vector<Character*> character_vec;
-    for(auto ch : str){
-        auto character=character_map_[ch];
-        if(character==nullptr){
-            spdlog::error("LoadStr error,no bitmap,ch:{}",ch);
+    unsigned long long key=((unsigned long long)left_code_point<<32)|right_code_point;
+    auto iter=kerning_map_.find(key);
+    if(iter!=kerning_map_.end()){
+        return iter->second;
+    }
+    //主线程使用第0个FT_Face
+    FT_Face ft_face=thread_ft_faces_[0];
+    FT_Vector delta;
+    FT_Get_Kerning(ft_face,FT_Get_Char_Index(ft_face,left_code_point),FT_Get_Char_Index(ft_face,right_code_point),FT_KERNING_DEFAULT,&delta);
+    float kerning=delta.x/64.0f;
+    kerning_map_[key]=kerning;
+    return kerning;
+}
+
+void Font::TouchPage(unsigned short page) {
+    if(page<pages_.size()){
+        pages_[page]->last_use_frame_=frame_;
+    }
+}
+
+bool Font::LoadCharactersToPage(Page* page, const std::vector<unsigned int>& code_points) {
+    //找出页中缺少的字符，去重。
+    std::vector<unsigned int> missing_code_points;
+    for (auto code_point : code_points) {
+        if(page->character_map_.find(code_point)!=page->character_map_.end()){
+            continue;
+        }
+        if(std::find(missing_code_points.begin(),missing_code_points.end(),code_point)!=missing_code_points.end()){
             continue;
         }
-        character_vec.push_back(character);
+        missing_code_points.push_back(code_point);
     }
-    return character_vec;
+    if(missing_code_points.empty()){
+        return true;
+    }
+
+    //在工作线程并行生成bitmap，SDF生成比较耗时，并行收益明显。
+    std::vector<GlyphBitmap> glyph_bitmaps(missing_code_points.size());
+    JobSystem::ParallelFor((int)missing_code_points.size(),[&](int i){
+        RasterizeGlyph(missing_code_points[i],glyph_bitmaps[i]);
+    });
+
+    //装箱只能在一个线程里做
+    for (auto& glyph_bitmap : glyph_bitmaps) {
+        if(InsertGlyph(page,glyph_bitmap)==false){
+            return false;
+        }
+    }
+    return true;
+}
+
+void Font::RasterizeGlyph(unsigned int code_point, GlyphBitmap& glyph_bitmap) {
+    FT_Face ft_face=thread_ft_faces_[JobSystem::thread_index()];
+
+    //加载这个字的字形,加载到 ft_face 上面去;Glyph：字形，图形字符 [glif];
+    FT_Load_Glyph(ft_face, FT_Get_Char_Index(ft_face, code_point), FT_LOAD_DEFAULT);
+    //渲染为256级灰度图，或者有向距离场。
+    FT_Render_Glyph(ft_face->glyph, sdf_?FT_RENDER_MODE_SDF:FT_RENDER_MODE_NORMAL);
+
+    FT_GlyphSlot ft_glyph_slot=ft_face->glyph;
+    FT_Bitmap& ft_bitmap = ft_glyph_slot->bitmap;
+    glyph_bitmap.code_point_=code_point;
+    glyph_bitmap.width_=ft_bitmap.width;
+    glyph_bitmap.rows_=ft_bitmap.rows;
+    glyph_bitmap.left_=ft_glyph_slot->bitmap_left;
+    glyph_bitmap.top_=ft_glyph_slot->bitmap_top;
+    glyph_bitmap.advance_=ft_glyph_slot->advance.x/64.0f;
+    glyph_bitmap.buffer_.resize(ft_bitmap.width*ft_bitmap.rows);
+    for (unsigned int row = 0; row < ft_bitmap.rows; ++row) {
+        memcpy(glyph_bitmap.buffer_.data()+row*ft_bitmap.width, ft_bitmap.buffer+row*ft_bitmap.pitch, ft_bitmap.width);
+    }
+}
+
+bool Font::InsertGlyph(Page* page, const GlyphBitmap& glyph_bitmap) {
+    //计算新生成的字符，在图集中的位置，空格这种没有bitmap的字符不占位置。
+    int x=0,y=0;
+    if(glyph_bitmap.width_>0 && glyph_bitmap.rows_>0){
+        if(page->packer_->Insert(glyph_bitmap.width_+glyph_padding_,glyph_bitmap.rows_+glyph_padding_,x,y)==false){
+            return false;
+        }
+
+        //写入内存中的图集，记录需要上传的行范围。
+        for (int row = 0; row < glyph_bitmap.rows_; ++row) {
+            memcpy(page->pixels_+(y+row)*font_texture_size_+x, glyph_bitmap.buffer_.data()+row*glyph_bitmap.width_, glyph_bitmap.width_);
+        }
+        page->dirty_y_min_=std::min(page->dirty_y_min_,y);
+        page->dirty_y_max_=std::max(page->dirty_y_max_,y+glyph_bitmap.rows_);
+    }
+
+    //存储字符信息
+    Character* character=new Character(x*1.0f/font_texture_size_,y*1.0f/font_texture_size_,(x+glyph_bitmap.width_)*1.0f/font_texture_size_,(y+glyph_bitmap.rows_)*1.0f/font_texture_size_);
+    character->page_=(unsigned short)(std::find(pages_.begin(),pages_.end(),page)-pages_.begin());
+    character->font_texture_=page->font_texture_;
+    character->width_=glyph_bitmap.width_;
+    character->height_=glyph_bitmap.rows_;
+    character->bearing_x_=glyph_bitmap.left_;
+    character->bearing_y_=glyph_bitmap.top_;
+    character->advance_=glyph_bitmap.advance_;
+    page->character_map_[glyph_bitmap.code_point_]=character;
+    return true;
+}
+
+Font::Page* Font::AcquirePage() {
+    if(pages_.size()<max_page_num_){
+        Page* page=new Page();
+        page->packer_=new SkylinePacker(font_texture_size_,font_texture_size_);
+        //创建空白的、仅Alpha通道纹理，用于生成文字。
+        page->pixels_=(unsigned char *)malloc(font_texture_size_ * font_texture_size_);
+        memset(page->pixels_, 0,font_texture_size_*font_texture_size_);
+        page->dirty_y_min_=font_texture_size_;
+        page->dirty_y_max_=0;
+        page->font_texture_=Texture2D::Create(font_texture_size_,
+                                              font_texture_size_,
+                                              GL_RED,
+                                              GL_RED,
+                                              GL_LINEAR,
+                                              GL_LINEAR,
+                                              GL_CLAMP_TO_EDGE,
+                                              GL_CLAMP_TO_EDGE,
+                                              GL_UNSIGNED_BYTE,
+                                              page->pixels_,
+                                              font_texture_size_ * font_texture_size_);
+        page->last_use_frame_=frame_;
+        pages_.push_back(page);
+        return page;
+    }
+
+    //淘汰最久没有使用的页，本帧使用的页不能淘汰。
+    Page* lru_page= nullptr;
+    for (auto page : pages_) {
+        if(page->last_use_frame_==frame_){
+            continue;
+        }
+        if(lru_page== nullptr || page->last_use_frame_<lru_page->last_use_frame_){
+            lru_page=page;
+        }
+    }
+    if(lru_page== nullptr){
+        return nullptr;
+    }
+    ClearPage(lru_page);
+    lru_page->last_use_frame_=frame_;
+    atlas_version_++;
+    return lru_page;
 }
 
+void Font::ClearPage(Page* page) {
+    for (auto& pair : page->character_map_) {
+        delete pair.second;
+    }
+    page->character_map_.clear();
+    page->packer_->Reset();
+    //旧的像素也要清掉，否则线性过滤会采样到旧字形。
+    memset(page->pixels_, 0,font_texture_size_*font_texture_size_);
+    page->dirty_y_min_=0;
+    page->dirty_y_max_=font_texture_size_;
+}
 
+void Font::UploadDirtyPages() {
+    for (auto page : pages_) {
+        if(page->dirty_y_min_>=page->dirty_y_max_){
+            continue;
+        }
+        //上传整行，内存中连续，不需要再拷贝子区域。
+        int rows=page->dirty_y_max_-page->dirty_y_min_;
+        page->font_texture_->UpdateSubImage(0, page->dirty_y_min_, font_texture_size_, rows, GL_RED, GL_UNSIGNED_BYTE,
+                                            page->pixels_+page->dirty_y_min_*font_texture_size_, font_texture_size_*rows);
+        page->dirty_y_min_=font_texture_size_;
+        page->dirty_y_max_=0;
+    }
+}
 
+void Font::Flush() {
+    for (auto& pair : font_map_) {
+        if(pair.second!= nullptr){
+            pair.second->UploadDirtyPages();
+        }
+    }
+    frame_++;
+}
@@ -7,17 +7,27 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 #include "freetype/ftglyph.h"
 #include "glm/glm.hpp"
 
 class Texture2D;
+class SkylinePacker;
 class Font {
 public:
-    Texture2D* font_texture(){return font_texture_;}
+    ~Font();
 
-    /// freetype为字符生成bitmap
-    /// \param c
-    void LoadCharacter(char ch);
+    /// 第一页字形图集
+    Texture2D* font_texture(){return pages_.empty()? nullptr:pages_[0]->font_texture_;}
+
+    /// 生成字形的字号，SDF模式下显示任意字号都按 显示字号/font_size 缩放。
+    unsigned short font_size(){return font_size_;}
+
+    /// 是否SDF(有向距离场)模式，图集中存储的是到字形轮廓的距离，由Shader计算边缘。
+    bool sdf(){return sdf_;}
+
+    /// 行高，单位为像素(font_size字号下)。
+    float line_height(){return line_height_;}
 
     /// 记录单个字符在图集上的坐标、宽高，用于生成同尺寸的顶点数据，1：1渲染。
     struct Character{
@@ -25,29 +35,115 @@ public:
         float left_top_y_;
         float right_bottom_x_;
         float right_bottom_y_;
+        unsigned short page_;//所在图集页
+        Texture2D* font_texture_;//所在图集页的纹理
+        //字形度量，单位为像素(font_size字号下)。
+        unsigned short width_;//bitmap宽
+        unsigned short height_;//bitmap高
+        short bearing_x_;//基线起点到bitmap左边的距离
+        short bearing_y_;//基线到bitmap顶部的距离
+        float advance_;//画完这个字后，基线起点前进的距离
         Character(float left_top_x,float left_top_y,float right_bottom_x,float right_bottom_y){
             left_top_x_=left_top_x;
             left_top_y_=left_top_y;
             right_bottom_x_=right_bottom_x;
             right_bottom_y_=right_bottom_y;
+            page_=0;
+            font_texture_= nullptr;
+            width_=0;
+            height_=0;
+            bearing_x_=0;
+            bearing_y_=0;
+            advance_=0;
         }
     };
 
     /// 为字符串生成bitmap，返回字符串每个字符的Character数据。
-    /// \param str
+    /// 同一个字符串的字符保证在同一页图集上，这样一个UIText只需要一张纹理。
+    /// \param str UTF-8字符串
     /// \return
     std::vector<Character*> LoadStr(std::string str);
 
+    /// 为码点生成bitmap，结果写入character_vec，长度与code_points相同，没有bitmap的码点为nullptr。
+    /// character_vec的容量会被复用，字形都已经生成时不分配内存。
+    /// \return 失败返回false
+    bool LoadCodePoints(const std::vector<unsigned int>& code_points,std::vector<Character*>& character_vec);
+
+    /// 两个字符之间的字距调整，单位为像素(font_size字号下)，结果会缓存。
+    float GetKerning(unsigned int left_code_point,unsigned int right_code_point);
+
+    /// 标记图集页在本帧被使用，图集满了淘汰页时，跳过本帧使用的页。
+    void TouchPage(unsigned short page);
+
+    /// 图集页被淘汰重用后递增，UIText发现变化需要重新生成Mesh。
+    unsigned int atlas_version(){return atlas_version_;}
+
+    /// 最多创建的图集页数量，超过后淘汰最久没有使用的页。
+    void set_max_page_num(unsigned short max_page_num){max_page_num_=max_page_num;}
+
+private:
+    /// 一页字形图集
+    struct Page{
+        Texture2D* font_texture_= nullptr;
+        SkylinePacker* packer_= nullptr;
+        unsigned char* pixels_= nullptr;//内存中的图集像素，新字形先写到这里，每帧合并上传一次。
+        int dirty_y_min_;//需要上传的行范围[dirty_y_min_,dirty_y_max_)
+        int dirty_y_max_;
+        unsigned int last_use_frame_=0;
+        std::unordered_map<unsigned int,Character*> character_map_;//已经生成bitmap的字符 key:Unicode码点
+    };
+
+    /// freetype生成的字形
+    struct GlyphBitmap{
+        unsigned int code_point_;
+        int width_;
+        int rows_;
+        int left_;
+        int top_;
+        float advance_;
+        std::vector<unsigned char> buffer_;
+    };
+
+    /// 将字符串中缺少的字符生成到指定页，缺少的字符在工作线程并行生成bitmap。
+    /// \return 页放不下返回false
+    bool LoadCharactersToPage(Page* page,const std::vector<unsigned int>& code_points);
+
+    /// freetype为字符生成bitmap，可以在工作线程调用，每个线程使用自己的FT_Face。
+    void RasterizeGlyph(unsigned int code_point,GlyphBitmap& glyph_bitmap);
+
+    /// 将字形放入页，写入页的内存像素。
+    /// \return 页放不下返回false
+    bool InsertGlyph(Page* page,const GlyphBitmap& glyph_bitmap);
+
+    /// 为每个线程创建FT_Face，FreeType的FT_Face不能多线程同时使用。
+    /// \return 是否成功
+    bool CreateThreadFaces(int length);
+
+    /// 新建一页，已经达到最大页数时，淘汰最久没有使用的页。
+    /// \return 所有页都在本帧使用，返回nullptr
+    Page* AcquirePage();
+
+    /// 清空页中的字形
+    void ClearPage(Page* page);
+
+    /// 上传所有页中新生成的字形，每页一次。
+    void UploadDirtyPages();
+
 private:
     unsigned short font_size_=20;//默认字体大小
     char* font_file_buffer_= nullptr;//ttf字体文件加载到内存
-    FT_Library ft_library_;
-    FT_Face ft_face_;
-    Texture2D* font_texture_;
+    bool sdf_= false;
+    int sdf_spread_=8;//SDF的距离范围(像素)，字形四周也会扩展这么多像素
+    std::vector<FT_Library> thread_ft_libraries_;//每个线程一个，下标为 JobSystem::thread_index()
+    std::vector<FT_Face> thread_ft_faces_;
     unsigned short font_texture_size_=1024;
-    unsigned short font_texture_fill_x=0;//
-    unsigned short font_texture_fill_y=0;
-    std::unordered_map<char,Character*> character_map_;//已经生成bitmap的字符
+    unsigned short glyph_padding_=1;//字形之间的间隔，避免线性过滤采样到相邻字形
+    unsigned short max_page_num_=4;
+    std::vector<Page*> pages_;
+    unsigned int atlas_version_=0;
+    float line_height_=0;//行高
+    bool has_kerning_= false;//字体是否包含字距调整表
+    std::unordered_map<unsigned long long,float> kerning_map_;//字距调整缓存 key:左码点<<32|右码点
 
 public:
     /// 加载一个字体文件并解析
@@ -56,12 +152,28 @@ public:
     /// \return
     static Font* LoadFromFile(std::string font_file_path,unsigned short font_size);
 
+    /// 加载一个字体文件，以SDF模式生成字形，一张图集服务所有字号。
+    /// \param font_file_path ttf字体文件路径
+    /// \param font_size 生成SDF的字号，越大细节越好，一般48就够用。
+    /// \return
+    static Font* LoadSDFFromFile(std::string font_file_path,unsigned short font_size=48);
+
     /// 获取Font实例
     /// \param font_file_path ttf路径
     /// \return
     static Font* GetFont(std::string font_file_path);
+
+    /// 将UTF-8字符串解码为Unicode码点，非法字节跳过。
+    static void DecodeUTF8(const std::string& str,std::vector<unsigned int>& code_points);
+
+    /// 每帧调用一次，上传所有字体本帧新生成的字形。
+    static void Flush();
+
 private:
+    static Font* Load(const std::string& font_file_path,unsigned short font_size,bool sdf);
+
     static std::unordered_map<std::string,Font*> font_map_;//存储加载的字体 key：ttf路径 value：Font实例
+    static unsigned int frame_;//Flush的次数，用作LRU的时间
 };
 
 
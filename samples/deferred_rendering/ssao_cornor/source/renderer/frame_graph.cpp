@@ -0,0 +1,237 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "frame_graph.h"
+#include <algorithm>
+#include "easy/profiler.h"
+#include "camera.h"
+#include "render_texture.h"
+#include "texture_2d.h"
+#include "render_device/render_task_producer.h"
+#include "utils/debug.h"
+
+bool FrameGraph::enable_=false;
+bool FrameGraph::dirty_=true;
+std::vector<FrameGraph::Pass> FrameGraph::pass_vec_;
+std::vector<Camera*> FrameGraph::camera_vec_;
+std::vector<FrameGraph::Lifetime> FrameGraph::lifetime_vec_;
+std::vector<FrameGraph::Physical> FrameGraph::physical_vec_;
+std::unordered_map<RenderTexture*,RenderTexture*> FrameGraph::alias_map_;
+unsigned int FrameGraph::culled_pass_num_=0;
+unsigned int FrameGraph::transient_render_texture_num_=0;
+
+void FrameGraph::Remove(RenderTexture* render_texture) {
+    if(render_texture->transient()==false){
+        return;
+    }
+    alias_map_.erase(render_texture);
+    dirty_=true;
+}
+
+const std::vector<Camera*>& FrameGraph::Compile(const std::vector<Camera*>& all_camera) {
+    if(dirty_==false){
+        return camera_vec_;
+    }
+    EASY_FUNCTION();
+    pass_vec_.clear();
+    for (auto camera : all_camera) {
+        pass_vec_.push_back({camera,false,0,{}});
+    }
+    Cull(pass_vec_);
+    Sort(pass_vec_);
+    Allocate();
+    dirty_=false;
+
+    DEBUG_LOG_INFO("frame graph compiled, pass:{} culled:{} transient render texture:{} physical:{}",
+                   camera_vec_.size(),culled_pass_num_,transient_render_texture_num_,physical_vec_.size());
+    return camera_vec_;
+}
+
+void FrameGraph::Cull(std::vector<Pass>& pass_vec) {
+    //渲染到屏幕、或者写入非临时RenderTexture(可能被外部使用)的Pass，结果一定被使用。
+    std::vector<unsigned int> live_stack;
+    for (unsigned int i = 0; i < pass_vec.size(); ++i) {
+        RenderTexture* target=pass_vec[i].camera_->target_render_texture();
+        if(target== nullptr || target->transient()==false){
+            pass_vec[i].live_=true;
+            live_stack.push_back(i);
+        }
+    }
+    //从这些Pass往前找，写入它们输入的Pass，结果也被使用。
+    while(live_stack.empty()==false){
+        Camera* camera=pass_vec[live_stack.back()].camera_;
+        live_stack.pop_back();
+        for (auto input : camera->input_render_textures()) {
+            for (unsigned int i = 0; i < pass_vec.size(); ++i) {
+                if(pass_vec[i].live_==false && pass_vec[i].camera_->target_render_texture()==input){
+                    pass_vec[i].live_=true;
+                    live_stack.push_back(i);
+                }
+            }
+        }
+    }
+    culled_pass_num_=0;
+    for (auto& pass : pass_vec) {
+        if(pass.live_==false){
+            culled_pass_num_++;
+        }
+    }
+}
+
+void FrameGraph::Sort(std::vector<Pass>& pass_vec) {
+    //写入RenderTexture的Pass，排在读取它的Pass之前。多个Pass写入同一个RenderTexture时，按depth顺序。
+    for (unsigned int i = 0; i < pass_vec.size(); ++i) {
+        if(pass_vec[i].live_==false){
+            continue;
+        }
+        Camera* camera=pass_vec[i].camera_;
+        for (unsigned int j = 0; j < pass_vec.size(); ++j) {
+            if(j==i || pass_vec[j].live_==false){
+                continue;
+            }
+            RenderTexture* target=pass_vec[j].camera_->target_render_texture();
+            if(target== nullptr){
+                continue;
+            }
+            const std::vector<RenderTexture*>& inputs=camera->input_render_textures();
+            bool read=std::find(inputs.begin(),inputs.end(),target)!=inputs.end();
+            bool write_before=j<i && target==camera->target_render_texture();
+            if(read || write_before){
+                pass_vec[j].next_vec_.push_back(i);
+                pass_vec[i].dependency_num_++;
+            }
+        }
+    }
+
+    //拓扑排序，每次取depth最小的没有前置依赖的Pass，没有依赖关系的相机保持原来的顺序。
+    camera_vec_.clear();
+    std::vector<bool> done(pass_vec.size(),false);
+    while(true){
+        int ready=-1;
+        for (unsigned int i = 0; i < pass_vec.size(); ++i) {
+            if(pass_vec[i].live_ && done[i]==false && pass_vec[i].dependency_num_==0){
+                ready=(int)i;
+                break;
+            }
+        }
+        if(ready<0){
+            break;
+        }
+        done[ready]=true;
+        camera_vec_.push_back(pass_vec[ready].camera_);
+        for (auto next : pass_vec[ready].next_vec_) {
+            pass_vec[next].dependency_num_--;
+        }
+    }
+    //循环依赖，剩下的Pass按depth顺序渲染。
+    for (unsigned int i = 0; i < pass_vec.size(); ++i) {
+        if(pass_vec[i].live_ && done[i]==false){
+            DEBUG_LOG_ERROR("frame graph cycle at camera depth {}",pass_vec[i].camera_->depth());
+            camera_vec_.push_back(pass_vec[i].camera_);
+        }
+    }
+}
+
+void FrameGraph::Allocate() {
+    //临时RenderTexture的生命周期：从第一个读写它的Pass到最后一个读写它的Pass。
+    lifetime_vec_.clear();
+    auto touch=[](RenderTexture* render_texture,unsigned int pass_index){
+        if(render_texture== nullptr || render_texture->transient()==false){
+            return;
+        }
+        for (auto& lifetime : lifetime_vec_) {
+            if(lifetime.render_texture_==render_texture){
+                lifetime.last_pass_=pass_index;
+                return;
+            }
+        }
+        lifetime_vec_.push_back({render_texture,pass_index,pass_index});
+    };
+    for (unsigned int i = 0; i < camera_vec_.size(); ++i) {
+        touch(camera_vec_[i]->target_render_texture(),i);
+        for (auto input : camera_vec_[i]->input_render_textures()) {
+            touch(input,i);
+        }
+    }
+    transient_render_texture_num_=(unsigned int)lifetime_vec_.size();
+    std::stable_sort(lifetime_vec_.begin(),lifetime_vec_.end(),[](const Lifetime& a,const Lifetime& b){
+        return a.first_pass_<b.first_pass_;
+    });
+
+    //按开始时间依次分配，优先沿用上一次的分配，避免重新映射。
+    for (auto& physical : physical_vec_) {
+        physical.used_=false;
+        physical.last_pass_=0;
+    }
+    for (auto& lifetime : lifetime_vec_) {
+        RenderTexture* render_texture=lifetime.render_texture_;
+        auto free=[&lifetime,render_texture](const Physical& physical){
+            return physical.render_texture_->Compatible(render_texture) && (physical.used_==false || physical.last_pass_<lifetime.first_pass_);
+        };
+        Physical* target= nullptr;
+        auto iter=alias_map_.find(render_texture);
+        if(iter!=alias_map_.end()){
+            for (auto& physical : physical_vec_) {
+                if(physical.render_texture_==iter->second && free(physical)){
+                    target=&physical;
+                    break;
+                }
+            }
+        }
+        if(target== nullptr){
+            for (auto& physical : physical_vec_) {
+                if(free(physical)){
+                    target=&physical;
+                    break;
+                }
+            }
+        }
+        if(target== nullptr){
+            physical_vec_.push_back({render_texture->CreateCompatible(),0,false});
+            target=&physical_vec_.back();
+        }
+        target->used_=true;
+        target->last_pass_=lifetime.last_pass_;
+        Alias(render_texture,target->render_texture_);
+    }
+
+    //删除不再使用的显存
+    for (auto iter=physical_vec_.begin();iter!=physical_vec_.end();){
+        if(iter->used_){
+            iter++;
+            continue;
+        }
+        RenderTexture* physical=iter->render_texture_;
+        iter=physical_vec_.erase(iter);
+        for (auto alias_iter=alias_map_.begin();alias_iter!=alias_map_.end();){
+            if(alias_iter->second==physical){
+                alias_iter=alias_map_.erase(alias_iter);
+            }else{
+                alias_iter++;
+            }
+        }
+        delete physical;
+    }
+}
+
+void FrameGraph::Alias(RenderTexture* render_texture, RenderTexture* physical) {
+    auto iter=alias_map_.find(render_texture);
+    if(iter!=alias_map_.end() && iter->second==physical){
+        return;
+    }
+    alias_map_[render_texture]=physical;
+
+    std::vector<Texture2D*> texture_vec;
+    std::vector<Texture2D*> physical_texture_vec;
+    render_texture->GetTextures(texture_vec);
+    physical->GetTextures(physical_texture_vec);
+    std::vector<unsigned int> texture_handle_vec;
+    std::vector<unsigned int> physical_texture_handle_vec;
+    for (size_t i = 0; i < texture_vec.size(); ++i) {
+        texture_handle_vec.push_back(texture_vec[i]->texture_handle());
+        physical_texture_handle_vec.push_back(physical_texture_vec[i]->texture_handle());
+    }
+    RenderTaskProducer::ProduceRenderTaskAliasRenderTexture(render_texture->frame_buffer_object_handle(),physical->frame_buffer_object_handle(),
+                                                            (int)texture_handle_vec.size(),texture_handle_vec.data(),physical_texture_handle_vec.data());
+}
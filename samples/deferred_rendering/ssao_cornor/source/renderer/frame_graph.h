@@ -0,0 +1,90 @@
+//
+// Created by captainchen on 2026/10/19.
+// 帧图：每个相机是一个Pass，写入目标RenderTexture，读取声明的输入RenderTexture。
+// 根据读写关系自动排序相机，剔除结果没有被使用的Pass，
+// 生命周期不重叠的临时RenderTexture共用同一份显存，相邻Pass写入同一个目标时不重复绑定FBO。
+//
+
+#ifndef UNTITLED_FRAME_GRAPH_H
+#define UNTITLED_FRAME_GRAPH_H
+
+#include <vector>
+#include <unordered_map>
+
+class Camera;
+class RenderTexture;
+class FrameGraph {
+public:
+    /// 是否使用帧图调度相机，关闭时按相机depth顺序渲染。
+    static bool enable(){return enable_;}
+    static void set_enable(bool enable){enable_=enable;dirty_=true;}
+
+    /// 相机、读写关系变化后，下一帧重新编译。
+    static void SetDirty(){dirty_=true;}
+
+    /// RenderTexture销毁时移除分配关系
+    static void Remove(RenderTexture* render_texture);
+
+    /// 编译帧图，没有变化时直接返回上一次的结果。
+    /// \param all_camera 按depth排序的所有相机
+    /// \return 排序、剔除后需要渲染的相机
+    static const std::vector<Camera*>& Compile(const std::vector<Camera*>& all_camera);
+
+    /// 上一次编译剔除的Pass数量
+    static unsigned int culled_pass_num(){return culled_pass_num_;}
+
+    /// 上一次编译的临时RenderTexture数量
+    static unsigned int transient_render_texture_num(){return transient_render_texture_num_;}
+
+    /// 实际创建的临时RenderTexture数量
+    static unsigned int physical_render_texture_num(){return (unsigned int)physical_vec_.size();}
+
+private:
+    /// 一个Pass，对应一个相机。
+    struct Pass{
+        Camera* camera_;
+        bool live_;//结果被使用
+        unsigned int dependency_num_;//排序时还没有执行的前置Pass数量
+        std::vector<unsigned int> next_vec_;//依赖这个Pass的Pass
+    };
+
+    /// 临时RenderTexture的生命周期，按排序后的Pass序号。
+    struct Lifetime{
+        RenderTexture* render_texture_;
+        unsigned int first_pass_;
+        unsigned int last_pass_;
+    };
+
+    /// 实际创建的RenderTexture
+    struct Physical{
+        RenderTexture* render_texture_;
+        unsigned int last_pass_;//最后使用的Pass，之后的临时RenderTexture可以复用。
+        bool used_;//本次编译是否分配
+    };
+
+    /// 剔除结果没有被使用的Pass
+    static void Cull(std::vector<Pass>& pass_vec);
+
+    /// 按读写依赖拓扑排序，没有依赖的Pass保持depth顺序。
+    static void Sort(std::vector<Pass>& pass_vec);
+
+    /// 为临时RenderTexture分配实际的显存，生命周期不重叠的共用。
+    static void Allocate();
+
+    /// 把临时RenderTexture的句柄映射到实际创建的RenderTexture
+    static void Alias(RenderTexture* render_texture,RenderTexture* physical);
+
+private:
+    static bool enable_;
+    static bool dirty_;
+    static std::vector<Pass> pass_vec_;
+    static std::vector<Camera*> camera_vec_;//排序、剔除后的相机
+    static std::vector<Lifetime> lifetime_vec_;
+    static std::vector<Physical> physical_vec_;//实际创建的RenderTexture
+    static std::unordered_map<RenderTexture*,RenderTexture*> alias_map_;//临时RenderTexture当前映射到的实际RenderTexture
+    static unsigned int culled_pass_num_;
+    static unsigned int transient_render_texture_num_;
+};
+
+
+#endif //UNTITLED_FRAME_GRAPH_H
@@ -15,6 +15,8 @@ using std::ios;
 using std::cout;
 using std::endl;
 
+std::unordered_map<std::string,Texture2D*> Material::global_textures_;
+
 Material::Material() = default;
 
 Material::~Material() = default;
@@ -75,6 +77,14 @@ void Material::SetUniformMatrix4f(const std::string& shader_property_name,glm::m
     uniform_matrix4f_map_[shader_property_name]= value;
 }
 
+Texture2D* Material::GetGlobalTexture(const std::string& property) {
+    auto iter=global_textures_.find(property);
+    if(iter==global_textures_.end()){
+        return nullptr;
+    }
+    return iter->second;
+}
+
 void Material::SetTexture(const string& property, Texture2D *texture2D) {
     for (auto& pair : textures_){
         if(pair.first==property){
@@ -39,6 +39,14 @@ public:
     std::unordered_map<std::string,glm::vec3>& uniform_3f_map(){return uniform_3f_map_;}
     std::unordered_map<std::string,glm::mat4>& uniform_matrix4f_map(){return uniform_matrix4f_map_;}
 
+    /// 设置全局纹理，材质中声明了这个纹理但没有设置时使用，例如光源分簇的索引纹理。
+    /// \param property
+    /// \param texture2D
+    static void SetGlobalTexture(const std::string& property, Texture2D* texture2D){global_textures_[property]=texture2D;}
+
+    /// 获取全局纹理，没有设置返回nullptr
+    static Texture2D* GetGlobalTexture(const std::string& property);
+
 private:
     Shader* shader_{};
     std::vector<std::pair<std::string,Texture2D*>> textures_;
@@ -48,6 +56,8 @@ private:
     std::unordered_map<std::string,glm::vec3> uniform_3f_map_;
 
     std::unordered_map<std::string,glm::mat4> uniform_matrix4f_map_;
+
+    static std::unordered_map<std::string,Texture2D*> global_textures_;//全局纹理
 };
 
 
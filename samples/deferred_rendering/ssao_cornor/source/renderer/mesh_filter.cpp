@@ -4,10 +4,13 @@
 
 
 #include "mesh_filter.h"
+#include <climits>
 #include <fstream>
 #include <rttr/registration>
 #include "app/application.h"
 #include "utils/debug.h"
+#include "utils/typed_buffer.h"
+#include "mesh_simplifier.h"
 
 using std::ifstream;
 using std::ios;
@@ -35,7 +38,6 @@ void MeshFilter::LoadMesh(string mesh_file_path) {
     //读取顶点索引数据
     unsigned short* vertex_index_data=(unsigned short*)malloc(mesh_file_head.vertex_index_num_*sizeof(unsigned short));
     input_file_stream.read((char*)vertex_index_data,mesh_file_head.vertex_index_num_*sizeof(unsigned short));
-    input_file_stream.close();
 
     mesh_=new Mesh();
     mesh_->name_=mesh_file_head.name_;
@@ -43,9 +45,69 @@ void MeshFilter::LoadMesh(string mesh_file_path) {
     mesh_->vertex_index_num_=mesh_file_head.vertex_index_num_;
     mesh_->vertex_data_=(Vertex*)vertex_data;
     mesh_->vertex_index_data_=vertex_index_data;
+    CalculateBoundingSphere();
+
+    //读取LOD块，旧的Mesh文件读到这里就结束了。
+    ClearLOD();
+    MeshFileLODHead mesh_file_lod_head;
+    input_file_stream.read((char*)&mesh_file_lod_head,sizeof(mesh_file_lod_head));
+    if(input_file_stream.gcount()==sizeof(mesh_file_lod_head) && strncmp(mesh_file_lod_head.type_,"LODs",4)==0){
+        if(mesh_file_lod_head.lod_num_<1 || mesh_file_lod_head.lod_num_>MESH_LOD_MAX_NUM){
+            DEBUG_LOG_ERROR("MeshFilter::LoadMesh {} invalid lod num {}",mesh_file_path,mesh_file_lod_head.lod_num_);
+            input_file_stream.close();
+            return;
+        }
+        lods_.push_back({mesh_,mesh_file_lod_head.lod0_screen_relative_height_});
+        for (int i = 1; i < mesh_file_lod_head.lod_num_; ++i) {
+            if(LoadLODLevel(input_file_stream)==false){
+                //文件被截断或者数据错误，丢弃整个LOD链，只使用LOD0。
+                DEBUG_LOG_ERROR("MeshFilter::LoadMesh {} lod {} is broken, lod chain dropped",mesh_file_path,i);
+                ClearLOD();
+                break;
+            }
+        }
+    }
+    input_file_stream.close();
+}
+
+bool MeshFilter::LoadLODLevel(ifstream& input_file_stream) {
+    MeshFileLODLevelHead lod_level_head;
+    input_file_stream.read((char*)&lod_level_head,sizeof(lod_level_head));
+    if(input_file_stream.gcount()!=sizeof(lod_level_head) || lod_level_head.vertex_num_==0
+        || lod_level_head.vertex_index_num_==0 || lod_level_head.vertex_index_num_%3!=0){
+        return false;
+    }
+    Mesh* lod_mesh=new Mesh();
+    lod_mesh->name_=mesh_->name_;
+    lod_mesh->vertex_num_=lod_level_head.vertex_num_;
+    lod_mesh->vertex_index_num_=lod_level_head.vertex_index_num_;
+    std::streamsize vertex_data_size=lod_level_head.vertex_num_*sizeof(Vertex);
+    lod_mesh->vertex_data_=(Vertex*)malloc(vertex_data_size);
+    input_file_stream.read((char*)lod_mesh->vertex_data_,vertex_data_size);
+    if(input_file_stream.gcount()!=vertex_data_size){
+        delete lod_mesh;
+        return false;
+    }
+    std::streamsize vertex_index_data_size=lod_level_head.vertex_index_num_*sizeof(unsigned short);
+    lod_mesh->vertex_index_data_=(unsigned short*)malloc(vertex_index_data_size);
+    input_file_stream.read((char*)lod_mesh->vertex_index_data_,vertex_index_data_size);
+    if(input_file_stream.gcount()!=vertex_index_data_size){
+        delete lod_mesh;
+        return false;
+    }
+    //索引不能超出这一级的顶点
+    for (unsigned short i = 0; i < lod_mesh->vertex_index_num_; ++i) {
+        if(lod_mesh->vertex_index_data_[i]>=lod_mesh->vertex_num_){
+            delete lod_mesh;
+            return false;
+        }
+    }
+    lods_.push_back({lod_mesh,lod_level_head.screen_relative_height_});
+    return true;
 }
 
 void MeshFilter::CreateMesh(std::vector<Vertex> &vertex_data, std::vector<unsigned short> &vertex_index_data) {
+    ClearLOD();
     if(mesh_!= nullptr){
         delete mesh_;
         mesh_=nullptr;
@@ -56,14 +118,16 @@ void MeshFilter::CreateMesh(std::vector<Vertex> &vertex_data, std::vector<unsign
 
     unsigned short vertex_data_size= mesh_->vertex_num_ * sizeof(Vertex);
     mesh_->vertex_data_= static_cast<Vertex *>(malloc(vertex_data_size));
-    memcpy(mesh_->vertex_data_, &vertex_data[0], vertex_data_size);
+    memcpy((void*)mesh_->vertex_data_, &vertex_data[0], vertex_data_size);
 
     unsigned short vertex_index_data_size=mesh_->vertex_num_ * sizeof(Vertex);
     mesh_->vertex_index_data_= static_cast<unsigned short *>(malloc(vertex_index_data_size));
     memcpy(mesh_->vertex_index_data_,&vertex_index_data[0],vertex_index_data_size);
+    CalculateBoundingSphere();
 }
 
 void MeshFilter::CreateMesh(std::vector<float>& vertex_data,std::vector<unsigned short>& vertex_index_data){
+    ClearLOD();
     if(mesh_!= nullptr){
         delete mesh_;
         mesh_=nullptr;
@@ -74,17 +138,185 @@ void MeshFilter::CreateMesh(std::vector<float>& vertex_data,std::vector<unsigned
 
     unsigned short vertex_data_size= mesh_->vertex_num_ * sizeof(Vertex);
     mesh_->vertex_data_= static_cast<Vertex *>(malloc(vertex_data_size));
-    memcpy(mesh_->vertex_data_, &vertex_data[0], vertex_data_size);
+    memcpy((void*)mesh_->vertex_data_, &vertex_data[0], vertex_data_size);
 
     unsigned short vertex_index_data_size=mesh_->vertex_index_num_ * sizeof(unsigned short);
     mesh_->vertex_index_data_= static_cast<unsigned short *>(malloc(vertex_index_data_size));
     memcpy(mesh_->vertex_index_data_,&vertex_index_data[0],vertex_index_data_size);
+    CalculateBoundingSphere();
+}
+
+void MeshFilter::CreateMesh(TypedBuffer* vertex_data, TypedBuffer* vertex_index_data) {
+    if(vertex_data== nullptr || vertex_index_data== nullptr){
+        DEBUG_LOG_ERROR("MeshFilter::CreateMesh vertex_data or vertex_index_data is nullptr");
+        return;
+    }
+    if(vertex_data->type()!=TypedBuffer::Type::FLOAT32 || vertex_index_data->type()!=TypedBuffer::Type::UINT16){
+        DEBUG_LOG_ERROR("MeshFilter::CreateMesh need float32 vertex buffer and uint16 index buffer");
+        return;
+    }
+    size_t float_num_per_vertex=sizeof(Vertex)/sizeof(float);//一个vertex由12个float组成。
+    if(vertex_data->length()%float_num_per_vertex!=0){
+        DEBUG_LOG_ERROR("MeshFilter::CreateMesh vertex buffer length {} is not a multiple of {}",vertex_data->length(),float_num_per_vertex);
+        return;
+    }
+    //Mesh的顶点个数、索引个数是unsigned short
+    size_t vertex_num=vertex_data->length()/float_num_per_vertex;
+    size_t vertex_index_num=vertex_index_data->length();
+    if(vertex_num==0 || vertex_index_num==0 || vertex_num>USHRT_MAX || vertex_index_num>USHRT_MAX){
+        DEBUG_LOG_ERROR("MeshFilter::CreateMesh invalid vertex num {} or index num {}",vertex_num,vertex_index_num);
+        return;
+    }
+    //索引越界时绘制会读到顶点缓冲区之外
+    unsigned short* vertex_index_array=static_cast<unsigned short*>(vertex_index_data->data());
+    for (size_t i = 0; i < vertex_index_num; ++i) {
+        if(vertex_index_array[i]>=vertex_num){
+            DEBUG_LOG_ERROR("MeshFilter::CreateMesh index {} out of range,vertex num {}",vertex_index_array[i],vertex_num);
+            return;
+        }
+    }
+    ClearLOD();
+    if(mesh_!= nullptr){
+        delete mesh_;
+        mesh_=nullptr;
+    }
+    mesh_=new Mesh();
+    mesh_->vertex_num_=(unsigned short)vertex_num;
+    mesh_->vertex_index_num_=(unsigned short)vertex_index_num;
+    //缓冲区内存也是malloc分配的，Mesh析构时free。
+    mesh_->vertex_data_= static_cast<Vertex *>(vertex_data->Release());
+    mesh_->vertex_index_data_= static_cast<unsigned short *>(vertex_index_data->Release());
+    CalculateBoundingSphere();
+}
+
+void MeshFilter::set_vertex_relate_bone_infos(TypedBuffer* vertex_relate_bone_info_data) {
+    if(vertex_relate_bone_info_data== nullptr || vertex_relate_bone_info_data->type()!=TypedBuffer::Type::UINT8){
+        DEBUG_LOG_ERROR("MeshFilter::set_vertex_relate_bone_infos need uint8 buffer");
+        return;
+    }
+    //蒙皮按顶点个数读取，大小必须和顶点个数一致。
+    size_t vertex_num=mesh_==nullptr?0:mesh_->vertex_num_;
+    if(vertex_num==0 || vertex_relate_bone_info_data->byte_size()!=vertex_num*sizeof(VertexRelateBoneInfo)){
+        DEBUG_LOG_ERROR("MeshFilter::set_vertex_relate_bone_infos buffer byte size {} not match vertex num {}",
+                        vertex_relate_bone_info_data->byte_size(),vertex_num);
+        return;
+    }
+    if(vertex_relate_bone_infos_!=nullptr){
+        free(vertex_relate_bone_infos_);
+    }
+    vertex_relate_bone_infos_= static_cast<VertexRelateBoneInfo*>(vertex_relate_bone_info_data->Release());
 }
 
 const char* MeshFilter::GetMeshName() {
     return mesh_->name_;
 }
 
+void MeshFilter::GenerateLOD(unsigned char lod_num,float reduce_ratio) {
+    if(mesh_==nullptr){
+        DEBUG_LOG_ERROR("MeshFilter::GenerateLOD failed, mesh is null");
+        return;
+    }
+    ClearLOD();
+    if(lod_num>MESH_LOD_MAX_NUM){
+        lod_num=MESH_LOD_MAX_NUM;
+    }
+    //默认每一级屏幕占比减半，最后一级一直使用。
+    lods_.push_back({mesh_,0.5f});
+
+    std::vector<glm::vec3> positions(mesh_->vertex_num_);
+    std::vector<glm::vec2> uvs(mesh_->vertex_num_);
+    for (int i = 0; i < mesh_->vertex_num_; ++i) {
+        positions[i]=mesh_->vertex_data_[i].position_;
+        uvs[i]=mesh_->vertex_data_[i].uv_;
+    }
+    std::vector<unsigned short> indices(mesh_->vertex_index_data_,mesh_->vertex_index_data_+mesh_->vertex_index_num_);
+
+    for (int lod_level = 1; lod_level < lod_num; ++lod_level) {
+        size_t target_index_count=(size_t)(indices.size()*reduce_ratio)/3*3;
+        //每一级都在上一级的基础上简化，索引始终指向LOD0的顶点。
+        std::vector<unsigned short> lod_indices=MeshSimplifier::Simplify(positions,uvs,indices,target_index_count);
+        if(lod_indices.empty() || lod_indices.size()>=indices.size()){
+            break;//已经简化不动了
+        }
+        indices=lod_indices;
+        std::vector<unsigned short> remap=MeshSimplifier::CompactVertices(lod_indices,mesh_->vertex_num_);
+
+        Mesh* lod_mesh=new Mesh();
+        lod_mesh->name_=mesh_->name_;
+        lod_mesh->vertex_num_=remap.size();
+        lod_mesh->vertex_index_num_=lod_indices.size();
+        lod_mesh->vertex_data_=(Vertex*)malloc(remap.size()*sizeof(Vertex));
+        for (size_t i = 0; i < remap.size(); ++i) {
+            lod_mesh->vertex_data_[i]=mesh_->vertex_data_[remap[i]];
+        }
+        lod_mesh->vertex_index_data_=(unsigned short*)malloc(lod_indices.size()*sizeof(unsigned short));
+        memcpy(lod_mesh->vertex_index_data_,lod_indices.data(),lod_indices.size()*sizeof(unsigned short));
+
+        lods_.back().screen_relative_height_=0.5f/(1<<(lod_level-1));
+        lods_.push_back({lod_mesh,0.f});
+    }
+    if(lods_.size()==1){
+        lods_.clear();
+    }
+}
+
+void MeshFilter::set_lod_screen_relative_height(unsigned char lod_level,float screen_relative_height) {
+    if(lod_level>=lods_.size()){
+        DEBUG_LOG_ERROR("MeshFilter::set_lod_screen_relative_height failed, lod_level {} out of range",lod_level);
+        return;
+    }
+    lods_[lod_level].screen_relative_height_=screen_relative_height;
+}
+
+unsigned char MeshFilter::SelectLOD(float screen_relative_height,unsigned char current_lod_level) {
+    if(lods_.empty()){
+        return 0;
+    }
+    unsigned char lod_level=current_lod_level;
+    unsigned char last_lod_level=lods_.size()-1;
+    if(lod_level>last_lod_level){
+        lod_level=last_lod_level;
+    }
+    //变小到低于当前级别阈值一定比例，才切换到更粗的级别。
+    while(lod_level<last_lod_level && screen_relative_height<lods_[lod_level].screen_relative_height_*(1.f-lod_hysteresis_)){
+        lod_level++;
+    }
+    //变大到超过上一级阈值一定比例，才切换到更细的级别。
+    while(lod_level>0 && screen_relative_height>=lods_[lod_level-1].screen_relative_height_*(1.f+lod_hysteresis_)){
+        lod_level--;
+    }
+    return lod_level;
+}
+
+void MeshFilter::CalculateBoundingSphere() {
+    if(mesh_==nullptr || mesh_->vertex_num_==0){
+        bounding_sphere_center_=glm::vec3(0.f);
+        bounding_sphere_radius_=0.f;
+        return;
+    }
+    //用AABB中心作为球心
+    glm::vec3 min_position=mesh_->vertex_data_[0].position_;
+    glm::vec3 max_position=min_position;
+    for (int i = 1; i < mesh_->vertex_num_; ++i) {
+        min_position=glm::min(min_position,mesh_->vertex_data_[i].position_);
+        max_position=glm::max(max_position,mesh_->vertex_data_[i].position_);
+    }
+    bounding_sphere_center_=(min_position+max_position)*0.5f;
+    float radius=0.f;
+    for (int i = 0; i < mesh_->vertex_num_; ++i) {
+        radius=glm::max(radius,glm::length(mesh_->vertex_data_[i].position_-bounding_sphere_center_));
+    }
+    bounding_sphere_radius_=radius;
+}
+
+void MeshFilter::ClearLOD() {
+    for (size_t i = 1; i < lods_.size(); ++i) {
+        delete lods_[i].mesh_;
+    }
+    lods_.clear();
+    mesh_version_++;
+}
+
 void MeshFilter::LoadWeight(string weight_file_path) {
     //读取 Mesh文件头
     ifstream input_file_stream(Application::data_path()+weight_file_path,ios::in | ios::binary);
@@ -112,6 +344,7 @@ void MeshFilter::LoadWeight(string weight_file_path) {
 
 
 MeshFilter::~MeshFilter() {
+    ClearLOD();
     if(mesh_!=nullptr) {
         delete mesh_;
         mesh_=nullptr;
@@ -121,7 +354,7 @@ MeshFilter::~MeshFilter() {
         skinned_mesh_=nullptr;
     }
     if(vertex_relate_bone_infos_!=nullptr) {
-        delete vertex_relate_bone_infos_;
+        free(vertex_relate_bone_infos_);
         vertex_relate_bone_infos_=nullptr;
     }
 }
@@ -5,13 +5,17 @@
 #ifndef UNTITLED_MESH_FILTER_H
 #define UNTITLED_MESH_FILTER_H
 
+#include <fstream>
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
 #include "component/component.h"
 
+#define MESH_LOD_MAX_NUM 8 //最大LOD级别数量
+
 using std::string;
 
+class TypedBuffer;
 
 class MeshFilter:public Component{
 public:
@@ -68,7 +72,28 @@ public:
         }
     };
 
-    /// 加载Mesh文件
+    /// Mesh文件LOD块头，紧跟在LOD0数据之后，旧的Mesh文件没有这个块。
+    /// 后面依次是LOD1~LODn，每一级都是 MeshFileLODLevelHead + 顶点数据 + 索引数据。
+    struct MeshFileLODHead{
+        char type_[4];//LOD块标记 "LODs"
+        unsigned short lod_num_;//LOD级别个数，包含LOD0
+        float lod0_screen_relative_height_;//LOD0的切换屏幕占比
+    };
+
+    /// Mesh文件中单个LOD级别的头
+    struct MeshFileLODLevelHead{
+        float screen_relative_height_;//切换屏幕占比
+        unsigned short vertex_num_;//顶点个数
+        unsigned short vertex_index_num_;//索引个数
+    };
+
+    /// LOD级别
+    struct LOD{
+        Mesh* mesh_;
+        float screen_relative_height_;//屏幕占比(包围球投影直径/屏幕高度)不小于这个值时使用这一级。
+    };
+
+    /// 加载Mesh文件，如果文件带有LOD块，同时加载LOD链。
     /// \param mesh_file_path
     void LoadMesh(string mesh_file_path);
     /// 创建 Mesh
@@ -81,12 +106,54 @@ public:
     /// \param vertex_index_data 所有的索引数据,以unsigned short数组形式从lua传过来
     void CreateMesh(std::vector<float>& vertex_data,std::vector<unsigned short>& vertex_index_data);
 
+    /// 创建Mesh，直接接管缓冲区的内存，不拷贝，之后两个缓冲区变为空。
+    /// 顶点、索引个数为0或者超过65535，索引超出顶点个数时不创建，缓冲区保持不变。
+    /// \param vertex_data float32缓冲区，每个顶点12个float。
+    /// \param vertex_index_data uint16缓冲区
+    void CreateMesh(TypedBuffer* vertex_data,TypedBuffer* vertex_index_data);
+
     /// 获取Mesh对象指针
     Mesh* mesh(){return mesh_;};
 
     /// 获取Mesh名
     const char* GetMeshName();
 
+    /// 用边折叠简化生成LOD链，替换已有的LOD1~LODn，离线工具没有生成LOD时使用。
+    /// \param lod_num LOD级别个数，包含LOD0
+    /// \param reduce_ratio 每一级相对上一级保留的三角形比例
+    void GenerateLOD(unsigned char lod_num,float reduce_ratio=0.5f);
+
+    /// LOD级别个数，包含LOD0，没有LOD链时为1。
+    unsigned char lod_num(){return lods_.empty()?1:lods_.size();}
+
+    /// 获取指定LOD级别的Mesh，级别超出范围返回nullptr。
+    Mesh* lod_mesh(unsigned char lod_level){
+        if(lods_.empty()){
+            return lod_level==0?mesh_:nullptr;
+        }
+        return lod_level<lods_.size()?lods_[lod_level].mesh_:nullptr;
+    }
+
+    /// Mesh或者LOD链被替换的次数，MeshRenderer据此重新创建VAO。
+    unsigned int mesh_version(){return mesh_version_;}
+
+    /// 设置指定LOD级别的切换屏幕占比
+    void set_lod_screen_relative_height(unsigned char lod_level,float screen_relative_height);
+
+    /// LOD切换的滞后比例，防止在切换边界上来回跳。
+    float lod_hysteresis(){return lod_hysteresis_;}
+    void set_lod_hysteresis(float lod_hysteresis){lod_hysteresis_=lod_hysteresis;}
+
+    /// 根据屏幕占比选择LOD级别，带滞后。
+    /// \param screen_relative_height 屏幕占比
+    /// \param current_lod_level 上一次选择的级别
+    /// \return 新的LOD级别
+    unsigned char SelectLOD(float screen_relative_height,unsigned char current_lod_level);
+
+    /// 模型空间包围球
+    glm::vec3& bounding_sphere_center(){return bounding_sphere_center_;}
+    float bounding_sphere_radius(){return bounding_sphere_radius_;}
+
     /// 顶点关联骨骼及权重,每个顶点最多可以关联4个骨骼。
     struct VertexRelateBoneInfo{
         char bone_index_[4];//骨骼索引，一般骨骼少于128个，用char就行。
@@ -101,16 +168,20 @@ public:
     /// 每个顶点按照 bone_index_[4] bone_weight_[4] 的顺序存储，
     void set_vertex_relate_bone_infos(std::vector<int>& vertex_relate_bone_info_data){
         if(vertex_relate_bone_infos_!=nullptr){
-            delete[] vertex_relate_bone_infos_;
+            free(vertex_relate_bone_infos_);
             vertex_relate_bone_infos_ = nullptr;
         }
         size_t data_size=vertex_relate_bone_info_data.size()*sizeof(char);
         vertex_relate_bone_infos_= static_cast<VertexRelateBoneInfo*>(malloc(data_size));
-        for (int i = 0; i < data_size; ++i) {
+        for (size_t i = 0; i < data_size; ++i) {
             ((char*)vertex_relate_bone_infos_)[i]=vertex_relate_bone_info_data[i];
         }
     }
 
+    /// 设置顶点关联骨骼信息，直接接管缓冲区的内存，不拷贝。
+    /// \param vertex_relate_bone_info_data uint8缓冲区，长度为顶点个数*8，格式同上，长度不一致时不设置。
+    void set_vertex_relate_bone_infos(TypedBuffer* vertex_relate_bone_info_data);
+
     /// 加载权重文件
     /// \param weight_file_path 权重文件路径
     void LoadWeight(string weight_file_path);
@@ -118,8 +189,23 @@ public:
     /// 获取蒙皮Mesh对象指针
     Mesh* skinned_mesh(){return skinned_mesh_;};
     void set_skinned_mesh(Mesh* skinned_mesh){skinned_mesh_ = skinned_mesh;};
+private:
+    /// 计算LOD0的包围球
+    void CalculateBoundingSphere();
+
+    /// 删除LOD1~LODn，LOD0就是mesh_，不在这里删除。替换Mesh、LOD链之前都会调用，同时增加mesh_version_。
+    void ClearLOD();
+
+    /// 读取Mesh文件中的一个LOD级别，添加到lods_。
+    /// \return 文件被截断或者数据错误时返回false
+    bool LoadLODLevel(std::ifstream& input_file_stream);
 private:
     Mesh* mesh_= nullptr;//Mesh对象
+    std::vector<LOD> lods_;//LOD链，lods_[0].mesh_就是mesh_，为空表示没有LOD。
+    unsigned int mesh_version_=0;//Mesh或者LOD链被替换的次数
+    float lod_hysteresis_=0.1f;//LOD切换滞后比例
+    glm::vec3 bounding_sphere_center_;//模型空间包围球中心
+    float bounding_sphere_radius_=0.f;//模型空间包围球半径
     Mesh* skinned_mesh_= nullptr;//蒙皮Mesh对象
     VertexRelateBoneInfo* vertex_relate_bone_infos_= nullptr;//顶点关联骨骼信息(4个骨骼索引、权重)，长度为顶点数
 
@@ -10,6 +10,7 @@
 #include <glm/gtx/euler_angles.hpp>
 #include "timetool/stopwatch.h"
 #include "easy/profiler.h"
+#include "easy/arbitrary_value.h"
 #include "material.h"
 #include "mesh_filter.h"
 #include "texture_2d.h"
@@ -29,6 +30,9 @@ RTTR_REGISTRATION
             .constructor<>()(rttr::policy::ctor::as_raw_ptr);
 }
 
+unsigned int MeshRenderer::lod_triangle_count_[MESH_LOD_MAX_NUM];
+unsigned int MeshRenderer::lod_draw_count_[MESH_LOD_MAX_NUM];
+
 MeshRenderer::MeshRenderer():Component(),material_(nullptr) {
 
 }
@@ -67,11 +71,7 @@ void MeshRenderer::Render() {
     }
 
     EASY_BLOCK("CalculateModelMatrix");
-    glm::mat4 trans = glm::translate(transform->position());
-    auto rotation=transform->rotation();
-    glm::mat4 eulerAngleYXZ = glm::eulerAngleYXZ(glm::radians(rotation.y), glm::radians(rotation.x), glm::radians(rotation.z));
-    glm::mat4 scale = glm::scale(transform->scale()); //缩放;
-    glm::mat4 model = trans*scale*eulerAngleYXZ;
+    glm::mat4 model = CalculateModelMatrix(transform);
 //    glm::mat4 mvp=projection*view * model;
     EASY_END_BLOCK;
 
@@ -83,29 +83,67 @@ void MeshRenderer::Render() {
     if(!mesh_filter){
         return;
     }
-    //当骨骼蒙皮动画生效时，渲染骨骼蒙皮Mesh
+    CheckMeshVersion(mesh_filter);
+    //当骨骼蒙皮动画生效时，渲染骨骼蒙皮Mesh。蒙皮Mesh每帧由CPU重新计算，不参与LOD。
     MeshFilter::Mesh* mesh=mesh_filter->skinned_mesh()== nullptr?mesh_filter->mesh():mesh_filter->skinned_mesh();
+    unsigned char lod_level=0;
+    if(mesh_filter->skinned_mesh()== nullptr && mesh_filter->lod_num()>1){
+        EASY_BLOCK("SelectLOD");
+        float screen_relative_height=CalculateScreenRelativeHeight(current_camera,mesh_filter,model);
+        lod_level=mesh_filter->SelectLOD(screen_relative_height,camera_lod_level_map_[current_camera]);
+        camera_lod_level_map_[current_camera]=lod_level;
+        mesh=mesh_filter->lod_mesh(lod_level);
+        EASY_END_BLOCK;
+    }
+    if(mesh==nullptr){
+        return;
+    }
 
     //指定目标Shader程序。
     EASY_BLOCK("GenerateBuffer");
     auto shader=material_->shader();
     GLuint shader_program_handle= shader->shader_program_handle();
 
-    if(vertex_array_object_handle_ == 0){
-        vertex_array_object_handle_=GPUResourceMapper::GenerateVAOHandle();
-        vertex_buffer_object_handle_=GPUResourceMapper::GenerateVBOHandle();
-        //发出任务：创建VAO
-        RenderTaskProducer::ProduceRenderTaskCreateVAO(shader_program_handle, vertex_array_object_handle_,
-                                                       vertex_buffer_object_handle_,
-                                                       mesh->vertex_num_ * sizeof(MeshFilter::Vertex),
-                                                       sizeof(MeshFilter::Vertex),
-                                                       mesh->vertex_data_,
-                                                       mesh->vertex_index_num_ * sizeof(unsigned short),
-                                                       mesh->vertex_index_data_);
-    }
-    else{
-        //发出任务：更新VBO
-        RenderTaskProducer::ProduceRenderTaskUpdateVBOSubData(vertex_buffer_object_handle_, mesh->vertex_num_ * sizeof(MeshFilter::Vertex),mesh->vertex_data_);
+    unsigned int vertex_array_object_handle=vertex_array_object_handle_;
+    if(lod_level==0){
+        if(vertex_array_object_handle_ == 0){
+            vertex_array_object_handle_=GPUResourceMapper::GenerateVAOHandle();
+            vertex_buffer_object_handle_=GPUResourceMapper::GenerateVBOHandle();
+            //发出任务：创建VAO
+            RenderTaskProducer::ProduceRenderTaskCreateVAO(shader_program_handle, vertex_array_object_handle_,
+                                                           vertex_buffer_object_handle_,
+                                                           mesh->vertex_num_ * sizeof(MeshFilter::Vertex),
+                                                           sizeof(MeshFilter::Vertex),
+                                                           mesh->vertex_data_,
+                                                           mesh->vertex_index_num_ * sizeof(unsigned short),
+                                                           mesh->vertex_index_data_);
+        }
+        else{
+            //发出任务：更新VBO
+            RenderTaskProducer::ProduceRenderTaskUpdateVBOSubData(vertex_buffer_object_handle_, mesh->vertex_num_ * sizeof(MeshFilter::Vertex),mesh->vertex_data_);
+        }
+        vertex_array_object_handle=vertex_array_object_handle_;
+    }else{
+        //LOD1~LODn是静态数据，创建一次VAO后不再更新，LOD链替换后在CheckMeshVersion中删除。
+        size_t lod_handle_num=mesh_filter->lod_num()-1;
+        if(lod_vertex_array_object_handles_.size()<lod_handle_num){
+            lod_vertex_array_object_handles_.resize(lod_handle_num,0);
+            lod_vertex_buffer_object_handles_.resize(lod_handle_num,0);
+        }
+        unsigned int& lod_vertex_array_object_handle=lod_vertex_array_object_handles_[lod_level-1];
+        if(lod_vertex_array_object_handle == 0){
+            lod_vertex_array_object_handle=GPUResourceMapper::GenerateVAOHandle();
+            lod_vertex_buffer_object_handles_[lod_level-1]=GPUResourceMapper::GenerateVBOHandle();
+            //发出任务：创建VAO
+            RenderTaskProducer::ProduceRenderTaskCreateVAO(shader_program_handle, lod_vertex_array_object_handle,
+                                                           lod_vertex_buffer_object_handles_[lod_level-1],
+                                                           mesh->vertex_num_ * sizeof(MeshFilter::Vertex),
+                                                           sizeof(MeshFilter::Vertex),
+                                                           mesh->vertex_data_,
+                                                           mesh->vertex_index_num_ * sizeof(unsigned short),
+                                                           mesh->vertex_index_data_);
+        }
+        vertex_array_object_handle=lod_vertex_array_object_handle;
     }
     EASY_END_BLOCK;
 
@@ -114,7 +152,9 @@ void MeshRenderer::Render() {
         // PreRender
         EASY_BLOCK("PreRender");
         game_object()->ForeachComponent([](Component* component){
-            component->OnPreRender();
+            if(component->NeedCallHook(COMPONENT_HOOK_ON_PRE_RENDER)){
+                component->OnPreRender();
+            }
         });
         EASY_END_BLOCK;
 
@@ -133,13 +173,17 @@ void MeshRenderer::Render() {
 
         //上传Texture
         std::vector<std::pair<std::string,Texture2D*>> textures=material_->textures();
-        for (int texture_index = 0; texture_index < textures.size(); ++texture_index) {
+        for (size_t texture_index = 0; texture_index < textures.size(); ++texture_index) {
             Texture2D* texture_2d=textures[texture_index].second;
             if(texture_2d==nullptr){
-                continue;
+                //材质没有设置，使用全局纹理。
+                texture_2d=Material::GetGlobalTexture(textures[texture_index].first);
+                if(texture_2d==nullptr){
+                    continue;
+                }
             }
             //激活纹理单元,将加载的图片纹理句柄，绑定到纹理单元上。
-            RenderTaskProducer::ProduceRenderTaskActiveAndBindTexture(textures[texture_index].first,GL_TEXTURE0+texture_index,textures[texture_index].second->texture_handle());
+            RenderTaskProducer::ProduceRenderTaskActiveAndBindTexture(textures[texture_index].first,GL_TEXTURE0+texture_index,texture_2d->texture_handle());
             //设置Shader程序从纹理单元读取颜色数据
             RenderTaskProducer::ProduceRenderTaskSetUniform1i(shader_program_handle,textures[texture_index].first.c_str(),texture_index);
         }
@@ -163,14 +207,116 @@ void MeshRenderer::Render() {
         }
 
         // 绑定VAO并绘制
-        RenderTaskProducer::ProduceRenderTaskBindVAOAndDrawElements(vertex_array_object_handle_,mesh->vertex_index_num_);
+        RenderTaskProducer::ProduceRenderTaskBindVAOAndDrawElements(vertex_array_object_handle,mesh->vertex_index_num_);
+        lod_triangle_count_[lod_level]+=mesh->vertex_index_num_/3;
+        lod_draw_count_[lod_level]++;
 
         // PostRender
         EASY_BLOCK("PostRender");
         game_object()->ForeachComponent([](Component* component){
-            component->OnPostRender();
+            if(component->NeedCallHook(COMPONENT_HOOK_ON_POST_RENDER)){
+                component->OnPostRender();
+            }
         });
         EASY_END_BLOCK;
     }
 }
 
+glm::mat4 MeshRenderer::CalculateModelMatrix(Transform* transform) {
+    glm::mat4 trans = glm::translate(transform->position());
+    auto rotation=transform->rotation();
+    glm::mat4 eulerAngleYXZ = glm::eulerAngleYXZ(glm::radians(rotation.y), glm::radians(rotation.x), glm::radians(rotation.z));
+    glm::mat4 scale = glm::scale(transform->scale()); //缩放;
+    return trans*scale*eulerAngleYXZ;
+}
+
+bool MeshRenderer::GetWorldBounds(glm::mat4& model, glm::vec3& center, float& radius) {
+    auto transform=game_object()->GetComponent<Transform>();
+    auto mesh_filter=game_object()->GetComponent<MeshFilter>();
+    if(transform== nullptr || mesh_filter== nullptr){
+        return false;
+    }
+    model=CalculateModelMatrix(transform);
+    //包围球变换到世界空间，半径按最大缩放轴放大。
+    center=glm::vec3(model*glm::vec4(mesh_filter->bounding_sphere_center(),1.0f));
+    float max_scale=glm::max(glm::length(glm::vec3(model[0])),glm::max(glm::length(glm::vec3(model[1])),glm::length(glm::vec3(model[2]))));
+    radius=mesh_filter->bounding_sphere_radius()*max_scale;
+    return true;
+}
+
+void MeshRenderer::RenderShadowCaster() {
+    auto mesh_filter=game_object()->GetComponent<MeshFilter>();
+    if(mesh_filter== nullptr){
+        return;
+    }
+    CheckMeshVersion(mesh_filter);
+    //优先使用LOD0，只在远处渲染过的物体使用已经创建的LOD。
+    //VAO按材质Shader的a_pos位置创建，阴影Shader的a_pos也在location 0。
+    unsigned int vertex_array_object_handle=vertex_array_object_handle_;
+    MeshFilter::Mesh* mesh=mesh_filter->skinned_mesh()== nullptr?mesh_filter->mesh():mesh_filter->skinned_mesh();
+    for (size_t i = 0; vertex_array_object_handle==0 && i < lod_vertex_array_object_handles_.size(); ++i) {
+        vertex_array_object_handle=lod_vertex_array_object_handles_[i];
+        mesh=mesh_filter->lod_mesh(i+1);
+    }
+    if(vertex_array_object_handle==0 || mesh== nullptr){
+        return;
+    }
+    RenderTaskProducer::ProduceRenderTaskBindVAOAndDrawElements(vertex_array_object_handle,mesh->vertex_index_num_);
+}
+
+void MeshRenderer::CheckMeshVersion(MeshFilter* mesh_filter) {
+    if(mesh_filter->mesh_version()==mesh_version_){
+        return;
+    }
+    mesh_version_=mesh_filter->mesh_version();
+    //旧VAO的索引个数、顶点缓冲区大小和新的Mesh不一致，删除后在Render中重新创建。
+    if(vertex_array_object_handle_!=0){
+        RenderTaskProducer::ProduceRenderTaskDeleteVAO(vertex_array_object_handle_,vertex_buffer_object_handle_);
+        vertex_array_object_handle_=0;
+        vertex_buffer_object_handle_=0;
+    }
+    for (size_t i = 0; i < lod_vertex_array_object_handles_.size(); ++i) {
+        if(lod_vertex_array_object_handles_[i]!=0){
+            RenderTaskProducer::ProduceRenderTaskDeleteVAO(lod_vertex_array_object_handles_[i],lod_vertex_buffer_object_handles_[i]);
+        }
+    }
+    lod_vertex_array_object_handles_.clear();
+    lod_vertex_buffer_object_handles_.clear();
+}
+
+unsigned char MeshRenderer::lod_level(Camera* camera) {
+    auto iter=camera_lod_level_map_.find(camera);
+    if(iter==camera_lod_level_map_.end()){
+        return 0;
+    }
+    return iter->second;
+}
+
+float MeshRenderer::CalculateScreenRelativeHeight(Camera* camera,MeshFilter* mesh_filter,glm::mat4& model) {
+    //包围球变换到世界空间，半径按最大缩放轴放大。
+    glm::vec3 center=glm::vec3(model*glm::vec4(mesh_filter->bounding_sphere_center(),1.0f));
+    float max_scale=glm::max(glm::length(glm::vec3(model[0])),glm::max(glm::length(glm::vec3(model[1])),glm::length(glm::vec3(model[2]))));
+    float radius=mesh_filter->bounding_sphere_radius()*max_scale;
+
+    glm::mat4& projection=camera->projection_mat4();
+    //正交投影 projection[1][1]=2/(top-bottom)，占比和距离无关。
+    if(projection[3][3]==1.0f){
+        return radius*projection[1][1];
+    }
+    //透视投影 projection[1][1]=1/tan(fov/2)，占比=半径/(距离*tan(fov/2))。
+    float distance=-(camera->view_mat4()*glm::vec4(center,1.0f)).z;
+    if(distance<=radius){
+        return 1.0f;//相机在包围球内
+    }
+    return radius*projection[1][1]/distance;
+}
+
+void MeshRenderer::ResetLODStatistics() {
+    memset(lod_triangle_count_,0,sizeof(lod_triangle_count_));
+    memset(lod_draw_count_,0,sizeof(lod_draw_count_));
+}
+
+void MeshRenderer::ReportLODStatistics() {
+    EASY_ARRAY("LOD triangle count",lod_triangle_count_,MESH_LOD_MAX_NUM);
+    EASY_ARRAY("LOD draw count",lod_draw_count_,MESH_LOD_MAX_NUM);
+}
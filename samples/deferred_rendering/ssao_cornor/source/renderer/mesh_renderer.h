@@ -6,12 +6,16 @@
 #define UNTITLED_MESH_RENDERER_H
 
 #include <memory>
+#include <vector>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include "component/component.h"
+#include "mesh_filter.h"
 
 class Material;
-class MeshFilter;
 class Texture2D;
+class Camera;
+class Transform;
 class MeshRenderer:public Component{
 public:
     MeshRenderer();
@@ -21,12 +25,68 @@ public:
     Material* material(){return material_;}
 
     virtual void Render();//渲染
+
+    /// 当前相机上一次选择的LOD级别
+    unsigned char lod_level(Camera* camera);
+
+    /// 是否投射阴影
+    bool cast_shadow(){return cast_shadow_;}
+    void set_cast_shadow(bool cast_shadow){cast_shadow_=cast_shadow;}
+
+    /// 获取模型矩阵和世界空间包围球，用于阴影投射物体的剔除。
+    /// \param model 模型矩阵
+    /// \param center 包围球中心
+    /// \param radius 包围球半径
+    /// \return 没有Transform、MeshFilter时返回false
+    bool GetWorldBounds(glm::mat4& model,glm::vec3& center,float& radius);
+
+    /// 绘制阴影深度，使用已经激活的阴影Shader，不绑定材质的纹理和Uniform。
+    /// 复用相机渲染时创建的VAO，还没有在相机中渲染过的物体跳过。
+    void RenderShadowCaster();
+
+public:
+    /// 清空LOD统计，每帧渲染前调用。
+    static void ResetLODStatistics();
+
+    /// 本帧各LOD级别绘制的三角形个数
+    static unsigned int lod_triangle_count(unsigned char lod_level){return lod_level<MESH_LOD_MAX_NUM?lod_triangle_count_[lod_level]:0;}
+
+    /// 本帧各LOD级别绘制的物体个数
+    static unsigned int lod_draw_count(unsigned char lod_level){return lod_level<MESH_LOD_MAX_NUM?lod_draw_count_[lod_level]:0;}
+
+    /// 输出LOD统计到profiler
+    static void ReportLODStatistics();
+
+private:
+    /// 计算Mesh包围球在相机中的屏幕占比(投影直径/屏幕高度)
+    /// \param camera 相机
+    /// \param mesh_filter MeshFilter
+    /// \param model 模型矩阵
+    static float CalculateScreenRelativeHeight(Camera* camera,MeshFilter* mesh_filter,glm::mat4& model);
+
+    /// 计算模型矩阵
+    static glm::mat4 CalculateModelMatrix(Transform* transform);
+
+    /// MeshFilter替换了Mesh或者LOD链时，删除所有VAO，之后按新的Mesh重新创建。
+    void CheckMeshVersion(MeshFilter* mesh_filter);
+
 private:
     Material* material_;
 
     unsigned int vertex_buffer_object_handle_=0;//顶点缓冲区对象句柄
     unsigned int vertex_array_object_handle_=0;//顶点数组对象句柄
 
+    std::vector<unsigned int> lod_vertex_buffer_object_handles_;//LOD1~LODn的VBO句柄，LOD0使用上面的句柄。
+    std::vector<unsigned int> lod_vertex_array_object_handles_;//LOD1~LODn的VAO句柄
+    unsigned int mesh_version_=0;//创建VAO时MeshFilter的mesh_version
+
+    std::unordered_map<Camera*,unsigned char> camera_lod_level_map_;//每个相机上一次选择的LOD级别，用于滞后切换。
+
+    bool cast_shadow_=true;//投射阴影
+
+    static unsigned int lod_triangle_count_[MESH_LOD_MAX_NUM];//本帧各LOD级别绘制的三角形个数
+    static unsigned int lod_draw_count_[MESH_LOD_MAX_NUM];//本帧各LOD级别绘制的物体个数
+
 RTTR_ENABLE();
 };
 
@@ -0,0 +1,295 @@
+﻿//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "mesh_simplifier.h"
+#include <queue>
+#include <map>
+#include <unordered_map>
+#include <tuple>
+#include <cmath>
+
+namespace {
+    /// 对称4x4矩阵，只存上三角10个值。
+    struct Quadric{
+        double a_[10]={0};
+
+        /// 加上一个平面 ax+by+cz+d=0 的二次误差
+        void AddPlane(double a,double b,double c,double d,double weight){
+            a_[0]+=weight*a*a; a_[1]+=weight*a*b; a_[2]+=weight*a*c; a_[3]+=weight*a*d;
+            a_[4]+=weight*b*b; a_[5]+=weight*b*c; a_[6]+=weight*b*d;
+            a_[7]+=weight*c*c; a_[8]+=weight*c*d;
+            a_[9]+=weight*d*d;
+        }
+
+        void Add(const Quadric& other){
+            for (int i = 0; i < 10; ++i) {
+                a_[i]+=other.a_[i];
+            }
+        }
+
+        /// 计算点到所有平面的距离平方和
+        double Evaluate(const glm::vec3& p) const{
+            double x=p.x,y=p.y,z=p.z;
+            return a_[0]*x*x + 2*a_[1]*x*y + 2*a_[2]*x*z + 2*a_[3]*x
+                 + a_[4]*y*y + 2*a_[5]*y*z + 2*a_[6]*y
+                 + a_[7]*z*z + 2*a_[8]*z
+                 + a_[9];
+        }
+    };
+
+    /// 候选折叠：将 from_ 折叠到 to_
+    struct Collapse{
+        double cost_;
+        int from_;
+        int to_;
+        unsigned int from_version_;
+        unsigned int to_version_;
+
+        bool operator>(const Collapse& other) const{
+            return cost_>other.cost_;
+        }
+    };
+
+    /// 边界边的约束平面权重，边界上的折叠会改变轮廓，代价需要远大于内部。
+    const double kBoundaryWeight=100.0;
+}
+
+std::vector<unsigned short> MeshSimplifier::Simplify(const std::vector<glm::vec3>& positions,
+                                                     const std::vector<glm::vec2>& uvs,
+                                                     const std::vector<unsigned short>& indices,
+                                                     size_t target_index_count,
+                                                     float max_error) {
+    size_t triangle_num=indices.size()/3;
+    if(indices.size()<=target_index_count || triangle_num==0){
+        return indices;
+    }
+
+    //1. 按坐标焊接顶点，同一坐标的顶点归为一簇。
+    std::map<std::tuple<float,float,float>,int> position_cluster_map;
+    std::vector<int> cluster_of_vertex(positions.size(),-1);
+    std::vector<std::vector<unsigned short>> cluster_vertices;
+    std::vector<glm::vec3> cluster_position;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        auto key=std::make_tuple(positions[i].x,positions[i].y,positions[i].z);
+        auto iter=position_cluster_map.find(key);
+        if(iter==position_cluster_map.end()){
+            iter=position_cluster_map.emplace(key,(int)cluster_position.size()).first;
+            cluster_position.push_back(positions[i]);
+            cluster_vertices.emplace_back();
+        }
+        cluster_of_vertex[i]=iter->second;
+        cluster_vertices[iter->second].push_back((unsigned short)i);
+    }
+    size_t cluster_num=cluster_position.size();
+
+    //2. 三角形列表，以及每个簇关联的三角形。
+    std::vector<unsigned short> triangles(indices.begin(),indices.begin()+triangle_num*3);
+    std::vector<bool> triangle_removed(triangle_num,false);
+    std::vector<std::vector<int>> cluster_triangles(cluster_num);
+    for (size_t t = 0; t < triangle_num; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            cluster_triangles[cluster_of_vertex[triangles[t*3+k]]].push_back((int)t);
+        }
+    }
+
+    //3. 每个簇的二次误差矩阵 = 相邻三角形所在平面(按面积加权)。
+    std::vector<Quadric> quadrics(cluster_num);
+    std::map<std::pair<int,int>,int> edge_use_count;
+    size_t live_triangle_num=0;
+    for (size_t t = 0; t < triangle_num; ++t) {
+        int c0=cluster_of_vertex[triangles[t*3]];
+        int c1=cluster_of_vertex[triangles[t*3+1]];
+        int c2=cluster_of_vertex[triangles[t*3+2]];
+        if(c0==c1 || c1==c2 || c0==c2){//退化三角形直接丢弃
+            triangle_removed[t]=true;
+            continue;
+        }
+        live_triangle_num++;
+        glm::vec3 p0=cluster_position[c0],p1=cluster_position[c1],p2=cluster_position[c2];
+        glm::vec3 cross=glm::cross(p1-p0,p2-p0);
+        float area=glm::length(cross);
+        if(area<=0.f){
+            continue;
+        }
+        glm::vec3 normal=cross/area;
+        double d=-glm::dot(normal,p0);
+        for (int c : {c0,c1,c2}) {
+            quadrics[c].AddPlane(normal.x,normal.y,normal.z,d,area);
+        }
+        int cs[3]={c0,c1,c2};
+        for (int k = 0; k < 3; ++k) {
+            int a=cs[k],b=cs[(k+1)%3];
+            edge_use_count[std::make_pair(std::min(a,b),std::max(a,b))]++;
+        }
+    }
+
+    //4. 边界边(只被一个三角形使用)加上垂直于三角形的约束平面，尽量保持轮廓。
+    for (size_t t = 0; t < triangle_num; ++t) {
+        if(triangle_removed[t]){
+            continue;
+        }
+        int cs[3]={cluster_of_vertex[triangles[t*3]],cluster_of_vertex[triangles[t*3+1]],cluster_of_vertex[triangles[t*3+2]]};
+        glm::vec3 face_normal=glm::cross(cluster_position[cs[1]]-cluster_position[cs[0]],cluster_position[cs[2]]-cluster_position[cs[0]]);
+        if(glm::length(face_normal)<=0.f){
+            continue;
+        }
+        face_normal=glm::normalize(face_normal);
+        for (int k = 0; k < 3; ++k) {
+            int a=cs[k],b=cs[(k+1)%3];
+            if(edge_use_count[std::make_pair(std::min(a,b),std::max(a,b))]!=1){
+                continue;
+            }
+            glm::vec3 edge=cluster_position[b]-cluster_position[a];
+            float edge_length=glm::length(edge);
+            if(edge_length<=0.f){
+                continue;
+            }
+            glm::vec3 normal=glm::normalize(glm::cross(edge,face_normal));
+            double d=-glm::dot(normal,cluster_position[a]);
+            quadrics[a].AddPlane(normal.x,normal.y,normal.z,d,kBoundaryWeight*edge_length*edge_length);
+            quadrics[b].AddPlane(normal.x,normal.y,normal.z,d,kBoundaryWeight*edge_length*edge_length);
+        }
+    }
+
+    //5. 所有边的两个方向都作为候选折叠，按代价放入小顶堆。
+    std::vector<bool> cluster_alive(cluster_num,true);
+    std::vector<unsigned int> cluster_version(cluster_num,0);
+    std::priority_queue<Collapse,std::vector<Collapse>,std::greater<Collapse>> collapse_queue;
+    auto push_collapse=[&](int from,int to){
+        Quadric quadric=quadrics[from];
+        quadric.Add(quadrics[to]);
+        collapse_queue.push({quadric.Evaluate(cluster_position[to]),from,to,cluster_version[from],cluster_version[to]});
+    };
+    for (auto& edge : edge_use_count) {
+        push_collapse(edge.first.first,edge.first.second);
+        push_collapse(edge.first.second,edge.first.first);
+    }
+
+    //判断折叠后 from 相邻的三角形是否会翻转
+    auto collapse_flip_triangle=[&](int from,int to)->bool{
+        for (int t : cluster_triangles[from]) {
+            if(triangle_removed[t]){
+                continue;
+            }
+            int cs[3]={cluster_of_vertex[triangles[t*3]],cluster_of_vertex[triangles[t*3+1]],cluster_of_vertex[triangles[t*3+2]]};
+            if(cs[0]==to || cs[1]==to || cs[2]==to){
+                continue;//这个三角形会被删除
+            }
+            glm::vec3 p[3],q[3];
+            for (int k = 0; k < 3; ++k) {
+                p[k]=cluster_position[cs[k]];
+                q[k]=cs[k]==from?cluster_position[to]:p[k];
+            }
+            glm::vec3 normal_before=glm::cross(p[1]-p[0],p[2]-p[0]);
+            glm::vec3 normal_after=glm::cross(q[1]-q[0],q[2]-q[0]);
+            if(glm::length(normal_after)<=0.f || glm::dot(normal_before,normal_after)<=0.f){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    //6. 不断取代价最小的边折叠，直到达到目标。
+    size_t target_triangle_num=target_index_count/3;
+    while(live_triangle_num>target_triangle_num && !collapse_queue.empty()){
+        Collapse collapse=collapse_queue.top();
+        collapse_queue.pop();
+        int from=collapse.from_,to=collapse.to_;
+        if(!cluster_alive[from] || !cluster_alive[to]){
+            continue;
+        }
+        if(collapse.from_version_!=cluster_version[from] || collapse.to_version_!=cluster_version[to]){
+            continue;//簇已经变化，这是过期的候选
+        }
+        if(collapse.cost_>max_error){
+            break;
+        }
+        if(collapse_flip_triangle(from,to)){
+            continue;
+        }
+
+        for (int t : cluster_triangles[from]) {
+            if(triangle_removed[t]){
+                continue;
+            }
+            bool contain_to=false;
+            for (int k = 0; k < 3; ++k) {
+                if(cluster_of_vertex[triangles[t*3+k]]==to){
+                    contain_to=true;
+                }
+            }
+            if(contain_to){
+                triangle_removed[t]=true;
+                live_triangle_num--;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                unsigned short& vertex_index=triangles[t*3+k];
+                if(cluster_of_vertex[vertex_index]!=from){
+                    continue;
+                }
+                //在目标簇里挑UV最接近的顶点
+                unsigned short best_vertex=cluster_vertices[to][0];
+                if(!uvs.empty()){
+                    float best_distance=1e30f;
+                    for (unsigned short candidate : cluster_vertices[to]) {
+                        glm::vec2 delta=uvs[candidate]-uvs[vertex_index];
+                        float distance=glm::dot(delta,delta);
+                        if(distance<best_distance){
+                            best_distance=distance;
+                            best_vertex=candidate;
+                        }
+                    }
+                }
+                vertex_index=best_vertex;
+            }
+            cluster_triangles[to].push_back(t);
+        }
+
+        cluster_alive[from]=false;
+        cluster_triangles[from].clear();
+        quadrics[to].Add(quadrics[from]);
+        cluster_version[to]++;
+
+        //重新计算 to 相邻边的代价
+        for (int t : cluster_triangles[to]) {
+            if(triangle_removed[t]){
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                int neighbor=cluster_of_vertex[triangles[t*3+k]];
+                if(neighbor==to){
+                    continue;
+                }
+                push_collapse(to,neighbor);
+                push_collapse(neighbor,to);
+            }
+        }
+    }
+
+    std::vector<unsigned short> result;
+    result.reserve(live_triangle_num*3);
+    for (size_t t = 0; t < triangle_num; ++t) {
+        if(triangle_removed[t]){
+            continue;
+        }
+        result.push_back(triangles[t*3]);
+        result.push_back(triangles[t*3+1]);
+        result.push_back(triangles[t*3+2]);
+    }
+    return result;
+}
+
+std::vector<unsigned short> MeshSimplifier::CompactVertices(std::vector<unsigned short>& indices,size_t vertex_num) {
+    std::vector<int> new_index_of_vertex(vertex_num,-1);
+    std::vector<unsigned short> remap;
+    for (auto& index : indices) {
+        if(new_index_of_vertex[index]<0){
+            new_index_of_vertex[index]=(int)remap.size();
+            remap.push_back(index);
+        }
+        index=(unsigned short)new_index_of_vertex[index];
+    }
+    return remap;
+}
@@ -3,16 +3,19 @@
 //
 
 #include "render_texture.h"
+#include <typeinfo>
 #include "renderer/texture_2d.h"
+#include "renderer/frame_graph.h"
 #include "render_device/gpu_resource_mapper.h"
 #include "render_device/render_task_producer.h"
 
 RenderTexture::RenderTexture(): width_(128), height_(128), frame_buffer_object_handle_(0),in_use_(false),
-                                color_texture_2d_(nullptr),depth_texture_2d_(nullptr) {
+                                color_texture_2d_(nullptr),depth_texture_2d_(nullptr),transient_(false) {
 }
 
 RenderTexture::~RenderTexture() {
-    if(frame_buffer_object_handle_>0){
+    FrameGraph::Remove(this);
+    if(frame_buffer_object_handle_>0 && transient_==false){
         RenderTaskProducer::ProduceRenderTaskDeleteFBO(frame_buffer_object_handle_);
     }
     //删除Texture2D
@@ -27,15 +30,40 @@ RenderTexture::~RenderTexture() {
 void RenderTexture::Init(unsigned short width, unsigned short height) {
     width_=width;
     height_=height;
-    color_texture_2d_=Texture2D::Create(width_,height_,GL_RGB,GL_RGB,GL_LINEAR,
-                                        GL_LINEAR,
-                                        GL_CLAMP_TO_EDGE,
-                                        GL_CLAMP_TO_EDGE,GL_UNSIGNED_SHORT_5_6_5, nullptr,0);
-    depth_texture_2d_=Texture2D::Create(width_,height_,GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT,GL_LINEAR,
-                                        GL_LINEAR,
-                                        GL_CLAMP_TO_EDGE,
-                                        GL_CLAMP_TO_EDGE,GL_UNSIGNED_SHORT, nullptr,0);
+    color_texture_2d_=CreateAttachment(GL_RGB,GL_RGB,GL_UNSIGNED_SHORT_5_6_5);
+    depth_texture_2d_=CreateAttachment(GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT,GL_UNSIGNED_SHORT);
     //创建FBO任务
+    GenerateFrameBufferObjectHandle();
+    if(transient_==false){
+        RenderTaskProducer::ProduceRenderTaskCreateFBO(frame_buffer_object_handle_,width_,height_,color_texture_2d_->texture_handle(),depth_texture_2d_->texture_handle());
+    }
+}
+
+void RenderTexture::GetTextures(std::vector<Texture2D*>& textures) {
+    textures.push_back(color_texture_2d_);
+    textures.push_back(depth_texture_2d_);
+}
+
+RenderTexture* RenderTexture::CreateCompatible() {
+    RenderTexture* render_texture=new RenderTexture();
+    render_texture->Init(width_,height_);
+    return render_texture;
+}
+
+bool RenderTexture::Compatible(RenderTexture* render_texture) {
+    return typeid(*this)==typeid(*render_texture) && width_==render_texture->width_ && height_==render_texture->height_;
+}
+
+Texture2D* RenderTexture::CreateAttachment(unsigned int server_format, unsigned int client_format, unsigned int data_type) {
+    if(transient_){
+        return Texture2D::CreateAlias(width_,height_,server_format);
+    }
+    return Texture2D::Create(width_,height_,server_format,client_format,GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE,data_type, nullptr,0);
+}
+
+void RenderTexture::GenerateFrameBufferObjectHandle() {
     frame_buffer_object_handle_ = GPUResourceMapper::GenerateFBOHandle();
-    RenderTaskProducer::ProduceRenderTaskCreateFBO(frame_buffer_object_handle_,width_,height_,color_texture_2d_->texture_handle(),depth_texture_2d_->texture_handle());
+    if(transient_){
+        FrameGraph::SetDirty();
+    }
 }
@@ -5,6 +5,8 @@
 #ifndef RENDER_TEXTURE_H
 #define RENDER_TEXTURE_H
 
+#include <vector>
+
 class Texture2D;
 class RenderTexture {
 public:
@@ -47,6 +49,33 @@ public:
         return depth_texture_2d_;
     }
 
+    /// 是否临时RenderTexture
+    bool transient(){
+        return transient_;
+    }
+    /// 设置为临时RenderTexture，需要在Init之前设置。
+    /// 临时RenderTexture只生成句柄，不创建GPU资源，由FrameGraph按生命周期分配共用的显存。
+    void set_transient(bool transient){
+        transient_=transient;
+    }
+
+    /// 获取所有附着的纹理，顺序固定，用于映射别名。
+    /// \param textures
+    virtual void GetTextures(std::vector<Texture2D*>& textures);
+
+    /// 创建一个相同类型、相同尺寸的RenderTexture，分配GPU资源。
+    virtual RenderTexture* CreateCompatible();
+
+    /// 是否相同类型、相同尺寸，可以共用显存。
+    virtual bool Compatible(RenderTexture* render_texture);
+
+protected:
+    /// 创建附着的纹理，临时RenderTexture只生成句柄。
+    Texture2D* CreateAttachment(unsigned int server_format,unsigned int client_format,unsigned int data_type);
+
+    /// 生成FBO句柄，临时RenderTexture不创建FBO。
+    void GenerateFrameBufferObjectHandle();
+
 protected:
     unsigned short width_;
     unsigned short height_;
@@ -54,6 +83,7 @@ protected:
     Texture2D* color_texture_2d_;//FBO颜色附着点关联的颜色纹理
     Texture2D* depth_texture_2d_;//FBO深度附着点关联的深度纹理
     bool in_use_;//正在被使用
+    bool transient_;//临时RenderTexture，GPU资源由FrameGraph分配。
 };
 
 
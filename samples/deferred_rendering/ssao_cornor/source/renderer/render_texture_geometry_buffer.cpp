@@ -9,11 +9,11 @@
 
 RenderTextureGeometryBuffer::RenderTextureGeometryBuffer(): RenderTexture(), frag_position_texture_2d_(nullptr),
 frag_normal_texture_2d_(nullptr),frag_vertex_color_texture_2d_(nullptr),frag_diffuse_color_texture_2d_(nullptr),
-frag_specular_intensity_texture_2d_(nullptr),frag_specular_highlight_shininess_texture_2d_(nullptr){
+frag_specular_intensity_texture_2d_(nullptr),frag_specular_highlight_shininess_texture_2d_(nullptr),packed_(false){
 }
 
 RenderTextureGeometryBuffer::~RenderTextureGeometryBuffer() {
-    if(frame_buffer_object_handle_>0){
+    if(frame_buffer_object_handle_>0 && transient_==false){
         RenderTaskProducer::ProduceRenderTaskDeleteFBO(frame_buffer_object_handle_);
     }
     //删除Texture2D
@@ -40,22 +40,61 @@ RenderTextureGeometryBuffer::~RenderTextureGeometryBuffer() {
 void RenderTextureGeometryBuffer::Init(unsigned short width, unsigned short height) {
     width_=width;
     height_=height;
-    //如果要在纹理中存储超过1的值，需要使用浮点纹理
-    frag_position_texture_2d_=Texture2D::Create(width_, height_, GL_RGBA16F, GL_RGB,GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_FLOAT, nullptr, 0);
-    frag_normal_texture_2d_=Texture2D::Create(width_, height_, GL_RGBA16F, GL_RGB, GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_FLOAT, nullptr, 0);
-    frag_vertex_color_texture_2d_=Texture2D::Create(width_, height_, GL_RGBA, GL_RGB, GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_FLOAT, nullptr, 0);
-    frag_diffuse_color_texture_2d_=Texture2D::Create(width_, height_, GL_RGBA, GL_RGB, GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_FLOAT, nullptr, 0);
-    frag_specular_intensity_texture_2d_=Texture2D::Create(width_, height_, GL_RGBA, GL_RGB, GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_FLOAT, nullptr, 0);
-    frag_specular_highlight_shininess_texture_2d_=Texture2D::Create(width_, height_, GL_RGBA16F, GL_RGB, GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_FLOAT, nullptr, 0);
-    depth_texture_2d_=Texture2D::Create(width_,height_,GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT,GL_LINEAR,GL_LINEAR,GL_CLAMP_TO_EDGE,GL_CLAMP_TO_EDGE, GL_UNSIGNED_SHORT, nullptr,0);
+    if(packed_){
+        //法线八面体编码成2个分量，16位定点精度足够。
+        frag_normal_texture_2d_=CreateAttachment(GL_RG16, GL_RG, GL_UNSIGNED_SHORT);
+        //rgb:Diffuse a:高光强度
+        frag_diffuse_color_texture_2d_=CreateAttachment(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+        //rgb:顶点颜色 a:反光度/256
+        frag_vertex_color_texture_2d_=CreateAttachment(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+        //从深度重建坐标，16位深度精度不够。
+        depth_texture_2d_=CreateAttachment(GL_DEPTH_COMPONENT24,GL_DEPTH_COMPONENT, GL_UNSIGNED_INT);
+    }else{
+        //如果要在纹理中存储超过1的值，需要使用浮点纹理
+        frag_position_texture_2d_=CreateAttachment(GL_RGBA16F, GL_RGB, GL_FLOAT);
+        frag_normal_texture_2d_=CreateAttachment(GL_RGBA16F, GL_RGB, GL_FLOAT);
+        frag_vertex_color_texture_2d_=CreateAttachment(GL_RGBA, GL_RGB, GL_FLOAT);
+        frag_diffuse_color_texture_2d_=CreateAttachment(GL_RGBA, GL_RGB, GL_FLOAT);
+        frag_specular_intensity_texture_2d_=CreateAttachment(GL_RGBA, GL_RGB, GL_FLOAT);
+        frag_specular_highlight_shininess_texture_2d_=CreateAttachment(GL_RGBA16F, GL_RGB, GL_FLOAT);
+        depth_texture_2d_=CreateAttachment(GL_DEPTH_COMPONENT,GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT);
+    }
     //创建FBO任务
-    frame_buffer_object_handle_ = GPUResourceMapper::GenerateFBOHandle();
+    GenerateFrameBufferObjectHandle();
+    if(transient_){
+        return;
+    }
+    std::vector<unsigned int> color_texture_handle_vec;
+    for (auto texture_2d : ColorAttachments()) {
+        color_texture_handle_vec.push_back(texture_2d->texture_handle());
+    }
     RenderTaskProducer::ProduceRenderTaskCreateGBuffer(frame_buffer_object_handle_, width_, height_,
-                                                       frag_position_texture_2d_->texture_handle(),
-                                                       frag_normal_texture_2d_->texture_handle(),
-                                                       frag_vertex_color_texture_2d_->texture_handle(),
-                                                       frag_diffuse_color_texture_2d_->texture_handle(),
-                                                       frag_specular_intensity_texture_2d_->texture_handle(),
-                                                       frag_specular_highlight_shininess_texture_2d_->texture_handle(),
+                                                       (int)color_texture_handle_vec.size(), color_texture_handle_vec.data(),
                                                        depth_texture_2d_->texture_handle());
 }
+
+std::vector<Texture2D*> RenderTextureGeometryBuffer::ColorAttachments() {
+    if(packed_){
+        return {frag_normal_texture_2d_,frag_diffuse_color_texture_2d_,frag_vertex_color_texture_2d_};
+    }
+    return {frag_position_texture_2d_,frag_normal_texture_2d_,frag_vertex_color_texture_2d_,
+            frag_diffuse_color_texture_2d_,frag_specular_intensity_texture_2d_,frag_specular_highlight_shininess_texture_2d_};
+}
+
+void RenderTextureGeometryBuffer::GetTextures(std::vector<Texture2D*>& textures) {
+    for (auto texture_2d : ColorAttachments()) {
+        textures.push_back(texture_2d);
+    }
+    textures.push_back(depth_texture_2d_);
+}
+
+RenderTexture* RenderTextureGeometryBuffer::CreateCompatible() {
+    RenderTextureGeometryBuffer* render_texture=new RenderTextureGeometryBuffer();
+    render_texture->set_packed(packed_);
+    render_texture->Init(width_,height_);
+    return render_texture;
+}
+
+bool RenderTextureGeometryBuffer::Compatible(RenderTexture* render_texture) {
+    return RenderTexture::Compatible(render_texture) && packed_==static_cast<RenderTextureGeometryBuffer*>(render_texture)->packed_;
+}
@@ -18,6 +18,22 @@ public:
     /// \param height
     virtual void Init(unsigned short width,unsigned short height) override;
 
+    virtual void GetTextures(std::vector<Texture2D*>& textures) override;
+
+    virtual RenderTexture* CreateCompatible() override;
+
+    virtual bool Compatible(RenderTexture* render_texture) override;
+
+    /// 压缩GBuffer：法线八面体编码存到RG16，高光强度存到Diffuse的A通道，反光度存到顶点颜色的A通道，
+    /// 不存储坐标，Shader从深度重建，6张颜色纹理减少为3张。
+    bool packed(){
+        return packed_;
+    }
+    /// 需要在Init之前设置
+    void set_packed(bool packed){
+        packed_=packed;
+    }
+
     Texture2D* frag_position_texture_2d(){
         return frag_position_texture_2d_;
     }
@@ -36,6 +52,10 @@ public:
     Texture2D* frag_specular_highlight_shininess_texture_2d(){
         return frag_specular_highlight_shininess_texture_2d_;
     }
+private:
+    /// 按颜色附着点顺序排列的颜色纹理
+    std::vector<Texture2D*> ColorAttachments();
+
 private:
     Texture2D* frag_position_texture_2d_;//将FBO颜色附着点0关联的颜色纹理,存储顶点片段坐标数据,绑定到FBO颜色附着点0
     Texture2D* frag_normal_texture_2d_;//将FBO颜色附着点1关联的颜色纹理，存储顶点片段法线数据,绑定到FBO颜色附着点1
@@ -43,6 +63,7 @@ private:
     Texture2D* frag_diffuse_color_texture_2d_;//将FBO颜色附着点3关联的颜色纹理，存储顶点片段Diffuse颜色数据，绑定到FBO颜色附着点3
     Texture2D* frag_specular_intensity_texture_2d_;//将FBO颜色附着点4关联的颜色纹理，存储顶点片段高光强度数据，绑定到FBO颜色附着点4
     Texture2D* frag_specular_highlight_shininess_texture_2d_;//将FBO颜色附着点5关联的颜色纹理，存储顶点片段反光度数据，绑定到FBO颜色附着点5
+    bool packed_;//压缩GBuffer，只创建法线、顶点颜色、Diffuse纹理，颜色附着点依次是法线、Diffuse、顶点颜色。
 };
 
 
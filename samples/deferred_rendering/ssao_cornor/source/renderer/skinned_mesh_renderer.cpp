@@ -10,6 +10,9 @@
 #include "animation.h"
 #include "animation_clip.h"
 #include "utils/debug.h"
+#include "utils/job_system.h"
+
+#define SKINNED_VERTEX_BATCH_SIZE 1024 //每个蒙皮任务计算的顶点数量
 
 using namespace rttr;
 RTTR_REGISTRATION
@@ -84,42 +87,44 @@ void SkinnedMeshRenderer::Update() {
     }
 
     EASY_BLOCK("CalculateVertexByBone");
-    //计算当前帧顶点位置
-    for(int i=0;i<skinned_mesh->vertex_num_;i++){
-        auto& vertex=mesh->vertex_data_[i];
-        glm::vec4 vertex_position=glm::vec4(vertex.position_,1.0f);
-        glm::vec3 vertex_normal=vertex.normal_;
-
-        glm::vec4 pos_by_bones;//对每个Bone计算一次位置，然后乘以权重，最后求和
-        glm::vec3 normal_by_bones;
-
-        for(int j=0;j<4;j++){
-            auto& bone_index=vertex_relate_bone_infos[i].bone_index_[j];//顶点关联的骨骼索引
-            if(bone_index==-1){
-                continue;
+    //计算当前帧顶点位置，顶点之间没有依赖，分段并行计算。
+    JobSystem::ParallelForBatch(skinned_mesh->vertex_num_,SKINNED_VERTEX_BATCH_SIZE,[&](int begin,int end){
+        for(int i=begin;i<end;i++){
+            auto& vertex=mesh->vertex_data_[i];
+            glm::vec4 vertex_position=glm::vec4(vertex.position_,1.0f);
+            glm::vec3 vertex_normal=vertex.normal_;
+
+            glm::vec4 pos_by_bones;//对每个Bone计算一次位置，然后乘以权重，最后求和
+            glm::vec3 normal_by_bones;
+
+            for(int j=0;j<4;j++){
+                auto& bone_index=vertex_relate_bone_infos[i].bone_index_[j];//顶点关联的骨骼索引
+                if(bone_index==-1){
+                    continue;
+                }
+                float bone_weight=vertex_relate_bone_infos[i].bone_weight_[j]/100.f;//顶点关联的骨骼权重
+
+                //当前帧顶点关联的骨骼矩阵
+                auto& bone_matrix=bone_matrices[bone_index];
+                //计算当前帧顶点位置(模型坐标系，bone_matrix里带了相对于模型坐标系的位置，作用到骨骼坐标系的位置上，就转换到了模型坐标系)
+                glm::vec4 pos_in_world=bone_matrix*vertex_position;
+                //乘以权重
+                pos_by_bones=pos_by_bones+pos_in_world*bone_weight;
+
+                //glm::vec3 normal_in_world=glm::mat3(bone_matrix) * vertex_normal;
+                //glm::vec3 normal_in_world=glm::mat3(glm::transpose(glm::inverse(bone_matrix))) * vertex_normal;
+                //当前帧顶点关联的用于法线计算的骨骼矩阵
+                auto& normal_bone_matrix=normal_bone_matrices[bone_index];
+                //计算当前帧顶点位置(模型坐标系，bone_matrix里带了相对于模型坐标系的位置，作用到骨骼坐标系的位置上，就转换到了模型坐标系)
+                glm::vec3 normal_in_world=normal_bone_matrix*vertex_normal;
+                //乘以权重
+                normal_by_bones=normal_by_bones+normal_in_world*bone_weight;
             }
-            float bone_weight=vertex_relate_bone_infos[i].bone_weight_[j]/100.f;//顶点关联的骨骼权重
-
-            //当前帧顶点关联的骨骼矩阵
-            auto& bone_matrix=bone_matrices[bone_index];
-            //计算当前帧顶点位置(模型坐标系，bone_matrix里带了相对于模型坐标系的位置，作用到骨骼坐标系的位置上，就转换到了模型坐标系)
-            glm::vec4 pos_in_world=bone_matrix*vertex_position;
-            //乘以权重
-            pos_by_bones=pos_by_bones+pos_in_world*bone_weight;
-
-            //glm::vec3 normal_in_world=glm::mat3(bone_matrix) * vertex_normal;
-            //glm::vec3 normal_in_world=glm::mat3(glm::transpose(glm::inverse(bone_matrix))) * vertex_normal;
-            //当前帧顶点关联的用于法线计算的骨骼矩阵
-            auto& normal_bone_matrix=normal_bone_matrices[bone_index];
-            //计算当前帧顶点位置(模型坐标系，bone_matrix里带了相对于模型坐标系的位置，作用到骨骼坐标系的位置上，就转换到了模型坐标系)
-            glm::vec3 normal_in_world=normal_bone_matrix*vertex_normal;
-            //乘以权重
-            normal_by_bones=normal_by_bones+normal_in_world*bone_weight;
-        }
 
-        skinned_mesh->vertex_data_[i].position_=pos_by_bones.xyz();
-        skinned_mesh->vertex_data_[i].normal_=normal_by_bones;
-    }
+            skinned_mesh->vertex_data_[i].position_=pos_by_bones.xyz();
+            skinned_mesh->vertex_data_[i].normal_=normal_by_bones;
+        }
+    });
     EASY_END_BLOCK;
 }
 
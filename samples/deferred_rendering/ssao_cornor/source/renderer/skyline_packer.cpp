@@ -0,0 +1,87 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "skyline_packer.h"
+#include <algorithm>
+#include <climits>
+
+SkylinePacker::SkylinePacker(int width, int height):width_(width),height_(height) {
+    Reset();
+}
+
+void SkylinePacker::Reset() {
+    skyline_.clear();
+    skyline_.push_back({0,0,width_});
+}
+
+int SkylinePacker::Fit(size_t index, int width, int height) {
+    int x=skyline_[index].x_;
+    if(x+width>width_){
+        return -1;
+    }
+    //矩形横跨的所有段中，最高的那段决定矩形的y。
+    int y=0;
+    int width_left=width;
+    for (size_t i = index; width_left>0; ++i) {
+        y=std::max(y,skyline_[i].y_);
+        if(y+height>height_){
+            return -1;
+        }
+        width_left-=skyline_[i].width_;
+    }
+    return y;
+}
+
+bool SkylinePacker::Insert(int width, int height, int& x, int& y) {
+    //选择放置后顶部最低的位置，相同时选择浪费宽度最小的段。
+    int best_top=INT_MAX;
+    int best_width=INT_MAX;
+    size_t best_index=skyline_.size();
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        int fit_y=Fit(i,width,height);
+        if(fit_y<0){
+            continue;
+        }
+        int top=fit_y+height;
+        if(top<best_top || (top==best_top && skyline_[i].width_<best_width)){
+            best_top=top;
+            best_width=skyline_[i].width_;
+            best_index=i;
+            x=skyline_[i].x_;
+            y=fit_y;
+        }
+    }
+    if(best_index==skyline_.size()){
+        return false;
+    }
+
+    //插入新的一段，并裁掉被它覆盖的后续段。
+    skyline_.insert(skyline_.begin()+best_index,{x,y+height,width});
+    for (size_t i = best_index+1; i < skyline_.size();) {
+        Node& previous=skyline_[i-1];
+        Node& node=skyline_[i];
+        int shrink=previous.x_+previous.width_-node.x_;
+        if(shrink<=0){
+            break;
+        }
+        node.x_+=shrink;
+        node.width_-=shrink;
+        if(node.width_<=0){
+            skyline_.erase(skyline_.begin()+i);
+        }else{
+            break;
+        }
+    }
+
+    //合并相同高度的相邻段
+    for (size_t i = 0; i+1 < skyline_.size();) {
+        if(skyline_[i].y_==skyline_[i+1].y_){
+            skyline_[i].width_+=skyline_[i+1].width_;
+            skyline_.erase(skyline_.begin()+i+1);
+        }else{
+            i++;
+        }
+    }
+    return true;
+}
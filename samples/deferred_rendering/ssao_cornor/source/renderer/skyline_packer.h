@@ -0,0 +1,50 @@
+//
+// Created by captainchen on 2026/10/19.
+// Skyline矩形装箱，用于动态字形图集。
+// 记录图集每一列已经填充到的高度(天际线)，新矩形放到能让它最低的位置，适合高度相近的字形逐个插入。
+//
+
+#ifndef UNTITLED_SKYLINE_PACKER_H
+#define UNTITLED_SKYLINE_PACKER_H
+
+#include <cstddef>
+#include <vector>
+
+class SkylinePacker {
+public:
+    SkylinePacker(int width,int height);
+
+    /// 放入一个矩形
+    /// \param width 宽
+    /// \param height 高
+    /// \param x 放入位置
+    /// \param y 放入位置
+    /// \return 放不下返回false
+    bool Insert(int width,int height,int& x,int& y);
+
+    /// 清空，重新开始填充。
+    void Reset();
+
+    int width(){return width_;}
+    int height(){return height_;}
+
+private:
+    /// 天际线中的一段，从x开始宽width，已经填充到y。
+    struct Node{
+        int x_;
+        int y_;
+        int width_;
+    };
+
+    /// 矩形左边对齐第index段时，能放置的最低y。
+    /// \return 放不下返回-1
+    int Fit(size_t index,int width,int height);
+
+private:
+    int width_;
+    int height_;
+    std::vector<Node> skyline_;
+};
+
+
+#endif //UNTITLED_SKYLINE_PACKER_H
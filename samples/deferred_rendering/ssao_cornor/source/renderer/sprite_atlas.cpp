@@ -0,0 +1,117 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "sprite_atlas.h"
+#include "rapidxml/rapidxml.hpp"
+#include "rapidxml/rapidxml_utils.hpp"
+#include "texture_2d.h"
+#include "app/application.h"
+#include "utils/debug.h"
+
+std::unordered_map<std::string,SpriteAtlas*> SpriteAtlas::sprite_atlas_map_;
+
+SpriteAtlas::~SpriteAtlas() {
+    for (auto page : pages_) {
+        delete page;
+    }
+    pages_.clear();
+}
+
+SpriteAtlas::Sprite* SpriteAtlas::GetSprite(const std::string& sprite_name) {
+    auto iter=sprite_map_.find(sprite_name);
+    if(iter==sprite_map_.end()){
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+SpriteAtlas* SpriteAtlas::LoadFromFile(const std::string& atlas_file_path) {
+    auto iter=sprite_atlas_map_.find(atlas_file_path);
+    if(iter!=sprite_atlas_map_.end()){
+        return iter->second;
+    }
+
+    //解析xml
+    rapidxml::file<> xml_file((Application::data_path()+atlas_file_path).c_str());
+    rapidxml::xml_document<> document;
+    document.parse<0>(xml_file.data());
+
+    //根节点
+    rapidxml::xml_node<>* atlas_node=document.first_node("atlas");
+    if(atlas_node == nullptr){
+        DEBUG_LOG_ERROR("atlas node not found:{}",atlas_file_path);
+        return nullptr;
+    }
+
+    SpriteAtlas* sprite_atlas=new SpriteAtlas();
+
+    //图集纹理路径相对于atlas文件所在目录
+    std::string atlas_directory;
+    auto last_index_of_slash=atlas_file_path.find_last_of('/');
+    if(last_index_of_slash!=std::string::npos){
+        atlas_directory=atlas_file_path.substr(0,last_index_of_slash+1);
+    }
+
+    //解析图集纹理
+    std::vector<glm::vec2> page_sizes;
+    rapidxml::xml_node<>* page_node=atlas_node->first_node("page");
+    while (page_node != nullptr){
+        rapidxml::xml_attribute<>* texture_attribute=page_node->first_attribute("texture");
+        rapidxml::xml_attribute<>* width_attribute=page_node->first_attribute("width");
+        rapidxml::xml_attribute<>* height_attribute=page_node->first_attribute("height");
+        if(texture_attribute == nullptr || width_attribute == nullptr || height_attribute == nullptr){
+            DEBUG_LOG_ERROR("atlas page attribute missing:{}",atlas_file_path);
+            break;
+        }
+        sprite_atlas->pages_.push_back(Texture2D::LoadFromFile(atlas_directory+texture_attribute->value()));
+        page_sizes.emplace_back(std::stof(width_attribute->value()),std::stof(height_attribute->value()));
+
+        page_node=page_node->next_sibling("page");
+    }
+
+    //解析Sprite，坐标以左下角为原点，换算成UV。
+    rapidxml::xml_node<>* sprite_node=atlas_node->first_node("sprite");
+    while (sprite_node != nullptr){
+        rapidxml::xml_attribute<>* name_attribute=sprite_node->first_attribute("name");
+        rapidxml::xml_attribute<>* page_attribute=sprite_node->first_attribute("page");
+        rapidxml::xml_attribute<>* x_attribute=sprite_node->first_attribute("x");
+        rapidxml::xml_attribute<>* y_attribute=sprite_node->first_attribute("y");
+        rapidxml::xml_attribute<>* width_attribute=sprite_node->first_attribute("width");
+        rapidxml::xml_attribute<>* height_attribute=sprite_node->first_attribute("height");
+        if(name_attribute == nullptr || page_attribute == nullptr || x_attribute == nullptr || y_attribute == nullptr
+           || width_attribute == nullptr || height_attribute == nullptr){
+            DEBUG_LOG_ERROR("atlas sprite attribute missing:{}",atlas_file_path);
+            break;
+        }
+        size_t page=std::stoul(page_attribute->value());
+        if(page>=sprite_atlas->pages_.size()){
+            DEBUG_LOG_ERROR("atlas sprite {} page {} out of range:{}",name_attribute->value(),page,atlas_file_path);
+            sprite_node=sprite_node->next_sibling("sprite");
+            continue;
+        }
+        Sprite sprite;
+        sprite.name_=name_attribute->value();
+        sprite.texture2D_=sprite_atlas->pages_[page];
+        sprite.width_=std::stof(width_attribute->value());
+        sprite.height_=std::stof(height_attribute->value());
+        float x=std::stof(x_attribute->value());
+        float y=std::stof(y_attribute->value());
+        glm::vec2 page_size=page_sizes[page];
+        sprite.uv_rect_=glm::vec4(x/page_size.x,y/page_size.y,(x+sprite.width_)/page_size.x,(y+sprite.height_)/page_size.y);
+        sprite_atlas->sprite_map_[sprite.name_]=sprite;
+
+        sprite_node=sprite_node->next_sibling("sprite");
+    }
+
+    sprite_atlas_map_[atlas_file_path]=sprite_atlas;
+    return sprite_atlas;
+}
+
+SpriteAtlas::Sprite* SpriteAtlas::FindSprite(const std::string& atlas_file_path, const std::string& sprite_name) {
+    SpriteAtlas* sprite_atlas=LoadFromFile(atlas_file_path);
+    if(sprite_atlas== nullptr){
+        return nullptr;
+    }
+    return sprite_atlas->GetSprite(sprite_name);
+}
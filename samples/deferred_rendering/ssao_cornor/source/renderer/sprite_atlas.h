@@ -0,0 +1,57 @@
+//
+// Created by captainchen on 2026/10/19.
+// UI图集，由 pack_atlas 工具生成的 .atlas 描述文件 + 一张或多张图集cpt。
+// UI组件通过名字取到Sprite，用图集纹理 + UV子区域绘制，同一图集的UI可以共用一张纹理。
+//
+
+#ifndef UNTITLED_SPRITE_ATLAS_H
+#define UNTITLED_SPRITE_ATLAS_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+class Texture2D;
+class SpriteAtlas {
+public:
+    /// 图集中的一张散图
+    struct Sprite{
+        std::string name_;
+        Texture2D* texture2D_= nullptr;//所在的图集纹理
+        glm::vec4 uv_rect_;//左下角UV(x,y)，右上角UV(z,w)
+        float width_=0;//原始像素宽
+        float height_=0;//原始像素高
+    };
+
+    ~SpriteAtlas();
+
+    /// 获取图集中的Sprite
+    /// \param sprite_name 散图名字，即打包时的图片文件名(不含扩展名)
+    /// \return 不存在返回nullptr
+    Sprite* GetSprite(const std::string& sprite_name);
+
+    const std::vector<Texture2D*>& pages(){return pages_;}
+
+private:
+    std::vector<Texture2D*> pages_;//图集纹理
+    std::unordered_map<std::string,Sprite> sprite_map_;
+
+public:
+    /// 加载图集，已经加载过的直接返回。
+    /// \param atlas_file_path .atlas 文件路径
+    /// \return
+    static SpriteAtlas* LoadFromFile(const std::string& atlas_file_path);
+
+    /// 加载图集并获取Sprite
+    /// \param atlas_file_path .atlas 文件路径
+    /// \param sprite_name 散图名字
+    /// \return 不存在返回nullptr
+    static Sprite* FindSprite(const std::string& atlas_file_path,const std::string& sprite_name);
+
+private:
+    static std::unordered_map<std::string,SpriteAtlas*> sprite_atlas_map_;//存储加载的图集 key：atlas路径 value：SpriteAtlas实例
+};
+
+
+#endif //UNTITLED_SPRITE_ATLAS_H
@@ -0,0 +1,202 @@
+﻿//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "text_layout.h"
+#include <algorithm>
+#include "easy/profiler.h"
+
+bool TextLayout::Layout(Font* font, const std::string& text, float scale, float max_width, Alignment alignment, float line_spacing) {
+    EASY_FUNCTION();
+    Font::DecodeUTF8(text,new_code_points_);
+
+    //字体、排版参数变化，或者图集页被淘汰(字形信息失效)，全部重新排版。
+    float line_height=font->line_height()*scale*line_spacing;
+    if(font!=font_ || atlas_version_!=font->atlas_version() || scale!=scale_ || max_width!=max_width_ || alignment!=alignment_ || line_height!=line_height_){
+        valid_=false;
+        font_=font;
+        scale_=scale;
+        max_width_=max_width;
+        alignment_=alignment;
+        line_height_=line_height;
+    }
+
+    //找到第一个变化的码点
+    unsigned int first_diff=0;
+    if(valid_){
+        size_t common_num=std::min(code_points_.size(),new_code_points_.size());
+        while(first_diff<common_num && code_points_[first_diff]==new_code_points_[first_diff]){
+            first_diff++;
+        }
+        if(first_diff==code_points_.size() && first_diff==new_code_points_.size()){
+            first_dirty_glyph_=(unsigned int)glyphs_.size();
+            return false;
+        }
+    }
+    code_points_.swap(new_code_points_);
+
+    //获取字形，同一个字符串的字形在同一页图集上，页变化了字形信息全部不同。
+    unsigned short last_page=0;
+    for (auto character : characters_) {
+        if(character!= nullptr){
+            last_page=character->page_;
+            break;
+        }
+    }
+    if(font->LoadCodePoints(code_points_,characters_)==false){
+        characters_.assign(code_points_.size(), nullptr);
+    }
+    for (auto character : characters_) {
+        if(character!= nullptr){
+            if(character->page_!=last_page){
+                valid_=false;
+            }
+            break;
+        }
+    }
+    //生成字形时可能淘汰了图集页
+    if(atlas_version_!=font->atlas_version()){
+        atlas_version_=font->atlas_version();
+        valid_=false;
+    }
+
+    //从变化位置所在行的上一行开始重新排版：变化的单词可能移回上一行。
+    //变化在第一行时没有上一行，直接从变化的字符继续排版(计分、计时这类单行文字)。
+    unsigned int line_index=0;
+    unsigned int resume_glyph=0;
+    if(valid_ && first_diff>0){
+        unsigned short diff_line=glyphs_[first_diff-1].line_;
+        line_index=diff_line>0?diff_line-1:0;
+        if(diff_line==0 && code_points_[first_diff-1]!='\n'){
+            resume_glyph=first_diff;
+        }
+    }
+    valid_=true;
+    unsigned int line_first=line_index<lines_.size()?lines_[line_index].first_glyph_:0;
+    unsigned int line_first_quad=line_index<lines_.size()?lines_[line_index].first_quad_:0;
+    unsigned int quad_index=line_first_quad;
+    unsigned int first_dirty_line=line_index;
+
+    float pen_x=0;
+    unsigned int break_glyph=line_first;//本行最后一个可以换行的位置，从这个字形开始新的一行。
+    if(resume_glyph>line_first){
+        //恢复排版到resume_glyph时的状态
+        const Glyph& last_glyph=glyphs_[resume_glyph-1];
+        pen_x=last_glyph.pen_x_+(last_glyph.character_!= nullptr?last_glyph.character_->advance_*scale:0);
+        for (unsigned int j = resume_glyph; j > line_first; --j) {
+            if(code_points_[j-1]==' '){
+                break_glyph=j;
+                break;
+            }
+            if(BreakBefore(code_points_[j-1])){
+                break_glyph=j-1;
+                break;
+            }
+        }
+        for (unsigned int j = resume_glyph; j > line_first; --j) {
+            if(glyphs_[j-1].quad_index_>=0){
+                quad_index=glyphs_[j-1].quad_index_+1;
+                break;
+            }
+        }
+    }else{
+        resume_glyph=line_first;
+    }
+    first_dirty_glyph_=resume_glyph;
+
+    glyphs_.resize(code_points_.size());
+    lines_.resize(line_index);
+    lines_.push_back({line_first,0,line_first_quad,0,0});
+
+    unsigned int i=resume_glyph;
+    while(i<code_points_.size()){
+        unsigned int code_point=code_points_[i];
+        Font::Character* character=characters_[i];
+        if(code_point=='\n'){
+            glyphs_[i]={character,code_point,pen_x,(unsigned short)line_index,-1};
+            FinishLine(line_index,i+1);
+            line_index++;
+            lines_.push_back({i+1,0,quad_index,0,0});
+            pen_x=0;
+            i++;
+            line_first=break_glyph=i;
+            continue;
+        }
+        if(BreakBefore(code_point)){
+            break_glyph=i;
+        }
+        //字距调整
+        if(i>line_first && characters_[i-1]!= nullptr && character!= nullptr){
+            pen_x+=font->GetKerning(code_points_[i-1],code_point)*scale;
+        }
+        //超过最大行宽，在最后一个可以换行的位置换行，一个单词都放不下时在当前字符前换行。
+        if(max_width>0 && i>line_first && code_point!=' ' && character!= nullptr
+            && pen_x+(character->bearing_x_+character->width_)*scale>max_width){
+            unsigned int new_line_first=break_glyph>line_first?break_glyph:i;
+            FinishLine(line_index,new_line_first);
+            quad_index=lines_[line_index].first_quad_;
+            for (unsigned int j = line_first; j < new_line_first; ++j) {
+                if(glyphs_[j].quad_index_>=0){
+                    quad_index++;
+                }
+            }
+            line_index++;
+            lines_.push_back({new_line_first,0,quad_index,0,0});
+            pen_x=0;
+            i=new_line_first;
+            line_first=break_glyph=i;
+            continue;
+        }
+
+        bool visible=character!= nullptr && character->width_>0 && character->height_>0;
+        glyphs_[i]={character,code_point,pen_x,(unsigned short)line_index,visible?(int)quad_index:-1};
+        if(visible){
+            quad_index++;
+        }
+        if(character!= nullptr){
+            pen_x+=character->advance_*scale;
+        }
+        if(code_point==' '){
+            break_glyph=i+1;
+        }
+        i++;
+    }
+    FinishLine(line_index,(unsigned int)code_points_.size());
+    quad_num_=quad_index;
+
+    //居中、右对齐时行宽变化会移动整行
+    if(alignment!=LEFT){
+        first_dirty_glyph_=std::min(first_dirty_glyph_,lines_[first_dirty_line].first_glyph_);
+    }
+
+    //对齐，变化的行才需要重新计算。
+    for (size_t line = first_dirty_line; line < lines_.size(); ++line) {
+        Line& l=lines_[line];
+        float box_width=max_width>0?max_width:0;
+        switch (alignment) {
+            case LEFT:
+                l.offset_x_=0;
+                break;
+            case CENTER:
+                l.offset_x_=(box_width-l.width_)*0.5f;
+                break;
+            case RIGHT:
+                l.offset_x_=box_width-l.width_;
+                break;
+        }
+    }
+    return true;
+}
+
+void TextLayout::FinishLine(unsigned int line_index, unsigned int end_glyph) {
+    Line& line=lines_[line_index];
+    line.glyph_num_=end_glyph-line.first_glyph_;
+    line.width_=0;
+    for (unsigned int i = line.first_glyph_; i < end_glyph; ++i) {
+        Glyph& glyph=glyphs_[i];
+        if(glyph.code_point_==' ' || glyph.code_point_=='\n' || glyph.character_== nullptr){
+            continue;
+        }
+        line.width_=std::max(line.width_,glyph.pen_x_+glyph.character_->advance_*scale_);
+    }
+}
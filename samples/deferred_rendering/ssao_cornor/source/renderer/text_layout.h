@@ -0,0 +1,93 @@
+﻿//
+// Created by captainchen on 2026/10/19.
+// 文字排版：字距调整、自动换行、对齐。
+// 缓存上一次排版的字形，文字变化时只从变化位置所在行的上一行开始重新排版，前面的行直接复用。
+// 所有缓冲区都复用容量，文字长度不超过历史最大长度时不分配内存。
+//
+
+#ifndef UNTITLED_TEXT_LAYOUT_H
+#define UNTITLED_TEXT_LAYOUT_H
+
+#include <string>
+#include <vector>
+#include "font.h"
+
+class TextLayout {
+public:
+    /// 水平对齐
+    enum Alignment{
+        LEFT,
+        CENTER,
+        RIGHT
+    };
+
+    /// 排版后的一个字符
+    struct Glyph{
+        Font::Character* character_;//没有bitmap的码点为nullptr
+        unsigned int code_point_;
+        float pen_x_;//字形原点在行内的x坐标，已经加上字距调整，不含对齐偏移。
+        unsigned short line_;//所在行
+        int quad_index_;//第几个四边形，不显示(空格、换行)为-1
+    };
+
+    /// 一行
+    struct Line{
+        unsigned int first_glyph_;
+        unsigned int glyph_num_;
+        unsigned int first_quad_;//行首之前的四边形数量
+        float width_;//不含行尾空格的宽度
+        float offset_x_;//对齐偏移
+    };
+
+    /// 排版
+    /// \param font 字体
+    /// \param text UTF-8文字
+    /// \param scale 显示字号/字体生成字号
+    /// \param max_width 最大行宽，超过自动换行，0表示不换行。
+    /// \param alignment 水平对齐，max_width为0时以原点为对齐点。
+    /// \param line_spacing 行距倍数
+    /// \return 排版结果是否变化
+    bool Layout(Font* font,const std::string& text,float scale,float max_width,Alignment alignment,float line_spacing);
+
+    /// 强制下次Layout全部重新排版
+    void Invalidate(){valid_=false;}
+
+    const std::vector<Glyph>& glyphs(){return glyphs_;}
+    const std::vector<Line>& lines(){return lines_;}
+
+    /// 需要显示的四边形数量
+    unsigned int quad_num(){return quad_num_;}
+
+    /// 上一次Layout从这个字形开始重新排版(包含对齐移动的整行)，之前的字形位置没有变化。
+    unsigned int first_dirty_glyph(){return first_dirty_glyph_;}
+
+    /// 第line行基线的y坐标
+    float line_y(unsigned short line){return -line*line_height_;}
+
+private:
+    /// 结束第line_index行，计算行宽。
+    void FinishLine(unsigned int line_index,unsigned int end_glyph);
+
+    /// 可以在这个字符之前换行(中日韩文字)
+    static bool BreakBefore(unsigned int code_point){return code_point>=0x2E80;}
+
+private:
+    bool valid_=false;//缓存是否可用
+    Font* font_= nullptr;
+    unsigned int atlas_version_=0;
+    float scale_=1.0f;
+    float max_width_=0;
+    Alignment alignment_=LEFT;
+    float line_height_=0;//行高乘以缩放和行距
+
+    std::vector<unsigned int> code_points_;//上一次排版的码点
+    std::vector<unsigned int> new_code_points_;//本次排版的码点，排版后与code_points_交换
+    std::vector<Font::Character*> characters_;
+    std::vector<Glyph> glyphs_;
+    std::vector<Line> lines_;
+    unsigned int quad_num_=0;
+    unsigned int first_dirty_glyph_=0;
+};
+
+
+#endif //UNTITLED_TEXT_LAYOUT_H
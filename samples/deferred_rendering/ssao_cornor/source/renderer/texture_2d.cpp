@@ -4,9 +4,11 @@
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "texture_2d.h"
 #include <fstream>
+#include <algorithm>
 #include "timetool/stopwatch.h"
 #include "stb/stb_truetype.h"
 #include "utils/debug.h"
+#include "utils/typed_buffer.h"
 #include "app/application.h"
 #include "render_device/render_task_producer.h"
 #include "render_device/gpu_resource_mapper.h"
@@ -16,13 +18,59 @@ using std::ifstream;
 using std::ios;
 using timetool::StopWatch;
 
-Texture2D::Texture2D() : mipmap_level_(0), width_(0), height_(0), gl_texture_format_(0), texture_handle_(0)
+/// 压缩格式每个4x4块的字节数，DXT1为8，DXT3、DXT5为16。
+/// \param gl_texture_format 压缩格式，glad没有定义S3TC扩展的常量，这里直接用数值。
+/// \return 不支持的格式返回0
+static unsigned int CompressedBlockSize(unsigned int gl_texture_format){
+    switch (gl_texture_format) {
+        case 0x83F0://GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+        case 0x83F1://GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+            return 8;
+        case 0x83F2://GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+        case 0x83F3://GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+/// 图像数据每个像素的通道数
+/// \param client_format 图像数据格式
+/// \return 不支持的格式返回0
+static unsigned int ClientFormatChannelNum(unsigned int client_format){
+    switch (client_format) {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT:
+            return 1;
+        case GL_RG:
+        case GL_RG_INTEGER:
+            return 2;
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER:
+            return 3;
+        case GL_RGBA:
+        case GL_BGRA:
+        case GL_RGBA_INTEGER:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+int Texture2D::quality_skip_mipmap_num_=0;
+unsigned int Texture2D::memory_budget_=0;
+unsigned int Texture2D::memory_size_total_=0;
+
+Texture2D::Texture2D() : mipmap_level_(0), mipmap_num_(1), memory_size_(0), width_(0), height_(0), gl_texture_format_(0), texture_handle_(0), alias_(false)
 {
 
 }
 
 Texture2D::~Texture2D() {
-    if(texture_handle_ > 0){
+    memory_size_total_-=memory_size_;
+    if(texture_handle_ > 0 && alias_==false){
         RenderTaskProducer::ProduceRenderTaskDeleteTextures(1,&texture_handle_);
     }
 }
@@ -49,22 +97,113 @@ Texture2D* Texture2D::LoadFromFile(std::string image_file_path)
         DEBUG_LOG_ERROR("image_file not exist:{}",image_file_path);
         return texture2d;
     }
-    CptFileHead cpt_file_head;
-    input_file_stream.read((char*)&cpt_file_head, sizeof(CptFileHead));
+    char type[3];
+    input_file_stream.read(type, sizeof(type));
+    input_file_stream.seekg(0, ios::beg);
+
+    unsigned char* data= nullptr;
+    unsigned int compress_size=0;
+    unsigned int mipmap_compress_size[CPT_MIPMAP_MAX_NUM];
+    if(type[0]=='c' && type[1]=='p' && type[2]=='m'){
+        //多级mipmap
+        CptMipmapFileHead cpt_mipmap_file_head;
+        input_file_stream.read((char*)&cpt_mipmap_file_head, sizeof(CptMipmapFileHead));
+        if(input_file_stream.gcount()!=sizeof(CptMipmapFileHead)){
+            DEBUG_LOG_ERROR("cpt file head truncated:{}",image_file_path);
+            return texture2d;
+        }
+        if(cpt_mipmap_file_head.version_!=kCptMipmapVersion || cpt_mipmap_file_head.mipmap_num_<=0 || cpt_mipmap_file_head.mipmap_num_>CPT_MIPMAP_MAX_NUM){
+            DEBUG_LOG_ERROR("cpt version:{} mipmap_num:{} not support:{}",cpt_mipmap_file_head.version_,cpt_mipmap_file_head.mipmap_num_,image_file_path);
+            return texture2d;
+        }
+        int mipmap_num=cpt_mipmap_file_head.mipmap_num_;
+        CptMipmapLevelHead cpt_mipmap_level_heads[CPT_MIPMAP_MAX_NUM];
+        input_file_stream.read((char*)cpt_mipmap_level_heads, sizeof(CptMipmapLevelHead)*mipmap_num);
+        if(input_file_stream.gcount()!=(std::streamsize)(sizeof(CptMipmapLevelHead)*mipmap_num)){
+            DEBUG_LOG_ERROR("cpt mipmap level head truncated:{}",image_file_path);
+            return texture2d;
+        }
+        //每一级的大小必须和宽高对应的压缩块大小一致，否则上传时会读越界。
+        unsigned int block_size=CompressedBlockSize(cpt_mipmap_file_head.gl_texture_format_);
+        if(block_size==0){
+            DEBUG_LOG_ERROR("cpt gl_texture_format:{} not support:{}",cpt_mipmap_file_head.gl_texture_format_,image_file_path);
+            return texture2d;
+        }
+        for (int i = 0; i < mipmap_num; ++i) {
+            CptMipmapLevelHead& level_head=cpt_mipmap_level_heads[i];
+            if(level_head.width_<=0 || level_head.height_<=0 || level_head.compress_size_<=0 ||
+               (unsigned int)level_head.compress_size_!=((level_head.width_+3)/4)*((level_head.height_+3)/4)*block_size){
+                DEBUG_LOG_ERROR("cpt mipmap level:{} width:{} height:{} compress_size:{} invalid:{}",
+                                i,level_head.width_,level_head.height_,level_head.compress_size_,image_file_path);
+                return texture2d;
+            }
+        }
 
-    unsigned char* data =(unsigned char*)malloc(cpt_file_head.compress_size_);
-    input_file_stream.read((char*)data, cpt_file_head.compress_size_);
+        //根据全局纹理质量跳过前几级，超出显存预算再继续跳过，至少保留最后一级。
+        int skip_mipmap_num=std::min(std::max(quality_skip_mipmap_num_,0),mipmap_num-1);
+        auto compress_size_from=[&](int mipmap_level){
+            unsigned int size=0;
+            for (int i = mipmap_level; i < mipmap_num; ++i) {
+                size+=cpt_mipmap_level_heads[i].compress_size_;
+            }
+            return size;
+        };
+        while(memory_budget_>0 && skip_mipmap_num<mipmap_num-1 && memory_size_total_+compress_size_from(skip_mipmap_num)>memory_budget_){
+            skip_mipmap_num++;
+        }
+
+        unsigned int skip_size=0;
+        for (int i = 0; i < skip_mipmap_num; ++i) {
+            skip_size+=cpt_mipmap_level_heads[i].compress_size_;
+        }
+        input_file_stream.seekg(skip_size, ios::cur);
+
+        for (int i = skip_mipmap_num; i < mipmap_num; ++i) {
+            mipmap_compress_size[i-skip_mipmap_num]=cpt_mipmap_level_heads[i].compress_size_;
+        }
+        compress_size=compress_size_from(skip_mipmap_num);
+        data =(unsigned char*)malloc(compress_size);
+        if(data== nullptr){
+            DEBUG_LOG_ERROR("cpt malloc {} failed:{}",compress_size,image_file_path);
+            return texture2d;
+        }
+        input_file_stream.read((char*)data, compress_size);
+        if(input_file_stream.gcount()!=(std::streamsize)compress_size){
+            DEBUG_LOG_ERROR("cpt mipmap data truncated,need:{} read:{}:{}",compress_size,input_file_stream.gcount(),image_file_path);
+            free(data);
+            return texture2d;
+        }
+
+        texture2d->gl_texture_format_=cpt_mipmap_file_head.gl_texture_format_;
+        texture2d->width_=cpt_mipmap_level_heads[skip_mipmap_num].width_;
+        texture2d->height_=cpt_mipmap_level_heads[skip_mipmap_num].height_;
+        texture2d->mipmap_level_=skip_mipmap_num;
+        texture2d->mipmap_num_=mipmap_num-skip_mipmap_num;
+    }else{
+        //只有一级
+        CptFileHead cpt_file_head;
+        input_file_stream.read((char*)&cpt_file_head, sizeof(CptFileHead));
+
+        compress_size=cpt_file_head.compress_size_;
+        mipmap_compress_size[0]=compress_size;
+        data =(unsigned char*)malloc(compress_size);
+        input_file_stream.read((char*)data, compress_size);
+
+        texture2d->gl_texture_format_=cpt_file_head.gl_texture_format_;
+        texture2d->width_=cpt_file_head.width_;
+        texture2d->height_=cpt_file_head.height_;
+    }
     input_file_stream.close();
 
-    texture2d->gl_texture_format_=cpt_file_head.gl_texture_format_;
-    texture2d->width_=cpt_file_head.width_;
-    texture2d->height_=cpt_file_head.height_;
+    texture2d->memory_size_=compress_size;
+    memory_size_total_+=compress_size;
     texture2d->texture_handle_=GPUResourceMapper::GenerateTextureHandle();
 
-    // 发出任务：创建压缩纹理
+    // 发出任务：创建压缩纹理，所有mipmap在一个任务里上传。
     RenderTaskProducer::ProduceRenderTaskCreateCompressedTexImage2D(texture2d->texture_handle_, texture2d->width_,
                                                                     texture2d->height_, texture2d->gl_texture_format_,
-                                                                    cpt_file_head.compress_size_, data);
+                                                                    compress_size, data,
+                                                                    texture2d->mipmap_num_, mipmap_compress_size);
 
     free(data);
     return texture2d;
@@ -104,4 +243,75 @@ Texture2D *Texture2D::Create(unsigned short width,
     return texture2d;
 }
 
+Texture2D* Texture2D::Create(unsigned short width, unsigned short height, unsigned int server_format, unsigned int client_format,
+                             unsigned int filter_mag_, unsigned int filter_min_, unsigned int wrap_s_, unsigned int wrap_t_,
+                             TypedBuffer* data) {
+    if(data== nullptr || data->data()== nullptr){
+        DEBUG_LOG_ERROR("Texture2D::Create data is nullptr or already released");
+        return nullptr;
+    }
+    //缓冲区小于图像大小时，渲染线程上传会读越界。
+    unsigned int channel_num=ClientFormatChannelNum(client_format);
+    if(channel_num==0){
+        DEBUG_LOG_ERROR("Texture2D::Create unsupported client_format:{}",client_format);
+        return nullptr;
+    }
+    size_t image_size=(size_t)width*height*channel_num*data->element_size();
+    if(data->byte_size()<image_size){
+        DEBUG_LOG_ERROR("Texture2D::Create data byte size {} less than image size {},width:{} height:{} channel:{}",
+                        data->byte_size(),image_size,width,height,channel_num);
+        return nullptr;
+    }
+    unsigned int data_type=GL_UNSIGNED_BYTE;
+    if(data->type()==TypedBuffer::Type::FLOAT32){
+        data_type=GL_FLOAT;
+    }else if(data->type()==TypedBuffer::Type::UINT16){
+        data_type=GL_UNSIGNED_SHORT;
+    }
+    unsigned int data_size=data->byte_size();
+
+    Texture2D* texture2d=new Texture2D();
+    texture2d->gl_texture_format_=server_format;
+    texture2d->width_=width;
+    texture2d->height_=height;
+    texture2d->texture_handle_=GPUResourceMapper::GenerateTextureHandle();
 
+    // 发出任务：创建纹理，缓冲区内存交给渲染任务。
+    RenderTaskProducer::ProduceRenderTaskCreateTexImage2D(texture2d->texture_handle_,
+                                                          texture2d->width_,
+                                                          texture2d->height_,
+                                                          texture2d->gl_texture_format_,
+                                                          client_format,
+                                                          filter_mag_,
+                                                          filter_min_,
+                                                          wrap_s_,
+                                                          wrap_t_,
+                                                          data_type,
+                                                          data_size,
+                                                          static_cast<unsigned char*>(data->Release()),
+                                                          true);
+
+    return texture2d;
+}
+
+Texture2D* Texture2D::CreateDepthArray(unsigned short width, unsigned short height, unsigned short layer_num) {
+    Texture2D* texture2d=new Texture2D();
+    texture2d->gl_texture_format_=GL_DEPTH_COMPONENT24;
+    texture2d->width_=width;
+    texture2d->height_=height;
+    texture2d->texture_handle_=GPUResourceMapper::GenerateTextureHandle();
+
+    // 发出任务：创建深度纹理数组
+    RenderTaskProducer::ProduceRenderTaskCreateDepthTextureArray(texture2d->texture_handle_,width,height,layer_num);
+    return texture2d;
+}
+
+Texture2D* Texture2D::CreateAlias(unsigned short width, unsigned short height, unsigned int server_format) {
+    Texture2D* texture2d=new Texture2D();
+    texture2d->gl_texture_format_=server_format;
+    texture2d->width_=width;
+    texture2d->height_=height;
+    texture2d->texture_handle_=GPUResourceMapper::GenerateTextureHandle();
+    texture2d->alias_=true;
+    return texture2d;
+}
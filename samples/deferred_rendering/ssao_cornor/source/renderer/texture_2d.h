@@ -11,6 +11,9 @@
 #include <iostream>
 #include <glad/gl.h>
 
+#define CPT_MIPMAP_MAX_NUM 16
+
+class TypedBuffer;
 class Texture2D
 {
 private:
@@ -42,19 +45,64 @@ public:
         int compress_size_;
     };
 
+    //多级mipmap的cpt文件头，type_为"cpm"。
+    //文件布局：CptMipmapFileHead + mipmap_num_个CptMipmapLevelHead + 从第0级开始依次存放的各级压缩数据。
+    //加载时跳过前N级，只需要根据CptMipmapLevelHead算出偏移，seek过去读取剩下的数据。
+    struct CptMipmapFileHead
+    {
+        char type_[3];
+        int version_;
+        int gl_texture_format_;
+        int mipmap_num_;
+    };
+
+    struct CptMipmapLevelHead
+    {
+        int width_;
+        int height_;
+        int compress_size_;
+    };
+
+    static const int kCptMipmapVersion=2;
+
     int mipmap_level(){return mipmap_level_;}
+    int mipmap_num(){return mipmap_num_;}
+    unsigned int memory_size(){return memory_size_;}
     int width(){return width_;}
     int height(){return height_;}
     GLenum gl_texture_format(){return gl_texture_format_;}
     unsigned int texture_handle(){return texture_handle_;}
     void set_texture_handle(unsigned int texture_handle){texture_handle_=texture_handle;}
 
+    /// 是否别名纹理，别名纹理的句柄映射到其它纹理，销毁时不删除GPU纹理。
+    bool alias(){return alias_;}
+
 private:
-    int mipmap_level_;
+    int mipmap_level_;//加载的第一级在文件中的级别，即跳过的mipmap数量
+    int mipmap_num_;//上传到GPU的mipmap数量
+    unsigned int memory_size_;//上传到GPU的压缩数据大小
     int width_;
     int height_;
     GLenum gl_texture_format_;
     unsigned int texture_handle_;//纹理ID
+    bool alias_;//别名纹理
+
+public:
+    /// 设置全局纹理质量，加载多级mipmap的cpt时跳过前N级，0表示加载完整的mipmap。至少保留最小的一级。
+    static void set_quality_skip_mipmap_num(int quality_skip_mipmap_num){quality_skip_mipmap_num_=quality_skip_mipmap_num;}
+    static int quality_skip_mipmap_num(){return quality_skip_mipmap_num_;}
+
+    /// 设置压缩纹理的显存预算(字节)，加载时超出预算就继续跳过更大的mipmap，0表示不限制。
+    static void set_memory_budget(unsigned int memory_budget){memory_budget_=memory_budget;}
+    static unsigned int memory_budget(){return memory_budget_;}
+
+    /// 当前所有压缩纹理占用的显存(字节)
+    static unsigned int memory_size_total(){return memory_size_total_;}
+
+private:
+    static int quality_skip_mipmap_num_;
+    static unsigned int memory_budget_;
+    static unsigned int memory_size_total_;
 
 public:
     /// 加载一个图片文件
@@ -82,6 +130,34 @@ public:
                              unsigned int data_type,
                              unsigned char* data,
                              unsigned int data_size);
+
+    /// 创建Texture(不压缩)，直接把缓冲区的内存交给渲染任务，不拷贝，之后缓冲区变为空。
+    /// \param data 图像数据，uint8缓冲区对应GL_UNSIGNED_BYTE，float32对应GL_FLOAT，uint16对应GL_UNSIGNED_SHORT。
+    /// \return
+    static Texture2D* Create(unsigned short width,
+                             unsigned short height,
+                             unsigned int server_format,
+                             unsigned int client_format,
+                             unsigned int filter_mag_,//放大滤波
+                             unsigned int filter_min_,//缩小滤波
+                             unsigned int wrap_s_,//水平方向包裹方式
+                             unsigned int wrap_t_,//垂直方向包裹方式
+                             TypedBuffer* data);
+
+    /// 创建别名纹理，只生成纹理句柄，不在GPU创建纹理。
+    /// 由FrameGraph把句柄映射到生命周期不重叠的RenderTexture共用的纹理。
+    /// \param width
+    /// \param height
+    /// \param server_format 在显存中储存的格式
+    /// \return
+    static Texture2D* CreateAlias(unsigned short width,unsigned short height,unsigned int server_format);
+
+    /// 创建深度纹理数组，开启深度比较，用于级联阴影，Shader中用sampler2DArrayShadow采样。
+    /// \param width
+    /// \param height
+    /// \param layer_num 层数
+    /// \return
+    static Texture2D* CreateDepthArray(unsigned short width,unsigned short height,unsigned short layer_num);
 };
 
 #endif //UNTITLED_TEXTURE2D_H
@@ -3,6 +3,7 @@
 //
 
 #include "ui_camera.h"
+#include "ui_canvas_batcher.h"
 
 #include <rttr/registration>
 
@@ -16,4 +17,17 @@ RTTR_REGISTRATION//注册反射
 
 UICamera::UICamera():Camera() {
     camera_use_for_=CameraUseFor::UI;
+    canvas_batcher_=new UICanvasBatcher();
+}
+
+UICamera::~UICamera() {
+    delete canvas_batcher_;
+}
+
+void UICamera::RenderUI() {
+    canvas_batcher_->Render(this);
+}
+
+unsigned int UICamera::batch_num() {
+    return canvas_batcher_->batch_num();
 }
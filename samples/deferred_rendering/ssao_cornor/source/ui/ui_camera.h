@@ -7,9 +7,20 @@
 
 #include "renderer/camera.h"
 
+class UICanvasBatcher;
 class UICamera :public Camera{
 public:
     UICamera();
+    ~UICamera();
+
+    /// 合批绘制这个相机可见的UI，在相机遍历中调用。
+    void RenderUI();
+
+    /// 上一次UI绘制的Batch数量，即DrawCall数量。
+    unsigned int batch_num();
+
+private:
+    UICanvasBatcher* canvas_batcher_;//UI合批
 
 RTTR_ENABLE();
 };
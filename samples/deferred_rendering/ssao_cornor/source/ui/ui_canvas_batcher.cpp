@@ -0,0 +1,501 @@
+﻿//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "ui_canvas_batcher.h"
+#include <algorithm>
+#include <cfloat>
+#include <glad/gl.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/transform2.hpp>
+#include <glm/gtx/euler_angles.hpp>
+#include "easy/profiler.h"
+#include "ui_graphic.h"
+#include "ui_mask.h"
+#include "component/game_object.h"
+#include "component/transform.h"
+#include "renderer/camera.h"
+#include "renderer/material.h"
+#include "renderer/shader.h"
+#include "renderer/texture_2d.h"
+#include "render_device/render_task_producer.h"
+#include "render_device/gpu_resource_mapper.h"
+#include "utils/debug.h"
+#include "utils/screen.h"
+
+#define UI_CANVAS_MAX_QUAD_NUM 16384 //索引是unsigned short，最多65536个顶点。
+#define UI_CANVAS_SORT_WINDOW 32 //合批排序时最多向前查找的UI数量
+
+std::unordered_map<std::string,Material*> UICanvasBatcher::material_map_;
+
+UICanvasBatcher::UICanvasBatcher() {
+
+}
+
+UICanvasBatcher::~UICanvasBatcher() {
+    if(vertex_array_object_handle_!=0){
+        RenderTaskProducer::ProduceRenderTaskDeleteVAO(vertex_array_object_handle_,vertex_buffer_object_handle_);
+    }
+}
+
+void UICanvasBatcher::Render(Camera* camera) {
+    EASY_FUNCTION(profiler::colors::Pink);
+    //收集结果复用容量，UI数量稳定后每帧不分配内存。
+    collect_elements_.clear();
+    Collect(camera,collect_elements_);
+    SortForBatching(collect_elements_);
+
+    if(SameLayout(collect_elements_)){
+        //层级没有变化，只把顶点变化的UI写回顶点缓冲，上传变化的范围。
+        unsigned int dirty_vertex_begin=UINT32_MAX;
+        unsigned int dirty_vertex_end=0;
+        for (size_t i = 0; i < elements_.size(); ++i) {
+            Element& element=elements_[i];
+            if(collect_elements_[i].vertex_changed_==false){
+                continue;
+            }
+            std::vector<MeshFilter::Vertex>& world_vertex_vector=element.graphic_->world_vertex_vector_;
+            std::copy(world_vertex_vector.begin(),world_vertex_vector.end(),vertex_vector_.begin()+element.first_vertex_);
+            dirty_vertex_begin=std::min(dirty_vertex_begin,element.first_vertex_);
+            dirty_vertex_end=std::max(dirty_vertex_end,element.first_vertex_+element.vertex_num_);
+        }
+        if(dirty_vertex_end>dirty_vertex_begin){
+            RenderTaskProducer::ProduceRenderTaskUpdateVBOSubData(vertex_buffer_object_handle_,
+                                                                  (dirty_vertex_end-dirty_vertex_begin)*sizeof(MeshFilter::Vertex),
+                                                                  vertex_vector_.data()+dirty_vertex_begin,
+                                                                  dirty_vertex_begin*sizeof(MeshFilter::Vertex));
+        }
+    }else{
+        elements_.swap(collect_elements_);
+        Rebuild();
+    }
+
+    DrawBatches(camera);
+}
+
+void UICanvasBatcher::Collect(Camera* camera, std::vector<Element>& elements) {
+    EASY_FUNCTION();
+    mask_stack_.clear();
+    std::vector<UIGraphic*>& graphics=collect_graphics_;
+    GameObject::Foreach([&](GameObject* game_object)->bool {
+        if(!game_object->active_self()){//当自身没有激活，返回false，打断遍历子节点。
+            return false;
+        }
+        //先序遍历回到遮罩的深度或更浅时，说明离开了遮罩的子节点。
+        while(mask_stack_.empty()==false && mask_stack_.back().depth_>=game_object->depth()){
+            PopMaskScope(elements);
+        }
+        //判断相机的 culling_mask 是否包含当前物体 layer
+        if((camera->culling_mask() & game_object->layer()) == 0x00){
+            return true;
+        }
+        //同一个GameObject上遮罩先绘制
+        graphics.clear();
+        game_object->ForeachComponent([&graphics](Component* component){
+            UIGraphic* graphic=dynamic_cast<UIGraphic*>(component);
+            if(graphic== nullptr || graphic->texture2D()== nullptr){
+                return;
+            }
+            if(graphic->mask()){
+                graphics.insert(graphics.begin(),graphic);
+            }else{
+                graphics.push_back(graphic);
+            }
+        });
+        for(auto graphic:graphics){
+            bool vertex_changed=UpdateGraphicVertex(graphic);
+            if(graphic->world_vertex_vector_.empty()){
+                continue;
+            }
+            //继承所在遮罩的模板值和裁剪矩形
+            unsigned char stencil_ref=0;
+            bool scissor=false;
+            glm::ivec4 scissor_rect(0);
+            if(mask_stack_.empty()==false){
+                MaskScope& parent=mask_stack_.back();
+                stencil_ref=parent.stencil_ref_;
+                scissor=parent.scissor_;
+                scissor_rect=parent.scissor_rect_;
+            }
+
+            Element element;
+            element.graphic_=graphic;
+            element.material_=GetMaterial(graphic->material_path());
+            element.texture2D_=graphic->texture2D();
+            element.stencil_state_=stencil_ref>0?STENCIL_TEST:STENCIL_NONE;
+            element.stencil_ref_=stencil_ref;
+            element.scissor_=scissor;
+            element.scissor_rect_=scissor_rect;
+            element.first_vertex_=0;
+            element.vertex_num_=(unsigned int)graphic->world_vertex_vector_.size();
+            element.vertex_changed_=vertex_changed;
+
+            if(graphic->mask()){
+                MaskScope scope;
+                scope.depth_=game_object->depth();
+                scope.mask_=graphic;
+                scope.vertex_changed_=vertex_changed;
+                scope.stencil_ref_=stencil_ref;
+                scope.scissor_=scissor;
+                scope.scissor_rect_=scissor_rect;
+                scope.parent_scissor_=scissor;
+                scope.parent_scissor_rect_=scissor_rect;
+
+                //没有旋转的矩形遮罩，遮罩范围就是屏幕上的矩形，用裁剪实现，不绘制遮罩。
+                UIMask* ui_mask=dynamic_cast<UIMask*>(graphic);
+                glm::mat4& model=graphic->model_;
+                if(ui_mask!= nullptr && ui_mask->rect_mask() && model[0][1]==0.f && model[1][0]==0.f){
+                    glm::ivec4 rect=WorldRectToScissor(camera,graphic->world_bounds_);
+                    if(scissor){
+                        //嵌套在矩形遮罩中，取交集。
+                        int min_x=std::max(rect.x,scissor_rect.x);
+                        int min_y=std::max(rect.y,scissor_rect.y);
+                        int max_x=std::min(rect.x+rect.z,scissor_rect.x+scissor_rect.z);
+                        int max_y=std::min(rect.y+rect.w,scissor_rect.y+scissor_rect.w);
+                        rect=glm::ivec4(min_x,min_y,std::max(max_x-min_x,0),std::max(max_y-min_y,0));
+                    }
+                    scope.mask_= nullptr;
+                    scope.scissor_=true;
+                    scope.scissor_rect_=rect;
+                    mask_stack_.push_back(scope);
+                    continue;
+                }
+
+                //模板遮罩，在父遮罩范围内把模板值+1。
+                if(stencil_ref==0xFF){
+                    DEBUG_LOG_ERROR("ui mask nesting exceed {}",0xFF);
+                    scope.mask_= nullptr;
+                    mask_stack_.push_back(scope);
+                    continue;
+                }
+                scope.stencil_ref_=stencil_ref+1;
+                mask_stack_.push_back(scope);
+
+                element.stencil_state_=STENCIL_WRITE;
+                element.stencil_ref_=scope.stencil_ref_;
+            }
+            elements.push_back(element);
+        }
+        return true;
+    });
+    while(mask_stack_.empty()==false){
+        PopMaskScope(elements);
+    }
+    RemoveUnusedErase(elements);
+}
+
+void UICanvasBatcher::PopMaskScope(std::vector<Element>& elements) {
+    MaskScope scope=mask_stack_.back();
+    mask_stack_.pop_back();
+    if(scope.mask_== nullptr){
+        return;
+    }
+    //再画一次遮罩，把模板值-1，恢复为父遮罩的模板。
+    Element element;
+    element.graphic_=scope.mask_;
+    element.material_=GetMaterial(scope.mask_->material_path());
+    element.texture2D_=scope.mask_->texture2D();
+    element.stencil_state_=STENCIL_ERASE;
+    element.stencil_ref_=scope.stencil_ref_;
+    element.scissor_=scope.parent_scissor_;
+    element.scissor_rect_=scope.parent_scissor_rect_;
+    element.first_vertex_=0;
+    element.vertex_num_=(unsigned int)scope.mask_->world_vertex_vector_.size();
+    element.vertex_changed_=scope.vertex_changed_;
+    elements.push_back(element);
+}
+
+void UICanvasBatcher::RemoveUnusedErase(std::vector<Element>& elements) {
+    //最后一个测试、写入模板的UI之后，不再使用模板，擦除没有意义，下一帧会清除模板缓冲。
+    size_t last_use=elements.size();
+    while(last_use>0){
+        StencilState stencil_state=elements[last_use-1].stencil_state_;
+        if(stencil_state==STENCIL_TEST || stencil_state==STENCIL_WRITE){
+            break;
+        }
+        last_use--;
+    }
+    auto iter=std::remove_if(elements.begin()+last_use,elements.end(),[](const Element& element){
+        return element.stencil_state_==STENCIL_ERASE;
+    });
+    elements.erase(iter,elements.end());
+}
+
+void UICanvasBatcher::SortForBatching(std::vector<Element>& elements) {
+    EASY_FUNCTION();
+    //把UI向前移动到最近一个可以合批的UI后面，只跨越不重叠的UI，所以绘制结果不变。
+    //遇到遮罩状态不同的UI就停止，遮罩内的UI保持连续，遮罩的写入、擦除不会被打乱。
+    for (size_t i = 1; i < elements.size(); ++i) {
+        const Element& element=elements[i];
+        const glm::vec4& bounds=element.graphic_->world_bounds_;
+        size_t window_begin=i>UI_CANVAS_SORT_WINDOW?i-UI_CANVAS_SORT_WINDOW:0;
+        size_t target=i;
+        for (size_t j = i; j > window_begin; --j) {
+            const Element& prev=elements[j-1];
+            if(SameMaskState(prev,element)==false){
+                break;
+            }
+            if(prev.material_==element.material_ && prev.texture2D_==element.texture2D_){
+                target=j;
+                break;
+            }
+            const glm::vec4& prev_bounds=prev.graphic_->world_bounds_;
+            if(bounds.x<prev_bounds.z && prev_bounds.x<bounds.z && bounds.y<prev_bounds.w && prev_bounds.y<bounds.w){
+                break;
+            }
+        }
+        if(target<i){
+            std::rotate(elements.begin()+target,elements.begin()+i,elements.begin()+i+1);
+        }
+    }
+}
+
+bool UICanvasBatcher::UpdateGraphicVertex(UIGraphic* graphic) {
+    auto transform=graphic->game_object()->GetComponent<Transform>();
+    glm::mat4 trans = glm::translate(transform->position());
+    auto rotation=transform->rotation();
+    glm::mat4 eulerAngleYXZ = glm::eulerAngleYXZ(glm::radians(rotation.y), glm::radians(rotation.x), glm::radians(rotation.z));
+    glm::mat4 scale = glm::scale(transform->scale()); //缩放;
+    glm::mat4 model = trans*scale*eulerAngleYXZ;
+
+    bool model_changed=graphic->model_valid_==false || model!=graphic->model_;
+    if(graphic->vertex_dirty_==false && model_changed==false){
+        return false;
+    }
+    graphic->vertex_dirty_=false;
+    graphic->model_valid_=true;
+    graphic->model_=model;
+
+    //UI顶点少，直接在CPU变换到世界坐标，这样不同位置的UI可以合批。
+    std::vector<MeshFilter::Vertex>& world_vertex_vector=graphic->world_vertex_vector_;
+    world_vertex_vector.clear();
+    graphic->FillVertex(world_vertex_vector);
+    glm::vec4 bounds(FLT_MAX,FLT_MAX,-FLT_MAX,-FLT_MAX);
+    for (auto& vertex : world_vertex_vector) {
+        vertex.position_=glm::vec3(model*glm::vec4(vertex.position_,1.0f));
+        bounds.x=std::min(bounds.x,vertex.position_.x);
+        bounds.y=std::min(bounds.y,vertex.position_.y);
+        bounds.z=std::max(bounds.z,vertex.position_.x);
+        bounds.w=std::max(bounds.w,vertex.position_.y);
+    }
+    graphic->world_bounds_=bounds;
+    return true;
+}
+
+bool UICanvasBatcher::SameLayout(const std::vector<Element>& elements) {
+    if(vertex_array_object_handle_==0 || elements.size()!=elements_.size()){
+        return false;
+    }
+    for (size_t i = 0; i < elements.size(); ++i) {
+        const Element& a=elements[i];
+        const Element& b=elements_[i];
+        if(a.graphic_!=b.graphic_ || a.material_!=b.material_ || a.texture2D_!=b.texture2D_ ||
+            SameMaskState(a,b)==false || a.vertex_num_!=b.vertex_num_){
+            return false;
+        }
+    }
+    return true;
+}
+
+void UICanvasBatcher::Rebuild() {
+    EASY_FUNCTION();
+    batches_.clear();
+    vertex_vector_.clear();
+    //拼接所有UI顶点，相邻且状态相同的UI合并为一个Batch，只在状态变化时打断。
+    for (auto& element : elements_) {
+        std::vector<MeshFilter::Vertex>& world_vertex_vector=element.graphic_->world_vertex_vector_;
+        if((vertex_vector_.size()+world_vertex_vector.size())/4>UI_CANVAS_MAX_QUAD_NUM){
+            DEBUG_LOG_ERROR("ui quad num exceed {}",UI_CANVAS_MAX_QUAD_NUM);
+            element.vertex_num_=0;
+            continue;
+        }
+        element.first_vertex_=(unsigned int)vertex_vector_.size();
+        vertex_vector_.insert(vertex_vector_.end(),world_vertex_vector.begin(),world_vertex_vector.end());
+
+        unsigned int first_index=element.first_vertex_/4*6;
+        unsigned int index_num=element.vertex_num_/4*6;
+        if(batches_.empty()==false){
+            Batch& batch=batches_.back();
+            if(batch.material_==element.material_ && batch.texture2D_==element.texture2D_ && batch.stencil_state_==element.stencil_state_
+                && batch.stencil_ref_==element.stencil_ref_ && batch.scissor_==element.scissor_ && batch.scissor_rect_==element.scissor_rect_
+                && batch.first_index_+batch.index_num_==first_index){
+                batch.index_num_+=index_num;
+                continue;
+            }
+        }
+        batches_.push_back({element.material_,element.texture2D_,element.stencil_state_,element.stencil_ref_,
+                            element.scissor_,element.scissor_rect_,first_index,index_num});
+    }
+    if(vertex_vector_.empty()){
+        return;
+    }
+
+    unsigned int quad_num=(unsigned int)vertex_vector_.size()/4;
+    if(EnsureCapacity(quad_num,batches_[0].material_->shader()->shader_program_handle())==false){
+        RenderTaskProducer::ProduceRenderTaskUpdateVBOSubData(vertex_buffer_object_handle_,vertex_vector_.size()*sizeof(MeshFilter::Vertex),vertex_vector_.data());
+    }
+}
+
+bool UICanvasBatcher::EnsureCapacity(unsigned int quad_num, unsigned int shader_program_handle) {
+    if(quad_num<=quad_capacity_){
+        return false;
+    }
+    unsigned int quad_capacity=quad_capacity_==0?64:quad_capacity_;
+    while(quad_capacity<quad_num){
+        quad_capacity*=2;
+    }
+    quad_capacity_=std::min(quad_capacity,(unsigned int)UI_CANVAS_MAX_QUAD_NUM);
+
+    //所有UI都是四边形，索引固定为 0,1,2 0,2,3 依次递增，只在扩容时生成。
+    std::vector<unsigned short> index_vector(quad_capacity_*6);
+    for (unsigned int i = 0; i < quad_capacity_; ++i) {
+        unsigned short first_vertex=(unsigned short)(i*4);
+        index_vector[i*6+0]=first_vertex;
+        index_vector[i*6+1]=first_vertex+1;
+        index_vector[i*6+2]=first_vertex+2;
+        index_vector[i*6+3]=first_vertex;
+        index_vector[i*6+4]=first_vertex+2;
+        index_vector[i*6+5]=first_vertex+3;
+    }
+    std::vector<MeshFilter::Vertex> vertex_vector(quad_capacity_*4);
+    std::copy(vertex_vector_.begin(),vertex_vector_.end(),vertex_vector.begin());
+
+    //旧的VAO不再使用，删除后重新创建更大的。UI Shader的顶点属性布局相同，VAO可以在各UI材质间共用。
+    if(vertex_array_object_handle_!=0){
+        RenderTaskProducer::ProduceRenderTaskDeleteVAO(vertex_array_object_handle_,vertex_buffer_object_handle_);
+    }
+    vertex_array_object_handle_=GPUResourceMapper::GenerateVAOHandle();
+    vertex_buffer_object_handle_=GPUResourceMapper::GenerateVBOHandle();
+    RenderTaskProducer::ProduceRenderTaskCreateVAO(shader_program_handle, vertex_array_object_handle_,
+                                                   vertex_buffer_object_handle_,
+                                                   vertex_vector.size() * sizeof(MeshFilter::Vertex),
+                                                   sizeof(MeshFilter::Vertex),
+                                                   vertex_vector.data(),
+                                                   index_vector.size() * sizeof(unsigned short),
+                                                   index_vector.data());
+    return true;
+}
+
+void UICanvasBatcher::DrawBatches(Camera* camera) {
+    EASY_FUNCTION();
+    if(batches_.empty()){
+        return;
+    }
+    glm::mat4 model(1.0f);//顶点已经是世界坐标
+    glm::mat4& view=camera->view_mat4();
+    glm::mat4& projection=camera->projection_mat4();
+
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_DEPTH_TEST,false);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_CULL_FACE,true);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_BLEND,true);
+    RenderTaskProducer::ProduceRenderTaskSetBlenderFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    Material* last_material= nullptr;
+    //只在状态变化时切换，遮罩内的Batch连续绘制。
+    StencilState last_stencil_state=STENCIL_NONE;
+    unsigned char last_stencil_ref=0;
+    bool last_scissor=false;
+    glm::ivec4 last_scissor_rect(-1);
+    ApplyStencilState(STENCIL_NONE,0);
+    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_SCISSOR_TEST,false);
+    for (auto& batch : batches_) {
+        Shader* shader=batch.material_->shader();
+        unsigned int shader_program_handle=shader->shader_program_handle();
+        //相邻Batch材质相同时，不再重复切换Shader和上传矩阵。
+        if(batch.material_!=last_material){
+            shader->Active();
+            RenderTaskProducer::ProduceRenderTaskSetUniformMatrix4fv(shader_program_handle, "u_model", false,model);
+            RenderTaskProducer::ProduceRenderTaskSetUniformMatrix4fv(shader_program_handle, "u_view", false,view);
+            RenderTaskProducer::ProduceRenderTaskSetUniformMatrix4fv(shader_program_handle, "u_projection", false,projection);
+            last_material=batch.material_;
+        }
+        RenderTaskProducer::ProduceRenderTaskActiveAndBindTexture("u_diffuse_texture",GL_TEXTURE0,batch.texture2D_->texture_handle());
+        RenderTaskProducer::ProduceRenderTaskSetUniform1i(shader_program_handle,"u_diffuse_texture",0);
+
+        if(batch.stencil_state_!=last_stencil_state || batch.stencil_ref_!=last_stencil_ref){
+            bool color_write=batch.stencil_state_!=STENCIL_WRITE && batch.stencil_state_!=STENCIL_ERASE;
+            bool last_color_write=last_stencil_state!=STENCIL_WRITE && last_stencil_state!=STENCIL_ERASE;
+            if(color_write!=last_color_write){
+                RenderTaskProducer::ProduceRenderTaskSetColorMask(color_write,color_write,color_write,color_write);
+            }
+            ApplyStencilState(batch.stencil_state_,batch.stencil_ref_);
+            last_stencil_state=batch.stencil_state_;
+            last_stencil_ref=batch.stencil_ref_;
+        }
+        if(batch.scissor_!=last_scissor){
+            RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_SCISSOR_TEST,batch.scissor_);
+            last_scissor=batch.scissor_;
+        }
+        if(batch.scissor_ && batch.scissor_rect_!=last_scissor_rect){
+            const glm::ivec4& rect=batch.scissor_rect_;
+            RenderTaskProducer::ProduceRenderTaskSetScissor(rect.x,rect.y,rect.z,rect.w);
+            last_scissor_rect=rect;
+        }
+        RenderTaskProducer::ProduceRenderTaskBindVAOAndDrawElements(vertex_array_object_handle_,batch.index_num_,batch.first_index_);
+    }
+    //恢复状态，不影响之后的绘制。
+    if(last_stencil_state==STENCIL_WRITE || last_stencil_state==STENCIL_ERASE){
+        RenderTaskProducer::ProduceRenderTaskSetColorMask(true,true,true,true);
+    }
+    ApplyStencilState(STENCIL_NONE,0);
+    if(last_scissor){
+        RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_SCISSOR_TEST,false);
+    }
+}
+
+glm::ivec4 UICanvasBatcher::WorldRectToScissor(Camera* camera, const glm::vec4& world_rect) {
+    glm::mat4 view_projection=camera->projection_mat4()*camera->view_mat4();
+    glm::vec4 min_clip=view_projection*glm::vec4(world_rect.x,world_rect.y,0.f,1.f);
+    glm::vec4 max_clip=view_projection*glm::vec4(world_rect.z,world_rect.w,0.f,1.f);
+    //NDC [-1,1] 转换到屏幕像素，左下角为原点，与glScissor一致。
+    float min_x=(std::min(min_clip.x,max_clip.x)*0.5f+0.5f)*Screen::width();
+    float min_y=(std::min(min_clip.y,max_clip.y)*0.5f+0.5f)*Screen::height();
+    float max_x=(std::max(min_clip.x,max_clip.x)*0.5f+0.5f)*Screen::width();
+    float max_y=(std::max(min_clip.y,max_clip.y)*0.5f+0.5f)*Screen::height();
+    int x=(int)std::floor(min_x);
+    int y=(int)std::floor(min_y);
+    return glm::ivec4(x,y,std::max((int)std::ceil(max_x)-x,0),std::max((int)std::ceil(max_y)-y,0));
+}
+
+bool UICanvasBatcher::SameMaskState(const Element& a, const Element& b) {
+    return a.stencil_state_==b.stencil_state_ && a.stencil_ref_==b.stencil_ref_ &&
+           a.scissor_==b.scissor_ && a.scissor_rect_==b.scissor_rect_;
+}
+
+void UICanvasBatcher::ApplyStencilState(StencilState stencil_state, unsigned char stencil_ref) {
+    switch (stencil_state) {
+        case STENCIL_NONE:{
+            RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, false);
+            break;
+        }
+        case STENCIL_TEST:{
+            RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, true);
+            RenderTaskProducer::ProduceRenderTaskSetStencilFunc(GL_EQUAL, stencil_ref, 0xFF);//等于遮罩模板值通过测试，就是所有父遮罩重叠的范围。
+            RenderTaskProducer::ProduceRenderTaskSetStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+            break;
+        }
+        case STENCIL_WRITE:{
+            RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, true);//开启模版测试
+            RenderTaskProducer::ProduceRenderTaskSetStencilFunc(GL_EQUAL, stencil_ref-1, 0xFF);//只在父遮罩范围内写入
+            RenderTaskProducer::ProduceRenderTaskSetStencilOp(GL_KEEP, GL_KEEP, GL_INCR);//像素的模版值 父遮罩模板值+1
+            break;
+        }
+        case STENCIL_ERASE:{
+            RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, true);
+            RenderTaskProducer::ProduceRenderTaskSetStencilFunc(GL_EQUAL, stencil_ref, 0xFF);//只擦除自己写入的范围
+            RenderTaskProducer::ProduceRenderTaskSetStencilOp(GL_KEEP, GL_KEEP, GL_DECR);//恢复为父遮罩模板值
+            break;
+        }
+    }
+}
+
+Material* UICanvasBatcher::GetMaterial(const char* material_path) {
+    auto iter=material_map_.find(material_path);
+    if(iter!=material_map_.end()){
+        return iter->second;
+    }
+    auto material=new Material();
+    material->Parse(material_path);
+    material_map_[material_path]=material;
+    return material;
+}
@@ -0,0 +1,148 @@
+//
+// Created by captainchen on 2026/10/19.
+// UI合批，每个UICamera一个。
+// 按层级先序遍历(即绘制顺序)收集UIGraphic，相邻且材质、纹理、遮罩状态相同的UI合并到同一个Batch，
+// 所有Batch共用一个流式顶点缓冲，一个Batch一次DrawCall。
+// UI层级和顶点数量不变时，只把顶点变化的UI写回顶点缓冲，只上传变化的范围。
+//
+// 遮罩：UIMask遮住自己子节点中的UI，可以嵌套。
+// 模板遮罩按嵌套深度分配模板值，进入遮罩时模板值+1，离开时把遮罩再画一次-1，恢复父遮罩的模板。
+// 矩形遮罩(没有旋转)用裁剪矩形实现，不写模板也不绘制遮罩。
+//
+
+#ifndef UNTITLED_UI_CANVAS_BATCHER_H
+#define UNTITLED_UI_CANVAS_BATCHER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "renderer/mesh_filter.h"
+
+class Camera;
+class Material;
+class Texture2D;
+class UIGraphic;
+class UICanvasBatcher {
+public:
+    UICanvasBatcher();
+    ~UICanvasBatcher();
+
+    /// 收集相机可见的UI，更新顶点缓冲并按Batch绘制。
+    /// \param camera 当前渲染的UI相机
+    void Render(Camera* camera);
+
+    /// 上一次绘制的Batch数量，即DrawCall数量。
+    unsigned int batch_num(){return (unsigned int)batches_.size();}
+
+    /// 上一次绘制的UI数量
+    unsigned int element_num(){return (unsigned int)elements_.size();}
+
+private:
+    /// 模板状态
+    enum StencilState{
+        STENCIL_NONE,//不使用模板
+        STENCIL_TEST,//只在模板值等于stencil_ref_的范围内绘制
+        STENCIL_WRITE,//绘制遮罩，在父遮罩范围内模板值+1，不写颜色。
+        STENCIL_ERASE//离开遮罩，再画一次遮罩，模板值-1，不写颜色。
+    };
+
+    /// 一个UI在画布顶点缓冲中的位置
+    struct Element{
+        UIGraphic* graphic_;
+        Material* material_;
+        Texture2D* texture2D_;
+        StencilState stencil_state_;
+        unsigned char stencil_ref_;//遮罩嵌套深度
+        bool scissor_;//是否在矩形遮罩中
+        glm::ivec4 scissor_rect_;//裁剪矩形 (x,y,width,height)，像素
+        unsigned int first_vertex_;
+        unsigned int vertex_num_;
+        bool vertex_changed_;//本帧顶点是否变化
+    };
+
+    /// 一次DrawCall
+    struct Batch{
+        Material* material_;
+        Texture2D* texture2D_;
+        StencilState stencil_state_;
+        unsigned char stencil_ref_;
+        bool scissor_;
+        glm::ivec4 scissor_rect_;
+        unsigned int first_index_;
+        unsigned int index_num_;
+    };
+
+    /// 收集时正在遍历的遮罩
+    struct MaskScope{
+        unsigned short depth_;//遮罩GameObject的层级深度，先序遍历回到这个深度或更浅时，离开遮罩。
+        UIGraphic* mask_;//模板遮罩，矩形遮罩为nullptr
+        bool vertex_changed_;//模板遮罩本帧顶点是否变化
+        unsigned char stencil_ref_;//遮罩内的模板值
+        bool scissor_;
+        glm::ivec4 scissor_rect_;//遮罩内的裁剪矩形
+        bool parent_scissor_;//进入遮罩前的裁剪状态，离开时擦除模板用。
+        glm::ivec4 parent_scissor_rect_;
+    };
+
+    /// 按绘制顺序收集UI，更新各UI的世界坐标顶点。
+    /// \param camera 当前渲染的UI相机
+    /// \param elements 收集结果
+    void Collect(Camera* camera,std::vector<Element>& elements);
+
+    /// 离开模板遮罩，添加擦除模板的Element。
+    void PopMaskScope(std::vector<Element>& elements);
+
+    /// 后面不再使用模板时，不需要擦除。
+    void RemoveUnusedErase(std::vector<Element>& elements);
+
+    /// 在不改变重叠UI先后顺序的前提下，把可以合批的UI排到一起。
+    /// 不会跨越遮罩状态移动，遮罩内的UI保持连续。
+    void SortForBatching(std::vector<Element>& elements);
+
+    /// 更新UI的世界坐标顶点，没有变化时不做任何事。
+    /// \return 顶点是否变化
+    bool UpdateGraphicVertex(UIGraphic* graphic);
+
+    /// 层级、材质、纹理、顶点数量都没有变化时，可以只更新变化的顶点。
+    bool SameLayout(const std::vector<Element>& elements);
+
+    /// 重新拼接所有顶点，重新划分Batch。
+    void Rebuild();
+
+    /// 确保顶点缓冲能容纳quad_num个四边形，不够时按2倍扩容重新创建。
+    /// \return 是否重新创建了VAO(重新创建时已经上传了全部顶点)
+    bool EnsureCapacity(unsigned int quad_num,unsigned int shader_program_handle);
+
+    /// 绘制所有Batch
+    void DrawBatches(Camera* camera);
+
+    /// 世界坐标矩形转换为屏幕像素矩形 (x,y,width,height)
+    static glm::ivec4 WorldRectToScissor(Camera* camera,const glm::vec4& world_rect);
+
+    /// 遮罩状态(模板、裁剪)是否相同
+    static bool SameMaskState(const Element& a,const Element& b);
+
+    /// 设置模板状态
+    static void ApplyStencilState(StencilState stencil_state,unsigned char stencil_ref);
+
+    /// 获取UI材质，同一个材质文件只加载一次。
+    static Material* GetMaterial(const char* material_path);
+
+private:
+    std::vector<Element> elements_;//上一次绘制的UI
+    std::vector<Batch> batches_;//上一次绘制的Batch
+    std::vector<MeshFilter::Vertex> vertex_vector_;//画布所有UI的顶点，世界坐标
+    std::vector<Element> collect_elements_;//本帧收集的UI
+    std::vector<UIGraphic*> collect_graphics_;//一个GameObject上的UI
+    std::vector<MaskScope> mask_stack_;//收集时的遮罩栈
+
+    unsigned int vertex_array_object_handle_=0;//顶点数组对象句柄
+    unsigned int vertex_buffer_object_handle_=0;//顶点缓冲区对象句柄
+    unsigned int quad_capacity_=0;//顶点缓冲能容纳的四边形数量
+
+    static std::unordered_map<std::string,Material*> material_map_;//UI材质 key:材质文件路径
+};
+
+
+#endif //UNTITLED_UI_CANVAS_BATCHER_H
@@ -0,0 +1,49 @@
+//
+// Created by captainchen on 2026/10/19.
+// UI可绘制组件的基类，UIImage、UIText、UIMask都从这里派生。
+// 组件本身不再创建MeshFilter、MeshRenderer，只提供顶点、纹理和材质，由UICamera的UICanvasBatcher合批绘制。
+//
+
+#ifndef UNTITLED_UI_GRAPHIC_H
+#define UNTITLED_UI_GRAPHIC_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "component/component.h"
+#include "renderer/mesh_filter.h"
+
+class Texture2D;
+class UIGraphic : public Component {
+public:
+    UIGraphic():Component(){}
+    ~UIGraphic() override{}
+
+    /// 合批使用的材质文件，材质相同、纹理相同、模板状态相同的相邻UI合并为一次绘制。
+    virtual const char* material_path()=0;
+
+    /// 合批使用的纹理，为空时不绘制。
+    virtual Texture2D* texture2D()=0;
+
+    /// 生成本地坐标的顶点，追加到vertex_vector，每4个顶点组成一个四边形(0,1,2 0,2,3)。
+    virtual void FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector)=0;
+
+    /// 是否模板遮罩，遮罩只写入模板缓冲，遮住子节点中的UI。
+    virtual bool mask(){return false;}
+
+    /// 标记顶点需要重新生成，下次绘制时只更新这个UI在画布顶点缓冲中的部分。
+    void SetVertexDirty(){vertex_dirty_=true;}
+
+private:
+    bool vertex_dirty_=true;//顶点需要重新生成
+    bool model_valid_=false;//model_是否已经计算过
+    glm::mat4 model_;//生成world_vertex_vector_时的模型矩阵，变化后需要重新变换顶点
+    glm::vec4 world_bounds_;//世界坐标包围矩形 (min_x,min_y,max_x,max_y)，合批排序判断重叠、矩形遮罩计算裁剪范围
+    std::vector<MeshFilter::Vertex> world_vertex_vector_;//变换到世界坐标的顶点，合批时拷贝到画布顶点缓冲
+
+    friend class UICanvasBatcher;
+
+RTTR_ENABLE();
+};
+
+
+#endif //UNTITLED_UI_GRAPHIC_H
@@ -7,9 +7,6 @@
 #include <rttr/registration>
 #include "component/game_object.h"
 #include "renderer/texture_2d.h"
-#include "renderer/material.h"
-#include "renderer/mesh_renderer.h"
-#include "render_device/render_task_producer.h"
 #include "utils/debug.h"
 
 using namespace rttr;
@@ -18,7 +15,7 @@ RTTR_REGISTRATION{
             .constructor<>()(rttr::policy::ctor::as_raw_ptr);
 }
 
-UIImage::UIImage():Component() {
+UIImage::UIImage():UIGraphic() {
 
 }
 
@@ -33,46 +30,53 @@ void UIImage::LoadTexture2D(const char* texture_file_path){
     set_texture(texture_2d);
 }
 
-void UIImage::Update() {
-    Component::Update();
-    if(texture2D_== nullptr){
+void UIImage::set_texture(Texture2D* texture2D) {
+    texture2D_=texture2D;
+    sprite_= nullptr;
+    SetVertexDirty();
+}
+
+void UIImage::set_sprite(SpriteAtlas::Sprite* sprite) {
+    if(sprite== nullptr){
+        DEBUG_LOG_ERROR("sprite is nullptr");
         return;
     }
-    MeshFilter* mesh_filter=game_object()->GetComponent<MeshFilter>();
-    if(mesh_filter== nullptr){
-        //创建 MeshFilter
-        std::vector<MeshFilter::Vertex> vertex_vector={
-                { {0.f, 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {0.f, 0.f} },
-                { {texture2D_->width(), 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {1.f, 0.f} },
-                { {texture2D_->width(),  texture2D_->height(), 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {1.f, 1.f} },
-                { {0.f,  texture2D_->height(), 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {0.f, 1.f} }
-        };
-        std::vector<unsigned short> index_vector={
-                0,1,2,
-                0,2,3
-        };
-        mesh_filter=game_object()->AddComponent<MeshFilter>();
-        mesh_filter->CreateMesh(vertex_vector,index_vector);
-
-        //创建 Material
-        auto material=new Material();//设置材质
-        material->Parse("material/ui_image.mat");
-        material->SetTexture("u_diffuse_texture", texture2D_);
+    texture2D_=sprite->texture2D_;
+    sprite_=sprite;
+    SetVertexDirty();
+}
 
-        //挂上 MeshRenderer 组件
-        auto mesh_renderer=game_object()->AddComponent<MeshRenderer>();
-        mesh_renderer->SetMaterial(material);
+void UIImage::LoadSprite(const char* atlas_file_path, const char* sprite_name) {
+    SpriteAtlas::Sprite* sprite=SpriteAtlas::FindSprite(atlas_file_path,sprite_name);
+    if(sprite== nullptr){
+        DEBUG_LOG_ERROR("sprite {} not found in {}",sprite_name,atlas_file_path);
+        return;
     }
+    set_sprite(sprite);
 }
 
-void UIImage::OnPreRender() {
-    Component::OnPreRender();
-    RenderTaskProducer::ProduceRenderTaskSetStencilFunc(GL_EQUAL, 0x1, 0xFF);//等于1 通过测试 ,就是上次绘制的图 的范围 才通过测试。
-    RenderTaskProducer::ProduceRenderTaskSetStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);//没有通过测试的，保留原来的，也就是保留上一次的值。
+float UIImage::width() {
+    if(sprite_!= nullptr){
+        return sprite_->width_;
+    }
+    return texture2D_== nullptr?0.f:texture2D_->width();
 }
 
-void UIImage::OnPostRender() {
-    Component::OnPostRender();
-    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, false);
+float UIImage::height() {
+    if(sprite_!= nullptr){
+        return sprite_->height_;
+    }
+    return texture2D_== nullptr?0.f:texture2D_->height();
 }
 
+void UIImage::FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector) {
+    float image_width=width();
+    float image_height=height();
+    glm::vec4 uv=uv_rect();
+    vertex_vector.insert(vertex_vector.end(),{
+            { {0.f, 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.x, uv.y} },
+            { {image_width, 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.z, uv.y} },
+            { {image_width,  image_height, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.z, uv.w} },
+            { {0.f,  image_height, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.x, uv.w} }
+    });
+}
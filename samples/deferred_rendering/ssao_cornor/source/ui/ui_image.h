@@ -5,31 +5,46 @@
 #ifndef UNTITLED_UI_IMAGE_H
 #define UNTITLED_UI_IMAGE_H
 
-#include "component/component.h"
-#include "renderer/mesh_filter.h"
+#include "ui_graphic.h"
+#include "renderer/sprite_atlas.h"
 
 class Texture2D;
-class UIImage : public Component {
+class UIImage : public UIGraphic {
 public:
     UIImage();
     ~UIImage() override;
 
-    Texture2D* texture2D(){return texture2D_;}
-    void set_texture(Texture2D* texture2D){
-        texture2D_=texture2D;
-    }
+    Texture2D* texture2D() override{return texture2D_;}
+    /// 设置整张Texture
+    void set_texture(Texture2D* texture2D);
+
+    /// 设置图集中的Sprite，使用图集纹理和Sprite的UV子区域。
+    void set_sprite(SpriteAtlas::Sprite* sprite);
+    SpriteAtlas::Sprite* sprite(){return sprite_;}
 
     /// 指定图片路径加载并设置
     /// \param texture_file_path
     void LoadTexture2D(const char* texture_file_path);
+
+    /// 指定图集和散图名字加载并设置
+    /// \param atlas_file_path .atlas 文件路径
+    /// \param sprite_name 散图名字
+    void LoadSprite(const char* atlas_file_path,const char* sprite_name);
+
+    /// 图片显示的宽高，使用Sprite时为Sprite原始像素尺寸，否则为Texture尺寸。
+    float width();
+    float height();
+    /// 左下角UV(x,y)，右上角UV(z,w)
+    glm::vec4 uv_rect(){return sprite_== nullptr?glm::vec4(0.f,0.f,1.f,1.f):sprite_->uv_rect_;}
 public:
-    void Update() override;
-    /// 渲染之前
-    void OnPreRender() override;
+    const char* material_path() override{return "material/ui_image.mat";}
+
+    /// 按宽高和UV生成四边形顶点
+    void FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector) override;
 
-    void OnPostRender() override;
 private:
     Texture2D* texture2D_= nullptr;//Texture
+    SpriteAtlas::Sprite* sprite_= nullptr;//图集中的Sprite，为空时显示整张Texture
 
 RTTR_ENABLE();
 };
@@ -7,10 +7,7 @@
 #include <rttr/registration>
 #include "component/game_object.h"
 #include "renderer/texture_2d.h"
-#include "renderer/material.h"
-#include "renderer/mesh_renderer.h"
 #include "utils/debug.h"
-#include "render_device/render_task_producer.h"
 
 using namespace rttr;
 RTTR_REGISTRATION{
@@ -27,54 +24,23 @@ UIMask::~UIMask() {
 
 }
 
-void UIMask::OnEnable() {
-
-}
-
-void UIMask::Update() {
-    Component::Update();
-    if(texture2D_== nullptr){
+void UIMask::LoadSprite(const char* atlas_file_path, const char* sprite_name) {
+    SpriteAtlas::Sprite* sprite=SpriteAtlas::FindSprite(atlas_file_path,sprite_name);
+    if(sprite== nullptr){
+        DEBUG_LOG_ERROR("sprite {} not found in {}",sprite_name,atlas_file_path);
         return;
     }
-    MeshFilter* mesh_filter=game_object()->GetComponent<MeshFilter>();
-    if(mesh_filter== nullptr){
-        //创建 MeshFilter
-        std::vector<MeshFilter::Vertex> vertex_vector={
-                { {0.f, 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {0.f, 0.f} },
-                { {texture2D_->width(), 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {1.f, 0.f} },
-                { {texture2D_->width(),  texture2D_->height(), 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {1.f, 1.f} },
-                { {0.f,  texture2D_->height(), 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {0.f, 1.f} }
-        };
-        std::vector<unsigned short> index_vector={
-                0,1,2,
-                0,2,3
-        };
-        mesh_filter=game_object()->AddComponent<MeshFilter>();
-        mesh_filter->CreateMesh(vertex_vector,index_vector);
-
-        //创建 Material
-        auto material=new Material();//设置材质
-        material->Parse("material/ui_mask.mat");
-        material->SetTexture("u_diffuse_texture", texture2D_);
-
-        //挂上 MeshRenderer 组件
-        auto mesh_renderer=game_object()->AddComponent<MeshRenderer>();
-        mesh_renderer->SetMaterial(material);
-    }
-}
-
-void UIMask::OnPreRender() {
-    Component::OnPreRender();
-    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, true);//开启模版测试
-    RenderTaskProducer::ProduceRenderTaskSetStencilBufferClearValue(0);//设置默认模版值 0
-    RenderTaskProducer::ProduceRenderTaskSetStencilFunc(GL_NEVER, 0x0, 0xFF);//通通不通过模版测试。
-    RenderTaskProducer::ProduceRenderTaskSetStencilOp(GL_INCR, GL_INCR, GL_INCR);//像素的模版值 0+1 = 1
-}
-
-void UIMask::OnPostRender() {
-    Component::OnPostRender();
-}
-
-void UIMask::OnDisable() {
-    RenderTaskProducer::ProduceRenderTaskSetEnableState(GL_STENCIL_TEST, false);
+    set_sprite(sprite);
+}
+
+void UIMask::FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector) {
+    float width=sprite_== nullptr?texture2D_->width():sprite_->width_;
+    float height=sprite_== nullptr?texture2D_->height():sprite_->height_;
+    glm::vec4 uv=sprite_== nullptr?glm::vec4(0.f,0.f,1.f,1.f):sprite_->uv_rect_;
+    vertex_vector.insert(vertex_vector.end(),{
+            { {0.f, 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.x, uv.y} },
+            { {width, 0.0f, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.z, uv.y} },
+            { {width,  height, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.z, uv.w} },
+            { {0.f,  height, 0.0f}, {1.0f,1.0f,1.0f,1.0f},   {uv.x, uv.w} }
+    });
 }
@@ -5,30 +5,49 @@
 #ifndef UNTITLED_UI_MASK_H
 #define UNTITLED_UI_MASK_H
 
-#include "component/component.h"
-#include "renderer/mesh_filter.h"
+#include "ui_graphic.h"
+#include "renderer/sprite_atlas.h"
 
 class Texture2D;
-class UIMask : public Component {
+/// 遮罩，子节点中的UI只在遮罩图片范围内显示，遮罩可以嵌套。
+/// 默认用模板缓冲按图片形状遮罩；设置为矩形遮罩并且没有旋转时，用裁剪矩形实现，不需要绘制遮罩。
+class UIMask : public UIGraphic {
 public:
     UIMask();
     ~UIMask() override;
 
-    Texture2D* texture2D(){return texture2D_;}
-    void set_texture(Texture2D* texture2D){texture2D_=texture2D;}
+    Texture2D* texture2D() override{return texture2D_;}
+    void set_texture(Texture2D* texture2D){texture2D_=texture2D;sprite_= nullptr;SetVertexDirty();}
+
+    /// 设置图集中的Sprite作为遮罩形状
+    void set_sprite(SpriteAtlas::Sprite* sprite){
+        if(sprite!= nullptr){
+            texture2D_=sprite->texture2D_;
+        }
+        sprite_=sprite;
+        SetVertexDirty();
+    }
+
+    /// 指定图集和散图名字加载并设置
+    /// \param atlas_file_path .atlas 文件路径
+    /// \param sprite_name 散图名字
+    void LoadSprite(const char* atlas_file_path,const char* sprite_name);
 
 public:
-    void OnEnable() override;
+    const char* material_path() override{return "material/ui_mask.mat";}
+
+    /// 使用Sprite时取Sprite的尺寸和UV子区域
+    void FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector) override;
 
-    void Update() override;
-    /// 渲染之前
-    void OnPreRender() override;
-    /// 渲染之后
-    void OnPostRender() override;
+    bool mask() override{return true;}
 
-    void OnDisable() override;
+    /// 矩形遮罩，使用图片的矩形范围裁剪，忽略图片形状。
+    void set_rect_mask(bool rect_mask){rect_mask_=rect_mask;}
+    bool rect_mask(){return rect_mask_;}
 private:
+    bool rect_mask_= false;//矩形遮罩
     Texture2D* texture2D_= nullptr;//Texture
+    SpriteAtlas::Sprite* sprite_= nullptr;//图集中的Sprite，为空时使用整张Texture
 
 RTTR_ENABLE();
 };
@@ -7,9 +7,6 @@
 #include <rttr/registration>
 #include "component/game_object.h"
 #include "renderer/texture_2d.h"
-#include "renderer/material.h"
-#include "renderer/mesh_renderer.h"
-#include "renderer/mesh_filter.h"
 #include "renderer/font.h"
 #include "utils/debug.h"
 
@@ -19,11 +16,11 @@ RTTR_REGISTRATION{
             .constructor<>()(rttr::policy::ctor::as_raw_ptr);
 }
 
-UIText::UIText():color_({1,1,1,1}) {
+UIText::UIText():UIGraphic(),font_(nullptr),color_({1,1,1,1}) {
 
 }
 
-void UIText::set_text(std::string text) {
+void UIText::set_text(const std::string& text) {
     if(text_==text){
         return;
     }
@@ -38,62 +35,70 @@ void UIText::Update() {
         return;
     }
 
-    MeshFilter* mesh_filter=game_object()->GetComponent<MeshFilter>();
-    if(mesh_filter== nullptr){
-        //挂上 MeshFilter 组件
-        mesh_filter=game_object()->AddComponent<MeshFilter>();
-
-        //创建 Material
-        auto material=new Material();//设置材质
-        material->Parse("material/ui_text.mat");
-
-        //挂上 MeshRenderer 组件
-        auto mesh_renderer=game_object()->AddComponent<MeshRenderer>();
-        mesh_renderer->SetMaterial(material);
-
-        //使用文字贴图
-        material->SetTexture("u_diffuse_texture", font_->font_texture());
+    //图集页被淘汰后字形信息失效，TextLayout会发现并全部重新排版。
+    if(font_atlas_version_!=font_->atlas_version()){
+        font_atlas_version_=font_->atlas_version();
+        dirty_=true;
     }
 
     if(dirty_){
         dirty_=false;
+        //按显示字号缩放字形
+        float scale=font_size_==0?1.0f:font_size_*1.0f/font_->font_size();
+        if(text_layout_.Layout(font_,text_,scale,width_,alignment_,line_spacing_)){
+            WriteVertex(color_dirty_?0:text_layout_.first_dirty_glyph());
+            color_dirty_=false;
+            SetVertexDirty();
+        }
+    }
+    if(color_dirty_){
+        color_dirty_=false;
+        WriteVertex(0);
+        SetVertexDirty();
+    }
+    //正在显示的文字所在的页，不能被淘汰。
+    font_->TouchPage(font_page_);
+}
 
-        std::vector<Font::Character*> character_vec=font_->LoadStr(text_);
-        //遍历每个字符进行绘制
-        std::vector<MeshFilter::Vertex> vertex_vector;
-        std::vector<unsigned short> index_vector(character_vec.size()*6);
-
-        int x=0;
-        std::vector<unsigned short> index={0, 1, 2, 0, 2, 3};
-
-        for (int i = 0; i < character_vec.size(); ++i) {
-            auto character=character_vec[i];
-            unsigned short width=(character->right_bottom_x_-character->left_top_x_)*font_->font_texture()->width();
-            unsigned short height=(character->right_bottom_y_-character->left_top_y_)*font_->font_texture()->height();
-            //因为FreeType生成的bitmap是上下颠倒的，所以这里UV坐标也要做对应翻转，将左上角作为零点。
-            vertex_vector.insert(vertex_vector.end(),{
-                    {{x,0.0f, 0.0f}, color_, {character->left_top_x_,     character->right_bottom_y_}},
-                    {{x+width,0.0f, 0.0f}, color_, {character->right_bottom_x_, character->right_bottom_y_}},
-                    {{x+width,height, 0.0f}, color_, {character->right_bottom_x_, character->left_top_y_}},
-                    {{x,height, 0.0f}, color_, {character->left_top_x_,     character->left_top_y_}}
-            });
-            x+=width;
-
-
-            for (int j = 0; j < index.size(); ++j) {
-                index_vector[i*index.size()+j]=index[j]+i*4;
-            }
+void UIText::WriteVertex(unsigned int first_glyph) {
+    const std::vector<TextLayout::Glyph>& glyphs=text_layout_.glyphs();
+    //同一个字符串的字符都在同一页图集上
+    for (auto& glyph : glyphs) {
+        if(glyph.character_!= nullptr){
+            font_page_=glyph.character_->page_;
+            font_texture_=glyph.character_->font_texture_;
+            break;
+        }
+    }
+    //容量只增不减，文字长度不超过历史最大长度时不分配内存。
+    vertex_vector_.resize(text_layout_.quad_num()*4);
+    float scale=font_size_==0?1.0f:font_size_*1.0f/font_->font_size();
+    const std::vector<TextLayout::Line>& lines=text_layout_.lines();
+    for (size_t i = first_glyph; i < glyphs.size(); ++i) {
+        const TextLayout::Glyph& glyph=glyphs[i];
+        if(glyph.quad_index_<0){
+            continue;
         }
-        mesh_filter->CreateMesh(vertex_vector,index_vector);
+        Font::Character* character=glyph.character_;
+        float left=lines[glyph.line_].offset_x_+glyph.pen_x_+character->bearing_x_*scale;
+        float right=left+character->width_*scale;
+        float top=text_layout_.line_y(glyph.line_)+character->bearing_y_*scale;
+        float bottom=top-character->height_*scale;
+        //因为FreeType生成的bitmap是上下颠倒的，所以这里UV坐标也要做对应翻转，将左上角作为零点。
+        MeshFilter::Vertex* quad=&vertex_vector_[glyph.quad_index_*4];
+        quad[0]={{left,bottom, 0.0f}, color_, {character->left_top_x_,     character->right_bottom_y_}};
+        quad[1]={{right,bottom, 0.0f}, color_, {character->right_bottom_x_, character->right_bottom_y_}};
+        quad[2]={{right,top, 0.0f}, color_, {character->right_bottom_x_, character->left_top_y_}};
+        quad[3]={{left,top, 0.0f}, color_, {character->left_top_x_,     character->left_top_y_}};
     }
 }
 
-void UIText::OnPreRender() {
-    Component::OnPreRender();
+const char* UIText::material_path() {
+    return font_!= nullptr && font_->sdf()?"material/ui_text_sdf.mat":"material/ui_text.mat";
 }
 
-void UIText::OnPostRender() {
-    Component::OnPostRender();
+void UIText::FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector) {
+    vertex_vector.insert(vertex_vector.end(),vertex_vector_.begin(),vertex_vector_.end());
 }
 
 UIText::~UIText() {
@@ -7,36 +7,71 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
-#include "component/component.h"
+#include "ui_graphic.h"
+#include "renderer/text_layout.h"
 
 class Font;
-class MeshRenderer;
-class UIText : public Component {
+class UIText : public UIGraphic {
 public:
     UIText();
     ~UIText();
 
-    void set_font(Font* font){font_=font;}
+    void set_font(Font* font){font_=font;dirty_=true;}
     Font* font(){return font_;}
 
-    void set_text(std::string text);
-    std::string text(){return text_;}
+    void set_text(const std::string& text);
+    const std::string& text(){return text_;}
 
-    void set_color(glm::vec4 color){color_=color;}
+    /// 显示字号，0表示使用字体生成字形的字号。SDF字体可以任意缩放而保持边缘清晰。
+    void set_font_size(unsigned short font_size){if(font_size_!=font_size){font_size_=font_size;dirty_=true;}}
+    unsigned short font_size(){return font_size_;}
+
+    void set_color(glm::vec4 color){if(color_!=color){color_=color;color_dirty_=true;}}
     glm::vec4 color(){return color_;}
+
+    /// 最大行宽，超过自动换行，0表示不换行。
+    void set_width(float width){if(width_!=width){width_=width;dirty_=true;}}
+    float width(){return width_;}
+
+    /// 水平对齐，width为0时以原点为对齐点。
+    void set_alignment(TextLayout::Alignment alignment){if(alignment_!=alignment){alignment_=alignment;dirty_=true;}}
+    TextLayout::Alignment alignment(){return alignment_;}
+
+    /// 行距倍数
+    void set_line_spacing(float line_spacing){if(line_spacing_!=line_spacing){line_spacing_=line_spacing;dirty_=true;}}
+    float line_spacing(){return line_spacing_;}
 public:
     void Update() override;
-    /// 渲染之前
-    void OnPreRender() override;
 
-    void OnPostRender() override;
+    /// SDF字体用Shader根据距离计算边缘
+    const char* material_path() override;
+
+    /// 文字所在的字形图集页纹理
+    Texture2D* texture2D() override{return font_texture_;}
+
+    void FillVertex(std::vector<MeshFilter::Vertex>& vertex_vector) override;
+
+private:
+    /// 从first_glyph开始，把排版结果写入顶点，之前的顶点没有变化。
+    void WriteVertex(unsigned int first_glyph);
 
 private:
     Font* font_;
     std::string text_;
-    bool dirty_;//是否变化需要重新生成Mesh
+    bool dirty_=false;//是否变化需要重新排版
+    bool color_dirty_=false;//颜色变化，只需要重写顶点颜色
+    unsigned short font_size_=0;//显示字号
+    float width_=0;//最大行宽
+    TextLayout::Alignment alignment_=TextLayout::LEFT;
+    float line_spacing_=1.0f;
+    TextLayout text_layout_;//排版缓存
+    unsigned short font_page_=0;//文字所在的字形图集页
+    unsigned int font_atlas_version_=0;//排版时字形图集的版本，图集页被淘汰后需要重新排版
     glm::vec4 color_;//字体颜色
+    Texture2D* font_texture_= nullptr;//文字所在的字形图集页纹理
+    std::vector<MeshFilter::Vertex> vertex_vector_;//本地坐标顶点，文字变化时只重写变化的部分
 
 RTTR_ENABLE();
 };
@@ -0,0 +1,211 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "job_system.h"
+#include <algorithm>
+#include "easy/profiler.h"
+#include "easy/arbitrary_value.h"
+
+std::vector<std::thread> JobSystem::threads_;
+std::vector<JobSystem::Worker*> JobSystem::worker_vec_;
+std::atomic<int> JobSystem::queued_job_num_(0);
+std::mutex JobSystem::sleep_mutex_;
+std::condition_variable JobSystem::sleep_condition_;
+std::condition_variable JobSystem::wait_condition_;
+bool JobSystem::exit_=false;
+std::chrono::steady_clock::time_point JobSystem::last_statistics_time_;
+thread_local unsigned int JobSystem::thread_index_=0;
+
+void JobSystem::Init(unsigned int worker_num) {
+    if(worker_num==0){
+        unsigned int hardware_concurrency=std::thread::hardware_concurrency();
+        worker_num=hardware_concurrency>1?hardware_concurrency-1:1;
+    }
+    exit_=false;
+    //主线程也有一个队列
+    for (unsigned int i = 0; i <= worker_num; ++i) {
+        worker_vec_.push_back(new Worker());
+    }
+    last_statistics_time_=std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < worker_num; ++i) {
+        threads_.emplace_back(&JobSystem::WorkerLoop,i+1);
+    }
+}
+
+void JobSystem::Exit() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        exit_=true;
+    }
+    sleep_condition_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+    for (auto worker : worker_vec_) {
+        delete worker;
+    }
+    worker_vec_.clear();
+}
+
+void JobSystem::Dispatch(JobGroup& job_group, std::function<void()> job) {
+    job_group.pending_job_num_++;
+    if(threads_.empty()){
+        //没有工作线程就直接执行
+        Job inline_job{&job_group,std::move(job)};
+        RunJob(inline_job, nullptr);
+        return;
+    }
+    Worker* worker=worker_vec_[thread_index_];
+    {
+        std::lock_guard<std::mutex> lock(worker->job_deque_mutex_);
+        worker->job_deque_.push_back({&job_group,std::move(job)});
+    }
+    queued_job_num_++;
+    //加锁再通知，避免工作线程检查完条件、还没有休眠时错过通知。
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_condition_.notify_one();
+    //Wait的线程也可以执行新任务
+    wait_condition_.notify_all();
+}
+
+void JobSystem::Wait(JobGroup& job_group) {
+    EASY_FUNCTION();
+    while(job_group.finished()==false){
+        if(TryRunOneJob()){
+            continue;
+        }
+        //队列空了，剩下的任务正在其它线程执行，休眠到任务组完成或者有新任务。
+        EASY_BLOCK("JobSystem Wait Idle",profiler::colors::Grey);
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wait_condition_.wait(lock,[&job_group](){
+            return job_group.finished() || queued_job_num_.load()>0;
+        });
+        EASY_END_BLOCK;
+    }
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)>& job) {
+    JobGroup job_group;
+    for (int i = 0; i < count; ++i) {
+        Dispatch(job_group,[&job,i](){
+            job(i);
+        });
+    }
+    Wait(job_group);
+}
+
+void JobSystem::ParallelForBatch(int count, int batch_size, const std::function<void(int, int)>& job) {
+    batch_size=std::max(batch_size,1);
+    JobGroup job_group;
+    for (int begin = 0; begin < count; begin+=batch_size) {
+        int end=std::min(begin+batch_size,count);
+        Dispatch(job_group,[&job,begin,end](){
+            job(begin,end);
+        });
+    }
+    Wait(job_group);
+}
+
+void JobSystem::WorkerLoop(unsigned int thread_index) {
+    thread_index_=thread_index;
+    EASY_THREAD("JobWorker");
+    while(true){
+        if(TryRunOneJob()){
+            continue;
+        }
+        EASY_BLOCK("JobWorker Idle",profiler::colors::Grey);
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_condition_.wait(lock,[](){
+            return exit_ || queued_job_num_.load()>0;
+        });
+        if(exit_ && queued_job_num_.load()==0){
+            return;//exit_ 并且队列已经清空
+        }
+        EASY_END_BLOCK;
+    }
+}
+
+bool JobSystem::TryRunOneJob() {
+    if(worker_vec_.empty() || queued_job_num_.load()==0){
+        return false;
+    }
+    Worker* worker=worker_vec_[thread_index_];
+    Job job;
+    bool found=false;
+    //自己的队列从尾部取
+    {
+        std::lock_guard<std::mutex> lock(worker->job_deque_mutex_);
+        if(worker->job_deque_.empty()==false){
+            job=std::move(worker->job_deque_.back());
+            worker->job_deque_.pop_back();
+            found=true;
+        }
+    }
+    //从其它线程队列头部偷
+    for (size_t i = 1; found==false && i < worker_vec_.size(); ++i) {
+        Worker* victim=worker_vec_[(thread_index_+i)%worker_vec_.size()];
+        std::lock_guard<std::mutex> lock(victim->job_deque_mutex_);
+        if(victim->job_deque_.empty()==false){
+            job=std::move(victim->job_deque_.front());
+            victim->job_deque_.pop_front();
+            found=true;
+            worker->steal_num_++;
+        }
+    }
+    if(found==false){
+        return false;
+    }
+    queued_job_num_--;
+    RunJob(job,worker);
+    return true;
+}
+
+void JobSystem::RunJob(Job& job,Worker* worker) {
+    auto start_time=std::chrono::steady_clock::now();
+    job.function_();
+    //减到0之后任务组可能已经被等待的线程销毁，不能再访问。
+    bool group_finished=job.job_group_->pending_job_num_.fetch_sub(1)==1;
+    if(group_finished){
+        //加锁再通知，避免等待的线程检查完条件、还没有休眠时错过通知。
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        wait_condition_.notify_all();
+    }
+    if(worker!= nullptr){
+        worker->busy_time_+=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start_time).count();
+        worker->job_num_++;
+    }
+}
+
+void JobSystem::UpdateStatistics() {
+    auto now=std::chrono::steady_clock::now();
+    long long elapsed_time=std::chrono::duration_cast<std::chrono::nanoseconds>(now-last_statistics_time_).count();
+    last_statistics_time_=now;
+    if(elapsed_time<=0){
+        return;
+    }
+    for (auto worker : worker_vec_) {
+        long long busy_time=worker->busy_time_.load();
+        unsigned int job_num=worker->job_num_.load();
+        unsigned int steal_num=worker->steal_num_.load();
+        worker->utilization_=std::min((float)(busy_time-worker->last_busy_time_)/elapsed_time,1.0f);
+        worker->frame_job_num_=job_num-worker->last_job_num_;
+        worker->frame_steal_num_=steal_num-worker->last_steal_num_;
+        worker->last_busy_time_=busy_time;
+        worker->last_job_num_=job_num;
+        worker->last_steal_num_=steal_num;
+    }
+    //工作线程平均利用率
+    if(worker_vec_.size()>1){
+        float total_utilization=0;
+        for (size_t i = 1; i < worker_vec_.size(); ++i) {
+            total_utilization+=worker_vec_[i]->utilization_;
+        }
+        EASY_VALUE("job worker utilization",total_utilization/(worker_vec_.size()-1));
+    }
+}
@@ -0,0 +1,121 @@
+//
+// Created by captainchen on 2026/10/19.
+// 任务系统，工作线程数等于CPU核数减1(主线程也会参与执行)。
+// 每个线程有自己的任务队列，派发的任务放到当前线程队列的尾部，自己从尾部取(刚派发的任务数据还在缓存里)，
+// 自己的队列空了就从其它线程队列的头部偷任务。
+// 等待任务组完成的线程不会空等，而是从队列里取任务来执行，所以任务里可以再派发子任务并等待。
+// 物理(PhysX)、光源分簇、蒙皮、字形光栅化都使用这一个线程池，避免各自创建线程抢占CPU核。
+//
+
+#ifndef UNTITLED_JOB_SYSTEM_H
+#define UNTITLED_JOB_SYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+/// 任务组，记录还没有完成的任务数量。
+class JobGroup {
+public:
+    JobGroup():pending_job_num_(0){}
+
+    bool finished(){return pending_job_num_.load()==0;}
+
+private:
+    std::atomic<int> pending_job_num_;
+
+    friend class JobSystem;
+};
+
+class JobSystem {
+public:
+    /// 启动工作线程
+    /// \param worker_num 工作线程数量，0表示CPU核数减1。
+    static void Init(unsigned int worker_num=0);
+
+    /// 等待队列中的任务执行完，然后停止工作线程。
+    static void Exit();
+
+    /// 派发一个任务
+    /// \param job_group 任务所属的任务组
+    /// \param job 任务
+    static void Dispatch(JobGroup& job_group,std::function<void()> job);
+
+    /// 等待任务组完成，等待期间当前线程也会执行队列中的任务，队列为空时休眠，直到任务组完成或者有新任务。
+    static void Wait(JobGroup& job_group);
+
+    /// 将 [0,count) 拆分成 count 个任务并行执行，等待全部完成后返回。
+    static void ParallelFor(int count,const std::function<void(int)>& job);
+
+    /// 将 [0,count) 按batch_size分段并行执行，适合每个元素计算量很小的循环，例如蒙皮的每个顶点。
+    /// \param job 参数是一段的 [begin,end)
+    static void ParallelForBatch(int count,int batch_size,const std::function<void(int,int)>& job);
+
+    static unsigned int worker_num(){return (unsigned int)threads_.size();}
+
+    /// 当前线程的编号，非工作线程(主线程)为0，工作线程从1开始。
+    /// 用于给每个线程分配独立的资源，例如每个线程一个FreeType实例。
+    static unsigned int thread_index(){return thread_index_;}
+
+    /// 统计上一次调用以来每个线程的利用率，每帧调用一次。
+    static void UpdateStatistics();
+
+    /// 上一帧线程忙碌时间占比，0是主线程(以及其它非工作线程)。
+    static float utilization(unsigned int thread_index){return thread_index<worker_vec_.size()?worker_vec_[thread_index]->utilization_:0;}
+
+    /// 上一帧线程执行的任务数量
+    static unsigned int job_num(unsigned int thread_index){return thread_index<worker_vec_.size()?worker_vec_[thread_index]->frame_job_num_:0;}
+
+    /// 上一帧线程从其它线程偷来执行的任务数量
+    static unsigned int steal_num(unsigned int thread_index){return thread_index<worker_vec_.size()?worker_vec_[thread_index]->frame_steal_num_:0;}
+
+private:
+    struct Job{
+        JobGroup* job_group_;
+        std::function<void()> function_;
+    };
+
+    /// 每个线程的任务队列和统计
+    struct Worker{
+        std::mutex job_deque_mutex_;
+        std::deque<Job> job_deque_;
+
+        std::atomic<long long> busy_time_{0};//执行任务的累计时间(纳秒)
+        std::atomic<unsigned int> job_num_{0};
+        std::atomic<unsigned int> steal_num_{0};
+
+        long long last_busy_time_=0;//上一次统计时的累计时间
+        unsigned int last_job_num_=0;
+        unsigned int last_steal_num_=0;
+        float utilization_=0;
+        unsigned int frame_job_num_=0;
+        unsigned int frame_steal_num_=0;
+    };
+
+    static void WorkerLoop(unsigned int thread_index);
+
+    /// 先从当前线程队列尾部取任务，没有就从其它线程队列头部偷一个。
+    /// \return 所有队列为空时返回false
+    static bool TryRunOneJob();
+
+    static void RunJob(Job& job,Worker* worker);
+
+private:
+    static std::vector<std::thread> threads_;
+    static std::vector<Worker*> worker_vec_;//下标是thread_index，0是主线程。
+    static std::atomic<int> queued_job_num_;//所有队列中还没有开始执行的任务数量
+    static std::mutex sleep_mutex_;
+    static std::condition_variable sleep_condition_;//没有任务时工作线程休眠
+    static std::condition_variable wait_condition_;//Wait的线程在队列为空时休眠，任务组完成或者派发新任务时唤醒。
+    static bool exit_;
+    static std::chrono::steady_clock::time_point last_statistics_time_;
+    static thread_local unsigned int thread_index_;
+};
+
+
+#endif //UNTITLED_JOB_SYSTEM_H
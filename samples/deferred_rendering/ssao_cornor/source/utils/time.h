@@ -32,6 +32,11 @@ public:
     //~en Set fixed update time
     static void set_fixed_update_time(float time){fixed_update_time_ = time;}
 
+    //~zh 一帧最多执行几次FixedUpdate，超出的时间丢弃，避免卡顿后越追越慢。
+    //~en Max FixedUpdate count per frame, the remaining time is dropped to avoid the spiral of death.
+    static unsigned int max_fixed_update_num(){return max_fixed_update_num_;}
+    static void set_max_fixed_update_num(unsigned int num){max_fixed_update_num_ = num>0?num:1;}
+
 private:
     static std::chrono::system_clock::time_point startup_time_;
     static float last_frame_time_;
@@ -42,6 +47,8 @@ private:
     //~zh 固定更新时间，一般用于物理模拟
     //~en Fixed update time, usually used for physics simulation
     static float fixed_update_time_;
+
+    static unsigned int max_fixed_update_num_;
 };
 
 
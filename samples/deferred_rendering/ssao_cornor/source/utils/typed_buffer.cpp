@@ -0,0 +1,93 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "typed_buffer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+TypedBuffer::TypedBuffer(Type type, size_t length):type_(type),length_(0),data_(nullptr) {
+    Resize(length);
+}
+
+TypedBuffer::~TypedBuffer() {
+    free(data_);
+}
+
+size_t TypedBuffer::element_size() {
+    switch (type_) {
+        case Type::FLOAT32:
+            return sizeof(float);
+        case Type::UINT16:
+            return sizeof(unsigned short);
+        default:
+            return sizeof(unsigned char);
+    }
+}
+
+double TypedBuffer::Get(size_t index) {
+    if(index<1 || index>length_){
+        return 0;
+    }
+    switch (type_) {
+        case Type::FLOAT32:
+            return static_cast<float*>(data_)[index-1];
+        case Type::UINT16:
+            return static_cast<unsigned short*>(data_)[index-1];
+        default:
+            return static_cast<unsigned char*>(data_)[index-1];
+    }
+}
+
+void TypedBuffer::Set(size_t index, double value) {
+    if(index<1 || index>length_){
+        return;
+    }
+    switch (type_) {
+        case Type::FLOAT32:
+            static_cast<float*>(data_)[index-1]=(float)value;
+            break;
+        //超出范围的值转换成整数是未定义行为，先截断到类型范围，NaN变为0。
+        case Type::UINT16:
+            static_cast<unsigned short*>(data_)[index-1]=(unsigned short)std::min(std::max(0.0,value),65535.0);
+            break;
+        default:
+            static_cast<unsigned char*>(data_)[index-1]=(unsigned char)std::min(std::max(0.0,value),255.0);
+            break;
+    }
+}
+
+void TypedBuffer::Fill(double value) {
+    for (size_t i = 1; i <= length_; ++i) {
+        Set(i,value);
+    }
+}
+
+void TypedBuffer::Resize(size_t length) {
+    if(length==length_){
+        return;
+    }
+    if(length==0){
+        free(data_);
+        data_=nullptr;
+        length_=0;
+        return;
+    }
+    void* data=realloc(data_,length*element_size());
+    if(data==nullptr){
+        return;
+    }
+    if(length>length_){
+        memset(static_cast<unsigned char*>(data)+length_*element_size(),0,(length-length_)*element_size());
+    }
+    data_=data;
+    length_=length;
+}
+
+void* TypedBuffer::Release() {
+    void* data=data_;
+    data_=nullptr;
+    length_=0;
+    return data;
+}
@@ -0,0 +1,66 @@
+//
+// Created by captainchen on 2026/10/19.
+// 类型化缓冲区：C++分配的float32/uint16/uint8数组，Lua通过下标直接读写，不用先填table再逐个转换成std::vector。
+// 创建Mesh、纹理时直接把内存交给Mesh、渲染任务，不再拷贝，之后缓冲区变为空。
+//
+
+#ifndef UNTITLED_TYPED_BUFFER_H
+#define UNTITLED_TYPED_BUFFER_H
+
+#include <cstddef>
+
+class TypedBuffer {
+public:
+    enum class Type{
+        FLOAT32,
+        UINT16,
+        UINT8
+    };
+
+    /// \param type 元素类型
+    /// \param length 元素个数，初始为0。
+    TypedBuffer(Type type,size_t length);
+    ~TypedBuffer();
+
+    TypedBuffer(const TypedBuffer&)=delete;
+    TypedBuffer& operator=(const TypedBuffer&)=delete;
+
+    Type type(){return type_;}
+
+    /// 元素个数
+    size_t length(){return length_;}
+
+    /// 字节数
+    size_t byte_size(){return length_*element_size();}
+
+    /// 每个元素的字节数
+    size_t element_size();
+
+    void* data(){return data_;}
+
+    /// 读取元素，越界返回0。
+    /// \param index 从1开始，和Lua一致。
+    double Get(size_t index);
+
+    /// 写入元素，越界忽略，整数类型的值截断到类型范围。
+    /// \param index 从1开始，和Lua一致。
+    void Set(size_t index,double value);
+
+    /// 所有元素设置为同一个值
+    void Fill(double value);
+
+    /// 改变长度，保留原有数据，新增部分为0。
+    void Resize(size_t length);
+
+    /// 交出内存所有权(malloc分配，使用者负责free)，之后缓冲区长度为0。
+    /// \return 长度为0时返回nullptr
+    void* Release();
+
+private:
+    Type type_;
+    size_t length_;
+    void* data_;
+};
+
+
+#endif //UNTITLED_TYPED_BUFFER_H
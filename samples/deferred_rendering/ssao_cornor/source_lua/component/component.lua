@@ -4,11 +4,16 @@
 --- DateTime: 5/16/2022 10:55 PM
 ---
 
+require("component_scheduler")
+
 --- @class Component @组件
 Component={}
 
 function Component:ctor()
     self.game_object_=nil
+    self.update_interval_=1--每几帧调用一次Update
+    self.update_slot_=0--间隔大于1时，在第几帧调用
+    self.update_delta_time_=0--距离上一次调用Update的时间
     self:InitCppComponent()
     self:SetToCpp()
 end
@@ -33,6 +38,29 @@ function Component:set_game_object(game_object)
     self.game_object_=game_object
     game_object:cpp_class_instance():AttachComponent(self.cpp_component_instance_)
     self.cpp_component_instance_:Awake()
+    --Update/FixedUpdate交给Lua调度器批量调用
+    if self.cpp_component_instance_:DelegateUpdateToLua() then
+        ComponentScheduler:Add(self)
+    end
+end
+
+--- 每几帧调用一次Update，同样间隔的组件分散到不同帧调用。
+--- @param interval number @间隔帧数，1表示每帧调用
+function Component:set_update_interval(interval)
+    interval=math.max(math.floor(interval),1)
+    self.update_interval_=interval
+    self.update_slot_=ComponentScheduler:AllocateUpdateSlot(interval)
+end
+
+--- @return number
+function Component:update_interval()
+    return self.update_interval_
+end
+
+--- 距离上一次调用Update的时间，间隔帧数大于1时用这个代替Time:delta_time()。
+--- @return number
+function Component:update_delta_time()
+    return self.update_delta_time_
 end
 
 function Component:OnEnable()
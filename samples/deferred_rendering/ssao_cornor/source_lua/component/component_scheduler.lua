@@ -0,0 +1,90 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+require("lua_extension")
+require("utils/time")
+
+--- @class ComponentScheduler @Lua组件调度器
+--- Lua组件的Update/FixedUpdate不再由C++逐个调用，C++每帧只进入Lua一次，在这里遍历数组调用。
+--- 每个组件单独用xpcall调用，一个组件出错不影响其它组件。
+--- 组件添加后一直保留到Lua虚拟机关闭：引擎没有移除组件、销毁GameObject的接口，GameObject禁用时只跳过调用。
+--- 以后添加这些接口时，需要同时从这里的数组中移除组件。
+ComponentScheduler={
+    update_component_list_={},--实现了Update的组件
+    fixed_update_component_list_={},--实现了FixedUpdate的组件
+    update_slot_num_={},--每种更新间隔已经分配的槽位数量，key:间隔帧数
+    frame_=0,
+}
+
+--- 出错时附加调用栈
+local function error_handler(err)
+    return debug.traceback(tostring(err),2)
+end
+
+--- 添加组件，实现了Update或FixedUpdate才添加。
+--- @param component Component
+function ComponentScheduler:Add(component)
+    if component.Update~=Component.Update and component.scheduler_update_index_==nil then
+        table.insert(self.update_component_list_,component)
+        component.scheduler_update_index_=#self.update_component_list_
+        component.last_update_time_=Time:TimeSinceStartup()
+    end
+    if component.FixedUpdate~=nil and component.FixedUpdate~=Component.FixedUpdate and component.scheduler_fixed_update_index_==nil then
+        table.insert(self.fixed_update_component_list_,component)
+        component.scheduler_fixed_update_index_=#self.fixed_update_component_list_
+    end
+end
+
+--- 给指定更新间隔的组件分配槽位，同一间隔的组件均匀分散到不同帧。
+--- @param interval number @间隔帧数
+--- @return number @槽位
+function ComponentScheduler:AllocateUpdateSlot(interval)
+    local slot=self.update_slot_num_[interval] or 0
+    self.update_slot_num_[interval]=slot+1
+    return slot%interval
+end
+
+--- 调用一个组件的函数
+local function call(component,function_name)
+    local ok,err=xpcall(component[function_name],error_handler,component)
+    if not ok then
+        print("\n---- RUN LUA_FUNCTION ERROR ----\nComponent call " .. function_name .. " error,type:" .. tostring(component.__cname) .. "\n" .. tostring(err) .. "\n------------------------")
+    end
+end
+
+--- 每帧由C++调用一次
+function ComponentScheduler:Update()
+    self.frame_=self.frame_+1
+    local now=Time:TimeSinceStartup()
+    local list=self.update_component_list_
+    local i=1
+    --组件Update中可能添加组件，每次重新取数组长度。
+    while i<=#list do
+        local component=list[i]
+        local interval=component.update_interval_
+        if (interval==1 or (self.frame_+component.update_slot_)%interval==0) and component.game_object_:active() then
+            component.update_delta_time_=now-component.last_update_time_
+            component.last_update_time_=now
+            call(component,"Update")
+        end
+        i=i+1
+    end
+end
+
+--- 每个固定步长由C++调用一次
+function ComponentScheduler:FixedUpdate()
+    local list=self.fixed_update_component_list_
+    local i=1
+    while i<=#list do
+        local component=list[i]
+        if component.game_object_:active() then
+            call(component,"FixedUpdate")
+        end
+        i=i+1
+    end
+end
+
+Cpp.Component.set_lua_scheduler(ComponentScheduler)
\ No newline at end of file
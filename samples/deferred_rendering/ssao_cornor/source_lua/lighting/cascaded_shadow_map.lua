@@ -0,0 +1,90 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+require("lua_extension")
+
+--- 级联阴影：方向光的阴影按相机视锥体深度分级渲染，材质声明 u_shadow_map_texture 即可采样。
+CascadedShadowMap={
+
+}
+
+--- 设置阴影深度纹理分辨率和级联数量
+--- @param resolution number @每一级深度纹理的宽高
+--- @param cascade_num number @级联数量，最多4级
+function CascadedShadowMap:Init(resolution,cascade_num)
+    Cpp.CascadedShadowMap.Init(resolution,cascade_num)
+end
+
+--- 设置投射阴影的方向光，nil时不渲染阴影。
+--- @param directional_light DirectionalLight
+function CascadedShadowMap:set_light(directional_light)
+    Cpp.CascadedShadowMap.set_light(directional_light and directional_light.cpp_component_instance_ or nil)
+end
+
+--- 设置级联贴合的相机，nil时不渲染阴影。
+--- @param camera Camera
+function CascadedShadowMap:set_camera(camera)
+    Cpp.CascadedShadowMap.set_camera(camera and camera.cpp_component_instance_ or nil)
+end
+
+--- 阴影距离
+--- @return number
+function CascadedShadowMap:shadow_distance()
+    return Cpp.CascadedShadowMap.shadow_distance()
+end
+
+--- 相机远裁剪面更远时只在这个距离内计算阴影
+--- @param shadow_distance number
+function CascadedShadowMap:set_shadow_distance(shadow_distance)
+    Cpp.CascadedShadowMap.set_shadow_distance(shadow_distance)
+end
+
+--- 级联划分方式
+--- @return number
+function CascadedShadowMap:split_lambda()
+    return Cpp.CascadedShadowMap.split_lambda()
+end
+
+--- 0:均匀划分 1:按对数划分
+--- @param split_lambda number
+function CascadedShadowMap:set_split_lambda(split_lambda)
+    Cpp.CascadedShadowMap.set_split_lambda(split_lambda)
+end
+
+--- 深度偏移，单位是阴影纹理像素。
+--- @return number
+function CascadedShadowMap:depth_bias()
+    return Cpp.CascadedShadowMap.depth_bias()
+end
+
+--- @param depth_bias number
+function CascadedShadowMap:set_depth_bias(depth_bias)
+    Cpp.CascadedShadowMap.set_depth_bias(depth_bias)
+end
+
+--- 投射阴影的Layer
+--- @return number
+function CascadedShadowMap:culling_mask()
+    return Cpp.CascadedShadowMap.culling_mask()
+end
+
+--- @param culling_mask number
+function CascadedShadowMap:set_culling_mask(culling_mask)
+    Cpp.CascadedShadowMap.set_culling_mask(culling_mask)
+end
+
+--- 上一次渲染的投射阴影物体数量
+--- @return number
+function CascadedShadowMap:caster_num()
+    return Cpp.CascadedShadowMap.caster_num()
+end
+
+--- 上一次渲染指定级联绘制的物体数量
+--- @param cascade number @级联序号，从0开始。
+--- @return number
+function CascadedShadowMap:caster_draw_num(cascade)
+    return Cpp.CascadedShadowMap.caster_draw_num(cascade)
+end
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 require("lua_extension")
 require("physics/raycast_hit")
+require("physics/scene_query_batch")
 
 --- @class Physics @物理引擎
 Physics={
@@ -55,4 +56,62 @@ end
 --- @param raycast_hit RaycastHit @射线结果，需要传入引用
 function Physics:RaycastSingle(origin,dir,distance,raycast_hit)
     return Cpp.Physics.RaycastSingle(origin,dir,distance,raycast_hit.cpp_class_instance_)
+end
+
+--- 是否异步模拟
+--- @return boolean
+function Physics:async()
+    return Cpp.Physics.async()
+end
+
+--- 异步模拟和渲染并行，下一个固定步长开始时取回结果。
+--- @param async boolean
+function Physics:set_async(async)
+    Cpp.Physics.set_async(async)
+end
+
+--- 每个固定步长的模拟次数
+--- @return number
+function Physics:sub_step_num()
+    return Cpp.Physics.sub_step_num()
+end
+
+--- @param sub_step_num number
+function Physics:set_sub_step_num(sub_step_num)
+    Cpp.Physics.set_sub_step_num(sub_step_num)
+end
+
+--- 上一次取回结果时等待模拟完成的时间(毫秒)
+--- @return number
+function Physics:fetch_wait_time()
+    return Cpp.Physics.fetch_wait_time()
+end
+
+--- 上一次异步模拟和主线程并行的时间(毫秒)
+--- @return number
+function Physics:overlap_time()
+    return Cpp.Physics.overlap_time()
+end
+
+--- 是否连接PVD，需要在物理初始化之前设置，一般在config.lua中配置。
+--- @return boolean
+function Physics:pvd_enable()
+    return Cpp.Physics.pvd_enable()
+end
+
+--- @param pvd_enable boolean
+function Physics:set_pvd_enable(pvd_enable)
+    Cpp.Physics.set_pvd_enable(pvd_enable)
+end
+
+--- 是否已经连接上PVD
+--- @return boolean
+function Physics:pvd_connected()
+    return Cpp.Physics.pvd_connected()
+end
+
+--- 上一个固定步长的物理统计
+--- @return table @active_body_num sleeping_body_num static_body_num contact_pair_num broad_phase_pair_num new_touch_num lost_touch_num simulate_time fetch_time
+function Physics:statistics()
+    return Cpp.Physics.statistics()
 end
\ No newline at end of file
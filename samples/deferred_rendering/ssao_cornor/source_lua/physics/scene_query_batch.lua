@@ -0,0 +1,84 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+require("lua_extension")
+require("cpp_class")
+
+--- @class SceneQueryBatch : CppClass @批量场景检测，一批射线、扫掠、重叠检测只调用一次C++。
+SceneQueryBatch=class("SceneQueryBatch",CppClass)
+
+--- @param max_query_num number @一批最多多少个检测
+--- @param max_hit_num number @每个检测最多记录多少个击中结果
+function SceneQueryBatch:ctor(max_query_num,max_hit_num)
+    SceneQueryBatch.super.ctor(self,max_query_num,max_hit_num)
+end
+
+--- 实例化C++ Class
+function SceneQueryBatch:InitCppClass(max_query_num,max_hit_num)
+    self.cpp_class_instance_=Cpp.SceneQueryBatch(max_query_num,max_hit_num)
+end
+
+--- 清空已经提交的检测
+function SceneQueryBatch:Clear()
+    self.cpp_class_instance_:Clear()
+end
+
+--- 批量提交射线检测
+--- @param rays table @每7个数一个：起点xyz、方向xyz、距离。
+function SceneQueryBatch:AddRaycasts(rays)
+    self.cpp_class_instance_:AddRaycasts(rays)
+end
+
+--- 批量提交球体扫掠检测
+--- @param sweeps table @每8个数一个：起点xyz、半径、方向xyz、距离。
+function SceneQueryBatch:AddSphereSweeps(sweeps)
+    self.cpp_class_instance_:AddSphereSweeps(sweeps)
+end
+
+--- 批量提交球体重叠检测
+--- @param overlaps table @每4个数一个：中心xyz、半径。
+function SceneQueryBatch:AddSphereOverlaps(overlaps)
+    self.cpp_class_instance_:AddSphereOverlaps(overlaps)
+end
+
+--- 并行执行所有检测
+--- @return number @击中结果总数
+function SceneQueryBatch:Execute()
+    return self.cpp_class_instance_:Execute()
+end
+
+--- 每个检测的击中结果数量
+--- @return table @下标是检测序号(从1开始)
+function SceneQueryBatch:hit_nums()
+    return self.cpp_class_instance_:hit_nums()
+end
+
+--- 指定检测的击中结果数量
+--- @param query_index number @检测序号，从1开始。
+--- @return number
+function SceneQueryBatch:hit_num(query_index)
+    return self.cpp_class_instance_:hit_num(query_index)
+end
+
+--- 指定检测的一个击中结果，有 position、normal、distance、game_object。
+--- @param query_index number @检测序号，从1开始。
+--- @param hit_index number @击中结果序号，从1开始。
+--- @return SceneQueryHit|nil @序号超出范围返回nil
+function SceneQueryBatch:hit(query_index,hit_index)
+    return self.cpp_class_instance_:hit(query_index,hit_index)
+end
+
+--- 所有击中结果，每个结果有 position、normal、distance、game_object。
+--- @return table @hits[i][j]是第i个检测的第j个结果，只包含有效的结果。
+function SceneQueryBatch:hits()
+    return self.cpp_class_instance_:hits()
+end
+
+--- 每个检测最多记录多少个击中结果
+--- @return number
+function SceneQueryBatch:max_hit_num()
+    return self.cpp_class_instance_:max_hit_num()
+end
\ No newline at end of file
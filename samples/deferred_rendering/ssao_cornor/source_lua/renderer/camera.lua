@@ -120,7 +120,29 @@ function Camera:target_render_texture()
     return self.lua_target_render_texture_
 end
 
+--- 声明读取的RenderTexture，开启FrameGraph后据此排序相机、剔除没有被使用的相机。
+--- @param render_texture RenderTexture @读取的RenderTexture
+function Camera:AddInputRenderTexture(render_texture)
+    self.cpp_component_instance_:AddInputRenderTexture(render_texture:cpp_class_instance())
+end
+
+--- 清空读取的RenderTexture
+function Camera:ClearInputRenderTexture()
+    self.cpp_component_instance_:ClearInputRenderTexture()
+end
+
 --- 设置延迟渲染
 function Camera:set_deferred_shading(deferred_shading)
     self.cpp_component_instance_:set_deferred_shading(deferred_shading)
-end
\ No newline at end of file
+end
+--- 是否给点光源分簇
+--- @return boolean
+function Camera:light_cluster()
+    return self.cpp_component_instance_:light_cluster()
+end
+
+--- 设置渲染前以这个相机的视锥体给点光源分簇，光照Shader只计算片段所在簇的点光源。
+--- @param light_cluster boolean
+function Camera:set_light_cluster(light_cluster)
+    self.cpp_component_instance_:set_light_cluster(light_cluster)
+end
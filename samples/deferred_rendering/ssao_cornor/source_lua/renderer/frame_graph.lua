@@ -0,0 +1,42 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+require("lua_extension")
+
+--- 帧图：相机按读写的RenderTexture自动排序、剔除，临时RenderTexture共用显存。
+FrameGraph={
+
+}
+
+--- 是否使用帧图调度相机
+--- @return boolean
+function FrameGraph:enable()
+    return Cpp.FrameGraph.enable()
+end
+
+--- 开启后相机不再按depth顺序渲染，而是按读写依赖排序。
+--- @param enable boolean
+function FrameGraph:set_enable(enable)
+    Cpp.FrameGraph.set_enable(enable)
+end
+
+--- 剔除的相机数量
+--- @return number
+function FrameGraph:culled_pass_num()
+    return Cpp.FrameGraph.culled_pass_num()
+end
+
+--- 临时RenderTexture数量
+--- @return number
+function FrameGraph:transient_render_texture_num()
+    return Cpp.FrameGraph.transient_render_texture_num()
+end
+
+--- 实际创建的临时RenderTexture数量
+--- @return number
+function FrameGraph:physical_render_texture_num()
+    return Cpp.FrameGraph.physical_render_texture_num()
+end
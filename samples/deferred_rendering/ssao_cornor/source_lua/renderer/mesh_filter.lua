@@ -5,6 +5,7 @@
 ---
 
 require("lua_extension")
+require("utils/typed_buffer")
 
 --- @class MeshFilter : Component
 MeshFilter=class("MeshFilter",Component)
@@ -25,9 +26,13 @@ function MeshFilter:LoadMesh(mesh_file_path)
 end
 
 --- 创建Mesh
---- @param vertex_data table 所有的顶点数据,以float数组形式
---- @param vertex_index_data table 所有的索引数据,以unsigned short数组形式
+--- @param vertex_data table|userdata 所有的顶点数据,以float数组形式，或者TypedBuffer.Float32(不拷贝，之后缓冲区变为空)
+--- @param vertex_index_data table|userdata 所有的索引数据,以unsigned short数组形式，或者TypedBuffer.Uint16
 function MeshFilter:CreateMesh(vertex_data,vertex_index_data)
+    if type(vertex_data)=="userdata" then
+        self.cpp_component_instance_:CreateMesh(vertex_data,vertex_index_data)
+        return
+    end
     self.cpp_component_instance_:CreateMesh(sol2.convert_sequence_float(vertex_data),sol2.convert_sequence_ushort(vertex_index_data))
 end
 
@@ -38,8 +43,12 @@ function MeshFilter:GetMeshName()
 end
 
 --- 设置顶点关联骨骼信息
---- @param vertex_relate_bone_info_data table unsigned char数组形式，长度为顶点个数*8.
+--- @param vertex_relate_bone_info_data table|userdata unsigned char数组形式，长度为顶点个数*8，或者TypedBuffer.Uint8(不拷贝).
 function MeshFilter:set_vertex_relate_bone_infos(vertex_relate_bone_info_data)
+    if type(vertex_relate_bone_info_data)=="userdata" then
+        self.cpp_component_instance_:set_vertex_relate_bone_infos(vertex_relate_bone_info_data)
+        return
+    end
     self.cpp_component_instance_:set_vertex_relate_bone_infos(sol2.convert_sequence_int(vertex_relate_bone_info_data))
 end
 
@@ -47,4 +56,30 @@ end
 --- @param weight_file_path string @权重文件路径
 function MeshFilter:LoadWeight(weight_file_path)
     self.cpp_component_instance_:LoadWeight(weight_file_path)
-end
\ No newline at end of file
+end
+
+--- 用边折叠简化生成LOD链
+--- @param lod_num number @LOD级别个数，包含LOD0
+--- @param reduce_ratio number @每一级相对上一级保留的三角形比例
+function MeshFilter:GenerateLOD(lod_num,reduce_ratio)
+    self.cpp_component_instance_:GenerateLOD(lod_num,reduce_ratio or 0.5)
+end
+
+--- LOD级别个数，包含LOD0
+--- @return number
+function MeshFilter:lod_num()
+    return self.cpp_component_instance_:lod_num()
+end
+
+--- 设置指定LOD级别的切换屏幕占比
+--- @param lod_level number @LOD级别
+--- @param screen_relative_height number @屏幕占比(包围球投影直径/屏幕高度)不小于这个值时使用这一级
+function MeshFilter:set_lod_screen_relative_height(lod_level,screen_relative_height)
+    self.cpp_component_instance_:set_lod_screen_relative_height(lod_level,screen_relative_height)
+end
+
+--- 设置LOD切换滞后比例
+--- @param lod_hysteresis number
+function MeshFilter:set_lod_hysteresis(lod_hysteresis)
+    self.cpp_component_instance_:set_lod_hysteresis(lod_hysteresis)
+end
@@ -36,4 +36,30 @@ end
 --- 渲染
 function MeshRenderer:Render()
     self.cpp_component_instance_:Render()
-end
\ No newline at end of file
+end
+
+--- 本帧指定LOD级别绘制的三角形个数
+--- @param lod_level number @LOD级别
+--- @return number
+function MeshRenderer:lod_triangle_count(lod_level)
+    return Cpp.MeshRenderer.lod_triangle_count(lod_level)
+end
+
+--- 本帧指定LOD级别绘制的物体个数
+--- @param lod_level number @LOD级别
+--- @return number
+function MeshRenderer:lod_draw_count(lod_level)
+    return Cpp.MeshRenderer.lod_draw_count(lod_level)
+end
+
+--- 是否投射级联阴影
+--- @return boolean
+function MeshRenderer:cast_shadow()
+    return self.cpp_component_instance_:cast_shadow()
+end
+
+--- 设置是否投射级联阴影，地面等不需要投射阴影的物体可以关闭。
+--- @param cast_shadow boolean
+function MeshRenderer:set_cast_shadow(cast_shadow)
+    self.cpp_component_instance_:set_cast_shadow(cast_shadow)
+end
@@ -13,6 +13,8 @@ function RenderTexture:ctor()
     RenderTexture.super.ctor(self)
     ---@field color_texture_2d_ Texture2D
     self.color_texture_2d_=nil
+    ---@field depth_texture_2d_ Texture2D
+    self.depth_texture_2d_=nil
 end
 
 --- 实例化C++ Class
@@ -27,6 +29,17 @@ function RenderTexture:Init(width,height)
     self.cpp_class_instance_:Init(width,height)
 end
 
+--- 是否临时RenderTexture
+function RenderTexture:transient()
+    return self.cpp_class_instance_:transient()
+end
+
+--- 设置为临时RenderTexture，需要在Init之前设置。GPU资源由FrameGraph按生命周期分配，生命周期不重叠的共用显存。
+--- @param transient boolean
+function RenderTexture:set_transient(transient)
+    self.cpp_class_instance_:set_transient(transient)
+end
+
 function RenderTexture:width()
     return self.cpp_class_instance_:width()
 end
@@ -64,5 +77,9 @@ function RenderTexture:color_texture_2d()
 end
 
 function RenderTexture:depth_texture_2d()
-    return self.cpp_class_instance_:depth_texture_2d()
+    if self.depth_texture_2d_==nil then
+        local cpp_depth_texture_2d=self.cpp_class_instance_:depth_texture_2d()
+        self.depth_texture_2d_=Texture2D.new_with(cpp_depth_texture_2d)
+    end
+    return self.depth_texture_2d_
 end
@@ -32,6 +32,18 @@ function RenderTextureGeometryBuffer:Init(width,height)
     self.cpp_class_instance_:Init(width,height)
 end
 
+--- 是否压缩GBuffer，法线八面体编码，高光强度、反光度存到Diffuse、顶点颜色的A通道，坐标从深度重建。
+--- @return boolean
+function RenderTextureGeometryBuffer:packed()
+    return self.cpp_class_instance_:packed()
+end
+
+--- 设置压缩GBuffer，需要在Init之前设置。
+--- @param packed boolean
+function RenderTextureGeometryBuffer:set_packed(packed)
+    self.cpp_class_instance_:set_packed(packed)
+end
+
 function RenderTextureGeometryBuffer:frag_position_texture_2d()
     if self.frag_position_texture_2d_==nil then
         local cpp_frag_position_texture_2d=self.cpp_class_instance_:frag_position_texture_2d()
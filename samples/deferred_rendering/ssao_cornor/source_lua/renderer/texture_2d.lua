@@ -23,6 +23,22 @@ function Texture2D.LoadFromFile(image_file_path)
     return texture_2d
 end
 
+--- 用缓冲区数据创建纹理(不压缩)，缓冲区内存直接交给渲染线程，不拷贝，之后缓冲区变为空。
+--- @param width number
+--- @param height number
+--- @param server_format number @显存中的格式，例如GL_RGBA
+--- @param client_format number @内存中的格式
+--- @param filter_mag number @放大滤波
+--- @param filter_min number @缩小滤波
+--- @param wrap_s number @水平方向包裹方式
+--- @param wrap_t number @垂直方向包裹方式
+--- @param data userdata @TypedBuffer，uint8对应GL_UNSIGNED_BYTE，float32对应GL_FLOAT
+--- @return Texture2D
+function Texture2D.CreateFromBuffer(width,height,server_format,client_format,filter_mag,filter_min,wrap_s,wrap_t,data)
+    local cpp_instance = Cpp.Texture2D.CreateFromBuffer(width,height,server_format,client_format,filter_mag,filter_min,wrap_s,wrap_t,data)
+    return Texture2D.new_with(cpp_instance)
+end
+
 --- 返回图片宽
 --- @return number
 function Texture2D:width()
@@ -35,3 +51,27 @@ function Texture2D:height()
     return self.cpp_class_instance_:height()
 end
 
+
+--- 返回上传到GPU的mipmap数量
+--- @return number
+function Texture2D:mipmap_num()
+    return self.cpp_class_instance_:mipmap_num()
+end
+
+--- 设置全局纹理质量，加载多级mipmap的cpt时跳过前N级，0表示加载完整的mipmap。
+--- @param quality_skip_mipmap_num number
+function Texture2D.set_quality_skip_mipmap_num(quality_skip_mipmap_num)
+    Cpp.Texture2D.set_quality_skip_mipmap_num(quality_skip_mipmap_num)
+end
+
+--- 设置压缩纹理的显存预算(字节)，超出预算时加载会继续跳过更大的mipmap，0表示不限制。
+--- @param memory_budget number
+function Texture2D.set_memory_budget(memory_budget)
+    Cpp.Texture2D.set_memory_budget(memory_budget)
+end
+
+--- 返回当前所有压缩纹理占用的显存(字节)
+--- @return number
+function Texture2D.memory_size_total()
+    return Cpp.Texture2D.memory_size_total()
+end
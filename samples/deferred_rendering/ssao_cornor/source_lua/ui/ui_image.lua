@@ -25,4 +25,23 @@ end
 function UIImage:set_texture(texture_2d)
     self.texture_2d_=texture_2d
     self.cpp_component_instance_:set_texture(texture_2d:cpp_class_instance())
-end
\ No newline at end of file
+end
+
+--- 从图集中加载Sprite并设置，同一图集的图片共用一张纹理。
+--- @param atlas_file_path string .atlas 文件路径
+--- @param sprite_name string 散图名字，即打包时的图片文件名(不含扩展名)
+function UIImage:LoadSprite(atlas_file_path,sprite_name)
+    self.cpp_component_instance_:LoadSprite(atlas_file_path,sprite_name)
+end
+
+--- 图片显示的宽
+--- @return number
+function UIImage:width()
+    return self.cpp_component_instance_:width()
+end
+
+--- 图片显示的高
+--- @return number
+function UIImage:height()
+    return self.cpp_component_instance_:height()
+end
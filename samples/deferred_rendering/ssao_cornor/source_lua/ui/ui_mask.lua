@@ -25,6 +25,13 @@ function UIMask:set_texture(texture_2d)
     self.cpp_component_instance_:set_texture(texture_2d)
 end
 
+--- 从图集中加载Sprite作为遮罩形状，同一图集的图片共用一张纹理。
+--- @param atlas_file_path string .atlas 文件路径
+--- @param sprite_name string 散图名字，即打包时的图片文件名(不含扩展名)
+function UIMask:LoadSprite(atlas_file_path,sprite_name)
+    self.cpp_component_instance_:LoadSprite(atlas_file_path,sprite_name)
+end
+
 function UIMask:OnEnable()
     self.cpp_component_instance_:OnEnable()
 end
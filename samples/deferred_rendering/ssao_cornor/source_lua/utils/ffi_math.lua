@@ -0,0 +1,290 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+--- 不同的require路径会重复执行，ffi类型只能定义一次。
+if FFIMath~=nil then
+    return
+end
+
+--- @class FFIMath @LuaJIT ffi数学类型
+--- vec2 vec3 vec4 quat mat4 用ffi结构体定义，内存布局和glm相同(quat是x y z w，mat4按列存储)。
+--- 结构体运算由JIT编译，循环里的临时对象会被分配消除，不像glm usertype那样每次运算都创建userdata。
+--- 传给引擎接口前用 to_glm() 转换，引擎直接复制结构体内存。
+--- 不是LuaJIT时 FFIMath.enable 为false，脚本继续使用glm。
+FFIMath={enable=false}
+
+if jit==nil then
+    return
+end
+
+local ffi=require("ffi")
+
+ffi.cdef[[
+typedef struct { float x,y; } glm_vec2;
+typedef struct { float x,y,z; } glm_vec3;
+typedef struct { float x,y,z,w; } glm_vec4;
+typedef struct { float x,y,z,w; } glm_quat;
+typedef struct { float m[16]; } glm_mat4;
+]]
+
+local sqrt=math.sqrt
+local sin=math.sin
+local cos=math.cos
+local format=string.format
+local istype=ffi.istype
+
+local vec2,vec3,vec4,quat,mat4
+
+-- vec2
+do
+    local methods={}
+    function methods.length(a) return sqrt(a.x*a.x+a.y*a.y) end
+    function methods.dot(a,b) return a.x*b.x+a.y*b.y end
+    function methods.normalize(a)
+        local length=sqrt(a.x*a.x+a.y*a.y)
+        if length==0 then return vec2(0,0) end
+        return vec2(a.x/length,a.y/length)
+    end
+    function methods.lerp(a,b,t) return vec2(a.x+(b.x-a.x)*t,a.y+(b.y-a.y)*t) end
+    function methods.to_glm(a) return glm.vec2_from_ffi(a) end
+
+    vec2=ffi.metatype("glm_vec2",{
+        __index=methods,
+        __add=function(a,b) return vec2(a.x+b.x,a.y+b.y) end,
+        __sub=function(a,b) return vec2(a.x-b.x,a.y-b.y) end,
+        __mul=function(a,b)
+            if type(a)=="number" then return vec2(a*b.x,a*b.y) end
+            if type(b)=="number" then return vec2(a.x*b,a.y*b) end
+            return vec2(a.x*b.x,a.y*b.y)
+        end,
+        __div=function(a,b) return vec2(a.x/b,a.y/b) end,
+        __unm=function(a) return vec2(-a.x,-a.y) end,
+        __eq=function(a,b) return istype(vec2,a) and istype(vec2,b) and a.x==b.x and a.y==b.y end,
+        __tostring=function(a) return format("vec2(%f, %f)",a.x,a.y) end,
+    })
+end
+
+-- vec3
+do
+    local methods={}
+    function methods.length(a) return sqrt(a.x*a.x+a.y*a.y+a.z*a.z) end
+    function methods.dot(a,b) return a.x*b.x+a.y*b.y+a.z*b.z end
+    function methods.cross(a,b) return vec3(a.y*b.z-a.z*b.y,a.z*b.x-a.x*b.z,a.x*b.y-a.y*b.x) end
+    function methods.distance(a,b)
+        local x,y,z=a.x-b.x,a.y-b.y,a.z-b.z
+        return sqrt(x*x+y*y+z*z)
+    end
+    function methods.normalize(a)
+        local length=sqrt(a.x*a.x+a.y*a.y+a.z*a.z)
+        if length==0 then return vec3(0,0,0) end
+        return vec3(a.x/length,a.y/length,a.z/length)
+    end
+    function methods.lerp(a,b,t) return vec3(a.x+(b.x-a.x)*t,a.y+(b.y-a.y)*t,a.z+(b.z-a.z)*t) end
+    function methods.to_glm(a) return glm.vec3_from_ffi(a) end
+
+    vec3=ffi.metatype("glm_vec3",{
+        __index=methods,
+        __add=function(a,b) return vec3(a.x+b.x,a.y+b.y,a.z+b.z) end,
+        __sub=function(a,b) return vec3(a.x-b.x,a.y-b.y,a.z-b.z) end,
+        __mul=function(a,b)
+            if type(a)=="number" then return vec3(a*b.x,a*b.y,a*b.z) end
+            if type(b)=="number" then return vec3(a.x*b,a.y*b,a.z*b) end
+            return vec3(a.x*b.x,a.y*b.y,a.z*b.z)
+        end,
+        __div=function(a,b) return vec3(a.x/b,a.y/b,a.z/b) end,
+        __unm=function(a) return vec3(-a.x,-a.y,-a.z) end,
+        __eq=function(a,b) return istype(vec3,a) and istype(vec3,b) and a.x==b.x and a.y==b.y and a.z==b.z end,
+        __tostring=function(a) return format("vec3(%f, %f, %f)",a.x,a.y,a.z) end,
+    })
+end
+
+-- vec4
+do
+    local methods={}
+    function methods.length(a) return sqrt(a.x*a.x+a.y*a.y+a.z*a.z+a.w*a.w) end
+    function methods.dot(a,b) return a.x*b.x+a.y*b.y+a.z*b.z+a.w*b.w end
+    function methods.normalize(a)
+        local length=sqrt(a.x*a.x+a.y*a.y+a.z*a.z+a.w*a.w)
+        if length==0 then return vec4(0,0,0,0) end
+        return vec4(a.x/length,a.y/length,a.z/length,a.w/length)
+    end
+    function methods.lerp(a,b,t) return vec4(a.x+(b.x-a.x)*t,a.y+(b.y-a.y)*t,a.z+(b.z-a.z)*t,a.w+(b.w-a.w)*t) end
+    function methods.to_glm(a) return glm.vec4_from_ffi(a) end
+
+    vec4=ffi.metatype("glm_vec4",{
+        __index=methods,
+        __add=function(a,b) return vec4(a.x+b.x,a.y+b.y,a.z+b.z,a.w+b.w) end,
+        __sub=function(a,b) return vec4(a.x-b.x,a.y-b.y,a.z-b.z,a.w-b.w) end,
+        __mul=function(a,b)
+            if type(a)=="number" then return vec4(a*b.x,a*b.y,a*b.z,a*b.w) end
+            if type(b)=="number" then return vec4(a.x*b,a.y*b,a.z*b,a.w*b) end
+            return vec4(a.x*b.x,a.y*b.y,a.z*b.z,a.w*b.w)
+        end,
+        __div=function(a,b) return vec4(a.x/b,a.y/b,a.z/b,a.w/b) end,
+        __unm=function(a) return vec4(-a.x,-a.y,-a.z,-a.w) end,
+        __eq=function(a,b) return istype(vec4,a) and istype(vec4,b) and a.x==b.x and a.y==b.y and a.z==b.z and a.w==b.w end,
+        __tostring=function(a) return format("vec4(%f, %f, %f, %f)",a.x,a.y,a.z,a.w) end,
+    })
+end
+
+-- quat，构造参数按内存顺序 x y z w，和glm::quat构造函数的 w x y z 不同。
+do
+    local methods={}
+    function methods.length(q) return sqrt(q.x*q.x+q.y*q.y+q.z*q.z+q.w*q.w) end
+    function methods.normalize(q)
+        local length=sqrt(q.x*q.x+q.y*q.y+q.z*q.z+q.w*q.w)
+        if length==0 then return quat(0,0,0,1) end
+        return quat(q.x/length,q.y/length,q.z/length,q.w/length)
+    end
+    function methods.conjugate(q) return quat(-q.x,-q.y,-q.z,q.w) end
+
+    --- 旋转向量，v + w*t + cross(q.xyz,t)，t=2*cross(q.xyz,v)。
+    function methods.rotate(q,v)
+        local tx=2*(q.y*v.z-q.z*v.y)
+        local ty=2*(q.z*v.x-q.x*v.z)
+        local tz=2*(q.x*v.y-q.y*v.x)
+        return vec3(v.x+q.w*tx+q.y*tz-q.z*ty,
+                    v.y+q.w*ty+q.z*tx-q.x*tz,
+                    v.z+q.w*tz+q.x*ty-q.y*tx)
+    end
+
+    --- 转换为旋转矩阵，同 glm::mat4_cast。
+    function methods.to_mat4(q)
+        local xx,yy,zz=q.x*q.x,q.y*q.y,q.z*q.z
+        local xy,xz,yz=q.x*q.y,q.x*q.z,q.y*q.z
+        local wx,wy,wz=q.w*q.x,q.w*q.y,q.w*q.z
+        local m=mat4()
+        m.m[0]=1-2*(yy+zz) m.m[1]=2*(xy+wz)   m.m[2]=2*(xz-wy)
+        m.m[4]=2*(xy-wz)   m.m[5]=1-2*(xx+zz) m.m[6]=2*(yz+wx)
+        m.m[8]=2*(xz+wy)   m.m[9]=2*(yz-wx)   m.m[10]=1-2*(xx+yy)
+        m.m[15]=1
+        return m
+    end
+
+    quat=ffi.metatype("glm_quat",{
+        __index=methods,
+        __mul=function(p,q)
+            if istype(vec3,q) then
+                return methods.rotate(p,q)
+            end
+            return quat(p.w*q.x+p.x*q.w+p.y*q.z-p.z*q.y,
+                        p.w*q.y+p.y*q.w+p.z*q.x-p.x*q.z,
+                        p.w*q.z+p.z*q.w+p.x*q.y-p.y*q.x,
+                        p.w*q.w-p.x*q.x-p.y*q.y-p.z*q.z)
+        end,
+        __eq=function(a,b) return istype(quat,a) and istype(quat,b) and a.x==b.x and a.y==b.y and a.z==b.z and a.w==b.w end,
+        __tostring=function(q) return format("quat(%f, {%f, %f, %f})",q.w,q.x,q.y,q.z) end,
+    })
+end
+
+-- mat4，m[列*4+行]。
+do
+    local methods={}
+
+    --- 变换点，w为1。
+    function methods.transform_point(a,v)
+        local m=a.m
+        return vec3(m[0]*v.x+m[4]*v.y+m[8]*v.z+m[12],
+                    m[1]*v.x+m[5]*v.y+m[9]*v.z+m[13],
+                    m[2]*v.x+m[6]*v.y+m[10]*v.z+m[14])
+    end
+
+    --- 右乘平移矩阵，同 glm::translate。
+    function methods.translate(a,v)
+        local r=mat4(a)
+        local m=a.m
+        for row=0,3 do
+            r.m[12+row]=m[row]*v.x+m[4+row]*v.y+m[8+row]*v.z+m[12+row]
+        end
+        return r
+    end
+
+    --- 右乘缩放矩阵，同 glm::scale。
+    function methods.scale(a,v)
+        local r=mat4(a)
+        for row=0,3 do
+            r.m[row]=r.m[row]*v.x
+            r.m[4+row]=r.m[4+row]*v.y
+            r.m[8+row]=r.m[8+row]*v.z
+        end
+        return r
+    end
+
+    function methods.to_glm(a) return glm.mat4_from_ffi(a) end
+
+    mat4=ffi.metatype("glm_mat4",{
+        __index=methods,
+        __mul=function(a,b)
+            local m=a.m
+            if istype(vec4,b) then
+                return vec4(m[0]*b.x+m[4]*b.y+m[8]*b.z+m[12]*b.w,
+                            m[1]*b.x+m[5]*b.y+m[9]*b.z+m[13]*b.w,
+                            m[2]*b.x+m[6]*b.y+m[10]*b.z+m[14]*b.w,
+                            m[3]*b.x+m[7]*b.y+m[11]*b.z+m[15]*b.w)
+            end
+            local r=mat4()
+            local n=b.m
+            for column=0,12,4 do
+                local x,y,z,w=n[column],n[column+1],n[column+2],n[column+3]
+                for row=0,3 do
+                    r.m[column+row]=m[row]*x+m[4+row]*y+m[8+row]*z+m[12+row]*w
+                end
+            end
+            return r
+        end,
+        __eq=function(a,b)
+            if not (istype(mat4,a) and istype(mat4,b)) then return false end
+            for i=0,15 do
+                if a.m[i]~=b.m[i] then return false end
+            end
+            return true
+        end,
+        __tostring=function(a)
+            local m=a.m
+            return format("mat4x4((%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f))",
+                    m[0],m[1],m[2],m[3],m[4],m[5],m[6],m[7],m[8],m[9],m[10],m[11],m[12],m[13],m[14],m[15])
+        end,
+    })
+end
+
+FFIMath.enable=true
+FFIMath.vec2=vec2
+FFIMath.vec3=vec3
+FFIMath.vec4=vec4
+FFIMath.quat=quat
+
+--- 对角线为s的矩阵，同 glm.mat4(s)。
+function FFIMath.mat4(s)
+    local m=mat4()
+    if s then
+        m.m[0],m.m[5],m.m[10],m.m[15]=s,s,s,s
+    end
+    return m
+end
+
+--- 绕轴旋转，同 glm::angleAxis。
+--- @param angle number 弧度
+--- @param axis glm_vec3 单位向量
+function FFIMath.angle_axis(angle,axis)
+    local s=sin(angle*0.5)
+    return quat(axis.x*s,axis.y*s,axis.z*s,cos(angle*0.5))
+end
+
+--- 欧拉角转四元数，同 glm::quat(vec3)。
+--- @param euler glm_vec3 弧度
+function FFIMath.euler(euler)
+    local cx,cy,cz=cos(euler.x*0.5),cos(euler.y*0.5),cos(euler.z*0.5)
+    local sx,sy,sz=sin(euler.x*0.5),sin(euler.y*0.5),sin(euler.z*0.5)
+    return quat(sx*cy*cz-cx*sy*sz,
+                cx*sy*cz+sx*cy*sz,
+                cx*cy*sz-sx*sy*cz,
+                cx*cy*cz+sx*sy*sz)
+end
+
+--- glm.vec3转换为ffi结构体
+function FFIMath.from_glm_vec3(v)
+    return vec3(v.x,v.y,v.z)
+end
\ No newline at end of file
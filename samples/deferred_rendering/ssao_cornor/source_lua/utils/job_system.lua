@@ -0,0 +1,39 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+require("lua_extension")
+
+--- 任务系统：物理、光源分簇、蒙皮等共用的工作线程池，这里只读取统计。
+JobSystem={
+
+}
+
+--- 工作线程数量
+--- @return number
+function JobSystem:worker_num()
+    return Cpp.JobSystem.worker_num()
+end
+
+--- 上一帧线程忙碌时间占比
+--- @param thread_index number @0是主线程，工作线程从1开始。
+--- @return number
+function JobSystem:utilization(thread_index)
+    return Cpp.JobSystem.utilization(thread_index)
+end
+
+--- 上一帧线程执行的任务数量
+--- @param thread_index number
+--- @return number
+function JobSystem:job_num(thread_index)
+    return Cpp.JobSystem.job_num(thread_index)
+end
+
+--- 上一帧线程从其它线程偷来执行的任务数量
+--- @param thread_index number
+--- @return number
+function JobSystem:steal_num(thread_index)
+    return Cpp.JobSystem.steal_num(thread_index)
+end
\ No newline at end of file
@@ -105,4 +105,9 @@ end
 --- 判断字符串以 xx 结尾
 function string_endswith(str,end_str)
     return end_str=='' or string.sub(str,-string.len(end_str))==end_str
+end
+
+--- 左移n位，LuaJIT(Lua 5.1语法)没有 << 运算符。
+function shift_left(value,n)
+    return math.floor(value*2^n)
 end
\ No newline at end of file
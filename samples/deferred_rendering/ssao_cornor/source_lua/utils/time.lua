@@ -20,4 +20,16 @@ end
 --- @return number
 function Time:delta_time()
     return Cpp.Time.delta_time()
+end
+
+--- 一帧最多执行几次FixedUpdate
+--- @return number
+function Time:max_fixed_update_num()
+    return Cpp.Time.max_fixed_update_num()
+end
+
+--- 卡顿后超出次数的时间丢弃，避免越追越慢。
+--- @param num number
+function Time:set_max_fixed_update_num(num)
+    Cpp.Time.set_max_fixed_update_num(num)
 end
\ No newline at end of file
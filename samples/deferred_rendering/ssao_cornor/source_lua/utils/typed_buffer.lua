@@ -0,0 +1,42 @@
+---
+--- Generated by EmmyLua(https://github.com/EmmyLua)
+--- Created by captain.
+--- DateTime: 10/19/2026 10:00 PM
+---
+
+require("lua_extension")
+
+--- @class TypedBuffer @类型化缓冲区，C++分配的数组，直接返回C++实例，buffer[i]读写元素(下标从1开始)，#buffer取长度。
+--- 传给MeshFilter:CreateMesh、Texture2D.CreateFromBuffer后内存交给C++，缓冲区变为空。
+TypedBuffer={
+
+}
+
+--- 创建float32缓冲区，元素初始为0。
+--- @param length number @元素个数
+function TypedBuffer.Float32(length)
+    return Cpp.TypedBuffer.Float32(length)
+end
+
+--- 创建uint16缓冲区
+--- @param length number @元素个数
+function TypedBuffer.Uint16(length)
+    return Cpp.TypedBuffer.Uint16(length)
+end
+
+--- 创建uint8缓冲区
+--- @param length number @元素个数
+function TypedBuffer.Uint8(length)
+    return Cpp.TypedBuffer.Uint8(length)
+end
+
+--- 从table创建缓冲区，已有的table数据转换时使用。
+--- @param create_function function @TypedBuffer.Float32/Uint16/Uint8
+--- @param t table
+function TypedBuffer.FromTable(create_function,t)
+    local buffer=create_function(#t)
+    for i=1,#t do
+        buffer[i]=t[i]
+    end
+    return buffer
+end
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#define GLFW_INCLUDE_NONE
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -9,6 +10,9 @@
 #include "debug.h"
 #include "fbxsdk.h"
 #include "Common/Common.h"
+#include "mesh_simplifier.h"
+
+#define MESH_LOD_MAX_NUM 8 //最大LOD级别数量，和引擎MeshFilter一致，超出的文件引擎不加载。
 
 namespace Engine{
     //顶点
@@ -27,11 +31,34 @@ namespace Engine{
         unsigned short vertex_index_num_;//索引个数
     };
 
+    //Mesh文件LOD块头，紧跟在LOD0数据之后
+    struct MeshFileLODHead{
+        char type_[4];//LOD块标记 "LODs"
+        unsigned short lod_num_;//LOD级别个数，包含LOD0
+        float lod0_screen_relative_height_;//LOD0的切换屏幕占比
+    };
+
+    //Mesh文件中单个LOD级别的头
+    struct MeshFileLODLevelHead{
+        float screen_relative_height_;//切换屏幕占比
+        unsigned short vertex_num_;//顶点个数
+        unsigned short vertex_index_num_;//索引个数
+    };
+
+    //LOD级别数据
+    struct MeshLOD{
+        MeshFileLODLevelHead head_;
+        std::vector<Vertex> vertex_;
+        std::vector<unsigned short> index_;
+    };
+
     //Mesh文件
     struct MeshFile{
         MeshFileHead head_;
         Vertex *vertex_;
         unsigned short *index_;
+        float lod0_screen_relative_height_=0.5f;
+        std::vector<MeshLOD> lods_;//LOD1~LODn
 
         MeshFile(){
             vertex_ = nullptr;
@@ -56,9 +83,57 @@ namespace Engine{
                 file.write(reinterpret_cast<char*>(&head_), sizeof(head_));
                 file.write(reinterpret_cast<char*>(vertex_), sizeof(Vertex) * head_.vertex_num_);
                 file.write(reinterpret_cast<char*>(index_), sizeof(unsigned short) * head_.vertex_index_num_);
+                if(!lods_.empty()){
+                    MeshFileLODHead lod_head;
+                    memcpy(lod_head.type_,"LODs",4);
+                    lod_head.lod_num_=lods_.size()+1;
+                    lod_head.lod0_screen_relative_height_=lod0_screen_relative_height_;
+                    file.write(reinterpret_cast<char*>(&lod_head), sizeof(lod_head));
+                    for (auto& lod : lods_) {
+                        file.write(reinterpret_cast<char*>(&lod.head_), sizeof(lod.head_));
+                        file.write(reinterpret_cast<char*>(lod.vertex_.data()), sizeof(Vertex) * lod.head_.vertex_num_);
+                        file.write(reinterpret_cast<char*>(lod.index_.data()), sizeof(unsigned short) * lod.head_.vertex_index_num_);
+                    }
+                }
                 file.close();
             }
         }
+
+        // 用边折叠简化生成LOD1~LODn，每一级保留上一级一半的三角形，屏幕占比阈值减半。
+        void GenerateLOD(int lod_num){
+            std::vector<glm::vec3> positions(head_.vertex_num_);
+            std::vector<glm::vec2> uvs(head_.vertex_num_);
+            for (int i = 0; i < head_.vertex_num_; ++i) {
+                positions[i]=vertex_[i].position_;
+                uvs[i]=vertex_[i].uv_;
+            }
+            std::vector<unsigned short> indices(index_,index_+head_.vertex_index_num_);
+            float screen_relative_height=lod0_screen_relative_height_;
+            for (int lod_level = 1; lod_level < lod_num; ++lod_level) {
+                std::vector<unsigned short> lod_indices=MeshSimplifier::Simplify(positions,uvs,indices,indices.size()/2/3*3);
+                if(lod_indices.empty() || lod_indices.size()>=indices.size()){
+                    break;
+                }
+                indices=lod_indices;
+                std::vector<unsigned short> remap=MeshSimplifier::CompactVertices(lod_indices,head_.vertex_num_);
+                screen_relative_height*=0.5f;
+
+                MeshLOD lod;
+                lod.head_.screen_relative_height_=lod_level==lod_num-1?0.f:screen_relative_height;
+                lod.head_.vertex_num_=remap.size();
+                lod.head_.vertex_index_num_=lod_indices.size();
+                for (auto vertex_index : remap) {
+                    lod.vertex_.push_back(vertex_[vertex_index]);
+                }
+                lod.index_=lod_indices;
+                DEBUG_LOG_INFO("LOD{} triangle num: {}", lod_level, lod_indices.size()/3);
+                lods_.push_back(lod);
+            }
+            //最后一级一直使用
+            if(!lods_.empty()){
+                lods_.back().head_.screen_relative_height_=0.f;
+            }
+        }
     };
 }
 
@@ -68,6 +143,7 @@ void ParseMesh(const FbxMesh* pMesh);
 int LogSceneCheckError(FbxImporter *mImporter, FbxArray<FbxString *> &details);
 
 std::string src_file_path;
+int lod_num=1;//LOD级别个数，包含LOD0，1表示不生成LOD。
 
 int main(int argc,char** argv){
     Debug::Init();
@@ -77,7 +153,15 @@ int main(int argc,char** argv){
     if(argc>1){
         src_file_path=argv[1];
     }
-    DEBUG_LOG_INFO("src_file_name:{}", src_file_path);
+    if(argc>2){
+        lod_num=atoi(argv[2]);
+        if(lod_num<1 || lod_num>MESH_LOD_MAX_NUM){
+            int clamp_lod_num=std::min(std::max(lod_num,1),MESH_LOD_MAX_NUM);
+            DEBUG_LOG_WARN("lod_num:{} out of range [1,{}],use {}",lod_num,MESH_LOD_MAX_NUM,clamp_lod_num);
+            lod_num=clamp_lod_num;
+        }
+    }
+    DEBUG_LOG_INFO("src_file_name:{} lod_num:{}", src_file_path, lod_num);
 
     FbxManager * mSdkManager;
     FbxScene * mScene;
@@ -321,6 +405,10 @@ void ParseMesh(const FbxMesh* pMesh){
     }
     // 填充索引
     mesh_file.index_=lIndices;
+    // 生成LOD
+    if(lod_num>1){
+        mesh_file.GenerateLOD(lod_num);
+    }
     // 写入文件
     std::filesystem::path path(src_file_path);
     std::string src_file_name = path.filename().stem().string();
@@ -0,0 +1,37 @@
+﻿//
+// Created by captainchen on 2026/10/19.
+// 基于二次误差度量(QEM)的半边折叠网格简化，用于生成LOD。
+// 导出的Mesh没有共享顶点(每个三角形的顶点都是独立的)，所以先按坐标焊接顶点，在焊接后的顶点之间折叠边。
+// 半边折叠只删除顶点，不产生新顶点，简化后的索引仍然指向原始顶点数组，顶点的UV、法线、颜色都保持不变。
+//
+
+#ifndef UNTITLED_MESH_SIMPLIFIER_H
+#define UNTITLED_MESH_SIMPLIFIER_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+class MeshSimplifier {
+public:
+    /// 简化网格
+    /// \param positions 顶点坐标
+    /// \param uvs 顶点UV，可以为空。焊接后同一个位置有多个顶点时，挑UV最接近的那个替换，避免UV接缝被拉扯。
+    /// \param indices 三角形索引
+    /// \param target_index_count 目标索引个数，简化到小于等于这个数量，或者没有可折叠的边为止。
+    /// \param max_error 允许的最大误差(距离的平方)，超过就停止折叠。
+    /// \return 简化后的三角形索引，指向原始顶点数组。
+    static std::vector<unsigned short> Simplify(const std::vector<glm::vec3>& positions,
+                                                const std::vector<glm::vec2>& uvs,
+                                                const std::vector<unsigned short>& indices,
+                                                size_t target_index_count,
+                                                float max_error=1e30f);
+
+    /// 剔除没有被索引引用的顶点，并重建索引。
+    /// \param indices 三角形索引，会被改写为指向新顶点数组。
+    /// \param vertex_num 原始顶点个数
+    /// \return 新顶点数组中每个顶点对应的原始顶点下标
+    static std::vector<unsigned short> CompactVertices(std::vector<unsigned short>& indices,size_t vertex_num);
+};
+
+
+#endif //UNTITLED_MESH_SIMPLIFIER_H
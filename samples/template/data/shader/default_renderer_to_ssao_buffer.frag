@@ -4,9 +4,8 @@ uniform sampler2D u_frag_position_texture;//顶点片段坐标纹理
 uniform sampler2D u_frag_normal_texture;//顶点片段法线纹理
 uniform sampler2D u_noise_texture;//噪声纹理
 uniform vec3 u_ssao_kernel[64];//ssao采样核心
-
-uniform vec2 u_noise_texture_size;//噪声纹理大小
-uniform vec2 u_screen_size;//屏幕大小
+uniform float u_kernel_size;//实际使用的采样数量，不超过64
+uniform float u_ssao_scale;//SSAO分辨率缩小倍数 1:全分辨率 2:1/2 4:1/4
 
 uniform mat4 u_projection;
 
@@ -15,25 +14,26 @@ in vec2 v_uv;
 layout(location = 0) out vec4 o_fragColor;
 
 
-int kernelSize = 64;
 float radius = 0.5;
 float bias = 0.025;
 
 void main()
 {
-	vec3 frag_position = texture(u_frag_position_texture,v_uv).rgb;
-	vec3 frag_normal = texture(u_frag_normal_texture,v_uv).rgb;
+    //低分辨率时取对应的GBuffer像素，和模糊、上采样使用同一个深度。
+    ivec2 gbuffer_coord = ivec2(gl_FragCoord.xy) * int(u_ssao_scale);
+	vec3 frag_position = texelFetch(u_frag_position_texture,gbuffer_coord,0).rgb;
+	vec3 frag_normal = texelFetch(u_frag_normal_texture,gbuffer_coord,0).rgb;
 
-    //与屏幕像素1:1采样噪声纹理
-    vec2 uv_scale=vec2(u_screen_size.x/u_noise_texture_size.x,u_screen_size.y/u_noise_texture_size.y);
-    vec2 noise_uv = v_uv * uv_scale;
-    vec3 random_noise = texture(u_noise_texture,noise_uv).rgb;
+    //与SSAO像素1:1平铺噪声纹理，模糊半径覆盖噪声纹理大小。
+    ivec2 noise_size = textureSize(u_noise_texture,0);
+    vec3 random_noise = texelFetch(u_noise_texture,ivec2(gl_FragCoord.xy) % noise_size,0).rgb;
 
     // create TBN change-of-basis matrix: from tangent-space to view-space
     vec3 tangent = normalize(random_noise - frag_normal * dot(random_noise, frag_normal));
     vec3 bitangent = cross(frag_normal, tangent);
     mat3 TBN = mat3(tangent, bitangent, frag_normal);
     // iterate over the sample kernel and calculate occlusion factor
+    int kernelSize = clamp(int(u_kernel_size), 1, 64);
     float occlusion = 0.0;
     for(int i = 0; i < kernelSize; ++i)
     {
@@ -54,7 +54,7 @@ void main()
         float rangeCheck = smoothstep(0.0, 1.0, radius / abs(frag_position.z - sampleDepth));
         occlusion += (sampleDepth >= samplePos.z + bias ? 1.0 : 0.0) * rangeCheck;
     }
-    occlusion = 1.0 - (occlusion / kernelSize);
+    occlusion = 1.0 - (occlusion / float(kernelSize));
 
     o_fragColor = vec4(occlusion, occlusion, occlusion, 1.0);
 }
\ No newline at end of file
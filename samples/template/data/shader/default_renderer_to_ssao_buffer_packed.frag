@@ -0,0 +1,81 @@
+#version 330 core
+
+uniform sampler2D u_frag_depth_texture;//深度纹理，从深度重建顶点片段坐标
+uniform sampler2D u_frag_normal_texture;//顶点片段法线纹理，八面体编码
+uniform sampler2D u_noise_texture;//噪声纹理
+uniform vec3 u_ssao_kernel[64];//ssao采样核心
+uniform float u_kernel_size;//实际使用的采样数量，不超过64
+uniform float u_ssao_scale;//SSAO分辨率缩小倍数 1:全分辨率 2:1/2 4:1/4
+
+uniform mat4 u_projection;
+uniform mat4 u_inverse_view_projection;//渲染GBuffer相机的 (projection * view) 逆矩阵
+
+in vec2 v_uv;
+
+layout(location = 0) out vec4 o_fragColor;
+
+
+float radius = 0.5;
+float bias = 0.025;
+
+//八面体解码法线
+vec3 DecodeNormal(vec2 f)
+{
+    f = f * 2.0 - 1.0;
+    vec3 n = vec3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+//从深度重建世界坐标
+vec3 ReconstructPosition(vec2 uv)
+{
+    float depth = texture(u_frag_depth_texture,uv).r;
+    vec4 ndc = vec4(vec3(uv,depth) * 2.0 - 1.0, 1.0);
+    vec4 position = u_inverse_view_projection * ndc;
+    return position.xyz / position.w;
+}
+
+void main()
+{
+    //低分辨率时取对应的GBuffer像素，和模糊、上采样使用同一个深度。
+    ivec2 gbuffer_coord = ivec2(gl_FragCoord.xy) * int(u_ssao_scale);
+    vec2 gbuffer_uv = (vec2(gbuffer_coord) + 0.5) / vec2(textureSize(u_frag_depth_texture,0));
+	vec3 frag_position = ReconstructPosition(gbuffer_uv);
+	vec3 frag_normal = DecodeNormal(texelFetch(u_frag_normal_texture,gbuffer_coord,0).rg);
+
+    //与SSAO像素1:1平铺噪声纹理，模糊半径覆盖噪声纹理大小。
+    ivec2 noise_size = textureSize(u_noise_texture,0);
+    vec3 random_noise = texelFetch(u_noise_texture,ivec2(gl_FragCoord.xy) % noise_size,0).rgb;
+
+    // create TBN change-of-basis matrix: from tangent-space to view-space
+    vec3 tangent = normalize(random_noise - frag_normal * dot(random_noise, frag_normal));
+    vec3 bitangent = cross(frag_normal, tangent);
+    mat3 TBN = mat3(tangent, bitangent, frag_normal);
+    // iterate over the sample kernel and calculate occlusion factor
+    int kernelSize = clamp(int(u_kernel_size), 1, 64);
+    float occlusion = 0.0;
+    for(int i = 0; i < kernelSize; ++i)
+    {
+        // get sample position
+        vec3 samplePos = TBN * u_ssao_kernel[i]; // from tangent to view-space
+        samplePos = frag_position + samplePos * radius;
+
+        // project sample position (to sample texture) (to get position on screen/texture)
+        vec4 offset = vec4(samplePos, 1.0);
+        offset = u_projection * offset; // from view to clip-space
+        offset.xyz /= offset.w; // perspective divide
+        offset.xyz = offset.xyz * 0.5 + 0.5; // transform to range 0.0 - 1.0
+
+        // get sample depth
+        float sampleDepth = ReconstructPosition(offset.xy).z; // get depth value of kernel sample
+
+        // range check & accumulate
+        float rangeCheck = smoothstep(0.0, 1.0, radius / abs(frag_position.z - sampleDepth));
+        occlusion += (sampleDepth >= samplePos.z + bias ? 1.0 : 0.0) * rangeCheck;
+    }
+    occlusion = 1.0 - (occlusion / float(kernelSize));
+
+    o_fragColor = vec4(occlusion, occlusion, occlusion, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#version 330 core
+
+uniform sampler2D u_ssao_texture;//SSAO纹理，和当前渲染目标同样大小
+uniform sampler2D u_frag_depth_texture;//GBuffer深度纹理，全分辨率
+
+uniform vec3 u_blur_direction;//模糊方向 (1,0,0):水平 (0,1,0):垂直
+uniform float u_ssao_scale;//SSAO分辨率缩小倍数 1:全分辨率 2:1/2 4:1/4
+
+uniform mat4 u_projection;
+
+in vec2 v_uv;
+
+layout(location = 0) out vec4 o_fragColor;
+
+//高斯权重，半径3覆盖4x4噪声纹理。
+const float gaussian_weight[4] = float[](0.1995, 0.1760, 0.1210, 0.0648);
+//深度相差超过这个比例的像素不参与模糊，保留物体边缘。
+const float depth_threshold = 0.05;
+
+//取SSAO像素对应的GBuffer像素的线性深度
+float LinearDepth(ivec2 ssao_coord)
+{
+    float depth = texelFetch(u_frag_depth_texture, ssao_coord * int(u_ssao_scale), 0).r;
+    return u_projection[3][2] / (depth * 2.0 - 1.0 + u_projection[2][2]);
+}
+
+void main()
+{
+    ivec2 coord = ivec2(gl_FragCoord.xy);
+    ivec2 max_coord = textureSize(u_ssao_texture, 0) - 1;
+    ivec2 direction = ivec2(u_blur_direction.xy);
+
+    float center_depth = LinearDepth(coord);
+    float occlusion = texelFetch(u_ssao_texture, coord, 0).r * gaussian_weight[0];
+    float total_weight = gaussian_weight[0];
+    for(int i = 1; i < 4; ++i)
+    {
+        for(int side = -1; side <= 1; side += 2)
+        {
+            ivec2 sample_coord = clamp(coord + direction * i * side, ivec2(0), max_coord);
+            float depth_difference = abs(LinearDepth(sample_coord) - center_depth);
+            float weight = gaussian_weight[i] * max(0.0, 1.0 - depth_difference / (depth_threshold * abs(center_depth)));
+            occlusion += texelFetch(u_ssao_texture, sample_coord, 0).r * weight;
+            total_weight += weight;
+        }
+    }
+    occlusion /= total_weight;
+
+    o_fragColor = vec4(occlusion, occlusion, occlusion, 1.0);
+}
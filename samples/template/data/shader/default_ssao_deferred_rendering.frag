@@ -13,21 +13,63 @@ layout(std140) uniform AmbientBlock {
 uniform vec3 u_view_pos;
 
 uniform sampler2D u_frag_diffuse_color_texture;//顶点片段Diffuse纹理
-uniform sampler2D u_ssao_texture;//SSAO纹理
+uniform sampler2D u_ssao_texture;//SSAO纹理，可能是低分辨率
+uniform sampler2D u_frag_depth_texture;//GBuffer深度纹理，全分辨率
 
 uniform float u_use_ssao;//是否使用SSAO
+uniform float u_ssao_scale;//SSAO分辨率缩小倍数 1:全分辨率 2:1/2 4:1/4
+
+uniform mat4 u_projection;
 
 in vec2 v_uv;
 
 layout(location = 0) out vec4 o_fragColor;
 
+//线性深度
+float LinearDepth(ivec2 gbuffer_coord)
+{
+    float depth = texelFetch(u_frag_depth_texture, gbuffer_coord, 0).r;
+    return u_projection[3][2] / (depth * 2.0 - 1.0 + u_projection[2][2]);
+}
+
+//双边上采样：周围4个低分辨率SSAO像素按距离插值，再按深度差降低权重，避免物体边缘的遮蔽扩散到背景。
+float UpsampleSSAO()
+{
+    int scale = int(u_ssao_scale);
+    if(scale <= 1) {
+        return texture(u_ssao_texture,v_uv).r;
+    }
+    ivec2 coord = ivec2(gl_FragCoord.xy);
+    float center_depth = LinearDepth(coord);
+    ivec2 max_ssao_coord = textureSize(u_ssao_texture, 0) - 1;
+
+    //SSAO像素k取的是GBuffer像素k*scale，按这个位置插值。
+    vec2 ssao_position = (gl_FragCoord.xy - 0.5) / float(scale);
+    ivec2 base = ivec2(floor(ssao_position));
+    vec2 f = ssao_position - vec2(base);
+
+    float occlusion = 0.0;
+    float total_weight = 0.0;
+    for(int i = 0; i < 4; ++i)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 ssao_coord = clamp(base + offset, ivec2(0), max_ssao_coord);
+        vec2 bilinear = mix(1.0 - f, f, vec2(offset));
+        //和生成SSAO时取同一个GBuffer像素的深度
+        float depth_difference = abs(LinearDepth(ssao_coord * scale) - center_depth);
+        float weight = bilinear.x * bilinear.y / (depth_difference + 0.001 * abs(center_depth));
+        occlusion += texelFetch(u_ssao_texture, ssao_coord, 0).r * weight;
+        total_weight += weight;
+    }
+    return occlusion / total_weight;
+}
+
 void main()
 {
     vec3 frag_diffuse_color = texture(u_frag_diffuse_color_texture,v_uv).rgb;
-    float ssao = texture(u_ssao_texture,v_uv).r;
-
-    if(u_use_ssao<0.5) {
-        ssao = 1.0;
+    float ssao = 1.0;
+    if(u_use_ssao>=0.5) {
+        ssao = UpsampleSSAO();
     }
 	
     //ambient
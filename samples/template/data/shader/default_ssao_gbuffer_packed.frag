@@ -0,0 +1,26 @@
+#version 330 core
+
+in vec3 v_normal;
+in vec3 v_frag_pos;
+
+layout(location = 0) out vec2 o_frag_normal;//八面体编码法线
+layout(location = 1) out vec4 o_frag_diffuse_color;//rgb:Diffuse a:高光强度
+
+//八面体编码：法线投影到八面体再展开到正方形，2个分量存储单位向量。
+vec2 OctWrap(vec2 v)
+{
+	return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 EncodeNormal(vec3 n)
+{
+	n /= (abs(n.x) + abs(n.y) + abs(n.z));
+	n.xy = n.z >= 0.0 ? n.xy : OctWrap(n.xy);
+	return n.xy * 0.5 + 0.5;
+}
+
+void main()
+{
+	o_frag_normal = EncodeNormal(normalize(v_normal));
+	o_frag_diffuse_color = vec4(1.0,0,0,1.0);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 330 core
+
+uniform sampler2D u_diffuse_texture;
+
+in vec4 v_color;
+in vec2 v_uv;
+layout(location = 0) out vec4 o_fragColor;
+void main()
+{
+    //FreeType生成的SDF，0.5在轮廓上，大于0.5在字形内部。
+    float distance=texture(u_diffuse_texture,v_uv).r;
+    //屏幕上一个像素对应的距离变化，字号越大过渡越窄，边缘保持清晰。
+    float smoothing=max(fwidth(distance),0.0001);
+    float alpha=smoothstep(0.5-smoothing,0.5+smoothing,distance);
+    o_fragColor = vec4(v_color.x,v_color.y,v_color.z,alpha*v_color.a);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+
+uniform mat4 u_light_model_view_projection;
+
+layout(location = 0) in  vec3 a_pos;
+
+void main()
+{
+    gl_Position = u_light_model_view_projection * vec4(a_pos, 1.0);
+}
@@ -0,0 +1,53 @@
+#version 330 core
+
+#define CASCADED_SHADOW_MAX_NUM 4
+
+uniform sampler2D u_diffuse_texture;
+uniform sampler2DArrayShadow u_shadow_map_texture;//每一级一层，硬件比较深度。
+
+//级联阴影参数
+layout(std140) uniform CascadedShadowBlock {
+    mat4 light_view_projection[CASCADED_SHADOW_MAX_NUM];
+    vec4 split_depth;//每一级覆盖的相机视空间深度
+    int cascade_num;
+    float depth_bias;//深度偏移，已经换算到深度纹理的[0,1]范围
+}u_cascaded_shadow;
+
+in vec4 v_color;
+in vec2 v_uv;
+in vec3 v_world_pos;
+in float v_view_depth;
+
+layout(location = 0) out vec4 o_fragColor;
+
+float ShadowCalculation()
+{
+    //按视空间深度选择级联，超出阴影距离没有阴影。
+    int cascade = 0;
+    while(cascade < u_cascaded_shadow.cascade_num && v_view_depth > u_cascaded_shadow.split_depth[cascade]){
+        cascade++;
+    }
+    if(cascade >= u_cascaded_shadow.cascade_num){
+        return 0.0;
+    }
+    vec4 shadow_gl_Position = u_cascaded_shadow.light_view_projection[cascade] * vec4(v_world_pos, 1.0);
+    vec3 proj_coords = shadow_gl_Position.xyz / shadow_gl_Position.w * 0.5 + 0.5;
+    //光源和投影范围之间的物体被压到近裁剪面，这里的深度不会小于0。
+    float current_depth = min(proj_coords.z, 1.0) - u_cascaded_shadow.depth_bias;
+
+    //3x3 PCF，每次采样硬件再做一次双线性比较。
+    vec2 texel_size = 1.0 / vec2(textureSize(u_shadow_map_texture, 0).xy);
+    float lit = 0.0;
+    for(int x = -1; x <= 1; ++x){
+        for(int y = -1; y <= 1; ++y){
+            lit += texture(u_shadow_map_texture, vec4(proj_coords.xy + vec2(x, y) * texel_size, float(cascade), current_depth));
+        }
+    }
+    return 1.0 - lit / 9.0;
+}
+
+void main()
+{
+    float shadow = ShadowCalculation();
+    o_fragColor = texture(u_diffuse_texture,v_uv) * v_color * (1.0 - shadow * 0.7);
+}
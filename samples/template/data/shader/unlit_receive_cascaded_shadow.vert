@@ -0,0 +1,25 @@
+#version 330 core
+
+uniform mat4 u_model;
+uniform mat4 u_view;
+uniform mat4 u_projection;
+
+layout(location = 0) in  vec3 a_pos;
+layout(location = 1) in  vec4 a_color;
+layout(location = 2) in  vec2 a_uv;
+
+out vec4 v_color;
+out vec2 v_uv;
+out vec3 v_world_pos;
+out float v_view_depth;
+
+void main()
+{
+    vec4 world_pos = u_model * vec4(a_pos, 1.0);
+    vec4 view_pos = u_view * world_pos;
+    gl_Position = u_projection * view_pos;
+    v_color = a_color;
+    v_uv = a_uv;
+    v_world_pos = world_pos.xyz;
+    v_view_depth = -view_pos.z;
+}
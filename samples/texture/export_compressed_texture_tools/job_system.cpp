@@ -0,0 +1,107 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "job_system.h"
+
+std::vector<std::thread> JobSystem::workers_;
+std::deque<JobSystem::Job> JobSystem::job_queue_;
+std::mutex JobSystem::job_queue_mutex_;
+std::condition_variable JobSystem::job_queue_condition_;
+bool JobSystem::exit_=false;
+
+void JobSystem::Init(unsigned int worker_num) {
+    if(worker_num==0){
+        worker_num=std::thread::hardware_concurrency();
+    }
+    if(worker_num==0){
+        worker_num=1;
+    }
+    exit_=false;
+    for (unsigned int i = 0; i < worker_num; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerLoop);
+    }
+}
+
+void JobSystem::Exit() {
+    {
+        std::lock_guard<std::mutex> lock(job_queue_mutex_);
+        exit_=true;
+    }
+    job_queue_condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void JobSystem::Dispatch(JobGroup& job_group, std::function<void()> job) {
+    job_group.pending_job_num_++;
+    if(workers_.empty()){
+        //没有工作线程就直接执行
+        Job inline_job{&job_group,std::move(job)};
+        RunJob(inline_job);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(job_queue_mutex_);
+        job_queue_.push_back({&job_group,std::move(job)});
+    }
+    job_queue_condition_.notify_one();
+}
+
+void JobSystem::Wait(JobGroup& job_group) {
+    while(job_group.finished()==false){
+        if(TryRunOneJob()==false){
+            //队列空了，剩下的任务正在其它线程执行。
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)>& job) {
+    JobGroup job_group;
+    for (int i = 0; i < count; ++i) {
+        Dispatch(job_group,[&job,i](){
+            job(i);
+        });
+    }
+    Wait(job_group);
+}
+
+void JobSystem::WorkerLoop() {
+    while(true){
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(job_queue_mutex_);
+            job_queue_condition_.wait(lock,[](){
+                return exit_ || job_queue_.empty()==false;
+            });
+            if(job_queue_.empty()){
+                return;//exit_ 并且队列已经清空
+            }
+            job=std::move(job_queue_.front());
+            job_queue_.pop_front();
+        }
+        RunJob(job);
+    }
+}
+
+bool JobSystem::TryRunOneJob() {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(job_queue_mutex_);
+        if(job_queue_.empty()){
+            return false;
+        }
+        job=std::move(job_queue_.front());
+        job_queue_.pop_front();
+    }
+    RunJob(job);
+    return true;
+}
+
+void JobSystem::RunJob(Job& job) {
+    job.function_();
+    job.job_group_->pending_job_num_--;
+}
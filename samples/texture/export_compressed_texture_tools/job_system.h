@@ -0,0 +1,76 @@
+//
+// Created by captainchen on 2026/10/19.
+// 简单的任务系统，工作线程数等于CPU核数。
+// 等待任务组完成的线程不会空等，而是从队列里取任务来执行，所以任务里可以再派发子任务并等待(每张图片一个任务，图片里每行Block一个子任务)。
+//
+
+#ifndef UNTITLED_JOB_SYSTEM_H
+#define UNTITLED_JOB_SYSTEM_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+/// 任务组，记录还没有完成的任务数量。
+class JobGroup {
+public:
+    JobGroup():pending_job_num_(0){}
+
+    bool finished(){return pending_job_num_.load()==0;}
+
+private:
+    std::atomic<int> pending_job_num_;
+
+    friend class JobSystem;
+};
+
+class JobSystem {
+public:
+    /// 启动工作线程
+    /// \param worker_num 工作线程数量，0表示使用CPU核数。
+    static void Init(unsigned int worker_num=0);
+
+    /// 等待队列中的任务执行完，然后停止工作线程。
+    static void Exit();
+
+    /// 派发一个任务
+    /// \param job_group 任务所属的任务组
+    /// \param job 任务
+    static void Dispatch(JobGroup& job_group,std::function<void()> job);
+
+    /// 等待任务组完成，等待期间当前线程也会执行队列中的任务。
+    static void Wait(JobGroup& job_group);
+
+    /// 将 [0,count) 拆分成 count 个任务并行执行，等待全部完成后返回。
+    static void ParallelFor(int count,const std::function<void(int)>& job);
+
+    static unsigned int worker_num(){return (unsigned int)workers_.size();}
+
+private:
+    struct Job{
+        JobGroup* job_group_;
+        std::function<void()> function_;
+    };
+
+    static void WorkerLoop();
+
+    /// 从队列中取一个任务执行
+    /// \return 队列为空时返回false
+    static bool TryRunOneJob();
+
+    static void RunJob(Job& job);
+
+private:
+    static std::vector<std::thread> workers_;
+    static std::deque<Job> job_queue_;
+    static std::mutex job_queue_mutex_;
+    static std::condition_variable job_queue_condition_;
+    static bool exit_;
+};
+
+
+#endif //UNTITLED_JOB_SYSTEM_H
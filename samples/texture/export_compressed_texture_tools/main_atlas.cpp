@@ -0,0 +1,219 @@
+//
+// Created by captainchen on 2026/10/19.
+// UI图集打包工具，将散图用MaxRects装箱合并成一张或多张图集，压缩为cpt，并输出图集描述文件。
+// 用法: pack_atlas --output=ui/ui_atlas [--max-size=2048] [--padding=2] [--mipmap] image1.png image2.png ...
+// 输出: ui/ui_atlas_0.cpt ui/ui_atlas_1.cpt ... 以及 ui/ui_atlas.atlas
+// 图集描述文件格式:
+//   <atlas>
+//       <page texture="ui_atlas_0.cpt" width="512" height="512"/>
+//       <sprite name="btn_power" page="0" x="2" y="2" width="160" height="64"/>
+//   </atlas>
+// page的texture相对于atlas文件所在目录，sprite名字为图片文件名(不含扩展名)，坐标以左下角为原点(与OpenGL纹理坐标一致)。
+//
+
+#include <fstream>
+#include <algorithm>
+#include "spdlog/spdlog.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "stb/stb_image.h"
+#include "timetool/stopwatch.h"
+#include "texture_compressor.h"
+#include "max_rects_packer.h"
+#include "job_system.h"
+
+using timetool::StopWatch;
+
+/// 散图
+struct SpriteImage{
+    std::string name_;
+    int width_=0;
+    int height_=0;
+    bool alpha_=false;
+    std::vector<unsigned char> rgba_;
+
+    int page_=-1;//所在图集
+    MaxRectsPacker::Rect rect_;//在图集中的位置，包含padding
+};
+
+/// 图集
+struct AtlasPage{
+    int width_;
+    int height_;
+    std::vector<SpriteImage*> sprite_images_;
+};
+
+/// 尝试将散图全部放入指定尺寸的图集
+/// \param sprite_images 散图，按面积从大到小排列
+/// \param count 如果全部放下返回true，否则返回false，count为放入的个数(不会跳过放不下的，保证顺序)
+bool TryPack(std::vector<SpriteImage*>& sprite_images,int width,int height,int padding,size_t& count){
+    MaxRectsPacker packer(width,height);
+    count=0;
+    for (auto sprite_image : sprite_images) {
+        MaxRectsPacker::Rect rect;
+        if(packer.Insert(sprite_image->width_+padding*2,sprite_image->height_+padding*2,rect)==false){
+            return false;
+        }
+        sprite_image->rect_=rect;
+        count++;
+    }
+    return true;
+}
+
+/// 把散图拷贝到图集中，padding区域重复边缘像素，避免采样时混入相邻的散图。
+void BlitSpriteImage(const SpriteImage& sprite_image,int padding,std::vector<unsigned char>& atlas_rgba,int atlas_width){
+    for (int y = 0; y < sprite_image.rect_.height_; ++y) {
+        int src_y=std::min(std::max(y-padding,0),sprite_image.height_-1);
+        for (int x = 0; x < sprite_image.rect_.width_; ++x) {
+            int src_x=std::min(std::max(x-padding,0),sprite_image.width_-1);
+            const unsigned char* src=sprite_image.rgba_.data()+(src_y*sprite_image.width_+src_x)*4;
+            unsigned char* dest=atlas_rgba.data()+((sprite_image.rect_.y_+y)*atlas_width+sprite_image.rect_.x_+x)*4;
+            memcpy(dest,src,4);
+        }
+    }
+}
+
+std::string FileNameWithoutExtension(const std::string& file_path){
+    auto last_index_of_slash=file_path.find_last_of("/\\");
+    std::string file_name=last_index_of_slash==std::string::npos?file_path:file_path.substr(last_index_of_slash+1);
+    auto last_index_of_point=file_name.find_last_of('.');
+    return last_index_of_point==std::string::npos?file_name:file_name.substr(0,last_index_of_point);
+}
+
+int main(int argc,char** argv)
+{
+    spdlog::set_default_logger(spdlog::stdout_color_mt("pack_atlas"));
+
+    std::string output_path;
+    int max_size=2048;
+    int padding=2;
+    bool generate_mipmap=false;
+    std::vector<std::string> image_file_paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if(arg.rfind("--output=",0)==0){
+            output_path=arg.substr(9);
+        }else if(arg.rfind("--max-size=",0)==0){
+            max_size=std::stoi(arg.substr(11));
+        }else if(arg.rfind("--padding=",0)==0){
+            padding=std::stoi(arg.substr(10));
+        }else if(arg=="--mipmap"){
+            generate_mipmap=true;
+        }else{
+            image_file_paths.push_back(arg);
+        }
+    }
+    if(output_path.empty() || image_file_paths.empty()){
+        spdlog::error("usage: pack_atlas --output=ui/ui_atlas [--max-size=2048] [--padding=2] [--mipmap] image1.png image2.png ...");
+        return EXIT_FAILURE;
+    }
+
+    StopWatch stopwatch;
+    stopwatch.start();
+
+    //翻转图片，解析出来的图片数据从左下角开始，这是因为OpenGL的纹理坐标起始点为左下角。
+    stbi_set_flip_vertically_on_load(true);
+    JobSystem::Init();
+
+    //1. 并行加载散图
+    std::vector<SpriteImage> sprite_images(image_file_paths.size());
+    std::atomic<int> fail_num(0);
+    JobSystem::ParallelFor((int)image_file_paths.size(),[&](int i){
+        SpriteImage& sprite_image=sprite_images[i];
+        int channels_in_file;
+        unsigned char* data = stbi_load(image_file_paths[i].c_str(), &sprite_image.width_, &sprite_image.height_, &channels_in_file, 4);
+        if(data== nullptr){
+            spdlog::error("stbi_load failed:{}",image_file_paths[i]);
+            fail_num++;
+            return;
+        }
+        sprite_image.name_=FileNameWithoutExtension(image_file_paths[i]);
+        sprite_image.alpha_=channels_in_file==4 || channels_in_file==2;
+        sprite_image.rgba_.assign(data,data+sprite_image.width_*sprite_image.height_*4);
+        stbi_image_free(data);
+    });
+    if(fail_num>0){
+        JobSystem::Exit();
+        return EXIT_FAILURE;
+    }
+
+    //2. 按面积从大到小装箱，先尝试放入尽量小的图集，放不下就用最大尺寸装满一张，剩下的放到下一张。
+    std::vector<SpriteImage*> remain_sprite_images;
+    for (auto& sprite_image : sprite_images) {
+        if(sprite_image.width_+padding*2>max_size || sprite_image.height_+padding*2>max_size){
+            spdlog::error("sprite {} {}x{} larger than max_size:{}",sprite_image.name_,sprite_image.width_,sprite_image.height_,max_size);
+            JobSystem::Exit();
+            return EXIT_FAILURE;
+        }
+        remain_sprite_images.push_back(&sprite_image);
+    }
+    std::stable_sort(remain_sprite_images.begin(),remain_sprite_images.end(),[](SpriteImage* a,SpriteImage* b){
+        return a->width_*a->height_>b->width_*b->height_;
+    });
+
+    std::vector<AtlasPage> atlas_pages;
+    while(remain_sprite_images.empty()==false){
+        AtlasPage atlas_page{max_size,max_size,{}};
+        size_t count=0;
+        bool all_packed=false;
+        for (int size = 64; size <= max_size && all_packed==false; size*=2) {
+            //先试长方形(宽是高的两倍)，再试正方形。
+            if(size/2>=1 && TryPack(remain_sprite_images,size,size/2,padding,count)){
+                atlas_page={size,size/2,{}};
+                all_packed=true;
+            }else if(TryPack(remain_sprite_images,size,size,padding,count)){
+                atlas_page={size,size,{}};
+                all_packed=true;
+            }
+        }
+        if(all_packed==false){
+            TryPack(remain_sprite_images,max_size,max_size,padding,count);
+        }
+        int page_index=(int)atlas_pages.size();
+        for (size_t i = 0; i < count; ++i) {
+            remain_sprite_images[i]->page_=page_index;
+            atlas_page.sprite_images_.push_back(remain_sprite_images[i]);
+        }
+        remain_sprite_images.erase(remain_sprite_images.begin(),remain_sprite_images.begin()+count);
+        atlas_pages.push_back(atlas_page);
+    }
+
+    //3. 每张图集一个任务，拷贝散图并压缩。
+    std::string atlas_name=FileNameWithoutExtension(output_path);
+    JobSystem::ParallelFor((int)atlas_pages.size(),[&](int page_index){
+        AtlasPage& atlas_page=atlas_pages[page_index];
+        std::vector<unsigned char> atlas_rgba(atlas_page.width_*atlas_page.height_*4,0);
+        bool alpha=false;
+        for (auto sprite_image : atlas_page.sprite_images_) {
+            BlitSpriteImage(*sprite_image,padding,atlas_rgba,atlas_page.width_);
+            alpha=alpha || sprite_image->alpha_;
+        }
+        std::string cpt_file_path=fmt::format("{}_{}.cpt",output_path,page_index);
+        if(TextureCompressor::CompressRGBAToFile(std::move(atlas_rgba),atlas_page.width_,atlas_page.height_,alpha,cpt_file_path,generate_mipmap)==0){
+            fail_num++;
+            return;
+        }
+        spdlog::info("atlas page {} {}x{} sprite_num:{}",cpt_file_path,atlas_page.width_,atlas_page.height_,atlas_page.sprite_images_.size());
+    });
+    JobSystem::Exit();
+    if(fail_num>0){
+        return EXIT_FAILURE;
+    }
+
+    //4. 写入图集描述文件
+    std::ofstream output_file_stream(output_path+".atlas",std::ios::out | std::ios::trunc);
+    output_file_stream<<"<atlas>\n";
+    for (size_t page_index = 0; page_index < atlas_pages.size(); ++page_index) {
+        output_file_stream<<fmt::format("    <page texture=\"{}_{}.cpt\" width=\"{}\" height=\"{}\"/>\n",atlas_name,page_index,atlas_pages[page_index].width_,atlas_pages[page_index].height_);
+    }
+    for (auto& sprite_image : sprite_images) {
+        output_file_stream<<fmt::format("    <sprite name=\"{}\" page=\"{}\" x=\"{}\" y=\"{}\" width=\"{}\" height=\"{}\"/>\n",
+                                        sprite_image.name_,sprite_image.page_,sprite_image.rect_.x_+padding,sprite_image.rect_.y_+padding,
+                                        sprite_image.width_,sprite_image.height_);
+    }
+    output_file_stream<<"</atlas>\n";
+    output_file_stream.close();
+
+    stopwatch.stop();
+    spdlog::info("finish sprite_num:{} page_num:{} cost:{}ms",sprite_images.size(),atlas_pages.size(),stopwatch.milliseconds());
+    return EXIT_SUCCESS;
+}
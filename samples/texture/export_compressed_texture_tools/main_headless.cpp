@@ -0,0 +1,136 @@
+//
+// Created by captainchen on 2026/10/19.
+// 不创建窗口的纹理压缩工具，可以在构建机上批量执行。
+// 用法: compress_tex_headless [--mipmap] [--force] [--threads=N] [--cache=compress_tex_cache.txt] image1.jpg image2.png ...
+// 增量压缩：cache文件记录每张图片上次压缩时的Hash，Hash没变并且cpt文件存在，就跳过这张图片。
+//
+
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <mutex>
+#include "spdlog/spdlog.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "stb/stb_image.h"
+#include "timetool/stopwatch.h"
+#include "texture_compressor.h"
+#include "job_system.h"
+
+using timetool::StopWatch;
+
+/// 上次压缩的记录
+struct CompressRecord{
+    unsigned long long hash_;
+    bool mipmap_;
+};
+
+/// 读取cache文件，每行: hash mipmap 图片路径
+std::unordered_map<std::string,CompressRecord> LoadCompressCache(const std::string& cache_file_path){
+    std::unordered_map<std::string,CompressRecord> compress_cache;
+    std::ifstream input_file_stream(cache_file_path);
+    std::string line;
+    while(std::getline(input_file_stream,line)){
+        std::istringstream line_stream(line);
+        CompressRecord compress_record;
+        std::string image_file_path;
+        line_stream>>compress_record.hash_>>compress_record.mipmap_;
+        std::getline(line_stream>>std::ws,image_file_path);
+        if(line_stream.fail()==false && image_file_path.empty()==false){
+            compress_cache[image_file_path]=compress_record;
+        }
+    }
+    return compress_cache;
+}
+
+void SaveCompressCache(const std::string& cache_file_path,const std::unordered_map<std::string,CompressRecord>& compress_cache){
+    std::ofstream output_file_stream(cache_file_path,std::ios::out | std::ios::trunc);
+    for (auto& pair : compress_cache) {
+        output_file_stream<<pair.second.hash_<<" "<<pair.second.mipmap_<<" "<<pair.first<<"\n";
+    }
+}
+
+bool FileExist(const std::string& file_path){
+    std::ifstream input_file_stream(file_path);
+    return input_file_stream.is_open();
+}
+
+int main(int argc,char** argv)
+{
+    spdlog::set_default_logger(spdlog::stdout_color_mt("compress_tex"));
+
+    bool generate_mipmap=false;
+    bool force=false;
+    unsigned int thread_num=0;
+    std::string cache_file_path="compress_tex_cache.txt";
+    std::vector<std::string> image_file_paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if(arg=="--mipmap"){
+            generate_mipmap=true;
+        }else if(arg=="--force"){
+            force=true;
+        }else if(arg.rfind("--threads=",0)==0){
+            thread_num=(unsigned int)std::stoi(arg.substr(10));
+        }else if(arg.rfind("--cache=",0)==0){
+            cache_file_path=arg.substr(8);
+        }else{
+            image_file_paths.push_back(arg);
+        }
+    }
+
+    //翻转图片，解析出来的图片数据从左下角开始，这是因为OpenGL的纹理坐标起始点为左下角。
+    stbi_set_flip_vertically_on_load(true);
+
+    JobSystem::Init(thread_num);
+    spdlog::info("worker_num:{} image_num:{}",JobSystem::worker_num(),image_file_paths.size());
+
+    auto compress_cache=LoadCompressCache(cache_file_path);
+    std::mutex compress_cache_mutex;
+
+    StopWatch stopwatch;
+    stopwatch.start();
+
+    //每张图片一个任务
+    std::atomic<int> compress_num(0),skip_num(0),fail_num(0);
+    JobGroup job_group;
+    for (auto& src_image_file_path : image_file_paths) {
+        JobSystem::Dispatch(job_group,[&,src_image_file_path](){
+            //替换扩展名，没有扩展名时直接添加。目录名中的'.'不是扩展名。
+            std::string cpt_file_path=src_image_file_path;
+            auto last_index_of_slash=cpt_file_path.find_last_of("/\\");
+            auto last_index_of_point=cpt_file_path.find_last_of('.');
+            if(last_index_of_point==std::string::npos || (last_index_of_slash!=std::string::npos && last_index_of_point<last_index_of_slash)){
+                cpt_file_path.append(".cpt");
+            }else{
+                cpt_file_path.replace(last_index_of_point, cpt_file_path.size()-last_index_of_point, ".cpt");
+            }
+
+            unsigned long long hash=TextureCompressor::HashFile(src_image_file_path);
+            if(force==false && FileExist(cpt_file_path)){
+                std::lock_guard<std::mutex> lock(compress_cache_mutex);
+                auto iter=compress_cache.find(src_image_file_path);
+                if(iter!=compress_cache.end() && iter->second.hash_==hash && iter->second.mipmap_==generate_mipmap){
+                    skip_num++;
+                    return;
+                }
+            }
+
+            if(TextureCompressor::CompressImageFile(src_image_file_path,cpt_file_path,generate_mipmap)==false){
+                fail_num++;
+                return;
+            }
+            compress_num++;
+            std::lock_guard<std::mutex> lock(compress_cache_mutex);
+            compress_cache[src_image_file_path]={hash,generate_mipmap};
+        });
+    }
+    JobSystem::Wait(job_group);
+
+    stopwatch.stop();
+
+    SaveCompressCache(cache_file_path,compress_cache);
+    JobSystem::Exit();
+
+    spdlog::info("finish compress:{} skip:{} fail:{} cost:{}ms",compress_num.load(),skip_num.load(),fail_num.load(),stopwatch.milliseconds());
+    return fail_num>0?EXIT_FAILURE:EXIT_SUCCESS;
+}
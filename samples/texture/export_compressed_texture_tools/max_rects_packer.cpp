@@ -0,0 +1,103 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#include "max_rects_packer.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+    bool Contains(const MaxRectsPacker::Rect& a,const MaxRectsPacker::Rect& b){
+        return b.x_>=a.x_ && b.y_>=a.y_ && b.x_+b.width_<=a.x_+a.width_ && b.y_+b.height_<=a.y_+a.height_;
+    }
+}
+
+MaxRectsPacker::MaxRectsPacker(int width, int height):width_(width),height_(height),used_area_(0) {
+    free_rects_.push_back({0,0,width,height});
+}
+
+bool MaxRectsPacker::Insert(int width, int height, Rect& rect) {
+    //Best Short Side Fit
+    int best_short_side=INT_MAX;
+    int best_long_side=INT_MAX;
+    bool found=false;
+    for (auto& free_rect : free_rects_) {
+        if(free_rect.width_<width || free_rect.height_<height){
+            continue;
+        }
+        int leftover_x=free_rect.width_-width;
+        int leftover_y=free_rect.height_-height;
+        int short_side=std::min(leftover_x,leftover_y);
+        int long_side=std::max(leftover_x,leftover_y);
+        if(short_side<best_short_side || (short_side==best_short_side && long_side<best_long_side)){
+            best_short_side=short_side;
+            best_long_side=long_side;
+            rect={free_rect.x_,free_rect.y_,width,height};
+            found=true;
+        }
+    }
+    if(found==false){
+        return false;
+    }
+
+    //切分所有与之相交的空闲矩形
+    size_t free_rect_num=free_rects_.size();
+    for (size_t i = 0; i < free_rect_num;) {
+        if(SplitFreeRect(free_rects_[i],rect)){
+            free_rects_.erase(free_rects_.begin()+i);
+            free_rect_num--;
+        }else{
+            i++;
+        }
+    }
+    PruneFreeRects();
+
+    used_area_+=(long long)width*height;
+    return true;
+}
+
+float MaxRectsPacker::Occupancy() {
+    return (float)used_area_/((float)width_*height_);
+}
+
+bool MaxRectsPacker::SplitFreeRect(const Rect& free_rect, const Rect& used_rect) {
+    if(used_rect.x_>=free_rect.x_+free_rect.width_ || used_rect.x_+used_rect.width_<=free_rect.x_ ||
+       used_rect.y_>=free_rect.y_+free_rect.height_ || used_rect.y_+used_rect.height_<=free_rect.y_){
+        return false;
+    }
+    //注意 free_rect 是 free_rects_ 中元素的引用，先拷贝一份，push_back可能导致重新分配。
+    Rect free=free_rect;
+    //上下左右四个方向剩余的部分，都作为新的最大空闲矩形。
+    if(used_rect.x_>free.x_){
+        free_rects_.push_back({free.x_,free.y_,used_rect.x_-free.x_,free.height_});
+    }
+    if(used_rect.x_+used_rect.width_<free.x_+free.width_){
+        int x=used_rect.x_+used_rect.width_;
+        free_rects_.push_back({x,free.y_,free.x_+free.width_-x,free.height_});
+    }
+    if(used_rect.y_>free.y_){
+        free_rects_.push_back({free.x_,free.y_,free.width_,used_rect.y_-free.y_});
+    }
+    if(used_rect.y_+used_rect.height_<free.y_+free.height_){
+        int y=used_rect.y_+used_rect.height_;
+        free_rects_.push_back({free.x_,y,free.width_,free.y_+free.height_-y});
+    }
+    return true;
+}
+
+void MaxRectsPacker::PruneFreeRects() {
+    for (size_t i = 0; i < free_rects_.size(); ++i) {
+        for (size_t j = i+1; j < free_rects_.size();) {
+            if(Contains(free_rects_[j],free_rects_[i])){
+                free_rects_.erase(free_rects_.begin()+i);
+                i--;
+                break;
+            }
+            if(Contains(free_rects_[i],free_rects_[j])){
+                free_rects_.erase(free_rects_.begin()+j);
+            }else{
+                j++;
+            }
+        }
+    }
+}
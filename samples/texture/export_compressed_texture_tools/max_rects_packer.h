@@ -0,0 +1,53 @@
+//
+// Created by captainchen on 2026/10/19.
+// MaxRects矩形装箱，用于把UI散图合并成图集。
+// 维护所有最大空闲矩形，每放入一个矩形，就把与它相交的空闲矩形切分，并删除被其它空闲矩形包含的部分。
+// 选择位置使用 Best Short Side Fit：放入后剩余短边最小的空闲矩形。
+//
+
+#ifndef UNTITLED_MAX_RECTS_PACKER_H
+#define UNTITLED_MAX_RECTS_PACKER_H
+
+#include <vector>
+
+class MaxRectsPacker {
+public:
+    struct Rect{
+        int x_;
+        int y_;
+        int width_;
+        int height_;
+    };
+
+    MaxRectsPacker(int width,int height);
+
+    /// 放入一个矩形
+    /// \param width 宽
+    /// \param height 高
+    /// \param rect 放入的位置
+    /// \return 放不下返回false
+    bool Insert(int width,int height,Rect& rect);
+
+    /// 已使用的面积占比
+    float Occupancy();
+
+    int width(){return width_;}
+    int height(){return height_;}
+
+private:
+    /// 用放入的矩形切分空闲矩形
+    /// \return 有相交并切分返回true
+    bool SplitFreeRect(const Rect& free_rect,const Rect& used_rect);
+
+    /// 删除被其它空闲矩形包含的空闲矩形
+    void PruneFreeRects();
+
+private:
+    int width_;
+    int height_;
+    long long used_area_;
+    std::vector<Rect> free_rects_;
+};
+
+
+#endif //UNTITLED_MAX_RECTS_PACKER_H
@@ -0,0 +1,170 @@
+//
+// Created by captainchen on 2026/10/19.
+//
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_DXT_IMPLEMENTATION
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "texture_compressor.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "stb/stb_image.h"
+#include "stb/stb_dxt.h"
+#include "stb/stb_image_resize.h"
+#include "timetool/stopwatch.h"
+#include "spdlog/spdlog.h"
+#include "job_system.h"
+
+using timetool::StopWatch;
+using std::ofstream;
+using std::ifstream;
+using std::ios;
+
+bool TextureCompressor::CompressImageFile(const std::string& image_file_path, const std::string& cpt_file_path, bool generate_mipmap) {
+    StopWatch stopwatch;
+    stopwatch.start();
+
+    //统一按RGBA解析，channels_in_file 决定压缩格式。
+    //stbi_set_flip_vertically_on_load 在main中设置，因为OpenGL的纹理坐标起始点为左下角。
+    int width,height,channels_in_file;
+    unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &channels_in_file, 4);
+    if(data== nullptr){
+        spdlog::error("stbi_load failed:{}",image_file_path);
+        return false;
+    }
+    bool alpha=channels_in_file==4 || channels_in_file==2;
+
+    std::vector<unsigned char> rgba(data,data+width*height*4);
+    stbi_image_free(data);
+
+    int mipmap_num=CompressRGBAToFile(std::move(rgba),width,height,alpha,cpt_file_path,generate_mipmap);
+    if(mipmap_num==0){
+        return false;
+    }
+
+    stopwatch.stop();
+    spdlog::info("compress {} -> {} mipmap_num:{} cost:{}ms",image_file_path,cpt_file_path,mipmap_num,stopwatch.milliseconds());
+    return true;
+}
+
+int TextureCompressor::CompressRGBAToFile(std::vector<unsigned char> rgba, int width, int height, bool alpha,
+                                          const std::string& cpt_file_path, bool generate_mipmap) {
+    ofstream output_file_stream(cpt_file_path,ios::out | ios::binary);
+    if(output_file_stream.is_open()==false){
+        spdlog::error("open cpt file failed:{}",cpt_file_path);
+        return 0;
+    }
+
+    int mipmap_num=1;
+    int gl_texture_format=alpha?kGLCompressedRGBAS3TCDXT5:kGLCompressedRGBS3TCDXT1;
+    std::vector<unsigned char> compressed;
+    if(generate_mipmap==false){
+        CompressRGBA(rgba.data(),width,height,alpha,compressed);
+
+        CptFileHead cpt_file_head;
+        cpt_file_head.type_[0]='c';
+        cpt_file_head.type_[1]='p';
+        cpt_file_head.type_[2]='t';
+        cpt_file_head.mipmap_level_=0;
+        cpt_file_head.width_=width;
+        cpt_file_head.height_=height;
+        cpt_file_head.gl_texture_format_=gl_texture_format;
+        cpt_file_head.compress_size_=(int)compressed.size();
+
+        output_file_stream.write((char*)&cpt_file_head, sizeof(CptFileHead));
+        output_file_stream.write((char*)compressed.data(),compressed.size());
+    }else{
+        //逐级缩小并压缩，直到1x1。
+        std::vector<CptMipmapLevelHead> cpt_mipmap_level_heads;
+        std::vector<unsigned char> mipmap;
+        std::vector<unsigned char> level_compressed;
+        while(true){
+            CompressRGBA(rgba.data(),width,height,alpha,level_compressed);
+            compressed.insert(compressed.end(),level_compressed.begin(),level_compressed.end());
+            cpt_mipmap_level_heads.push_back({width,height,(int)level_compressed.size()});
+
+            if(width==1 && height==1){
+                break;
+            }
+            int mipmap_width,mipmap_height;
+            GenerateMipmap(rgba,width,height,mipmap,mipmap_width,mipmap_height);
+            rgba.swap(mipmap);
+            width=mipmap_width;
+            height=mipmap_height;
+        }
+
+        CptMipmapFileHead cpt_mipmap_file_head;
+        cpt_mipmap_file_head.type_[0]='c';
+        cpt_mipmap_file_head.type_[1]='p';
+        cpt_mipmap_file_head.type_[2]='m';
+        cpt_mipmap_file_head.version_=kCptMipmapVersion;
+        cpt_mipmap_file_head.gl_texture_format_=gl_texture_format;
+        cpt_mipmap_file_head.mipmap_num_=(int)cpt_mipmap_level_heads.size();
+
+        output_file_stream.write((char*)&cpt_mipmap_file_head, sizeof(CptMipmapFileHead));
+        output_file_stream.write((char*)cpt_mipmap_level_heads.data(), sizeof(CptMipmapLevelHead)*cpt_mipmap_level_heads.size());
+        output_file_stream.write((char*)compressed.data(),compressed.size());
+        mipmap_num=(int)cpt_mipmap_level_heads.size();
+    }
+    output_file_stream.close();
+    return mipmap_num;
+}
+
+int TextureCompressor::CompressedSize(int width, int height, bool alpha) {
+    int block_x_num=(width+3)/4;
+    int block_y_num=(height+3)/4;
+    return block_x_num*block_y_num*(alpha?16:8);
+}
+
+void TextureCompressor::CompressRGBA(const unsigned char* rgba, int width, int height, bool alpha, std::vector<unsigned char>& output) {
+    int block_x_num=(width+3)/4;
+    int block_y_num=(height+3)/4;
+    int block_size=alpha?16:8;
+    output.resize(CompressedSize(width,height,alpha));
+
+    //每行Block一个任务
+    JobSystem::ParallelFor(block_y_num,[&](int block_y){
+        unsigned char block[16*4];
+        unsigned char* dest=output.data()+block_y*block_x_num*block_size;
+        for (int block_x = 0; block_x < block_x_num; ++block_x) {
+            //取出4x4像素，超出边缘的重复边缘像素。
+            for (int y = 0; y < 4; ++y) {
+                int pixel_y=std::min(block_y*4+y,height-1);
+                for (int x = 0; x < 4; ++x) {
+                    int pixel_x=std::min(block_x*4+x,width-1);
+                    memcpy(block+(y*4+x)*4,rgba+(pixel_y*width+pixel_x)*4,4);
+                }
+            }
+            stb_compress_dxt_block(dest,block,alpha?1:0,STB_DXT_HIGHQUAL);
+            dest+=block_size;
+        }
+    });
+}
+
+void TextureCompressor::GenerateMipmap(const std::vector<unsigned char>& rgba, int width, int height,
+                                       std::vector<unsigned char>& output, int& output_width, int& output_height) {
+    output_width=std::max(width/2,1);
+    output_height=std::max(height/2,1);
+    output.resize(output_width*output_height*4);
+    //颜色在sRGB空间，缩小要在线性空间计算，否则会整体变暗。
+    stbir_resize_uint8_srgb(rgba.data(),width,height,0,output.data(),output_width,output_height,0,4,3,0);
+}
+
+unsigned long long TextureCompressor::HashFile(const std::string& file_path) {
+    ifstream input_file_stream(file_path,ios::in | ios::binary);
+    if(input_file_stream.is_open()==false){
+        return 0;
+    }
+    unsigned long long hash=14695981039346656037ULL;
+    char buffer[64*1024];
+    while(input_file_stream){
+        input_file_stream.read(buffer,sizeof(buffer));
+        std::streamsize read_size=input_file_stream.gcount();
+        for (std::streamsize i = 0; i < read_size; ++i) {
+            hash^=(unsigned char)buffer[i];
+            hash*=1099511628211ULL;
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,90 @@
+//
+// Created by captainchen on 2026/10/19.
+// CPU纹理压缩，不需要OpenGL上下文，可以在没有显卡的构建机上运行。
+// 3通道图片压缩为DXT1(BC1)，4通道图片压缩为DXT5(BC3)，与 Texture2D::CompressImageFile 从GPU下载的格式一致。
+// 每张图片一个任务，图片内按Block行拆分子任务并行压缩。
+//
+
+#ifndef UNTITLED_TEXTURE_COMPRESSOR_H
+#define UNTITLED_TEXTURE_COMPRESSOR_H
+
+#include <string>
+#include <vector>
+
+class TextureCompressor {
+public:
+    //cpt文件头，与 Texture2D::CptFileHead 一致，只有一级。
+    struct CptFileHead
+    {
+        char type_[3];
+        int mipmap_level_;
+        int width_;
+        int height_;
+        int gl_texture_format_;
+        int compress_size_;
+    };
+
+    //多级mipmap的cpt文件头，与 Texture2D::CptMipmapFileHead 一致，type_为"cpm"。
+    //文件布局：CptMipmapFileHead + mipmap_num_个CptMipmapLevelHead + 从第0级开始依次存放的各级压缩数据。
+    struct CptMipmapFileHead
+    {
+        char type_[3];
+        int version_;
+        int gl_texture_format_;
+        int mipmap_num_;
+    };
+
+    struct CptMipmapLevelHead
+    {
+        int width_;
+        int height_;
+        int compress_size_;
+    };
+
+    static const int kCptMipmapVersion=2;
+
+    //与 glad/glext.h 中定义的值一致，这里不引用OpenGL头文件。
+    static const int kGLCompressedRGBS3TCDXT1=0x83F0;
+    static const int kGLCompressedRGBAS3TCDXT5=0x83F3;
+
+public:
+    /// 压缩图片文件，保存为cpt文件。
+    /// \param image_file_path 图片文件
+    /// \param cpt_file_path 保存的cpt文件
+    /// \param generate_mipmap 是否生成mipmap
+    /// \return 是否成功
+    static bool CompressImageFile(const std::string& image_file_path,const std::string& cpt_file_path,bool generate_mipmap);
+
+    /// 压缩RGBA数据，保存为cpt文件。
+    /// \param rgba RGBA数据，每像素4字节，生成mipmap时会被缩小，所以传值。
+    /// \param width 宽
+    /// \param height 高
+    /// \param alpha true压缩为DXT5，false压缩为DXT1
+    /// \param cpt_file_path 保存的cpt文件
+    /// \param generate_mipmap 是否生成mipmap
+    /// \return 写入的mipmap数量，失败返回0
+    static int CompressRGBAToFile(std::vector<unsigned char> rgba,int width,int height,bool alpha,
+                                  const std::string& cpt_file_path,bool generate_mipmap);
+
+    /// 压缩RGBA数据，按Block行并行。宽高不是4的倍数时，边缘的Block重复边缘像素。
+    /// \param rgba RGBA数据，每像素4字节
+    /// \param width 宽
+    /// \param height 高
+    /// \param alpha true压缩为DXT5，false压缩为DXT1
+    /// \param output 压缩后的数据
+    static void CompressRGBA(const unsigned char* rgba,int width,int height,bool alpha,std::vector<unsigned char>& output);
+
+    /// 压缩后的数据大小
+    static int CompressedSize(int width,int height,bool alpha);
+
+    /// 生成下一级mipmap，宽高减半(最小为1)。
+    static void GenerateMipmap(const std::vector<unsigned char>& rgba,int width,int height,
+                               std::vector<unsigned char>& output,int& output_width,int& output_height);
+
+    /// 计算文件内容的Hash(FNV-1a 64)，用于增量压缩判断源图片是否修改。
+    /// \return 文件不存在返回0
+    static unsigned long long HashFile(const std::string& file_path);
+};
+
+
+#endif //UNTITLED_TEXTURE_COMPRESSOR_H